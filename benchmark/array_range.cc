@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <vector>
+#include "napi.h"
+
+// Native data that an addon appends to a JS array.
+static const std::vector<double>& Samples(size_t count) {
+  static std::vector<double> samples;
+  if (samples.size() != count) {
+    samples.resize(count);
+    for (size_t index = 0; index < count; index++) {
+      samples[index] = static_cast<double>(index) + 0.5;
+    }
+  }
+  return samples;
+}
+
+static std::vector<napi_value>& Handles(size_t count) {
+  static std::vector<napi_value> handles;
+  handles.resize(count);
+  return handles;
+}
+
+static void GetEach(const Napi::CallbackInfo& info) {
+  Napi::Array array = info[0].As<Napi::Array>();
+  uint32_t length = array.Length();
+  std::vector<napi_value>& values = Handles(length);
+  for (uint32_t index = 0; index < length; index++) {
+    values[index] = array.Get(index);
+  }
+}
+
+static void GetRange(const Napi::CallbackInfo& info) {
+  Napi::Array array = info[0].As<Napi::Array>();
+  uint32_t length = array.Length();
+  array.GetRange(0, length, Handles(length).data());
+}
+
+static void SetEach(const Napi::CallbackInfo& info) {
+  Napi::Array array = info[0].As<Napi::Array>();
+  uint32_t length = array.Length();
+  for (uint32_t index = 0; index < length; index++) {
+    array.Set(index, info[1]);
+  }
+}
+
+static void SetRange(const Napi::CallbackInfo& info) {
+  Napi::Array array = info[0].As<Napi::Array>();
+  uint32_t length = array.Length();
+  std::vector<napi_value>& values = Handles(length);
+  std::fill(values.begin(), values.end(), info[1]);
+  array.SetRange(0, length, values.data());
+}
+
+static Napi::Value AppendEach(const Napi::CallbackInfo& info) {
+  Napi::Array array = Napi::Array::New(info.Env());
+  uint32_t index = 0;
+  for (double sample : Samples(info[0].As<Napi::Number>().Uint32Value())) {
+    array.Set(index++, sample);
+  }
+  return array;
+}
+
+static Napi::Value AppendRange(const Napi::CallbackInfo& info) {
+  Napi::Array array = Napi::Array::New(info.Env());
+  array.Append(Samples(info[0].As<Napi::Number>().Uint32Value()));
+  return array;
+}
+
+static Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  exports["getEach"] = Napi::Function::New(env, GetEach);
+  exports["getRange"] = Napi::Function::New(env, GetRange);
+  exports["setEach"] = Napi::Function::New(env, SetEach);
+  exports["setRange"] = Napi::Function::New(env, SetRange);
+  exports["appendEach"] = Napi::Function::New(env, AppendEach);
+  exports["appendRange"] = Napi::Function::New(env, AppendRange);
+  return exports;
+}
+
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, Init)
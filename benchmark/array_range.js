@@ -0,0 +1,30 @@
+const path = require('path');
+const Benchmark = require('benchmark');
+const addonName = path.basename(__filename, '.js');
+
+const sizes = [16, 256, 4096, 65536];
+
+[addonName, addonName + '_noexcept']
+  .forEach((addonName) => {
+    const rootAddon = require('bindings')({
+      bindings: addonName,
+      module_root: __dirname
+    });
+
+    console.log(`\n${addonName}: `);
+
+    sizes.forEach((size) => {
+      const array = Array.from({ length: size }, (_, index) => index);
+
+      console.log(`\n${size} elements:`);
+      new Benchmark.Suite()
+        .add('      Get() per element', () => rootAddon.getEach(array))
+        .add('             GetRange()', () => rootAddon.getRange(array))
+        .add('      Set() per element', () => rootAddon.setEach(array, 1))
+        .add('             SetRange()', () => rootAddon.setRange(array, 1))
+        .add('Set(length) per element', () => rootAddon.appendEach(size))
+        .add('               Append()', () => rootAddon.appendRange(size))
+        .on('cycle', (event) => console.log(String(event.target)))
+        .run();
+    });
+  });
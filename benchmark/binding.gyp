@@ -1,6 +1,16 @@
 {
   'target_defaults': { 'includes': ['../common.gypi'] },
   'targets': [
+    {
+      'target_name': 'array_range',
+      'sources': [ 'array_range.cc' ],
+      'includes': [ '../except.gypi' ],
+    },
+    {
+      'target_name': 'array_range_noexcept',
+      'sources': [ 'array_range.cc' ],
+      'includes': [ '../noexcept.gypi' ],
+    },
     {
       'target_name': 'function_args',
       'sources': [ 'function_args.cc' ],
@@ -11,6 +21,26 @@
       'sources': [ 'function_args.cc' ],
       'includes': [ '../noexcept.gypi' ],
     },
+    {
+      'target_name': 'lazy_exports',
+      'sources': [ 'lazy_exports.cc' ],
+      'includes': [ '../except.gypi' ],
+    },
+    {
+      'target_name': 'lazy_exports_noexcept',
+      'sources': [ 'lazy_exports.cc' ],
+      'includes': [ '../noexcept.gypi' ],
+    },
+    {
+      'target_name': 'object_wrap',
+      'sources': [ 'object_wrap.cc' ],
+      'includes': [ '../except.gypi' ],
+    },
+    {
+      'target_name': 'object_wrap_noexcept',
+      'sources': [ 'object_wrap.cc' ],
+      'includes': [ '../noexcept.gypi' ],
+    },
     {
       'target_name': 'property_descriptor',
       'sources': [ 'property_descriptor.cc' ],
@@ -21,5 +51,35 @@
       'sources': [ 'property_descriptor.cc' ],
       'includes': [ '../noexcept.gypi' ],
     },
+    {
+      'target_name': 'scoped_loop',
+      'sources': [ 'scoped_loop.cc' ],
+      'includes': [ '../except.gypi' ],
+    },
+    {
+      'target_name': 'scoped_loop_noexcept',
+      'sources': [ 'scoped_loop.cc' ],
+      'includes': [ '../noexcept.gypi' ],
+    },
+    {
+      'target_name': 'serializer',
+      'sources': [ 'serializer.cc' ],
+      'includes': [ '../except.gypi' ],
+    },
+    {
+      'target_name': 'serializer_noexcept',
+      'sources': [ 'serializer.cc' ],
+      'includes': [ '../noexcept.gypi' ],
+    },
+    {
+      'target_name': 'symbol',
+      'sources': [ 'symbol.cc' ],
+      'includes': [ '../except.gypi' ],
+    },
+    {
+      'target_name': 'symbol_noexcept',
+      'sources': [ 'symbol.cc' ],
+      'includes': [ '../noexcept.gypi' ],
+    },
   ]
 }
@@ -0,0 +1,114 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+// Unlike the other benchmarks, this one does not load an addon. It measures
+// how long the compiler spends on translation units that include the library
+// in different ways, which is what dominates the build time of addons made of
+// many source files.
+const compiler = process.env.CXX || 'c++';
+const runs = Number(process.env.npm_config_build_time_runs) || 3;
+const nodeInclude = path.resolve(process.execPath, '..', '..', 'include', 'node');
+const libraryInclude = path.resolve(__dirname, '..');
+
+// A translation unit that only uses values, typed arrays and references.
+const valuesSource = `
+Napi::Value Sum(const Napi::CallbackInfo& info) {
+  Napi::Float64Array samples = info[0].As<Napi::Float64Array>();
+  Napi::ObjectReference options = Napi::Persistent(info[1].As<Napi::Object>());
+  double sum = 0;
+  for (size_t index = 0; index < samples.ElementLength(); index++) {
+    sum += samples[index];
+  }
+  Napi::Object result = Napi::Object::New(info.Env());
+  result["sum"] = sum;
+  result["options"] = options.Value();
+  return result;
+}
+`;
+
+// A translation unit that also defines a class.
+const classSource = valuesSource + `
+class Counter : public Napi::ObjectWrap<Counter> {
+ public:
+  static Napi::Function Define(Napi::Env env) {
+    return DefineClass(env, "Counter",
+                       {InstanceMethod<&Counter::Increment>("increment")});
+  }
+  Counter(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Counter>(info) {}
+
+ private:
+  Napi::Value Increment(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), ++count_);
+  }
+  double count_ = 0;
+};
+`;
+
+const modular = ['NODE_ADDON_API_MODULAR_HEADERS'];
+const externTemplates = ['NODE_ADDON_API_EXTERN_TEMPLATES'];
+
+const cases = [
+  ['values, napi.h', [], ['napi.h'], valuesSource],
+  ['values, modular', modular, ['napi.h'], valuesSource],
+  ['values, modular + extern templates',
+    modular.concat(externTemplates), ['napi.h'], valuesSource],
+  ['class, napi.h', [], ['napi.h'], classSource],
+  ['class, modular', modular, ['napi.h', 'napi-objectwrap.h'], classSource]
+];
+
+function median (values) {
+  const sorted = values.slice().sort((a, b) => a - b);
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+function compile (dir, name, defines, headers, body, optimization) {
+  const source = path.join(dir, `${name}.cc`);
+  fs.writeFileSync(source,
+    headers.map((header) => `#include "${header}"\n`).join('') + body);
+  const args = [
+    '-std=c++17',
+    optimization,
+    '-c',
+    '-o', path.join(dir, `${name}.o`),
+    `-DNAPI_VERSION=${process.versions.napi}`,
+    '-DNAPI_CPP_EXCEPTIONS',
+    ...defines.map((define) => `-D${define}`),
+    `-I${nodeInclude}`,
+    `-I${libraryInclude}`,
+    source
+  ];
+  const start = process.hrtime.bigint();
+  const child = spawnSync(compiler, args, { stdio: 'inherit' });
+  const elapsed = Number(process.hrtime.bigint() - start) / 1e6;
+  if (child.error || child.status !== 0) {
+    throw child.error || new Error(`${compiler} exited with ${child.status}`);
+  }
+  return elapsed;
+}
+
+if (!fs.existsSync(path.join(nodeInclude, 'node_api.h'))) {
+  console.log(`\nbuild_time: skipped, no Node.js headers in ${nodeInclude}`);
+} else {
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'napi-build-time-'));
+  try {
+    for (const optimization of ['-O0', '-O2']) {
+      console.log(`\nbuild_time (${compiler} ${optimization}, ` +
+        `median of ${runs}): `);
+      // Cases take turns so that a busy machine slows all of them alike.
+      const times = cases.map(() => []);
+      for (let run = 0; run < runs; run++) {
+        cases.forEach(([, defines, headers, body], index) => {
+          times[index].push(compile(dir, `case${index}`, defines, headers, body,
+            optimization));
+        });
+      }
+      cases.forEach(([label], index) => {
+        console.log(`${label.padStart(34)}: ${median(times[index]).toFixed(0)} ms`);
+      });
+    }
+  } finally {
+    fs.rmSync(dir, { recursive: true, force: true });
+  }
+}
@@ -0,0 +1,74 @@
+#include <string>
+#include <vector>
+#include "napi.h"
+
+// Stand-in for an addon that exposes many classes from its `Init` function.
+static const size_t kClassCount = 150;
+
+class Klass : public Napi::ObjectWrap<Klass> {
+ public:
+  Klass(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Klass>(info) {}
+
+  static Napi::Value Define(Napi::Env env) {
+    return DefineClass(env,
+                       "Klass",
+                       {
+                           InstanceMethod<&Klass::Method>("method0"),
+                           InstanceMethod<&Klass::Method>("method1"),
+                           InstanceMethod<&Klass::Method>("method2"),
+                           InstanceMethod<&Klass::Method>("method3"),
+                           InstanceMethod<&Klass::Method>("method4"),
+                           InstanceMethod<&Klass::Method>("method5"),
+                           InstanceMethod<&Klass::Method>("method6"),
+                           InstanceMethod<&Klass::Method>("method7"),
+                           InstanceAccessor<&Klass::Method>("accessor0"),
+                           InstanceAccessor<&Klass::Method>("accessor1"),
+                       });
+  }
+
+ private:
+  Napi::Value Method(const Napi::CallbackInfo& info) {
+    return info.Env().Undefined();
+  }
+};
+
+static const std::vector<std::string>& ClassNames() {
+  static std::vector<std::string> names;
+  if (names.empty()) {
+    for (size_t index = 0; index < kClassCount; index++) {
+      names.push_back("Class" + std::to_string(index));
+    }
+  }
+  return names;
+}
+
+static const std::vector<Napi::LazyExports::Entry>& LazyEntries() {
+  static std::vector<Napi::LazyExports::Entry> entries;
+  if (entries.empty()) {
+    for (const std::string& name : ClassNames()) {
+      entries.push_back({name.c_str(), Klass::Define});
+    }
+  }
+  return entries;
+}
+
+static void DefineEager(const Napi::CallbackInfo& info) {
+  Napi::Object target = info[0].As<Napi::Object>();
+  for (const std::string& name : ClassNames()) {
+    target[name] = Klass::Define(info.Env());
+  }
+}
+
+static void DefineLazy(const Napi::CallbackInfo& info) {
+  const std::vector<Napi::LazyExports::Entry>& entries = LazyEntries();
+  Napi::LazyExports::Define(
+      info.Env(), info[0], entries.data(), entries.size());
+}
+
+static Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  exports["defineEager"] = Napi::Function::New(env, DefineEager);
+  exports["defineLazy"] = Napi::Function::New(env, DefineLazy);
+  return exports;
+}
+
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -0,0 +1,30 @@
+const path = require('path');
+const Benchmark = require('benchmark');
+const addonName = path.basename(__filename, '.js');
+
+// Each case does the work an addon's `Init` function does for 150 classes,
+// so the numbers reflect the time `require()` spends in native code.
+[addonName, addonName + '_noexcept']
+  .forEach((addonName) => {
+    const rootAddon = require('bindings')({
+      bindings: addonName,
+      module_root: __dirname
+    });
+
+    console.log(`\n${addonName}: `);
+
+    new Benchmark.Suite()
+      .add('        eager DefineClass', () => {
+        rootAddon.defineEager({});
+      })
+      .add('          LazyExports', () => {
+        rootAddon.defineLazy({});
+      })
+      .add('LazyExports + 1 access', () => {
+        const exports = {};
+        rootAddon.defineLazy(exports);
+        return exports.Class0;
+      })
+      .on('cycle', (event) => console.log(String(event.target)))
+      .run();
+  });
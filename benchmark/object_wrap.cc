@@ -0,0 +1,57 @@
+#include "napi.h"
+
+// Two otherwise identical classes, the second of which is wrapped without a
+// reference to its JavaScript object.
+class ReferencedPoint : public Napi::ObjectWrap<ReferencedPoint> {
+ public:
+  ReferencedPoint(const Napi::CallbackInfo& info)
+      : Napi::ObjectWrap<ReferencedPoint>(info),
+        x_(info[0].As<Napi::Number>().DoubleValue()),
+        y_(info[1].As<Napi::Number>().DoubleValue()) {}
+
+  static Napi::Function Define(Napi::Env env) {
+    return DefineClass(env,
+                       "ReferencedPoint",
+                       {InstanceMethod<&ReferencedPoint::Sum>("sum")});
+  }
+
+ private:
+  Napi::Value Sum(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), x_ + y_);
+  }
+
+  double x_;
+  double y_;
+};
+
+class UnreferencedPoint : public Napi::ObjectWrap<UnreferencedPoint> {
+ public:
+  static constexpr bool kWrapReference = false;
+
+  UnreferencedPoint(const Napi::CallbackInfo& info)
+      : Napi::ObjectWrap<UnreferencedPoint>(info),
+        x_(info[0].As<Napi::Number>().DoubleValue()),
+        y_(info[1].As<Napi::Number>().DoubleValue()) {}
+
+  static Napi::Function Define(Napi::Env env) {
+    return DefineClass(env,
+                       "UnreferencedPoint",
+                       {InstanceMethod<&UnreferencedPoint::Sum>("sum")});
+  }
+
+ private:
+  Napi::Value Sum(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), x_ + y_);
+  }
+
+  double x_;
+  double y_;
+};
+
+static Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  exports["ReferencedPoint"] = ReferencedPoint::Define(env);
+  exports["UnreferencedPoint"] = UnreferencedPoint::Define(env);
+  return exports;
+}
+
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, Init)
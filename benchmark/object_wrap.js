@@ -0,0 +1,21 @@
+const path = require('path');
+const Benchmark = require('benchmark');
+const addonName = path.basename(__filename, '.js');
+
+[addonName, addonName + '_noexcept']
+  .forEach((addonName) => {
+    const rootAddon = require('bindings')({
+      bindings: addonName,
+      module_root: __dirname
+    });
+
+    console.log(`\n${addonName}: `);
+
+    // Construction includes wrapping, and the garbage collection of earlier
+    // instances, which is where a reference per instance costs the most.
+    new Benchmark.Suite()
+      .add('  new ReferencedPoint()', () => new rootAddon.ReferencedPoint(1, 2))
+      .add('new UnreferencedPoint()', () => new rootAddon.UnreferencedPoint(1, 2))
+      .on('cycle', (event) => console.log(String(event.target)))
+      .run();
+  });
@@ -26,6 +26,10 @@ static void Setter(const Napi::CallbackInfo& info) {
   (void)info[0];
 }
 
+static Napi::Value Method(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), 42);
+}
+
 #if NAPI_VERSION > 5
 class PropDescBenchmark : public Napi::Addon<PropDescBenchmark> {
  public:
@@ -40,6 +44,14 @@ class PropDescBenchmark : public Napi::Addon<PropDescBenchmark> {
                                      &PropDescBenchmark::Setter>(
                         "addon_templated", napi_enumerable),
                 });
+    DefineProperties(exports.Get("methods").As<Napi::Object>(),
+                     {
+                         InstanceMethod("addon",
+                                        &PropDescBenchmark::Method,
+                                        napi_enumerable),
+                         InstanceMethod<&PropDescBenchmark::Method>(
+                             "addon_templated", napi_enumerable),
+                     });
   }
 
  private:
@@ -51,6 +63,10 @@ class PropDescBenchmark : public Napi::Addon<PropDescBenchmark> {
     (void)info[0];
     (void)val;
   }
+
+  Napi::Value Method(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), 42);
+  }
 };
 #endif  // NAPI_VERSION > 5
 
@@ -74,6 +90,10 @@ static Napi::Object Init(Napi::Env env, Napi::Object exports) {
   exports.DefineProperty(Napi::PropertyDescriptor::Accessor<Getter, Setter>(
       "templated", napi_enumerable));
 
+  Napi::Object methods = Napi::Object::New(env);
+  methods["cplusplus"] = Napi::Function::New(env, Method);
+  exports["methods"] = methods;
+
 #if NAPI_VERSION > 5
   PropDescBenchmark::Init(env, exports);
 #endif  // NAPI_VERSION > 5
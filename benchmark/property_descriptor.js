@@ -9,8 +9,11 @@ const addonName = path.basename(__filename, '.js');
       module_root: __dirname
     });
     delete rootAddon.path;
+    const { methods } = rootAddon;
+    delete rootAddon.methods;
     const getters = new Benchmark.Suite();
     const setters = new Benchmark.Suite();
+    const calls = new Benchmark.Suite();
     const maxNameLength = Object.keys(rootAddon)
       .reduce((soFar, value) => Math.max(soFar, value.length), 0);
 
@@ -35,4 +38,16 @@ const addonName = path.basename(__filename, '.js');
     setters
       .on('cycle', (event) => console.log(String(event.target)))
       .run();
+
+    console.log('');
+
+    Object.keys(methods).forEach((key) => {
+      calls.add(`${key} method`.padStart(maxNameLength + 7), () => {
+        methods[key]();
+      });
+    });
+
+    calls
+      .on('cycle', (event) => console.log(String(event.target)))
+      .run();
   });
@@ -0,0 +1,72 @@
+#include <cmath>
+#include <vector>
+#include "napi.h"
+
+// Native data that an addon converts to JS values one element at a time.
+static const std::vector<double>& Samples(size_t count) {
+  static std::vector<double> samples;
+  if (samples.size() != count) {
+    samples.resize(count);
+    for (size_t index = 0; index < count; index++) {
+      samples[index] = std::sin(static_cast<double>(index)) * 1000.5;
+    }
+  }
+  return samples;
+}
+
+// Each conversion allocates a heap number, so the live handle count decides
+// how much the garbage collector has to trace while the loop is running.
+static double Convert(Napi::Env env, double sample) {
+  return Napi::Number::New(env, sample).DoubleValue();
+}
+
+static Napi::Value SingleScope(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  double sum = 0;
+  for (double sample : Samples(info[0].As<Napi::Number>().Uint32Value())) {
+    sum += Convert(env, sample);
+  }
+  return Napi::Number::New(env, sum);
+}
+
+static Napi::Value ScopePerElement(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  double sum = 0;
+  for (double sample : Samples(info[0].As<Napi::Number>().Uint32Value())) {
+    Napi::HandleScope scope(env);
+    sum += Convert(env, sample);
+  }
+  return Napi::Number::New(env, sum);
+}
+
+static Napi::Value WithScopedLoop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  double sum = 0;
+  Napi::ScopedLoop loop(env, info[1].As<Napi::Number>().Uint32Value());
+  for (double sample : Samples(info[0].As<Napi::Number>().Uint32Value())) {
+    sum += Convert(env, sample);
+    loop.Next();
+  }
+  return Napi::Number::New(env, sum);
+}
+
+static Napi::Value WithForEachScoped(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  double sum = 0;
+  Napi::ForEachScoped(
+      env,
+      Samples(info[0].As<Napi::Number>().Uint32Value()),
+      [&](double sample) { sum += Convert(env, sample); },
+      info[1].As<Napi::Number>().Uint32Value());
+  return Napi::Number::New(env, sum);
+}
+
+static Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  exports["singleScope"] = Napi::Function::New(env, SingleScope);
+  exports["scopePerElement"] = Napi::Function::New(env, ScopePerElement);
+  exports["scopedLoop"] = Napi::Function::New(env, WithScopedLoop);
+  exports["forEachScoped"] = Napi::Function::New(env, WithForEachScoped);
+  return exports;
+}
+
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -0,0 +1,61 @@
+const path = require('path');
+const { PerformanceObserver, performance } = require('perf_hooks');
+const addonName = path.basename(__filename, '.js');
+
+// A 10M-element loop is too long for repeated Benchmark.js sampling, so each
+// case runs once and reports its wall time together with the garbage
+// collection pauses that happened while it was running.
+const count = 10 * 1000 * 1000;
+const chunkSize = 1024;
+
+// Garbage collection entries reach observers asynchronously, a little after
+// the collection itself.
+const settle = () => new Promise((resolve) => setTimeout(resolve, 100));
+
+async function measure (label, fn) {
+  const pauses = [];
+  const observer = new PerformanceObserver((list) => {
+    list.getEntries().forEach((entry) => pauses.push(entry.duration));
+  });
+  global.gc();
+  await settle();
+  observer.observe({ entryTypes: ['gc'] });
+  const start = performance.now();
+  fn();
+  const elapsed = performance.now() - start;
+  await settle();
+  observer.disconnect();
+
+  const total = pauses.reduce((sum, pause) => sum + pause, 0);
+  const max = pauses.reduce((largest, pause) => Math.max(largest, pause), 0);
+  console.log(`${label}: ${elapsed.toFixed(1)} ms, ` +
+    `${pauses.length} GCs, ${total.toFixed(1)} ms paused ` +
+    `(max ${max.toFixed(1)} ms)`);
+}
+
+(async () => {
+  for (const name of [addonName, addonName + '_noexcept']) {
+    const rootAddon = require('bindings')({
+      bindings: name,
+      module_root: __dirname
+    });
+
+    console.log(`\n${name} (${count} elements): `);
+
+    // Warm up the conversion and the native sample buffer.
+    rootAddon.scopedLoop(count, chunkSize);
+
+    await measure('     single HandleScope', () => {
+      rootAddon.singleScope(count);
+    });
+    await measure('HandleScope per element', () => {
+      rootAddon.scopePerElement(count);
+    });
+    await measure(`   ScopedLoop (${chunkSize})`, () => {
+      rootAddon.scopedLoop(count, chunkSize);
+    });
+    await measure(`ForEachScoped (${chunkSize})`, () => {
+      rootAddon.forEachScoped(count, chunkSize);
+    });
+  }
+})();
@@ -0,0 +1,25 @@
+#include "napi.h"
+
+#if NAPI_VERSION > 5
+static Napi::Value Serialize(const Napi::CallbackInfo& info) {
+  return Napi::Serializer::Serialize(info.Env(), info[0]);
+}
+
+static Napi::Value Deserialize(const Napi::CallbackInfo& info) {
+  Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
+  return Napi::Deserializer::Deserialize(
+      info.Env(), buffer.Data(), buffer.Length());
+}
+#endif  // NAPI_VERSION > 5
+
+static Napi::Object Init(Napi::Env env, Napi::Object exports) {
+#if NAPI_VERSION > 5
+  exports["serialize"] = Napi::Function::New(env, Serialize);
+  exports["deserialize"] = Napi::Function::New(env, Deserialize);
+#else
+  (void)env;
+#endif  // NAPI_VERSION > 5
+  return exports;
+}
+
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, Init)
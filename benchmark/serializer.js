@@ -0,0 +1,53 @@
+const path = require('path');
+const v8 = require('v8');
+const Benchmark = require('benchmark');
+const addonName = path.basename(__filename, '.js');
+
+const rows = Array.from({ length: 1000 }, (_, i) => ({
+  id: i,
+  name: `row ${i}`,
+  score: i / 7,
+  active: i % 2 === 0,
+  tags: ['alpha', 'beta']
+}));
+
+const samples = new Float64Array(64 * 1024).map((_, i) => Math.sin(i));
+
+const payloads = {
+  'rows of objects': rows,
+  'Float64Array (512 KiB)': { samples }
+};
+
+[addonName, addonName + '_noexcept']
+  .forEach((addonName) => {
+    const rootAddon = require('bindings')({
+      bindings: addonName,
+      module_root: __dirname
+    });
+    if (!rootAddon.serialize) return;
+
+    console.log(`\n${addonName}: `);
+
+    Object.keys(payloads).forEach((payloadName) => {
+      const payload = payloads[payloadName];
+      const serialized = rootAddon.serialize(payload);
+      const json = JSON.stringify(payload);
+      const v8Serialized = v8.serialize(payload);
+
+      console.log(`${payloadName}, serialize:`);
+      new Benchmark.Suite()
+        .add('Napi::Serializer', () => rootAddon.serialize(payload))
+        .add('  JSON.stringify', () => JSON.stringify(payload))
+        .add('    v8.serialize', () => v8.serialize(payload))
+        .on('cycle', (event) => console.log(String(event.target)))
+        .run();
+
+      console.log(`${payloadName}, deserialize:`);
+      new Benchmark.Suite()
+        .add('Napi::Deserializer', () => rootAddon.deserialize(serialized))
+        .add('        JSON.parse', () => JSON.parse(json))
+        .add('    v8.deserialize', () => v8.deserialize(v8Serialized))
+        .on('cycle', (event) => console.log(String(event.target)))
+        .run();
+    });
+  });
@@ -0,0 +1,22 @@
+#include "napi.h"
+
+static Napi::Value WellKnown(const Napi::CallbackInfo& info) {
+  return Napi::Symbol::WellKnown(info.Env(), "iterator");
+}
+
+static Napi::Value ForString(const Napi::CallbackInfo& info) {
+  return Napi::Symbol::For(info.Env(), "benchmark.tag");
+}
+
+static Napi::Value ForValue(const Napi::CallbackInfo& info) {
+  return Napi::Symbol::For(info.Env(), info[0]);
+}
+
+static Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  exports["wellKnown"] = Napi::Function::New(env, WellKnown);
+  exports["forString"] = Napi::Function::New(env, ForString);
+  exports["forValue"] = Napi::Function::New(env, ForValue);
+  return exports;
+}
+
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, Init)
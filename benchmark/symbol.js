@@ -0,0 +1,20 @@
+const path = require('path');
+const Benchmark = require('benchmark');
+const addonName = path.basename(__filename, '.js');
+
+[addonName, addonName + '_noexcept']
+  .forEach((addonName) => {
+    const rootAddon = require('bindings')({
+      bindings: addonName,
+      module_root: __dirname
+    });
+
+    console.log(`\n${addonName}: `);
+
+    new Benchmark.Suite()
+      .add(' Symbol::WellKnown()', () => rootAddon.wellKnown())
+      .add('  Symbol::For(char*)', () => rootAddon.forString())
+      .add('Symbol::For(String)', () => rootAddon.forValue('benchmark.tag'))
+      .on('cycle', (event) => console.log(String(event.target)))
+      .run();
+  });
@@ -6,6 +6,8 @@ module.exports = {
   include: `"${__dirname}"`, // deprecated, can be removed as part of 4.0.0
   include_dir: includeDir,
   gyp: path.join(includeDir, 'node_api.gyp:nothing'),
+  // Optional; see NODE_ADDON_API_EXTERN_TEMPLATES in doc/setup.md.
+  source: path.join(includeDir, 'napi.cc'),
   isNodeApiBuiltin: true,
   needsFlag: false
 };
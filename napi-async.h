@@ -0,0 +1,744 @@
+#ifndef SRC_NAPI_ASYNC_H_
+#define SRC_NAPI_ASYNC_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// Node-API C++ Wrapper Classes: asynchronous operations
+//
+// Callback scopes, AsyncContext, AsyncWorker, the AsyncProgress workers and
+// thread-safe functions.
+//
+// Included by "napi.h" unless NODE_ADDON_API_MODULAR_HEADERS is defined. In
+// that case, include this header in the translation units that use it.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "napi.h"
+
+namespace Napi {
+
+#ifdef NAPI_CPP_CUSTOM_NAMESPACE
+namespace NAPI_CPP_CUSTOM_NAMESPACE {
+#endif
+
+#if (NAPI_VERSION > 2)
+class CallbackScope {
+ public:
+  CallbackScope(napi_env env, napi_callback_scope scope);
+  CallbackScope(napi_env env, napi_async_context context);
+  virtual ~CallbackScope();
+
+  // Disallow copying to prevent double close of napi_callback_scope
+  NAPI_DISALLOW_ASSIGN_COPY(CallbackScope)
+
+  operator napi_callback_scope() const;
+
+  Napi::Env Env() const;
+
+ private:
+  napi_env _env;
+  napi_callback_scope _scope;
+};
+
+/// Dispatches a batch of calls into JavaScript from a single callback scope.
+///
+/// Each `Function::MakeCallback()` opens and closes a callback scope of its
+/// own, and closing the outermost callback scope processes the
+/// `process.nextTick()` queue and the microtask queue. A `CallbackBatch` opens
+/// one scope for the given async context, makes every call with
+/// `napi_call_function()`, and lets the queued ticks run once, when the batch
+/// is destroyed.
+///
+/// If a call throws, the exception remains pending and subsequent calls fail;
+/// callers not using C++ exceptions should stop dispatching at that point.
+class CallbackBatch {
+ public:
+  CallbackBatch(napi_env env, napi_async_context context);
+
+  NAPI_DISALLOW_ASSIGN_COPY(CallbackBatch)
+
+  MaybeOrValue<Value> Call(napi_value func,
+                           napi_value recv,
+                           const std::initializer_list<napi_value>& args) const;
+  MaybeOrValue<Value> Call(napi_value func,
+                           napi_value recv,
+                           size_t argc,
+                           const napi_value* args) const;
+  template <typename... Args,
+            typename = details::enable_if_call_args<Args...>>
+  MaybeOrValue<Value> Call(napi_value func,
+                           napi_value recv,
+                           const Args&... args) const;
+
+  Napi::Env Env() const;
+
+ private:
+  CallbackScope _scope;
+};
+#endif
+
+class AsyncContext {
+ public:
+  explicit AsyncContext(napi_env env, const char* resource_name);
+  explicit AsyncContext(napi_env env,
+                        const char* resource_name,
+                        const Object& resource);
+  virtual ~AsyncContext();
+
+  AsyncContext(AsyncContext&& other);
+  AsyncContext& operator=(AsyncContext&& other);
+  NAPI_DISALLOW_ASSIGN_COPY(AsyncContext)
+
+  operator napi_async_context() const;
+
+  Napi::Env Env() const;
+
+ private:
+  napi_env _env;
+  napi_async_context _context;
+};
+
+#if NAPI_HAS_THREADS
+class AsyncWorker {
+ public:
+  virtual ~AsyncWorker();
+
+  NAPI_DISALLOW_ASSIGN_COPY(AsyncWorker)
+
+  operator napi_async_work() const;
+
+  Napi::Env Env() const;
+
+  void Queue();
+  void Cancel();
+  void SuppressDestruct();
+
+  ObjectReference& Receiver();
+  FunctionReference& Callback();
+
+  virtual void OnExecute(Napi::Env env);
+  virtual void OnWorkComplete(Napi::Env env, napi_status status);
+
+ protected:
+  explicit AsyncWorker(const Function& callback);
+  explicit AsyncWorker(const Function& callback, const char* resource_name);
+  explicit AsyncWorker(const Function& callback,
+                       const char* resource_name,
+                       const Object& resource);
+  explicit AsyncWorker(const Object& receiver, const Function& callback);
+  explicit AsyncWorker(const Object& receiver,
+                       const Function& callback,
+                       const char* resource_name);
+  explicit AsyncWorker(const Object& receiver,
+                       const Function& callback,
+                       const char* resource_name,
+                       const Object& resource);
+
+  explicit AsyncWorker(Napi::Env env);
+  explicit AsyncWorker(Napi::Env env, const char* resource_name);
+  explicit AsyncWorker(Napi::Env env,
+                       const char* resource_name,
+                       const Object& resource);
+
+  virtual void Execute() = 0;
+  virtual void OnOK();
+  virtual void OnError(const Error& e);
+  virtual void Destroy();
+  virtual std::vector<napi_value> GetResult(Napi::Env env);
+
+  void SetError(const std::string& error);
+
+ private:
+  static inline void OnAsyncWorkExecute(napi_env env, void* asyncworker);
+  static inline void OnAsyncWorkComplete(napi_env env,
+                                         napi_status status,
+                                         void* asyncworker);
+
+  napi_env _env;
+  napi_async_work _work;
+  ObjectReference _receiver;
+  FunctionReference _callback;
+  std::string _error;
+  bool _suppress_destruct;
+};
+#endif  // NAPI_HAS_THREADS
+
+#if (NAPI_VERSION > 3 && NAPI_HAS_THREADS)
+class ThreadSafeFunction {
+ public:
+  // This API may only be called from the main thread.
+  template <typename ResourceString>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount);
+
+  // This API may only be called from the main thread.
+  template <typename ResourceString, typename ContextType>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount,
+                                ContextType* context);
+
+  // This API may only be called from the main thread.
+  template <typename ResourceString, typename Finalizer>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount,
+                                Finalizer finalizeCallback);
+
+  // This API may only be called from the main thread.
+  template <typename ResourceString,
+            typename Finalizer,
+            typename FinalizerDataType>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount,
+                                Finalizer finalizeCallback,
+                                FinalizerDataType* data);
+
+  // This API may only be called from the main thread.
+  template <typename ResourceString, typename ContextType, typename Finalizer>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount,
+                                ContextType* context,
+                                Finalizer finalizeCallback);
+
+  // This API may only be called from the main thread.
+  template <typename ResourceString,
+            typename ContextType,
+            typename Finalizer,
+            typename FinalizerDataType>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount,
+                                ContextType* context,
+                                Finalizer finalizeCallback,
+                                FinalizerDataType* data);
+
+  // This API may only be called from the main thread.
+  template <typename ResourceString>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                const Object& resource,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount);
+
+  // This API may only be called from the main thread.
+  template <typename ResourceString, typename ContextType>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                const Object& resource,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount,
+                                ContextType* context);
+
+  // This API may only be called from the main thread.
+  template <typename ResourceString, typename Finalizer>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                const Object& resource,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount,
+                                Finalizer finalizeCallback);
+
+  // This API may only be called from the main thread.
+  template <typename ResourceString,
+            typename Finalizer,
+            typename FinalizerDataType>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                const Object& resource,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount,
+                                Finalizer finalizeCallback,
+                                FinalizerDataType* data);
+
+  // This API may only be called from the main thread.
+  template <typename ResourceString, typename ContextType, typename Finalizer>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                const Object& resource,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount,
+                                ContextType* context,
+                                Finalizer finalizeCallback);
+
+  // This API may only be called from the main thread.
+  template <typename ResourceString,
+            typename ContextType,
+            typename Finalizer,
+            typename FinalizerDataType>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                const Object& resource,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount,
+                                ContextType* context,
+                                Finalizer finalizeCallback,
+                                FinalizerDataType* data);
+
+  ThreadSafeFunction();
+  ThreadSafeFunction(napi_threadsafe_function tsFunctionValue);
+
+  operator napi_threadsafe_function() const;
+
+  // This API may be called from any thread.
+  napi_status BlockingCall() const;
+
+  // This API may be called from any thread.
+  template <typename Callback>
+  napi_status BlockingCall(Callback callback) const;
+
+  // This API may be called from any thread.
+  template <typename DataType, typename Callback>
+  napi_status BlockingCall(DataType* data, Callback callback) const;
+
+  // This API may be called from any thread.
+  napi_status NonBlockingCall() const;
+
+  // This API may be called from any thread.
+  template <typename Callback>
+  napi_status NonBlockingCall(Callback callback) const;
+
+  // This API may be called from any thread.
+  template <typename DataType, typename Callback>
+  napi_status NonBlockingCall(DataType* data, Callback callback) const;
+
+  // This API may only be called from the main thread.
+  void Ref(napi_env env) const;
+
+  // This API may only be called from the main thread.
+  void Unref(napi_env env) const;
+
+  // This API may be called from any thread.
+  napi_status Acquire() const;
+
+  // This API may be called from any thread.
+  napi_status Release() const;
+
+  // This API may be called from any thread.
+  napi_status Abort() const;
+
+  struct ConvertibleContext {
+    template <class T>
+    operator T*() {
+      return static_cast<T*>(context);
+    }
+    void* context;
+  };
+
+  // This API may be called from any thread.
+  ConvertibleContext GetContext() const;
+
+ private:
+  using CallbackWrapper = std::function<void(Napi::Env, Napi::Function)>;
+
+  template <typename ResourceString,
+            typename ContextType,
+            typename Finalizer,
+            typename FinalizerDataType>
+  static ThreadSafeFunction New(napi_env env,
+                                const Function& callback,
+                                const Object& resource,
+                                ResourceString resourceName,
+                                size_t maxQueueSize,
+                                size_t initialThreadCount,
+                                ContextType* context,
+                                Finalizer finalizeCallback,
+                                FinalizerDataType* data,
+                                napi_finalize wrapper);
+
+  napi_status CallInternal(CallbackWrapper* callbackWrapper,
+                           napi_threadsafe_function_call_mode mode) const;
+
+  static void CallJS(napi_env env,
+                     napi_value jsCallback,
+                     void* context,
+                     void* data);
+
+  napi_threadsafe_function _tsfn;
+};
+
+// A TypedThreadSafeFunction by default has no context (nullptr) and can
+// accept any type (void) to its CallJs.
+template <typename ContextType = std::nullptr_t,
+          typename DataType = void,
+          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*) =
+              nullptr>
+class TypedThreadSafeFunction {
+ public:
+  // This API may only be called from the main thread.
+  // Helper function that returns nullptr if running Node-API 5+, otherwise a
+  // non-empty, no-op Function. This provides the ability to specify at
+  // compile-time a callback parameter to `New` that safely does no action
+  // when targeting _any_ Node-API version.
+#if NAPI_VERSION > 4
+  static std::nullptr_t EmptyFunctionFactory(Napi::Env env);
+#else
+  static Napi::Function EmptyFunctionFactory(Napi::Env env);
+#endif
+  static Napi::Function FunctionOrEmpty(Napi::Env env,
+                                        Napi::Function& callback);
+
+#if NAPI_VERSION > 4
+  // This API may only be called from the main thread.
+  // Creates a new threadsafe function with:
+  //   Callback [missing] Resource [missing] Finalizer [missing]
+  template <typename ResourceString>
+  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
+      napi_env env,
+      ResourceString resourceName,
+      size_t maxQueueSize,
+      size_t initialThreadCount,
+      ContextType* context = nullptr);
+
+  // This API may only be called from the main thread.
+  // Creates a new threadsafe function with:
+  //   Callback [missing] Resource [passed] Finalizer [missing]
+  template <typename ResourceString>
+  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
+      napi_env env,
+      const Object& resource,
+      ResourceString resourceName,
+      size_t maxQueueSize,
+      size_t initialThreadCount,
+      ContextType* context = nullptr);
+
+  // This API may only be called from the main thread.
+  // Creates a new threadsafe function with:
+  //   Callback [missing] Resource [missing] Finalizer [passed]
+  template <typename ResourceString,
+            typename Finalizer,
+            typename FinalizerDataType = void>
+  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
+      napi_env env,
+      ResourceString resourceName,
+      size_t maxQueueSize,
+      size_t initialThreadCount,
+      ContextType* context,
+      Finalizer finalizeCallback,
+      FinalizerDataType* data = nullptr);
+
+  // This API may only be called from the main thread.
+  // Creates a new threadsafe function with:
+  //   Callback [missing] Resource [passed] Finalizer [passed]
+  template <typename ResourceString,
+            typename Finalizer,
+            typename FinalizerDataType = void>
+  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
+      napi_env env,
+      const Object& resource,
+      ResourceString resourceName,
+      size_t maxQueueSize,
+      size_t initialThreadCount,
+      ContextType* context,
+      Finalizer finalizeCallback,
+      FinalizerDataType* data = nullptr);
+#endif
+
+  // This API may only be called from the main thread.
+  // Creates a new threadsafe function with:
+  //   Callback [passed] Resource [missing] Finalizer [missing]
+  template <typename ResourceString>
+  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
+      napi_env env,
+      const Function& callback,
+      ResourceString resourceName,
+      size_t maxQueueSize,
+      size_t initialThreadCount,
+      ContextType* context = nullptr);
+
+  // This API may only be called from the main thread.
+  // Creates a new threadsafe function with:
+  //   Callback [passed] Resource [passed] Finalizer [missing]
+  template <typename ResourceString>
+  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
+      napi_env env,
+      const Function& callback,
+      const Object& resource,
+      ResourceString resourceName,
+      size_t maxQueueSize,
+      size_t initialThreadCount,
+      ContextType* context = nullptr);
+
+  // This API may only be called from the main thread.
+  // Creates a new threadsafe function with:
+  //   Callback [passed] Resource [missing] Finalizer [passed]
+  template <typename ResourceString,
+            typename Finalizer,
+            typename FinalizerDataType = void>
+  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
+      napi_env env,
+      const Function& callback,
+      ResourceString resourceName,
+      size_t maxQueueSize,
+      size_t initialThreadCount,
+      ContextType* context,
+      Finalizer finalizeCallback,
+      FinalizerDataType* data = nullptr);
+
+  // This API may only be called from the main thread.
+  // Creates a new threadsafe function with:
+  //   Callback [passed] Resource [passed] Finalizer [passed]
+  template <typename CallbackType,
+            typename ResourceString,
+            typename Finalizer,
+            typename FinalizerDataType>
+  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
+      napi_env env,
+      CallbackType callback,
+      const Object& resource,
+      ResourceString resourceName,
+      size_t maxQueueSize,
+      size_t initialThreadCount,
+      ContextType* context,
+      Finalizer finalizeCallback,
+      FinalizerDataType* data = nullptr);
+
+  TypedThreadSafeFunction();
+  TypedThreadSafeFunction(napi_threadsafe_function tsFunctionValue);
+
+  operator napi_threadsafe_function() const;
+
+  // This API may be called from any thread.
+  napi_status BlockingCall(DataType* data = nullptr) const;
+
+  // This API may be called from any thread.
+  napi_status NonBlockingCall(DataType* data = nullptr) const;
+
+  // This API may only be called from the main thread.
+  void Ref(napi_env env) const;
+
+  // This API may only be called from the main thread.
+  void Unref(napi_env env) const;
+
+  // This API may be called from any thread.
+  napi_status Acquire() const;
+
+  // This API may be called from any thread.
+  napi_status Release() const;
+
+  // This API may be called from any thread.
+  napi_status Abort() const;
+
+  // This API may be called from any thread.
+  ContextType* GetContext() const;
+
+ private:
+  template <typename ResourceString,
+            typename Finalizer,
+            typename FinalizerDataType>
+  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
+      napi_env env,
+      const Function& callback,
+      const Object& resource,
+      ResourceString resourceName,
+      size_t maxQueueSize,
+      size_t initialThreadCount,
+      ContextType* context,
+      Finalizer finalizeCallback,
+      FinalizerDataType* data,
+      napi_finalize wrapper);
+
+  static void CallJsInternal(napi_env env,
+                             napi_value jsCallback,
+                             void* context,
+                             void* data);
+
+ protected:
+  napi_threadsafe_function _tsfn;
+};
+template <typename DataType>
+class AsyncProgressWorkerBase : public AsyncWorker {
+ public:
+  virtual void OnWorkProgress(DataType* data) = 0;
+  class ThreadSafeData {
+   public:
+    ThreadSafeData(AsyncProgressWorkerBase* asyncprogressworker, DataType* data)
+        : _asyncprogressworker(asyncprogressworker), _data(data) {}
+
+    AsyncProgressWorkerBase* asyncprogressworker() {
+      return _asyncprogressworker;
+    };
+    DataType* data() { return _data; };
+
+   private:
+    AsyncProgressWorkerBase* _asyncprogressworker;
+    DataType* _data;
+  };
+  void OnWorkComplete(Napi::Env env, napi_status status) override;
+
+ protected:
+  explicit AsyncProgressWorkerBase(const Object& receiver,
+                                   const Function& callback,
+                                   const char* resource_name,
+                                   const Object& resource,
+                                   size_t queue_size = 1);
+  virtual ~AsyncProgressWorkerBase();
+
+// Optional callback of Napi::ThreadSafeFunction only available after
+// NAPI_VERSION 4. Refs: https://github.com/nodejs/node/pull/27791
+#if NAPI_VERSION > 4
+  explicit AsyncProgressWorkerBase(Napi::Env env,
+                                   const char* resource_name,
+                                   const Object& resource,
+                                   size_t queue_size = 1);
+#endif
+
+  static inline void OnAsyncWorkProgress(Napi::Env env,
+                                         Napi::Function jsCallback,
+                                         void* data);
+
+  napi_status NonBlockingCall(DataType* data);
+
+ private:
+  ThreadSafeFunction _tsfn;
+  bool _work_completed = false;
+  napi_status _complete_status;
+  static inline void OnThreadSafeFunctionFinalize(
+      Napi::Env env, void* data, AsyncProgressWorkerBase* context);
+};
+
+template <class T>
+class AsyncProgressWorker : public AsyncProgressWorkerBase<void> {
+ public:
+  virtual ~AsyncProgressWorker();
+
+  class ExecutionProgress {
+    friend class AsyncProgressWorker;
+
+   public:
+    void Signal() const;
+    void Send(const T* data, size_t count) const;
+
+   private:
+    explicit ExecutionProgress(AsyncProgressWorker* worker) : _worker(worker) {}
+    AsyncProgressWorker* const _worker;
+  };
+
+  void OnWorkProgress(void*) override;
+
+ protected:
+  explicit AsyncProgressWorker(const Function& callback);
+  explicit AsyncProgressWorker(const Function& callback,
+                               const char* resource_name);
+  explicit AsyncProgressWorker(const Function& callback,
+                               const char* resource_name,
+                               const Object& resource);
+  explicit AsyncProgressWorker(const Object& receiver,
+                               const Function& callback);
+  explicit AsyncProgressWorker(const Object& receiver,
+                               const Function& callback,
+                               const char* resource_name);
+  explicit AsyncProgressWorker(const Object& receiver,
+                               const Function& callback,
+                               const char* resource_name,
+                               const Object& resource);
+
+// Optional callback of Napi::ThreadSafeFunction only available after
+// NAPI_VERSION 4. Refs: https://github.com/nodejs/node/pull/27791
+#if NAPI_VERSION > 4
+  explicit AsyncProgressWorker(Napi::Env env);
+  explicit AsyncProgressWorker(Napi::Env env, const char* resource_name);
+  explicit AsyncProgressWorker(Napi::Env env,
+                               const char* resource_name,
+                               const Object& resource);
+#endif
+  virtual void Execute(const ExecutionProgress& progress) = 0;
+  virtual void OnProgress(const T* data, size_t count) = 0;
+
+ private:
+  void Execute() override;
+  void Signal();
+  void SendProgress_(const T* data, size_t count);
+
+  std::mutex _mutex;
+  T* _asyncdata;
+  size_t _asyncsize;
+  bool _signaled;
+};
+
+template <class T>
+class AsyncProgressQueueWorker
+    : public AsyncProgressWorkerBase<std::pair<T*, size_t>> {
+ public:
+  virtual ~AsyncProgressQueueWorker(){};
+
+  class ExecutionProgress {
+    friend class AsyncProgressQueueWorker;
+
+   public:
+    void Signal() const;
+    void Send(const T* data, size_t count) const;
+
+   private:
+    explicit ExecutionProgress(AsyncProgressQueueWorker* worker)
+        : _worker(worker) {}
+    AsyncProgressQueueWorker* const _worker;
+  };
+
+  void OnWorkComplete(Napi::Env env, napi_status status) override;
+  void OnWorkProgress(std::pair<T*, size_t>*) override;
+
+ protected:
+  explicit AsyncProgressQueueWorker(const Function& callback);
+  explicit AsyncProgressQueueWorker(const Function& callback,
+                                    const char* resource_name);
+  explicit AsyncProgressQueueWorker(const Function& callback,
+                                    const char* resource_name,
+                                    const Object& resource);
+  explicit AsyncProgressQueueWorker(const Object& receiver,
+                                    const Function& callback);
+  explicit AsyncProgressQueueWorker(const Object& receiver,
+                                    const Function& callback,
+                                    const char* resource_name);
+  explicit AsyncProgressQueueWorker(const Object& receiver,
+                                    const Function& callback,
+                                    const char* resource_name,
+                                    const Object& resource);
+
+// Optional callback of Napi::ThreadSafeFunction only available after
+// NAPI_VERSION 4. Refs: https://github.com/nodejs/node/pull/27791
+#if NAPI_VERSION > 4
+  explicit AsyncProgressQueueWorker(Napi::Env env);
+  explicit AsyncProgressQueueWorker(Napi::Env env, const char* resource_name);
+  explicit AsyncProgressQueueWorker(Napi::Env env,
+                                    const char* resource_name,
+                                    const Object& resource);
+#endif
+  virtual void Execute(const ExecutionProgress& progress) = 0;
+  virtual void OnProgress(const T* data, size_t count) = 0;
+
+ private:
+  void Execute() override;
+  void Signal() const;
+  void SendProgress_(const T* data, size_t count);
+};
+#endif  // NAPI_VERSION > 3 && NAPI_HAS_THREADS
+
+#ifdef NAPI_CPP_CUSTOM_NAMESPACE
+}  // namespace NAPI_CPP_CUSTOM_NAMESPACE
+#endif
+
+}  // namespace Napi
+
+#include "napi-async-inl.h"
+
+#endif  // SRC_NAPI_ASYNC_H_
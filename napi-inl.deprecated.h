@@ -11,18 +11,18 @@ inline PropertyDescriptor PropertyDescriptor::Accessor(
     Getter getter,
     napi_property_attributes attributes,
     void* /*data*/) {
-  using CbData = details::CallbackData<Getter, Napi::Value>;
-  // TODO: Delete when the function is destroyed
-  auto callbackData = new CbData({getter, nullptr});
-
-  return PropertyDescriptor({utf8name,
-                             nullptr,
-                             nullptr,
-                             CbData::Wrapper,
-                             nullptr,
-                             nullptr,
-                             attributes,
-                             callbackData});
+  napi_property_descriptor desc = napi_property_descriptor();
+  desc.utf8name = utf8name;
+  // Stateless getters and function pointers need no storage. Any other
+  // getter is never freed: use the overload that takes the object instead.
+  details::PrepareCallable<Napi::Value>(
+      getter,
+      nullptr,
+      &desc.getter,
+      &desc.data,
+      details::CallableStorageOf<Getter, Napi::Value>());
+  desc.attributes = attributes;
+  return desc;
 }
 
 template <typename Getter>
@@ -40,18 +40,18 @@ inline PropertyDescriptor PropertyDescriptor::Accessor(
     Getter getter,
     napi_property_attributes attributes,
     void* /*data*/) {
-  using CbData = details::CallbackData<Getter, Napi::Value>;
-  // TODO: Delete when the function is destroyed
-  auto callbackData = new CbData({getter, nullptr});
-
-  return PropertyDescriptor({nullptr,
-                             name,
-                             nullptr,
-                             CbData::Wrapper,
-                             nullptr,
-                             nullptr,
-                             attributes,
-                             callbackData});
+  napi_property_descriptor desc = napi_property_descriptor();
+  desc.name = name;
+  // Stateless getters and function pointers need no storage. Any other
+  // getter is never freed: use the overload that takes the object instead.
+  details::PrepareCallable<Napi::Value>(
+      getter,
+      nullptr,
+      &desc.getter,
+      &desc.data,
+      details::CallableStorageOf<Getter, Napi::Value>());
+  desc.attributes = attributes;
+  return desc;
 }
 
 template <typename Getter>
@@ -68,18 +68,17 @@ inline PropertyDescriptor PropertyDescriptor::Accessor(
     Setter setter,
     napi_property_attributes attributes,
     void* /*data*/) {
-  using CbData = details::AccessorCallbackData<Getter, Setter>;
-  // TODO: Delete when the function is destroyed
-  auto callbackData = new CbData({getter, setter, nullptr});
-
-  return PropertyDescriptor({utf8name,
-                             nullptr,
-                             nullptr,
-                             CbData::GetterWrapper,
-                             CbData::SetterWrapper,
-                             nullptr,
-                             attributes,
-                             callbackData});
+  napi_property_descriptor desc = napi_property_descriptor();
+  desc.utf8name = utf8name;
+  // Only a stateless getter and setter need no storage. Any other pair is
+  // never freed: use the overload that takes the object instead.
+  details::PrepareAccessor(getter,
+                           setter,
+                           nullptr,
+                           &desc,
+                           details::IsStatelessAccessor<Getter, Setter>());
+  desc.attributes = attributes;
+  return desc;
 }
 
 template <typename Getter, typename Setter>
@@ -99,18 +98,17 @@ inline PropertyDescriptor PropertyDescriptor::Accessor(
     Setter setter,
     napi_property_attributes attributes,
     void* /*data*/) {
-  using CbData = details::AccessorCallbackData<Getter, Setter>;
-  // TODO: Delete when the function is destroyed
-  auto callbackData = new CbData({getter, setter, nullptr});
-
-  return PropertyDescriptor({nullptr,
-                             name,
-                             nullptr,
-                             CbData::GetterWrapper,
-                             CbData::SetterWrapper,
-                             nullptr,
-                             attributes,
-                             callbackData});
+  napi_property_descriptor desc = napi_property_descriptor();
+  desc.name = name;
+  // Only a stateless getter and setter need no storage. Any other pair is
+  // never freed: use the overload that takes the object instead.
+  details::PrepareAccessor(getter,
+                           setter,
+                           nullptr,
+                           &desc,
+                           details::IsStatelessAccessor<Getter, Setter>());
+  desc.attributes = attributes;
+  return desc;
 }
 
 template <typename Getter, typename Setter>
@@ -132,18 +130,18 @@ inline PropertyDescriptor PropertyDescriptor::Function(
     napi_property_attributes attributes,
     void* /*data*/) {
   using ReturnType = decltype(cb(CallbackInfo(nullptr, nullptr)));
-  using CbData = details::CallbackData<Callable, ReturnType>;
-  // TODO: Delete when the function is destroyed
-  auto callbackData = new CbData({cb, nullptr});
-
-  return PropertyDescriptor({utf8name,
-                             nullptr,
-                             CbData::Wrapper,
-                             nullptr,
-                             nullptr,
-                             nullptr,
-                             attributes,
-                             callbackData});
+  napi_property_descriptor desc = napi_property_descriptor();
+  desc.utf8name = utf8name;
+  // Stateless callables and function pointers need no storage. Any other
+  // callable is never freed: use the overload that takes the object instead.
+  details::PrepareCallable<ReturnType>(
+      cb,
+      nullptr,
+      &desc.method,
+      &desc.data,
+      details::CallableStorageOf<Callable, ReturnType>());
+  desc.attributes = attributes;
+  return desc;
 }
 
 template <typename Callable>
@@ -162,18 +160,18 @@ inline PropertyDescriptor PropertyDescriptor::Function(
     napi_property_attributes attributes,
     void* /*data*/) {
   using ReturnType = decltype(cb(CallbackInfo(nullptr, nullptr)));
-  using CbData = details::CallbackData<Callable, ReturnType>;
-  // TODO: Delete when the function is destroyed
-  auto callbackData = new CbData({cb, nullptr});
-
-  return PropertyDescriptor({nullptr,
-                             name,
-                             CbData::Wrapper,
-                             nullptr,
-                             nullptr,
-                             nullptr,
-                             attributes,
-                             callbackData});
+  napi_property_descriptor desc = napi_property_descriptor();
+  desc.name = name;
+  // Stateless callables and function pointers need no storage. Any other
+  // callable is never freed: use the overload that takes the object instead.
+  details::PrepareCallable<ReturnType>(
+      cb,
+      nullptr,
+      &desc.method,
+      &desc.data,
+      details::CallableStorageOf<Callable, ReturnType>());
+  desc.attributes = attributes;
+  return desc;
 }
 
 template <typename Callable>
@@ -11,11 +11,14 @@
 // Note: Do not include this file directly! Include "napi.h" instead.
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <limits>
 #if NAPI_HAS_THREADS
 #include <mutex>
 #endif  // NAPI_HAS_THREADS
 #include <type_traits>
+#include <unordered_set>
 #include <utility>
 
 namespace Napi {
@@ -139,6 +142,101 @@ struct CallbackData<Callable, void> {
   void* data;
 };
 
+// Calls a callable that holds no state, such as an empty function object,
+// without storing it anywhere: a new instance is made for each call. This
+// leaves the data of the function to the caller.
+template <typename Callable, typename Return>
+struct StatelessCallback {
+  static inline napi_value Wrapper(napi_env env, napi_callback_info info) {
+    return details::WrapCallback([&] {
+      CallbackInfo callbackInfo(env, info);
+      return Callable()(callbackInfo);
+    });
+  }
+};
+
+template <typename Callable>
+struct StatelessCallback<Callable, void> {
+  static inline napi_value Wrapper(napi_env env, napi_callback_info info) {
+    return details::WrapCallback([&] {
+      CallbackInfo callbackInfo(env, info);
+      Callable()(callbackInfo);
+      return nullptr;
+    });
+  }
+};
+
+// Stores a function pointer in the data of a function, for functions that
+// have no data of their own.
+template <typename Return>
+struct FunctionPointerData {
+  using Pointer = Return (*)(const CallbackInfo& info);
+
+  static inline void* Pack(Pointer callback) {
+    void* data;
+    std::memcpy(&data, &callback, sizeof(data));
+    return data;
+  }
+
+  static inline Pointer Unpack(CallbackInfo& callbackInfo) {
+    void* data = callbackInfo.Data();
+    Pointer callback;
+    std::memcpy(&callback, &data, sizeof(callback));
+    callbackInfo.SetData(nullptr);
+    return callback;
+  }
+};
+
+template <typename Return>
+struct FunctionPointerCallback {
+  static inline napi_value Wrapper(napi_env env, napi_callback_info info) {
+    return details::WrapCallback([&] {
+      CallbackInfo callbackInfo(env, info);
+      return FunctionPointerData<Return>::Unpack(callbackInfo)(callbackInfo);
+    });
+  }
+};
+
+template <>
+struct FunctionPointerCallback<void> {
+  static inline napi_value Wrapper(napi_env env, napi_callback_info info) {
+    return details::WrapCallback([&] {
+      CallbackInfo callbackInfo(env, info);
+      FunctionPointerData<void>::Unpack(callbackInfo)(callbackInfo);
+      return nullptr;
+    });
+  }
+};
+
+// How a callable passed to `Function::New()` or to a `PropertyDescriptor`
+// reaches its callback.
+enum class CallableStorage {
+  // Empty and trivial: nothing needs to be stored.
+  Stateless,
+  // Convertible to a function pointer, such as a lambda without captures:
+  // the pointer is stored as the data of the function.
+  FunctionPointer,
+  // Anything else is stored in a `CallbackData` that is deleted when the
+  // function is garbage-collected.
+  Heap
+};
+
+template <typename Callable, typename Return>
+struct CallableStorageOf
+    : std::integral_constant<
+          CallableStorage,
+          std::is_empty<Callable>::value &&
+                  std::is_trivially_default_constructible<Callable>::value &&
+                  std::is_trivially_destructible<Callable>::value
+              ? CallableStorage::Stateless
+          : std::is_convertible<
+                Callable,
+                typename FunctionPointerData<Return>::Pointer>::value &&
+                  sizeof(typename FunctionPointerData<Return>::Pointer) ==
+                      sizeof(void*)
+              ? CallableStorage::FunctionPointer
+              : CallableStorage::Heap> {};
+
 template <void (*Callback)(const CallbackInfo& info)>
 napi_value TemplatedVoidCallback(napi_env env,
                                  napi_callback_info info) NAPI_NOEXCEPT {
@@ -207,6 +305,25 @@ struct FinalizeData {
   Hint* hint;
 };
 
+// Finalizers given as template arguments need no FinalizeData, which leaves
+// the finalize hint free for the caller.
+template <typename T, void (*Finalizer)(Env, T*)>
+inline void TemplatedFinalizer(napi_env env,
+                               void* data,
+                               void* /*finalizeHint*/) NAPI_NOEXCEPT {
+  WrapVoidCallback([&] { Finalizer(Env(env), static_cast<T*>(data)); });
+}
+
+template <typename T, typename Hint, void (*Finalizer)(Env, T*, Hint*)>
+inline void TemplatedFinalizerWithHint(napi_env env,
+                                       void* data,
+                                       void* finalizeHint) NAPI_NOEXCEPT {
+  WrapVoidCallback([&] {
+    Finalizer(
+        Env(env), static_cast<T*>(data), static_cast<Hint*>(finalizeHint));
+  });
+}
+
 #if (NAPI_VERSION > 3 && NAPI_HAS_THREADS)
 template <typename ContextType = void,
           typename Finalizer = std::function<void(Env, void*, ContextType*)>,
@@ -333,6 +450,99 @@ struct AccessorCallbackData {
   void* data;
 };
 
+// Picks the callback and the data through which a callable is reached,
+// according to its `CallableStorage`. Only the `Heap` kind allocates: the
+// allocation is returned so that the caller can tie it to the lifetime of a
+// JavaScript value, and null is returned otherwise.
+template <typename Return, typename Callable>
+inline CallbackData<Callable, Return>* PrepareCallable(
+    Callable& cb,
+    void* data,
+    napi_callback* callback,
+    void** callbackData,
+    std::integral_constant<CallableStorage, CallableStorage::Heap>) {
+  using CbData = CallbackData<Callable, Return>;
+  auto allocated = new CbData{std::move(cb), data};
+  *callback = CbData::Wrapper;
+  *callbackData = allocated;
+  return allocated;
+}
+
+template <typename Return, typename Callable>
+inline CallbackData<Callable, Return>* PrepareCallable(
+    Callable& /*cb*/,
+    void* data,
+    napi_callback* callback,
+    void** callbackData,
+    std::integral_constant<CallableStorage, CallableStorage::Stateless>) {
+  *callback = StatelessCallback<Callable, Return>::Wrapper;
+  *callbackData = data;
+  return nullptr;
+}
+
+template <typename Return, typename Callable>
+inline CallbackData<Callable, Return>* PrepareCallable(
+    Callable& cb,
+    void* data,
+    napi_callback* callback,
+    void** callbackData,
+    std::integral_constant<CallableStorage, CallableStorage::FunctionPointer>) {
+  // The data slot holds the pointer, so it is only free without caller data.
+  if (data != nullptr) {
+    return PrepareCallable<Return>(
+        cb,
+        data,
+        callback,
+        callbackData,
+        std::integral_constant<CallableStorage, CallableStorage::Heap>());
+  }
+  *callback = FunctionPointerCallback<Return>::Wrapper;
+  *callbackData = FunctionPointerData<Return>::Pack(cb);
+  return nullptr;
+}
+
+// An accessor needs no storage when both its getter and its setter are
+// stateless. A single data slot cannot hold two function pointers, so any
+// other pair is stored in an `AccessorCallbackData`.
+template <typename Getter, typename Setter>
+struct IsStatelessAccessor
+    : std::integral_constant<
+          bool,
+          CallableStorageOf<Getter, Napi::Value>::value ==
+                  CallableStorage::Stateless &&
+              CallableStorageOf<Setter, void>::value ==
+                  CallableStorage::Stateless> {};
+
+// Fills in the getter, the setter and the data of a property descriptor.
+// Like `PrepareCallable()`, it returns the allocation if there is one.
+template <typename Getter, typename Setter>
+inline AccessorCallbackData<Getter, Setter>* PrepareAccessor(
+    Getter& getter,
+    Setter& setter,
+    void* data,
+    napi_property_descriptor* desc,
+    std::false_type /*stateless*/) {
+  using CbData = AccessorCallbackData<Getter, Setter>;
+  auto allocated = new CbData{std::move(getter), std::move(setter), data};
+  desc->getter = CbData::GetterWrapper;
+  desc->setter = CbData::SetterWrapper;
+  desc->data = allocated;
+  return allocated;
+}
+
+template <typename Getter, typename Setter>
+inline AccessorCallbackData<Getter, Setter>* PrepareAccessor(
+    Getter& /*getter*/,
+    Setter& /*setter*/,
+    void* data,
+    napi_property_descriptor* desc,
+    std::true_type /*stateless*/) {
+  desc->getter = StatelessCallback<Getter, Napi::Value>::Wrapper;
+  desc->setter = StatelessCallback<Setter, void>::Wrapper;
+  desc->data = data;
+  return nullptr;
+}
+
 }  // namespace details
 
 #ifndef NODE_ADDON_API_DISABLE_DEPRECATED
@@ -776,6 +986,245 @@ inline MaybeOrValue<Object> Value::ToObject() const {
       _env, status, Napi::Object(_env, result), Napi::Object);
 }
 
+template <typename T>
+inline MaybeOrValue<T> Value::To() const {
+  T result{};
+  bool converted = Convert<T>::FromJS(*this, &result);
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  return converted ? Just(result) : Nothing<T>();
+#else
+  static_cast<void>(converted);
+  return result;
+#endif
+}
+
+namespace details {
+
+// Runs the Node-API object subtype checks in turn, stopping at the first
+// match. Arrays and typed arrays come first as the most common arguments.
+inline napi_status ClassifyObject(napi_env env,
+                                  napi_value value,
+                                  ClassifiedValue::Subtype* subtype,
+                                  bool* isBuffer) {
+  static const struct {
+    decltype(&napi_is_array) check;
+    ClassifiedValue::Subtype subtype;
+  } checks[] = {
+      {napi_is_array, ClassifiedValue::Subtype::Array},
+      {napi_is_typedarray, ClassifiedValue::Subtype::TypedArray},
+      {napi_is_arraybuffer, ClassifiedValue::Subtype::ArrayBuffer},
+      {napi_is_dataview, ClassifiedValue::Subtype::DataView},
+#if (NAPI_VERSION > 4)
+      {napi_is_date, ClassifiedValue::Subtype::Date},
+#endif
+      {napi_is_promise, ClassifiedValue::Subtype::Promise},
+  };
+
+  *subtype = ClassifiedValue::Subtype::None;
+  *isBuffer = false;
+  for (const auto& entry : checks) {
+    bool matches;
+    napi_status status = entry.check(env, value, &matches);
+    if (status != napi_ok) return status;
+    if (matches) {
+      *subtype = entry.subtype;
+      break;
+    }
+  }
+
+  // `napi_is_buffer()` accepts other array buffer views on newer Node.js
+  // versions, so defer to it for all of them as `Value::IsBuffer()` does.
+  if (*subtype == ClassifiedValue::Subtype::TypedArray ||
+      *subtype == ClassifiedValue::Subtype::DataView) {
+    return napi_is_buffer(env, value, isBuffer);
+  }
+  return napi_ok;
+}
+
+}  // namespace details
+
+inline ClassifiedValue Value::Classify() const {
+  if (IsEmpty()) {
+    return ClassifiedValue();
+  }
+
+  napi_valuetype type;
+  napi_status status = napi_typeof(_env, _value, &type);
+  NAPI_THROW_IF_FAILED(_env, status, ClassifiedValue());
+
+  ClassifiedValue::Subtype subtype = ClassifiedValue::Subtype::None;
+  bool isBuffer = false;
+  if (type == napi_object) {
+    status = details::ClassifyObject(_env, _value, &subtype, &isBuffer);
+    NAPI_THROW_IF_FAILED(_env, status, ClassifiedValue());
+  }
+  return ClassifiedValue(_env, _value, type, subtype, isBuffer);
+}
+
+template <typename Visitor>
+inline auto Value::Visit(Visitor&& visitor) const
+    -> decltype(visitor(std::declval<Value>())) {
+  return Classify().Visit(std::forward<Visitor>(visitor));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ClassifiedValue class
+////////////////////////////////////////////////////////////////////////////////
+
+inline ClassifiedValue::ClassifiedValue()
+    : _env(nullptr),
+      _value(nullptr),
+      _type(napi_undefined),
+      _subtype(Subtype::None),
+      _isBuffer(false) {}
+
+inline ClassifiedValue::ClassifiedValue(napi_env env,
+                                        napi_value value,
+                                        napi_valuetype type,
+                                        Subtype subtype,
+                                        bool isBuffer)
+    : _env(env),
+      _value(value),
+      _type(type),
+      _subtype(subtype),
+      _isBuffer(isBuffer) {}
+
+inline Napi::Value ClassifiedValue::Value() const {
+  return Napi::Value(_env, _value);
+}
+
+inline Napi::Env ClassifiedValue::Env() const {
+  return Napi::Env(_env);
+}
+
+inline napi_valuetype ClassifiedValue::Type() const {
+  return _type;
+}
+
+inline ClassifiedValue::Subtype ClassifiedValue::GetSubtype() const {
+  return _subtype;
+}
+
+inline bool ClassifiedValue::IsEmpty() const {
+  return _value == nullptr;
+}
+
+inline bool ClassifiedValue::IsUndefined() const {
+  return _type == napi_undefined;
+}
+
+inline bool ClassifiedValue::IsNull() const {
+  return _type == napi_null;
+}
+
+inline bool ClassifiedValue::IsBoolean() const {
+  return _type == napi_boolean;
+}
+
+inline bool ClassifiedValue::IsNumber() const {
+  return _type == napi_number;
+}
+
+#if NAPI_VERSION > 5
+inline bool ClassifiedValue::IsBigInt() const {
+  return _type == napi_bigint;
+}
+#endif  // NAPI_VERSION > 5
+
+#if (NAPI_VERSION > 4)
+inline bool ClassifiedValue::IsDate() const {
+  return _subtype == Subtype::Date;
+}
+#endif
+
+inline bool ClassifiedValue::IsString() const {
+  return _type == napi_string;
+}
+
+inline bool ClassifiedValue::IsSymbol() const {
+  return _type == napi_symbol;
+}
+
+inline bool ClassifiedValue::IsArray() const {
+  return _subtype == Subtype::Array;
+}
+
+inline bool ClassifiedValue::IsArrayBuffer() const {
+  return _subtype == Subtype::ArrayBuffer;
+}
+
+inline bool ClassifiedValue::IsTypedArray() const {
+  return _subtype == Subtype::TypedArray;
+}
+
+inline bool ClassifiedValue::IsObject() const {
+  return _type == napi_object || _type == napi_function;
+}
+
+inline bool ClassifiedValue::IsFunction() const {
+  return _type == napi_function;
+}
+
+inline bool ClassifiedValue::IsPromise() const {
+  return _subtype == Subtype::Promise;
+}
+
+inline bool ClassifiedValue::IsDataView() const {
+  return _subtype == Subtype::DataView;
+}
+
+inline bool ClassifiedValue::IsBuffer() const {
+  return _isBuffer;
+}
+
+inline bool ClassifiedValue::IsExternal() const {
+  return _type == napi_external;
+}
+
+template <typename Visitor>
+inline auto ClassifiedValue::Visit(Visitor&& visitor) const
+    -> decltype(visitor(std::declval<Napi::Value>())) {
+  switch (_type) {
+    case napi_boolean:
+      return visitor(Boolean(_env, _value));
+    case napi_number:
+      return visitor(Number(_env, _value));
+#if NAPI_VERSION > 5
+    case napi_bigint:
+      return visitor(BigInt(_env, _value));
+#endif  // NAPI_VERSION > 5
+    case napi_string:
+      return visitor(String(_env, _value));
+    case napi_symbol:
+      return visitor(Symbol(_env, _value));
+    case napi_function:
+      return visitor(Function(_env, _value));
+    case napi_external:
+      return visitor(External<void>(_env, _value));
+    case napi_object:
+      switch (_subtype) {
+        case Subtype::Array:
+          return visitor(Array(_env, _value));
+        case Subtype::ArrayBuffer:
+          return visitor(ArrayBuffer(_env, _value));
+        case Subtype::TypedArray:
+          return visitor(TypedArray(_env, _value));
+        case Subtype::DataView:
+          return visitor(DataView(_env, _value));
+#if (NAPI_VERSION > 4)
+        case Subtype::Date:
+          return visitor(Date(_env, _value));
+#endif
+        case Subtype::Promise:
+          return visitor(Promise(_env, _value));
+        default:
+          return visitor(Object(_env, _value));
+      }
+    default:
+      return visitor(Napi::Value(_env, _value));
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Boolean class
 ////////////////////////////////////////////////////////////////////////////////
@@ -909,6 +1358,22 @@ inline BigInt BigInt::New(napi_env env, uint64_t val) {
   return BigInt(env, value);
 }
 
+#ifdef NAPI_HAS_INT128
+inline BigInt BigInt::New(napi_env env, int128_t val) {
+  uint128_t magnitude =
+      val < 0 ? uint128_t(0) - static_cast<uint128_t>(val) : uint128_t(val);
+  uint64_t words[2] = {static_cast<uint64_t>(magnitude),
+                       static_cast<uint64_t>(magnitude >> 64)};
+  return New(env, val < 0 ? 1 : 0, words[1] != 0 ? 2 : 1, words);
+}
+
+inline BigInt BigInt::New(napi_env env, uint128_t val) {
+  uint64_t words[2] = {static_cast<uint64_t>(val),
+                       static_cast<uint64_t>(val >> 64)};
+  return New(env, 0, words[1] != 0 ? 2 : 1, words);
+}
+#endif  // NAPI_HAS_INT128
+
 inline BigInt BigInt::New(napi_env env,
                           int sign_bit,
                           size_t word_count,
@@ -950,6 +1415,57 @@ inline uint64_t BigInt::Uint64Value(bool* lossless) const {
   return result;
 }
 
+#ifdef NAPI_HAS_INT128
+namespace details {
+// Reads the sign and the low 128 bits of the magnitude of a BigInt.
+// `word_count` receives the number of words the full magnitude needs.
+inline napi_status BigIntToUint128(napi_env env,
+                                   napi_value value,
+                                   int* sign_bit,
+                                   size_t* word_count,
+                                   uint128_t* magnitude) {
+  uint64_t words[2] = {0, 0};
+  *word_count = 2;
+  napi_status status =
+      napi_get_value_bigint_words(env, value, sign_bit, word_count, words);
+  *magnitude = (static_cast<uint128_t>(words[1]) << 64) | words[0];
+  return status;
+}
+}  // namespace details
+
+inline int128_t BigInt::Int128Value(bool* lossless) const {
+  int sign_bit;
+  size_t word_count;
+  uint128_t magnitude;
+  napi_status status = details::BigIntToUint128(
+      _env, _value, &sign_bit, &word_count, &magnitude);
+  NAPI_THROW_IF_FAILED(_env, status, 0);
+
+  // Like Int64Value(), values out of range are truncated modulo 2^128.
+  const uint128_t limit = uint128_t(1) << 127;
+  if (lossless != nullptr) {
+    *lossless = word_count <= 2 &&
+                (sign_bit != 0 ? magnitude <= limit : magnitude < limit);
+  }
+  return static_cast<int128_t>(sign_bit != 0 ? uint128_t(0) - magnitude
+                                             : magnitude);
+}
+
+inline uint128_t BigInt::Uint128Value(bool* lossless) const {
+  int sign_bit;
+  size_t word_count;
+  uint128_t magnitude;
+  napi_status status = details::BigIntToUint128(
+      _env, _value, &sign_bit, &word_count, &magnitude);
+  NAPI_THROW_IF_FAILED(_env, status, 0);
+
+  if (lossless != nullptr) {
+    *lossless = word_count <= 2 && sign_bit == 0;
+  }
+  return sign_bit != 0 ? uint128_t(0) - magnitude : magnitude;
+}
+#endif  // NAPI_HAS_INT128
+
 inline size_t BigInt::WordCount() const {
   size_t word_count;
   napi_status status =
@@ -965,6 +1481,24 @@ inline void BigInt::ToWords(int* sign_bit,
       napi_get_value_bigint_words(_env, _value, sign_bit, word_count, words);
   NAPI_THROW_IF_FAILED_VOID(_env, status);
 }
+
+inline void BigInt::ToWords(int* sign_bit, std::vector<uint64_t>* words) const {
+  // Use whatever capacity the vector already has, and only ask again when
+  // that was not enough.
+  words->resize(words->capacity() > 0 ? words->capacity() : 2);
+  size_t word_count = words->size();
+  napi_status status = napi_get_value_bigint_words(
+      _env, _value, sign_bit, &word_count, words->data());
+  NAPI_THROW_IF_FAILED_VOID(_env, status);
+
+  if (word_count > words->size()) {
+    words->resize(word_count);
+    status = napi_get_value_bigint_words(
+        _env, _value, sign_bit, &word_count, words->data());
+    NAPI_THROW_IF_FAILED_VOID(_env, status);
+  }
+  words->resize(word_count);
+}
 #endif  // NAPI_VERSION > 5
 
 #if (NAPI_VERSION > 4)
@@ -979,6 +1513,104 @@ inline Date Date::New(napi_env env, double val) {
   return Date(env, value);
 }
 
+namespace details {
+
+// Returns the whole number of milliseconds, rounded towards negative
+// infinity, in a duration.
+template <typename Rep, typename Period>
+inline double FloorMilliseconds(const std::chrono::duration<Rep, Period>& d) {
+  std::chrono::milliseconds ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(d);
+  if (ms > d) {
+    ms -= std::chrono::milliseconds(1);
+  }
+  return static_cast<double>(ms.count());
+}
+
+// Converts milliseconds since the epoch to a duration, rounding towards
+// negative infinity when the duration is coarser than milliseconds. Returns
+// `false` if `milliseconds` is NaN or does not fit into `Duration`, such as
+// most dates before 1677 or after 2262 with a 64-bit count of nanoseconds.
+template <typename Duration>
+inline bool MillisecondsToDuration(double milliseconds, Duration* result) {
+  std::chrono::duration<double, std::milli> ms(milliseconds);
+  // The same conversion as the cast below, checked before it can overflow.
+  // The upper bound is exclusive because `max()` is rounded up to a power of
+  // two as a double.
+  double count =
+      std::chrono::duration<double, typename Duration::period>(ms).count();
+  if (!(count >= static_cast<double>(Duration::min().count()) &&
+        count < static_cast<double>(Duration::max().count()))) {
+    return false;
+  }
+  *result = std::chrono::duration_cast<Duration>(ms);
+  if (*result > ms) {
+    *result -= Duration(1);
+  }
+  return true;
+}
+
+}  // namespace details
+
+template <typename Duration>
+inline Date Date::New(napi_env env, const TimePoint<Duration>& value) {
+  return New(env, details::FloorMilliseconds(value.time_since_epoch()));
+}
+
+template <typename Duration>
+inline Array Date::NewArray(napi_env env,
+                            const TimePoint<Duration>* values,
+                            size_t count) {
+  // Dates are created in batches, each in its own handle scope, so that only
+  // the array itself outlives the loop.
+  const size_t kBatchSize = 256;
+
+  napi_value array;
+  napi_status status = napi_create_array_with_length(env, count, &array);
+  NAPI_THROW_IF_FAILED(env, status, Array());
+
+  for (size_t start = 0; start < count; start += kBatchSize) {
+    HandleScope scope(env);
+    size_t end = std::min(count, start + kBatchSize);
+    for (size_t i = start; i < end; i++) {
+      napi_value date;
+      status = napi_create_date(
+          env, details::FloorMilliseconds(values[i].time_since_epoch()), &date);
+      NAPI_THROW_IF_FAILED(env, status, Array());
+      status = napi_set_element(env, array, static_cast<uint32_t>(i), date);
+      NAPI_THROW_IF_FAILED(env, status, Array());
+    }
+  }
+  return Array(env, array);
+}
+
+template <typename Duration>
+inline Array Date::NewArray(napi_env env,
+                            const std::vector<TimePoint<Duration>>& values) {
+  return NewArray(env, values.data(), values.size());
+}
+
+template <typename Duration>
+inline Float64Array Date::NewEpochArray(napi_env env,
+                                        const TimePoint<Duration>* values,
+                                        size_t count) {
+  Float64Array array = Float64Array::New(env, count);
+  if (array.IsEmpty()) {
+    return array;
+  }
+  double* data = array.Data();
+  for (size_t i = 0; i < count; i++) {
+    data[i] = details::FloorMilliseconds(values[i].time_since_epoch());
+  }
+  return array;
+}
+
+template <typename Duration>
+inline Float64Array Date::NewEpochArray(
+    napi_env env, const std::vector<TimePoint<Duration>>& values) {
+  return NewEpochArray(env, values.data(), values.size());
+}
+
 inline void Date::CheckCast(napi_env env, napi_value value) {
   NAPI_CHECK(value != nullptr, "Date::CheckCast", "empty value");
 
@@ -1002,6 +1634,21 @@ inline double Date::ValueOf() const {
   NAPI_THROW_IF_FAILED(_env, status, 0);
   return result;
 }
+
+template <typename Duration>
+inline Date::TimePoint<Duration> Date::TimePointValue() const {
+  double milliseconds = ValueOf();
+  if (std::isnan(milliseconds)) {
+    NAPI_THROW(RangeError::New(_env, "Invalid Date"), TimePoint<Duration>());
+  }
+  Duration duration;
+  if (!details::MillisecondsToDuration(milliseconds, &duration)) {
+    NAPI_THROW(
+        RangeError::New(_env, "The Date is out of range of the time point."),
+        TimePoint<Duration>());
+  }
+  return TimePoint<Duration>(duration);
+}
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1156,9 +1803,26 @@ inline Symbol Symbol::New(napi_env env, napi_value description) {
   return Symbol(env, value);
 }
 
+#if NAPI_VERSION > 2
+namespace details {
+
+// Wraps a symbol from the `Builtins` cache, which is empty on failure.
+inline MaybeOrValue<Symbol> CachedSymbolResult(const Symbol& symbol) {
+#if defined(NODE_ADDON_API_ENABLE_MAYBE)
+  return symbol.IsEmpty() ? Nothing<Symbol>() : Just(symbol);
+#else
+  return symbol;
+#endif
+}
+
+}  // namespace details
+#endif  // NAPI_VERSION > 2
+
 inline MaybeOrValue<Symbol> Symbol::WellKnown(napi_env env,
                                               const std::string& name) {
-#if defined(NODE_ADDON_API_ENABLE_MAYBE)
+#if NAPI_VERSION > 2
+  return details::CachedSymbolResult(Builtins::WellKnownSymbol(env, name));
+#elif defined(NODE_ADDON_API_ENABLE_MAYBE)
   Value symbol_obj;
   Value symbol_value;
   if (Napi::Env(env).Global().Get("Symbol").UnwrapTo(&symbol_obj) &&
@@ -1178,11 +1842,22 @@ inline MaybeOrValue<Symbol> Symbol::WellKnown(napi_env env,
 
 inline MaybeOrValue<Symbol> Symbol::For(napi_env env,
                                         const std::string& description) {
+#if NAPI_VERSION > 2
+  return details::CachedSymbolResult(
+      Builtins::RegisteredSymbol(env, description));
+#else
   napi_value descriptionValue = String::New(env, description);
   return Symbol::For(env, descriptionValue);
+#endif
 }
 
 inline MaybeOrValue<Symbol> Symbol::For(napi_env env, const char* description) {
+#if NAPI_VERSION > 2
+  if (description != nullptr) {
+    return details::CachedSymbolResult(
+        Builtins::RegisteredSymbol(env, description));
+  }
+#endif  // NAPI_VERSION > 2
   napi_value descriptionValue = String::New(env, description);
   return Symbol::For(env, descriptionValue);
 }
@@ -1192,7 +1867,17 @@ inline MaybeOrValue<Symbol> Symbol::For(napi_env env, String description) {
 }
 
 inline MaybeOrValue<Symbol> Symbol::For(napi_env env, napi_value description) {
-#if defined(NODE_ADDON_API_ENABLE_MAYBE)
+  // Descriptions that are JavaScript values are not cached, since that would
+  // take converting them to strings, but `Symbol.for` itself is.
+#if NAPI_VERSION > 2 && defined(NODE_ADDON_API_ENABLE_MAYBE)
+  Value symbol_value;
+  if (Builtins::SymbolFor(env).Call({description}).UnwrapTo(&symbol_value)) {
+    return Just<Symbol>(symbol_value.As<Symbol>());
+  }
+  return Nothing<Symbol>();
+#elif NAPI_VERSION > 2
+  return Builtins::SymbolFor(env).Call({description}).As<Symbol>();
+#elif defined(NODE_ADDON_API_ENABLE_MAYBE)
   Value symbol_obj;
   Value symbol_for_value;
   Value symbol_value;
@@ -1274,6 +1959,13 @@ struct vf_fallback {
   static Value From(napi_env env, const T& value) { return Value(env, value); }
 };
 
+template <typename T>
+struct vf_convert {
+  static Value From(napi_env env, const T& value) {
+    return Convert<T>::ToJS(env, value);
+  }
+};
+
 template <typename...>
 struct disjunction : std::false_type {};
 template <typename B>
@@ -1293,11 +1985,16 @@ struct can_make_string
 template <typename T>
 Value Value::From(napi_env env, const T& value) {
   using Helper = typename std::conditional<
-      std::is_integral<T>::value || std::is_floating_point<T>::value,
+      (std::is_integral<T>::value || std::is_floating_point<T>::value) &&
+          !details::is_int128<T>::value,
       details::vf_number<T>,
-      typename std::conditional<details::can_make_string<T>::value,
-                                String,
-                                details::vf_fallback<T>>::type>::type;
+      typename std::conditional<
+          details::can_make_string<T>::value,
+          String,
+          typename std::conditional<std::is_convertible<T, napi_value>::value,
+                                    details::vf_fallback<T>,
+                                    details::vf_convert<T>>::type>::type>::
+      type;
   return Helper::From(env, value);
 }
 
@@ -1350,14 +2047,70 @@ inline bool TypeTaggable::CheckTypeTag(const napi_type_tag* type_tag) const {
 // Object class
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace details {
+
 template <typename Key>
-inline Object::PropertyLValue<Key>::operator Value() const {
-  MaybeOrValue<Value> val = Object(_env, _object).Get(_key);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  return val.Unwrap();
-#else
-  return val;
-#endif
+inline const Key& PropertyLValueKey<Key>::From(napi_env /*env*/,
+                                               const Key& key) {
+  return key;
+}
+
+inline napi_value PropertyLValueKey<std::string>::From(napi_env env,
+                                                       const char* utf8name) {
+  napi_value key;
+  napi_status status =
+      napi_create_string_utf8(env, utf8name, NAPI_AUTO_LENGTH, &key);
+  NAPI_THROW_IF_FAILED(env, status, nullptr);
+  return key;
+}
+
+inline napi_value PropertyLValueKey<std::string>::From(
+    napi_env env, const std::string& utf8name) {
+  napi_value key;
+  napi_status status =
+      napi_create_string_utf8(env, utf8name.c_str(), utf8name.size(), &key);
+  NAPI_THROW_IF_FAILED(env, status, nullptr);
+  return key;
+}
+
+inline napi_status GetPropertyOrElement(napi_env env,
+                                        napi_value object,
+                                        napi_value key,
+                                        napi_value* result) {
+  return napi_get_property(env, object, key, result);
+}
+
+inline napi_status GetPropertyOrElement(napi_env env,
+                                        napi_value object,
+                                        uint32_t index,
+                                        napi_value* result) {
+  return napi_get_element(env, object, index, result);
+}
+
+inline napi_status SetPropertyOrElement(napi_env env,
+                                        napi_value object,
+                                        napi_value key,
+                                        napi_value value) {
+  return napi_set_property(env, object, key, value);
+}
+
+inline napi_status SetPropertyOrElement(napi_env env,
+                                        napi_value object,
+                                        uint32_t index,
+                                        napi_value value) {
+  return napi_set_element(env, object, index, value);
+}
+
+}  // namespace details
+
+template <typename Key>
+inline Object::PropertyLValue<Key>::operator Value() const {
+  MaybeOrValue<Value> val = Object(_env, _object).Get(_key);
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  return val.Unwrap();
+#else
+  return val;
+#endif
 }
 
 template <typename Key>
@@ -1375,8 +2128,49 @@ inline Object::PropertyLValue<Key>& Object::PropertyLValue<Key>::operator=(
 }
 
 template <typename Key>
-inline Object::PropertyLValue<Key>::PropertyLValue(Object object, Key key)
-    : _env(object.Env()), _object(object), _key(key) {}
+inline Object::PropertyLValue<Key>& Object::PropertyLValue<Key>::operator+=(
+    double delta) {
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  Increment(delta).Unwrap();
+#else
+  Increment(delta);
+#endif
+  return *this;
+}
+
+template <typename Key>
+inline MaybeOrValue<double> Object::PropertyLValue<Key>::Increment(
+    double delta) {
+  napi_value value;
+  double number = 0;
+  napi_status status =
+      details::GetPropertyOrElement(_env, _object, _key, &value);
+  if (status == napi_ok) {
+    status = napi_get_value_double(_env, value, &number);
+    if (status == napi_number_expected) {
+      status = napi_coerce_to_number(_env, value, &value);
+      if (status == napi_ok) {
+        status = napi_get_value_double(_env, value, &number);
+      }
+    }
+  }
+  if (status == napi_ok) {
+    number += delta;
+    status = napi_create_double(_env, number, &value);
+  }
+  if (status == napi_ok) {
+    status = details::SetPropertyOrElement(_env, _object, _key, value);
+  }
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, number, double);
+}
+
+template <typename Key>
+template <typename KeyArg>
+inline Object::PropertyLValue<Key>::PropertyLValue(Object object,
+                                                   const KeyArg& key)
+    : _env(object.Env()),
+      _object(object),
+      _key(details::PropertyLValueKey<Key>::From(object.Env(), key)) {}
 
 inline Object Object::New(napi_env env) {
   napi_value value;
@@ -1581,6 +2375,72 @@ inline MaybeOrValue<Array> Object::GetPropertyNames() const {
   NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, Array(_env, result), Array);
 }
 
+namespace details {
+
+inline napi_status GetEntryKeys(napi_env env,
+                                napi_value object,
+                                Object::EntryKeys keys,
+                                napi_value* result) {
+#if NAPI_VERSION > 5
+  if (keys == Object::EntryKeys::OwnEnumerable) {
+    return napi_get_all_property_names(
+        env,
+        object,
+        napi_key_own_only,
+        static_cast<napi_key_filter>(napi_key_enumerable |
+                                     napi_key_skip_symbols),
+        napi_key_numbers_to_strings,
+        result);
+  }
+#endif  // NAPI_VERSION > 5
+  (void)keys;
+  return napi_get_property_names(env, object, result);
+}
+
+// Reads the key at `index` of `names` and the value of `object` for it. A
+// cached Object.entries() was measured slower than this for all but the
+// smallest objects, since it allocates an array for every entry.
+inline napi_status GetEntry(napi_env env,
+                            napi_value object,
+                            napi_value names,
+                            uint32_t index,
+                            napi_value* key,
+                            napi_value* value) {
+  napi_status status = napi_get_element(env, names, index, key);
+  if (status != napi_ok) {
+    return status;
+  }
+  return napi_get_property(env, object, *key, value);
+}
+
+}  // namespace details
+
+inline MaybeOrValue<std::vector<Object::Entry>> Object::GetEntries(
+    EntryKeys keys) const {
+  napi_value names;
+  uint32_t length = 0;
+  napi_status status = details::GetEntryKeys(_env, _value, keys, &names);
+  if (status == napi_ok) {
+    status = napi_get_array_length(_env, names, &length);
+  }
+  NAPI_MAYBE_THROW_IF_FAILED(_env, status, std::vector<Entry>);
+
+  std::vector<Entry> entries;
+  entries.reserve(length);
+  for (uint32_t index = 0; index < length; index++) {
+    napi_value key;
+    napi_value value;
+    status = details::GetEntry(_env, _value, names, index, &key, &value);
+    NAPI_MAYBE_THROW_IF_FAILED(_env, status, std::vector<Entry>);
+    entries.push_back(Entry{Value(_env, key), Value(_env, value)});
+  }
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  return Just(entries);
+#else
+  return entries;
+#endif
+}
+
 inline MaybeOrValue<bool> Object::DefineProperty(
     const PropertyDescriptor& property) const {
   napi_status status = napi_define_properties(
@@ -1747,13 +2607,105 @@ inline MaybeOrValue<bool> Object::Seal() const {
 // External class
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace details {
+
+// The shared state of an External<T>::Pool. Every live external holds the
+// slab alive, as does the pool until it is destroyed, so externals that
+// outlive the pool can still return their slots.
+template <typename T>
+class ExternalSlab {
+ public:
+  explicit ExternalSlab(size_t slabSize)
+      : _slabSize(slabSize == 0 ? 1 : slabSize),
+        _free(nullptr),
+        _live(0),
+        _owned(true) {}
+
+  template <typename... Args>
+  T* Create(Args&&... args) {
+    if (_free == nullptr) {
+      Grow();
+    }
+    // The object overwrites the link to the next free slot, so the slot is
+    // taken first and put back if the constructor of T throws.
+    struct Guard {
+      ~Guard() {
+        if (slot != nullptr) {
+          slab->Push(slot);
+        }
+      }
+      ExternalSlab* slab;
+      Slot* slot;
+    } guard = {this, _free};
+    _free = guard.slot->next;
+    T* data = new (guard.slot->storage) T(std::forward<Args>(args)...);
+    guard.slot = nullptr;
+    _live++;
+    return data;
+  }
+
+  void Destroy(T* data) {
+    data->~T();
+    Push(reinterpret_cast<Slot*>(data));
+    _live--;
+    DeleteIfUnused();
+  }
+
+  // Called when the pool is destroyed.
+  void Disown() {
+    _owned = false;
+    DeleteIfUnused();
+  }
+
+  size_t Live() const { return _live; }
+
+  static inline void Finalize(napi_env /*env*/,
+                              void* data,
+                              void* finalizeHint) NAPI_NOEXCEPT {
+    static_cast<ExternalSlab*>(finalizeHint)->Destroy(static_cast<T*>(data));
+  }
+
+ private:
+  union Slot {
+    Slot* next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  void Push(Slot* slot) {
+    slot->next = _free;
+    _free = slot;
+  }
+
+  void Grow() {
+    Slot* slots = new Slot[_slabSize];
+    _slabs.emplace_back(slots);
+    for (size_t index = _slabSize; index > 0; index--) {
+      Push(&slots[index - 1]);
+    }
+  }
+
+  void DeleteIfUnused() {
+    if (!_owned && _live == 0) {
+      delete this;
+    }
+  }
+
+  size_t _slabSize;
+  Slot* _free;
+  size_t _live;
+  bool _owned;
+  std::vector<std::unique_ptr<Slot[]>> _slabs;
+};
+
+}  // namespace details
+
 template <typename T>
 inline External<T> External<T>::New(napi_env env, T* data) {
   napi_value value;
   napi_status status =
       napi_create_external(env, data, nullptr, nullptr, &value);
   NAPI_THROW_IF_FAILED(env, status, External());
-  return External(env, value);
+  return Created(env, value);
 }
 
 template <typename T>
@@ -1775,7 +2727,7 @@ inline External<T> External<T>::New(napi_env env,
     delete finalizeData;
     NAPI_THROW_IF_FAILED(env, status, External());
   }
-  return External(env, value);
+  return Created(env, value);
 }
 
 template <typename T>
@@ -1798,6 +2750,41 @@ inline External<T> External<T>::New(napi_env env,
     delete finalizeData;
     NAPI_THROW_IF_FAILED(env, status, External());
   }
+  return Created(env, value);
+}
+
+template <typename T>
+template <void (*Finalizer)(Napi::Env, T*)>
+inline External<T> External<T>::New(napi_env env, T* data) {
+  napi_value value;
+  napi_status status = napi_create_external(
+      env, data, details::TemplatedFinalizer<T, Finalizer>, nullptr, &value);
+  NAPI_THROW_IF_FAILED(env, status, External());
+  return Created(env, value);
+}
+
+template <typename T>
+template <typename Hint, void (*Finalizer)(Napi::Env, T*, Hint*)>
+inline External<T> External<T>::New(napi_env env,
+                                    T* data,
+                                    Hint* finalizeHint) {
+  napi_value value;
+  napi_status status = napi_create_external(
+      env,
+      data,
+      details::TemplatedFinalizerWithHint<T, Hint, Finalizer>,
+      finalizeHint,
+      &value);
+  NAPI_THROW_IF_FAILED(env, status, External());
+  return Created(env, value);
+}
+
+template <typename T>
+inline External<T> External<T>::Created(napi_env env, napi_value value) {
+#if defined(NODE_ADDON_API_EXTERNAL_TYPE_TAGS) && NAPI_VERSION >= 8
+  napi_status status = napi_type_tag_object(env, value, DataTypeTag());
+  NAPI_THROW_IF_FAILED(env, status, External());
+#endif
   return External(env, value);
 }
 
@@ -1828,6 +2815,61 @@ inline T* External<T>::Data() const {
   return reinterpret_cast<T*>(data);
 }
 
+#if NAPI_VERSION >= 8
+template <typename T>
+inline const napi_type_tag* External<T>::DataTypeTag() {
+  // A `napi_type_tag` is `{lower, upper}`. The lower half spells "napi-ext" to
+  // keep the tag apart from randomly generated ones, and the upper half holds
+  // the address of the tag, which is unique to `T` within the addon.
+  static const napi_type_tag tag = {0x6e6170692d657874,
+                                    reinterpret_cast<uintptr_t>(&tag)};
+  return &tag;
+}
+
+template <typename T>
+inline T* External<T>::TryData() const {
+  napi_valuetype type;
+  bool isTagged = false;
+  void* data = nullptr;
+  if (_value == nullptr || napi_typeof(_env, _value, &type) != napi_ok ||
+      type != napi_external ||
+      napi_check_object_type_tag(_env, _value, DataTypeTag(), &isTagged) !=
+          napi_ok ||
+      !isTagged || napi_get_value_external(_env, _value, &data) != napi_ok) {
+    return nullptr;
+  }
+  return static_cast<T*>(data);
+}
+#endif  // NAPI_VERSION >= 8
+
+template <typename T>
+inline External<T>::Pool::Pool(size_t slabSize)
+    : _slab(new details::ExternalSlab<T>(slabSize)) {}
+
+template <typename T>
+inline External<T>::Pool::~Pool() {
+  _slab->Disown();
+}
+
+template <typename T>
+template <typename... Args>
+inline External<T> External<T>::Pool::New(napi_env env, Args&&... args) {
+  T* data = _slab->Create(std::forward<Args>(args)...);
+  napi_value value;
+  napi_status status = napi_create_external(
+      env, data, details::ExternalSlab<T>::Finalize, _slab, &value);
+  if (status != napi_ok) {
+    _slab->Destroy(data);
+    NAPI_THROW_IF_FAILED(env, status, External());
+  }
+  return Created(env, value);
+}
+
+template <typename T>
+inline size_t External<T>::Pool::Size() const {
+  return _slab->Live();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Array class
 ////////////////////////////////////////////////////////////////////////////////
@@ -1866,349 +2908,871 @@ inline uint32_t Array::Length() const {
   return result;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// ArrayBuffer class
-////////////////////////////////////////////////////////////////////////////////
-
-inline ArrayBuffer ArrayBuffer::New(napi_env env, size_t byteLength) {
-  napi_value value;
-  void* data;
-  napi_status status = napi_create_arraybuffer(env, byteLength, &data, &value);
-  NAPI_THROW_IF_FAILED(env, status, ArrayBuffer());
+inline MaybeOrValue<bool> Array::GetRange(uint32_t start,
+                                          uint32_t count,
+                                          napi_value* out) const {
+  napi_status status = napi_ok;
+  for (uint32_t i = 0; status == napi_ok && i < count; i++) {
+    status = napi_get_element(_env, _value, start + i, &out[i]);
+  }
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, status == napi_ok, bool);
+}
 
-  return ArrayBuffer(env, value);
+inline MaybeOrValue<bool> Array::SetRange(uint32_t start,
+                                          uint32_t count,
+                                          const napi_value* values) const {
+  napi_status status = napi_ok;
+  for (uint32_t i = 0; status == napi_ok && i < count; i++) {
+    status = napi_set_element(_env, _value, start + i, values[i]);
+  }
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, status == napi_ok, bool);
 }
 
-#ifndef NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
-inline ArrayBuffer ArrayBuffer::New(napi_env env,
-                                    void* externalData,
-                                    size_t byteLength) {
-  napi_value value;
-  napi_status status = napi_create_external_arraybuffer(
-      env, externalData, byteLength, nullptr, nullptr, &value);
-  NAPI_THROW_IF_FAILED(env, status, ArrayBuffer());
+#if NAPI_VERSION > 2
+namespace details {
 
-  return ArrayBuffer(env, value);
+// Reports whether a call to a cached `Map`/`Set` method completed.
+inline MaybeOrValue<bool> CallCompleted(const MaybeOrValue<Value>& result) {
+#if defined(NODE_ADDON_API_ENABLE_MAYBE)
+  return result.IsJust() ? Just(true) : Nothing<bool>();
+#else
+  return !result.IsEmpty();
+#endif
 }
 
-template <typename Finalizer>
-inline ArrayBuffer ArrayBuffer::New(napi_env env,
-                                    void* externalData,
-                                    size_t byteLength,
-                                    Finalizer finalizeCallback) {
-  napi_value value;
-  details::FinalizeData<void, Finalizer>* finalizeData =
-      new details::FinalizeData<void, Finalizer>(
-          {std::move(finalizeCallback), nullptr});
-  napi_status status = napi_create_external_arraybuffer(
-      env,
-      externalData,
-      byteLength,
-      details::FinalizeData<void, Finalizer>::Wrapper,
-      finalizeData,
-      &value);
-  if (status != napi_ok) {
-    delete finalizeData;
-    NAPI_THROW_IF_FAILED(env, status, ArrayBuffer());
+// Returns the boolean result of a call to a cached `Map`/`Set` method.
+inline MaybeOrValue<bool> CallResultToBool(napi_env env,
+                                           const MaybeOrValue<Value>& result) {
+#if defined(NODE_ADDON_API_ENABLE_MAYBE)
+  if (result.IsNothing()) {
+    return Nothing<bool>();
   }
+  napi_value value = result.Unwrap();
+#else
+  napi_value value = result;
+  if (value == nullptr) {
+    return false;
+  }
+#endif
+  bool boolean = false;
+  napi_status status = napi_get_value_bool(env, value, &boolean);
+  NAPI_RETURN_OR_THROW_IF_FAILED(env, status, boolean, bool);
+}
 
-  return ArrayBuffer(env, value);
+template <typename T>
+inline MaybeOrValue<T> CollectionResult(bool succeeded, T&& result) {
+#if defined(NODE_ADDON_API_ENABLE_MAYBE)
+  return succeeded ? Just(std::move(result)) : Nothing<T>();
+#else
+  static_cast<void>(succeeded);
+  return std::move(result);
+#endif
 }
 
-template <typename Finalizer, typename Hint>
-inline ArrayBuffer ArrayBuffer::New(napi_env env,
-                                    void* externalData,
-                                    size_t byteLength,
-                                    Finalizer finalizeCallback,
-                                    Hint* finalizeHint) {
-  napi_value value;
-  details::FinalizeData<void, Finalizer, Hint>* finalizeData =
-      new details::FinalizeData<void, Finalizer, Hint>(
-          {std::move(finalizeCallback), finalizeHint});
-  napi_status status = napi_create_external_arraybuffer(
-      env,
-      externalData,
-      byteLength,
-      details::FinalizeData<void, Finalizer, Hint>::WrapperWithHint,
-      finalizeData,
-      &value);
-  if (status != napi_ok) {
-    delete finalizeData;
-    NAPI_THROW_IF_FAILED(env, status, ArrayBuffer());
+// Copies the contents of a `Map` or `Set` into an array using `Array.from()`.
+// With `flatten`, the `[key, value]` pairs of a `Map` are flattened into a
+// single array of alternating keys and values.
+inline napi_status CollectionToArray(napi_env env,
+                                     napi_value collection,
+                                     bool flatten,
+                                     napi_value* result,
+                                     uint32_t* length) {
+  napi_value undefined;
+  napi_status status = napi_get_undefined(env, &undefined);
+  if (status != napi_ok) return status;
+
+  status = napi_call_function(
+      env, undefined, Builtins::ArrayFrom(env), 1, &collection, result);
+  if (status != napi_ok) return status;
+
+  if (flatten) {
+    status = napi_call_function(
+        env, *result, Builtins::ArrayFlat(env), 0, nullptr, result);
+    if (status != napi_ok) return status;
   }
 
-  return ArrayBuffer(env, value);
+  return napi_get_array_length(env, *result, length);
 }
-#endif  // NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
 
-inline void ArrayBuffer::CheckCast(napi_env env, napi_value value) {
-  NAPI_CHECK(value != nullptr, "ArrayBuffer::CheckCast", "empty value");
+// Builds the argument of the `Map` or `Set` constructor for `FromRange()`.
+template <typename Iterator>
+inline napi_status RangeToEntries(napi_env env,
+                                  Iterator first,
+                                  Iterator last,
+                                  std::true_type /* pairs */,
+                                  napi_value* result) {
+  napi_status status = napi_create_array(env, result);
+  for (uint32_t index = 0; status == napi_ok && first != last;
+       ++first, ++index) {
+    napi_value entry;
+    status = napi_create_array_with_length(env, 2, &entry);
+    if (status != napi_ok) break;
+    Value key = Value::From(env, std::get<0>(*first));
+    if (key.IsEmpty()) return napi_pending_exception;
+    status = napi_set_element(env, entry, 0, key);
+    if (status != napi_ok) break;
+    Value value = Value::From(env, std::get<1>(*first));
+    if (value.IsEmpty()) return napi_pending_exception;
+    status = napi_set_element(env, entry, 1, value);
+    if (status != napi_ok) break;
+    status = napi_set_element(env, *result, index, entry);
+  }
+  return status;
+}
 
-  bool result;
-  napi_status status = napi_is_arraybuffer(env, value, &result);
-  NAPI_CHECK(status == napi_ok,
-             "ArrayBuffer::CheckCast",
-             "napi_is_arraybuffer failed");
-  NAPI_CHECK(result, "ArrayBuffer::CheckCast", "value is not arraybuffer");
+template <typename Iterator>
+inline napi_status RangeToEntries(napi_env env,
+                                  Iterator first,
+                                  Iterator last,
+                                  std::false_type /* pairs */,
+                                  napi_value* result) {
+  napi_status status = napi_create_array(env, result);
+  for (uint32_t index = 0; status == napi_ok && first != last;
+       ++first, ++index) {
+    Value value = Value::From(env, *first);
+    if (value.IsEmpty()) return napi_pending_exception;
+    status = napi_set_element(env, *result, index, value);
+  }
+  return status;
 }
 
-inline ArrayBuffer::ArrayBuffer() : Object() {}
+// The number of values `Array::Append()` passes to each call of
+// `Array.prototype.push`. It bounds both the length of the argument list and
+// the number of converted values alive at once.
+constexpr size_t kArrayAppendChunkSize = 1024;
 
-inline ArrayBuffer::ArrayBuffer(napi_env env, napi_value value)
-    : Object(env, value) {}
-
-inline void* ArrayBuffer::Data() {
-  void* data;
-  napi_status status = napi_get_arraybuffer_info(_env, _value, &data, nullptr);
-  NAPI_THROW_IF_FAILED(_env, status, nullptr);
-  return data;
+inline napi_status ArrayPush(napi_env env,
+                             napi_value array,
+                             size_t argc,
+                             const napi_value* argv,
+                             uint32_t* length) {
+  napi_value result;
+  napi_status status = napi_call_function(
+      env, array, Builtins::ArrayPush(env), argc, argv, &result);
+  if (status != napi_ok) return status;
+  return napi_get_value_uint32(env, result, length);
+}
+
+template <typename Iterator>
+inline napi_status ArrayAppend(napi_env env,
+                               napi_value array,
+                               Iterator first,
+                               Iterator last,
+                               uint32_t* length) {
+  napi_status status = napi_get_array_length(env, array, length);
+  std::vector<napi_value> chunk;
+  chunk.reserve(kArrayAppendChunkSize);
+  while (status == napi_ok && first != last) {
+    // The converted values are only needed until they have been pushed.
+    HandleScope scope(env);
+    chunk.clear();
+    for (; first != last && chunk.size() < kArrayAppendChunkSize; ++first) {
+      Value value = Value::From(env, *first);
+      if (value.IsEmpty()) return napi_pending_exception;
+      chunk.push_back(value);
+    }
+    status = ArrayPush(env, array, chunk.size(), chunk.data(), length);
+  }
+  return status;
 }
 
-inline size_t ArrayBuffer::ByteLength() {
-  size_t length;
+}  // namespace details
+
+////////////////////////////////////////////////////////////////////////////////
+// Array class
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename... Args>
+inline MaybeOrValue<uint32_t> Array::Push(const Args&... values) const {
+  // The trailing element keeps the array non-empty when there are no values.
+  napi_value argv[] = {static_cast<napi_value>(Value::From(_env, values))...,
+                       nullptr};
+  uint32_t length = 0;
   napi_status status =
-      napi_get_arraybuffer_info(_env, _value, nullptr, &length);
-  NAPI_THROW_IF_FAILED(_env, status, 0);
-  return length;
+      details::ArrayPush(_env, _value, sizeof...(Args), argv, &length);
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, length, uint32_t);
 }
 
-#if NAPI_VERSION >= 7
-inline bool ArrayBuffer::IsDetached() const {
-  bool detached;
-  napi_status status = napi_is_detached_arraybuffer(_env, _value, &detached);
-  NAPI_THROW_IF_FAILED(_env, status, false);
-  return detached;
+template <typename Iterator>
+inline MaybeOrValue<uint32_t> Array::Append(Iterator first,
+                                            Iterator last) const {
+  uint32_t length = 0;
+  napi_status status =
+      details::ArrayAppend(_env, _value, first, last, &length);
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, length, uint32_t);
 }
 
-inline void ArrayBuffer::Detach() {
-  napi_status status = napi_detach_arraybuffer(_env, _value);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
+template <typename Range>
+inline MaybeOrValue<uint32_t> Array::Append(const Range& range) const {
+  return Append(range.begin(), range.end());
 }
-#endif  // NAPI_VERSION >= 7
 
 ////////////////////////////////////////////////////////////////////////////////
-// DataView class
+// Map class
 ////////////////////////////////////////////////////////////////////////////////
-inline DataView DataView::New(napi_env env, Napi::ArrayBuffer arrayBuffer) {
-  return New(env, arrayBuffer, 0, arrayBuffer.ByteLength());
-}
 
-inline DataView DataView::New(napi_env env,
-                              Napi::ArrayBuffer arrayBuffer,
-                              size_t byteOffset) {
-  if (byteOffset > arrayBuffer.ByteLength()) {
-    NAPI_THROW(RangeError::New(
-                   env, "Start offset is outside the bounds of the buffer"),
-               DataView());
-  }
-  return New(
-      env, arrayBuffer, byteOffset, arrayBuffer.ByteLength() - byteOffset);
+inline Map Map::New(napi_env env) {
+  napi_value value;
+  napi_status status = napi_new_instance(
+      env, Builtins::MapConstructor(env), 0, nullptr, &value);
+  NAPI_THROW_IF_FAILED(env, status, Map());
+  return Map(env, value);
 }
 
-inline DataView DataView::New(napi_env env,
-                              Napi::ArrayBuffer arrayBuffer,
-                              size_t byteOffset,
-                              size_t byteLength) {
-  if (byteOffset + byteLength > arrayBuffer.ByteLength()) {
-    NAPI_THROW(RangeError::New(env, "Invalid DataView length"), DataView());
-  }
-  napi_value value;
+template <typename Iterator>
+inline Map Map::FromRange(napi_env env, Iterator first, Iterator last) {
+  napi_value entries;
   napi_status status =
-      napi_create_dataview(env, byteLength, arrayBuffer, byteOffset, &value);
-  NAPI_THROW_IF_FAILED(env, status, DataView());
-  return DataView(env, value);
+      details::RangeToEntries(env, first, last, std::true_type(), &entries);
+  NAPI_THROW_IF_FAILED(env, status, Map());
+
+  napi_value value;
+  status = napi_new_instance(
+      env, Builtins::MapConstructor(env), 1, &entries, &value);
+  NAPI_THROW_IF_FAILED(env, status, Map());
+  return Map(env, value);
 }
 
-inline void DataView::CheckCast(napi_env env, napi_value value) {
-  NAPI_CHECK(value != nullptr, "DataView::CheckCast", "empty value");
+template <typename Range>
+inline Map Map::FromRange(napi_env env, const Range& range) {
+  return FromRange(env, range.begin(), range.end());
+}
+
+inline void Map::CheckCast(napi_env env, napi_value value) {
+  NAPI_CHECK(value != nullptr, "Map::CheckCast", "empty value");
 
   bool result;
-  napi_status status = napi_is_dataview(env, value, &result);
-  NAPI_CHECK(
-      status == napi_ok, "DataView::CheckCast", "napi_is_dataview failed");
-  NAPI_CHECK(result, "DataView::CheckCast", "value is not dataview");
+  napi_status status =
+      napi_instanceof(env, value, Builtins::MapConstructor(env), &result);
+  NAPI_CHECK(status == napi_ok, "Map::CheckCast", "napi_instanceof failed");
+  NAPI_CHECK(result, "Map::CheckCast", "value is not a Map");
 }
 
-inline DataView::DataView() : Object() {}
+inline Map::Map() : Object() {}
 
-inline DataView::DataView(napi_env env, napi_value value) : Object(env, value) {
-  napi_status status = napi_get_dataview_info(_env,
-                                              _value /* dataView */,
-                                              &_length /* byteLength */,
-                                              &_data /* data */,
-                                              nullptr /* arrayBuffer */,
-                                              nullptr /* byteOffset */);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
+inline Map::Map(napi_env env, napi_value value) : Object(env, value) {}
+
+inline MaybeOrValue<Value> Map::Get(napi_value key) const {
+  return Builtins::MapGet(_env).Call(_value, {key});
 }
 
-inline Napi::ArrayBuffer DataView::ArrayBuffer() const {
-  napi_value arrayBuffer;
-  napi_status status = napi_get_dataview_info(_env,
-                                              _value /* dataView */,
-                                              nullptr /* byteLength */,
-                                              nullptr /* data */,
-                                              &arrayBuffer /* arrayBuffer */,
-                                              nullptr /* byteOffset */);
-  NAPI_THROW_IF_FAILED(_env, status, Napi::ArrayBuffer());
-  return Napi::ArrayBuffer(_env, arrayBuffer);
+template <typename Key>
+inline MaybeOrValue<Value> Map::Get(const Key& key) const {
+  return Get(static_cast<napi_value>(Value::From(_env, key)));
 }
 
-inline size_t DataView::ByteOffset() const {
-  size_t byteOffset;
-  napi_status status = napi_get_dataview_info(_env,
-                                              _value /* dataView */,
-                                              nullptr /* byteLength */,
-                                              nullptr /* data */,
-                                              nullptr /* arrayBuffer */,
-                                              &byteOffset /* byteOffset */);
-  NAPI_THROW_IF_FAILED(_env, status, 0);
-  return byteOffset;
+inline MaybeOrValue<bool> Map::Set(napi_value key, napi_value value) const {
+  return details::CallCompleted(
+      Builtins::MapSet(_env).Call(_value, {key, value}));
 }
 
-inline size_t DataView::ByteLength() const {
-  return _length;
+template <typename Key, typename ValueType>
+inline MaybeOrValue<bool> Map::Set(const Key& key,
+                                   const ValueType& value) const {
+  return Set(static_cast<napi_value>(Value::From(_env, key)),
+             static_cast<napi_value>(Value::From(_env, value)));
 }
 
-inline void* DataView::Data() const {
-  return _data;
+inline MaybeOrValue<bool> Map::Has(napi_value key) const {
+  return details::CallResultToBool(_env,
+                                   Builtins::MapHas(_env).Call(_value, {key}));
 }
 
-inline float DataView::GetFloat32(size_t byteOffset) const {
-  return ReadData<float>(byteOffset);
+template <typename Key>
+inline MaybeOrValue<bool> Map::Has(const Key& key) const {
+  return Has(static_cast<napi_value>(Value::From(_env, key)));
 }
 
-inline double DataView::GetFloat64(size_t byteOffset) const {
-  return ReadData<double>(byteOffset);
+inline MaybeOrValue<bool> Map::Delete(napi_value key) const {
+  return details::CallResultToBool(
+      _env, Builtins::MapDelete(_env).Call(_value, {key}));
 }
 
-inline int8_t DataView::GetInt8(size_t byteOffset) const {
-  return ReadData<int8_t>(byteOffset);
+template <typename Key>
+inline MaybeOrValue<bool> Map::Delete(const Key& key) const {
+  return Delete(static_cast<napi_value>(Value::From(_env, key)));
 }
 
-inline int16_t DataView::GetInt16(size_t byteOffset) const {
-  return ReadData<int16_t>(byteOffset);
+inline uint32_t Map::Size() const {
+  napi_value size;
+  napi_status status = napi_get_named_property(_env, _value, "size", &size);
+  NAPI_THROW_IF_FAILED(_env, status, 0);
+
+  uint32_t result;
+  status = napi_get_value_uint32(_env, size, &result);
+  NAPI_THROW_IF_FAILED(_env, status, 0);
+  return result;
 }
 
-inline int32_t DataView::GetInt32(size_t byteOffset) const {
-  return ReadData<int32_t>(byteOffset);
+template <typename Callback>
+inline MaybeOrValue<bool> Map::ForEach(Callback callback) const {
+  napi_value entries;
+  uint32_t length;
+  napi_status status =
+      details::CollectionToArray(_env, _value, true, &entries, &length);
+  NAPI_MAYBE_THROW_IF_FAILED(_env, status, bool);
+
+  bool completed = true;
+  for (uint32_t i = 0; i + 1 < length; i += 2) {
+    napi_value key;
+    napi_value value;
+    status = napi_get_element(_env, entries, i, &key);
+    NAPI_MAYBE_THROW_IF_FAILED(_env, status, bool);
+    status = napi_get_element(_env, entries, i + 1, &value);
+    NAPI_MAYBE_THROW_IF_FAILED(_env, status, bool);
+    if (!callback(Value(_env, key), Value(_env, value))) {
+      completed = false;
+      break;
+    }
+  }
+  return details::CollectionResult(true, std::move(completed));
 }
 
-inline uint8_t DataView::GetUint8(size_t byteOffset) const {
-  return ReadData<uint8_t>(byteOffset);
+template <typename K, typename V>
+inline MaybeOrValue<std::unordered_map<K, V>> Map::ToUnorderedMap() const {
+  using Result = std::unordered_map<K, V>;
+
+  napi_value entries;
+  uint32_t length;
+  napi_status status =
+      details::CollectionToArray(_env, _value, true, &entries, &length);
+  NAPI_MAYBE_THROW_IF_FAILED(_env, status, Result);
+
+  Result result;
+  result.reserve(length / 2);
+  for (uint32_t i = 0; i + 1 < length; i += 2) {
+    napi_value key;
+    napi_value value;
+    status = napi_get_element(_env, entries, i, &key);
+    NAPI_MAYBE_THROW_IF_FAILED(_env, status, Result);
+    status = napi_get_element(_env, entries, i + 1, &value);
+    NAPI_MAYBE_THROW_IF_FAILED(_env, status, Result);
+
+    K k{};
+    V v{};
+    if (!Convert<K>::FromJS(Value(_env, key), &k) ||
+        !Convert<V>::FromJS(Value(_env, value), &v)) {
+      return details::CollectionResult(false, Result());
+    }
+    result.emplace(std::move(k), std::move(v));
+  }
+  return details::CollectionResult(true, std::move(result));
 }
 
-inline uint16_t DataView::GetUint16(size_t byteOffset) const {
-  return ReadData<uint16_t>(byteOffset);
+////////////////////////////////////////////////////////////////////////////////
+// Set class
+////////////////////////////////////////////////////////////////////////////////
+
+inline Set Set::New(napi_env env) {
+  napi_value value;
+  napi_status status = napi_new_instance(
+      env, Builtins::SetConstructor(env), 0, nullptr, &value);
+  NAPI_THROW_IF_FAILED(env, status, Set());
+  return Set(env, value);
 }
 
-inline uint32_t DataView::GetUint32(size_t byteOffset) const {
-  return ReadData<uint32_t>(byteOffset);
+template <typename Iterator>
+inline Set Set::FromRange(napi_env env, Iterator first, Iterator last) {
+  napi_value values;
+  napi_status status =
+      details::RangeToEntries(env, first, last, std::false_type(), &values);
+  NAPI_THROW_IF_FAILED(env, status, Set());
+
+  napi_value value;
+  status = napi_new_instance(
+      env, Builtins::SetConstructor(env), 1, &values, &value);
+  NAPI_THROW_IF_FAILED(env, status, Set());
+  return Set(env, value);
 }
 
-inline void DataView::SetFloat32(size_t byteOffset, float value) const {
-  WriteData<float>(byteOffset, value);
+template <typename Range>
+inline Set Set::FromRange(napi_env env, const Range& range) {
+  return FromRange(env, range.begin(), range.end());
 }
 
-inline void DataView::SetFloat64(size_t byteOffset, double value) const {
-  WriteData<double>(byteOffset, value);
+inline void Set::CheckCast(napi_env env, napi_value value) {
+  NAPI_CHECK(value != nullptr, "Set::CheckCast", "empty value");
+
+  bool result;
+  napi_status status =
+      napi_instanceof(env, value, Builtins::SetConstructor(env), &result);
+  NAPI_CHECK(status == napi_ok, "Set::CheckCast", "napi_instanceof failed");
+  NAPI_CHECK(result, "Set::CheckCast", "value is not a Set");
 }
 
-inline void DataView::SetInt8(size_t byteOffset, int8_t value) const {
-  WriteData<int8_t>(byteOffset, value);
+inline Set::Set() : Object() {}
+
+inline Set::Set(napi_env env, napi_value value) : Object(env, value) {}
+
+inline MaybeOrValue<bool> Set::Add(napi_value value) const {
+  return details::CallCompleted(
+      Builtins::SetAdd(_env).Call(_value, {value}));
 }
 
-inline void DataView::SetInt16(size_t byteOffset, int16_t value) const {
-  WriteData<int16_t>(byteOffset, value);
+template <typename ValueType>
+inline MaybeOrValue<bool> Set::Add(const ValueType& value) const {
+  return Add(static_cast<napi_value>(Value::From(_env, value)));
 }
 
-inline void DataView::SetInt32(size_t byteOffset, int32_t value) const {
-  WriteData<int32_t>(byteOffset, value);
+inline MaybeOrValue<bool> Set::Has(napi_value value) const {
+  return details::CallResultToBool(
+      _env, Builtins::SetHas(_env).Call(_value, {value}));
 }
 
-inline void DataView::SetUint8(size_t byteOffset, uint8_t value) const {
-  WriteData<uint8_t>(byteOffset, value);
+template <typename ValueType>
+inline MaybeOrValue<bool> Set::Has(const ValueType& value) const {
+  return Has(static_cast<napi_value>(Value::From(_env, value)));
 }
 
-inline void DataView::SetUint16(size_t byteOffset, uint16_t value) const {
-  WriteData<uint16_t>(byteOffset, value);
+inline MaybeOrValue<bool> Set::Delete(napi_value value) const {
+  return details::CallResultToBool(
+      _env, Builtins::SetDelete(_env).Call(_value, {value}));
 }
 
-inline void DataView::SetUint32(size_t byteOffset, uint32_t value) const {
-  WriteData<uint32_t>(byteOffset, value);
+template <typename ValueType>
+inline MaybeOrValue<bool> Set::Delete(const ValueType& value) const {
+  return Delete(static_cast<napi_value>(Value::From(_env, value)));
 }
 
-template <typename T>
-inline T DataView::ReadData(size_t byteOffset) const {
-  if (byteOffset + sizeof(T) > _length ||
-      byteOffset + sizeof(T) < byteOffset) {  // overflow
-    NAPI_THROW(
-        RangeError::New(_env, "Offset is outside the bounds of the DataView"),
-        0);
-  }
+inline uint32_t Set::Size() const {
+  napi_value size;
+  napi_status status = napi_get_named_property(_env, _value, "size", &size);
+  NAPI_THROW_IF_FAILED(_env, status, 0);
 
-  return *reinterpret_cast<T*>(static_cast<uint8_t*>(_data) + byteOffset);
+  uint32_t result;
+  status = napi_get_value_uint32(_env, size, &result);
+  NAPI_THROW_IF_FAILED(_env, status, 0);
+  return result;
 }
 
-template <typename T>
-inline void DataView::WriteData(size_t byteOffset, T value) const {
-  if (byteOffset + sizeof(T) > _length ||
-      byteOffset + sizeof(T) < byteOffset) {  // overflow
-    NAPI_THROW_VOID(
-        RangeError::New(_env, "Offset is outside the bounds of the DataView"));
+template <typename Callback>
+inline MaybeOrValue<bool> Set::ForEach(Callback callback) const {
+  napi_value values;
+  uint32_t length;
+  napi_status status =
+      details::CollectionToArray(_env, _value, false, &values, &length);
+  NAPI_MAYBE_THROW_IF_FAILED(_env, status, bool);
+
+  bool completed = true;
+  for (uint32_t i = 0; i < length; i++) {
+    napi_value value;
+    status = napi_get_element(_env, values, i, &value);
+    NAPI_MAYBE_THROW_IF_FAILED(_env, status, bool);
+    if (!callback(Value(_env, value))) {
+      completed = false;
+      break;
+    }
   }
+  return details::CollectionResult(true, std::move(completed));
+}
 
-  *reinterpret_cast<T*>(static_cast<uint8_t*>(_data) + byteOffset) = value;
+template <typename T>
+inline MaybeOrValue<std::vector<T>> Set::ToVector() const {
+  using Result = std::vector<T>;
+
+  napi_value values;
+  uint32_t length;
+  napi_status status =
+      details::CollectionToArray(_env, _value, false, &values, &length);
+  NAPI_MAYBE_THROW_IF_FAILED(_env, status, Result);
+
+  Result result;
+  result.reserve(length);
+  for (uint32_t i = 0; i < length; i++) {
+    napi_value value;
+    status = napi_get_element(_env, values, i, &value);
+    NAPI_MAYBE_THROW_IF_FAILED(_env, status, Result);
+
+    T item{};
+    if (!Convert<T>::FromJS(Value(_env, value), &item)) {
+      return details::CollectionResult(false, Result());
+    }
+    result.push_back(std::move(item));
+  }
+  return details::CollectionResult(true, std::move(result));
 }
+#endif  // NAPI_VERSION > 2
 
 ////////////////////////////////////////////////////////////////////////////////
-// TypedArray class
+// ArrayBuffer class
 ////////////////////////////////////////////////////////////////////////////////
-inline void TypedArray::CheckCast(napi_env env, napi_value value) {
-  NAPI_CHECK(value != nullptr, "TypedArray::CheckCast", "empty value");
-
-  bool result;
-  napi_status status = napi_is_typedarray(env, value, &result);
-  NAPI_CHECK(
-      status == napi_ok, "TypedArray::CheckCast", "napi_is_typedarray failed");
-  NAPI_CHECK(result, "TypedArray::CheckCast", "value is not typedarray");
-}
 
-inline TypedArray::TypedArray()
-    : Object(), _type(napi_typedarray_type::napi_int8_array), _length(0) {}
+inline ArrayBuffer ArrayBuffer::New(napi_env env, size_t byteLength) {
+  napi_value value;
+  void* data;
+  napi_status status = napi_create_arraybuffer(env, byteLength, &data, &value);
+  NAPI_THROW_IF_FAILED(env, status, ArrayBuffer());
 
-inline TypedArray::TypedArray(napi_env env, napi_value value)
-    : Object(env, value),
-      _type(napi_typedarray_type::napi_int8_array),
-      _length(0) {
-  if (value != nullptr) {
-    napi_status status =
-        napi_get_typedarray_info(_env,
-                                 _value,
-                                 &const_cast<TypedArray*>(this)->_type,
-                                 &const_cast<TypedArray*>(this)->_length,
-                                 nullptr,
-                                 nullptr,
-                                 nullptr);
-    NAPI_THROW_IF_FAILED_VOID(_env, status);
-  }
+  return ArrayBuffer(env, value);
 }
 
-inline TypedArray::TypedArray(napi_env env,
-                              napi_value value,
-                              napi_typedarray_type type,
-                              size_t length)
-    : Object(env, value), _type(type), _length(length) {}
+#ifndef NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+inline ArrayBuffer ArrayBuffer::New(napi_env env,
+                                    void* externalData,
+                                    size_t byteLength) {
+  napi_value value;
+  napi_status status = napi_create_external_arraybuffer(
+      env, externalData, byteLength, nullptr, nullptr, &value);
+  NAPI_THROW_IF_FAILED(env, status, ArrayBuffer());
 
-inline napi_typedarray_type TypedArray::TypedArrayType() const {
-  return _type;
+  return ArrayBuffer(env, value);
 }
 
-inline uint8_t TypedArray::ElementSize() const {
-  switch (_type) {
-    case napi_int8_array:
-    case napi_uint8_array:
-    case napi_uint8_clamped_array:
-      return 1;
+template <typename Finalizer>
+inline ArrayBuffer ArrayBuffer::New(napi_env env,
+                                    void* externalData,
+                                    size_t byteLength,
+                                    Finalizer finalizeCallback) {
+  napi_value value;
+  details::FinalizeData<void, Finalizer>* finalizeData =
+      new details::FinalizeData<void, Finalizer>(
+          {std::move(finalizeCallback), nullptr});
+  napi_status status = napi_create_external_arraybuffer(
+      env,
+      externalData,
+      byteLength,
+      details::FinalizeData<void, Finalizer>::Wrapper,
+      finalizeData,
+      &value);
+  if (status != napi_ok) {
+    delete finalizeData;
+    NAPI_THROW_IF_FAILED(env, status, ArrayBuffer());
+  }
+
+  return ArrayBuffer(env, value);
+}
+
+template <typename Finalizer, typename Hint>
+inline ArrayBuffer ArrayBuffer::New(napi_env env,
+                                    void* externalData,
+                                    size_t byteLength,
+                                    Finalizer finalizeCallback,
+                                    Hint* finalizeHint) {
+  napi_value value;
+  details::FinalizeData<void, Finalizer, Hint>* finalizeData =
+      new details::FinalizeData<void, Finalizer, Hint>(
+          {std::move(finalizeCallback), finalizeHint});
+  napi_status status = napi_create_external_arraybuffer(
+      env,
+      externalData,
+      byteLength,
+      details::FinalizeData<void, Finalizer, Hint>::WrapperWithHint,
+      finalizeData,
+      &value);
+  if (status != napi_ok) {
+    delete finalizeData;
+    NAPI_THROW_IF_FAILED(env, status, ArrayBuffer());
+  }
+
+  return ArrayBuffer(env, value);
+}
+
+template <void (*Finalizer)(Napi::Env, void*)>
+inline ArrayBuffer ArrayBuffer::New(napi_env env,
+                                    void* externalData,
+                                    size_t byteLength) {
+  napi_value value;
+  napi_status status = napi_create_external_arraybuffer(
+      env,
+      externalData,
+      byteLength,
+      details::TemplatedFinalizer<void, Finalizer>,
+      nullptr,
+      &value);
+  NAPI_THROW_IF_FAILED(env, status, ArrayBuffer());
+
+  return ArrayBuffer(env, value);
+}
+
+template <typename Hint, void (*Finalizer)(Napi::Env, void*, Hint*)>
+inline ArrayBuffer ArrayBuffer::New(napi_env env,
+                                    void* externalData,
+                                    size_t byteLength,
+                                    Hint* finalizeHint) {
+  napi_value value;
+  napi_status status = napi_create_external_arraybuffer(
+      env,
+      externalData,
+      byteLength,
+      details::TemplatedFinalizerWithHint<void, Hint, Finalizer>,
+      finalizeHint,
+      &value);
+  NAPI_THROW_IF_FAILED(env, status, ArrayBuffer());
+
+  return ArrayBuffer(env, value);
+}
+#endif  // NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+
+inline void ArrayBuffer::CheckCast(napi_env env, napi_value value) {
+  NAPI_CHECK(value != nullptr, "ArrayBuffer::CheckCast", "empty value");
+
+  bool result;
+  napi_status status = napi_is_arraybuffer(env, value, &result);
+  NAPI_CHECK(status == napi_ok,
+             "ArrayBuffer::CheckCast",
+             "napi_is_arraybuffer failed");
+  NAPI_CHECK(result, "ArrayBuffer::CheckCast", "value is not arraybuffer");
+}
+
+inline ArrayBuffer::ArrayBuffer() : Object() {}
+
+inline ArrayBuffer::ArrayBuffer(napi_env env, napi_value value)
+    : Object(env, value) {}
+
+inline void* ArrayBuffer::Data() {
+  void* data;
+  napi_status status = napi_get_arraybuffer_info(_env, _value, &data, nullptr);
+  NAPI_THROW_IF_FAILED(_env, status, nullptr);
+  return data;
+}
+
+inline size_t ArrayBuffer::ByteLength() {
+  size_t length;
+  napi_status status =
+      napi_get_arraybuffer_info(_env, _value, nullptr, &length);
+  NAPI_THROW_IF_FAILED(_env, status, 0);
+  return length;
+}
+
+#if NAPI_VERSION >= 7
+inline bool ArrayBuffer::IsDetached() const {
+  bool detached;
+  napi_status status = napi_is_detached_arraybuffer(_env, _value, &detached);
+  NAPI_THROW_IF_FAILED(_env, status, false);
+  return detached;
+}
+
+inline void ArrayBuffer::Detach() {
+  napi_status status = napi_detach_arraybuffer(_env, _value);
+  NAPI_THROW_IF_FAILED_VOID(_env, status);
+}
+#endif  // NAPI_VERSION >= 7
+
+////////////////////////////////////////////////////////////////////////////////
+// DataView class
+////////////////////////////////////////////////////////////////////////////////
+inline DataView DataView::New(napi_env env, Napi::ArrayBuffer arrayBuffer) {
+  return New(env, arrayBuffer, 0, arrayBuffer.ByteLength());
+}
+
+inline DataView DataView::New(napi_env env,
+                              Napi::ArrayBuffer arrayBuffer,
+                              size_t byteOffset) {
+  if (byteOffset > arrayBuffer.ByteLength()) {
+    NAPI_THROW(RangeError::New(
+                   env, "Start offset is outside the bounds of the buffer"),
+               DataView());
+  }
+  return New(
+      env, arrayBuffer, byteOffset, arrayBuffer.ByteLength() - byteOffset);
+}
+
+inline DataView DataView::New(napi_env env,
+                              Napi::ArrayBuffer arrayBuffer,
+                              size_t byteOffset,
+                              size_t byteLength) {
+  if (byteOffset + byteLength > arrayBuffer.ByteLength()) {
+    NAPI_THROW(RangeError::New(env, "Invalid DataView length"), DataView());
+  }
+  napi_value value;
+  napi_status status =
+      napi_create_dataview(env, byteLength, arrayBuffer, byteOffset, &value);
+  NAPI_THROW_IF_FAILED(env, status, DataView());
+  return DataView(env, value);
+}
+
+inline void DataView::CheckCast(napi_env env, napi_value value) {
+  NAPI_CHECK(value != nullptr, "DataView::CheckCast", "empty value");
+
+  bool result;
+  napi_status status = napi_is_dataview(env, value, &result);
+  NAPI_CHECK(
+      status == napi_ok, "DataView::CheckCast", "napi_is_dataview failed");
+  NAPI_CHECK(result, "DataView::CheckCast", "value is not dataview");
+}
+
+inline DataView::DataView() : Object() {}
+
+inline DataView::DataView(napi_env env, napi_value value) : Object(env, value) {
+  napi_status status = napi_get_dataview_info(_env,
+                                              _value /* dataView */,
+                                              &_length /* byteLength */,
+                                              &_data /* data */,
+                                              nullptr /* arrayBuffer */,
+                                              nullptr /* byteOffset */);
+  NAPI_THROW_IF_FAILED_VOID(_env, status);
+}
+
+inline Napi::ArrayBuffer DataView::ArrayBuffer() const {
+  napi_value arrayBuffer;
+  napi_status status = napi_get_dataview_info(_env,
+                                              _value /* dataView */,
+                                              nullptr /* byteLength */,
+                                              nullptr /* data */,
+                                              &arrayBuffer /* arrayBuffer */,
+                                              nullptr /* byteOffset */);
+  NAPI_THROW_IF_FAILED(_env, status, Napi::ArrayBuffer());
+  return Napi::ArrayBuffer(_env, arrayBuffer);
+}
+
+inline size_t DataView::ByteOffset() const {
+  size_t byteOffset;
+  napi_status status = napi_get_dataview_info(_env,
+                                              _value /* dataView */,
+                                              nullptr /* byteLength */,
+                                              nullptr /* data */,
+                                              nullptr /* arrayBuffer */,
+                                              &byteOffset /* byteOffset */);
+  NAPI_THROW_IF_FAILED(_env, status, 0);
+  return byteOffset;
+}
+
+inline size_t DataView::ByteLength() const {
+  return _length;
+}
+
+inline void* DataView::Data() const {
+  return _data;
+}
+
+inline float DataView::GetFloat32(size_t byteOffset) const {
+  return ReadData<float>(byteOffset);
+}
+
+inline double DataView::GetFloat64(size_t byteOffset) const {
+  return ReadData<double>(byteOffset);
+}
+
+inline int8_t DataView::GetInt8(size_t byteOffset) const {
+  return ReadData<int8_t>(byteOffset);
+}
+
+inline int16_t DataView::GetInt16(size_t byteOffset) const {
+  return ReadData<int16_t>(byteOffset);
+}
+
+inline int32_t DataView::GetInt32(size_t byteOffset) const {
+  return ReadData<int32_t>(byteOffset);
+}
+
+inline uint8_t DataView::GetUint8(size_t byteOffset) const {
+  return ReadData<uint8_t>(byteOffset);
+}
+
+inline uint16_t DataView::GetUint16(size_t byteOffset) const {
+  return ReadData<uint16_t>(byteOffset);
+}
+
+inline uint32_t DataView::GetUint32(size_t byteOffset) const {
+  return ReadData<uint32_t>(byteOffset);
+}
+
+inline void DataView::SetFloat32(size_t byteOffset, float value) const {
+  WriteData<float>(byteOffset, value);
+}
+
+inline void DataView::SetFloat64(size_t byteOffset, double value) const {
+  WriteData<double>(byteOffset, value);
+}
+
+inline void DataView::SetInt8(size_t byteOffset, int8_t value) const {
+  WriteData<int8_t>(byteOffset, value);
+}
+
+inline void DataView::SetInt16(size_t byteOffset, int16_t value) const {
+  WriteData<int16_t>(byteOffset, value);
+}
+
+inline void DataView::SetInt32(size_t byteOffset, int32_t value) const {
+  WriteData<int32_t>(byteOffset, value);
+}
+
+inline void DataView::SetUint8(size_t byteOffset, uint8_t value) const {
+  WriteData<uint8_t>(byteOffset, value);
+}
+
+inline void DataView::SetUint16(size_t byteOffset, uint16_t value) const {
+  WriteData<uint16_t>(byteOffset, value);
+}
+
+inline void DataView::SetUint32(size_t byteOffset, uint32_t value) const {
+  WriteData<uint32_t>(byteOffset, value);
+}
+
+template <typename T>
+inline T DataView::ReadData(size_t byteOffset) const {
+  if (byteOffset + sizeof(T) > _length ||
+      byteOffset + sizeof(T) < byteOffset) {  // overflow
+    NAPI_THROW(
+        RangeError::New(_env, "Offset is outside the bounds of the DataView"),
+        0);
+  }
+
+  return *reinterpret_cast<T*>(static_cast<uint8_t*>(_data) + byteOffset);
+}
+
+template <typename T>
+inline void DataView::WriteData(size_t byteOffset, T value) const {
+  if (byteOffset + sizeof(T) > _length ||
+      byteOffset + sizeof(T) < byteOffset) {  // overflow
+    NAPI_THROW_VOID(
+        RangeError::New(_env, "Offset is outside the bounds of the DataView"));
+  }
+
+  *reinterpret_cast<T*>(static_cast<uint8_t*>(_data) + byteOffset) = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// TypedArray class
+////////////////////////////////////////////////////////////////////////////////
+inline void TypedArray::CheckCast(napi_env env, napi_value value) {
+  NAPI_CHECK(value != nullptr, "TypedArray::CheckCast", "empty value");
+
+  bool result;
+  napi_status status = napi_is_typedarray(env, value, &result);
+  NAPI_CHECK(
+      status == napi_ok, "TypedArray::CheckCast", "napi_is_typedarray failed");
+  NAPI_CHECK(result, "TypedArray::CheckCast", "value is not typedarray");
+}
+
+inline TypedArray::TypedArray()
+    : Object(), _type(napi_typedarray_type::napi_int8_array), _length(0) {}
+
+inline TypedArray::TypedArray(napi_env env, napi_value value)
+    : Object(env, value),
+      _type(napi_typedarray_type::napi_int8_array),
+      _length(0) {
+  if (value != nullptr) {
+    napi_status status =
+        napi_get_typedarray_info(_env,
+                                 _value,
+                                 &const_cast<TypedArray*>(this)->_type,
+                                 &const_cast<TypedArray*>(this)->_length,
+                                 nullptr,
+                                 nullptr,
+                                 nullptr);
+    NAPI_THROW_IF_FAILED_VOID(_env, status);
+  }
+}
+
+inline TypedArray::TypedArray(napi_env env,
+                              napi_value value,
+                              napi_typedarray_type type,
+                              size_t length)
+    : Object(env, value), _type(type), _length(length) {}
+
+inline napi_typedarray_type TypedArray::TypedArrayType() const {
+  return _type;
+}
+
+namespace details {
+
+inline uint8_t TypedArrayElementSize(napi_typedarray_type type) {
+  switch (type) {
+    case napi_int8_array:
+    case napi_uint8_array:
+    case napi_uint8_clamped_array:
+      return 1;
     case napi_int16_array:
     case napi_uint16_array:
       return 2;
@@ -2227,6 +3791,12 @@ inline uint8_t TypedArray::ElementSize() const {
   }
 }
 
+}  // namespace details
+
+inline uint8_t TypedArray::ElementSize() const {
+  return details::TypedArrayElementSize(_type);
+}
+
 inline size_t TypedArray::ElementLength() const {
   return _length;
 }
@@ -2376,6 +3946,38 @@ inline napi_status CreateFunction(napi_env env,
   return status;
 }
 
+namespace details {
+
+template <typename Return, typename Callable>
+inline napi_status CreateCallableFunction(napi_env env,
+                                          const char* utf8name,
+                                          Callable& cb,
+                                          void* data,
+                                          napi_value* result) {
+  napi_callback callback;
+  void* callbackData;
+  auto allocated =
+      PrepareCallable<Return>(cb,
+                              data,
+                              &callback,
+                              &callbackData,
+                              CallableStorageOf<Callable, Return>());
+
+  napi_status status = napi_create_function(
+      env, utf8name, NAPI_AUTO_LENGTH, callback, callbackData, result);
+  if (allocated != nullptr) {
+    if (status == napi_ok) {
+      status = AttachData(env, *result, allocated);
+    }
+    if (status != napi_ok) {
+      delete allocated;
+    }
+  }
+  return status;
+}
+
+}  // namespace details
+
 template <Function::VoidCallback cb>
 inline Function Function::New(napi_env env, const char* utf8name, void* data) {
   napi_value result = nullptr;
@@ -2422,16 +4024,11 @@ inline Function Function::New(napi_env env,
                               const char* utf8name,
                               void* data) {
   using ReturnType = decltype(cb(CallbackInfo(nullptr, nullptr)));
-  using CbData = details::CallbackData<Callable, ReturnType>;
-  auto callbackData = new CbData{std::move(cb), data};
 
   napi_value value;
-  napi_status status =
-      CreateFunction(env, utf8name, CbData::Wrapper, callbackData, &value);
-  if (status != napi_ok) {
-    delete callbackData;
-    NAPI_THROW_IF_FAILED(env, status, Function());
-  }
+  napi_status status = details::CreateCallableFunction<ReturnType>(
+      env, utf8name, cb, data, &value);
+  NAPI_THROW_IF_FAILED(env, status, Function());
 
   return Function(env, value);
 }
@@ -2526,6 +4123,51 @@ inline MaybeOrValue<Value> Function::Call(napi_value recv,
       _env, status, Napi::Value(_env, result), Napi::Value);
 }
 
+namespace details {
+// Checks for arguments whose conversion failed with a pending exception.
+inline bool HasEmptyArgument(const napi_value* args, size_t argc) {
+  for (size_t index = 0; index < argc; index++) {
+    if (args[index] == nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Converts `args` with `Value::From()` and passes them to `call` as an
+// argument count and array. If a conversion failed with a pending exception,
+// returns an empty result without calling `call`.
+template <typename Call, typename... Args>
+inline MaybeOrValue<Value> CallWithArgs(napi_env env,
+                                        Call call,
+                                        const Args&... args) {
+  (void)env;  // Unused when there are no arguments.
+  // The trailing element keeps the array non-empty when there are no args.
+  napi_value argv[] = {Value::From(env, args)..., nullptr};
+#ifndef NAPI_CPP_EXCEPTIONS
+  if (HasEmptyArgument(argv, sizeof...(Args))) {
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+    return Nothing<Value>();
+#else
+    return Value();
+#endif
+  }
+#endif  // NAPI_CPP_EXCEPTIONS
+  return call(sizeof...(Args), static_cast<const napi_value*>(argv));
+}
+}  // namespace details
+
+template <typename... Args, typename>
+inline MaybeOrValue<Value> Function::Call(napi_value recv,
+                                          const Args&... args) const {
+  return details::CallWithArgs(
+      _env,
+      [&](size_t argc, const napi_value* argv) {
+        return Call(recv, argc, argv);
+      },
+      args...);
+}
+
 inline MaybeOrValue<Value> Function::MakeCallback(
     napi_value recv,
     const std::initializer_list<napi_value>& args,
@@ -2552,6 +4194,18 @@ inline MaybeOrValue<Value> Function::MakeCallback(
       _env, status, Napi::Value(_env, result), Napi::Value);
 }
 
+template <typename... Args, typename>
+inline MaybeOrValue<Value> Function::MakeCallback(napi_value recv,
+                                                  napi_async_context context,
+                                                  const Args&... args) const {
+  return details::CallWithArgs(
+      _env,
+      [&](size_t argc, const napi_value* argv) {
+        return MakeCallback(recv, argc, argv, context);
+      },
+      args...);
+}
+
 inline MaybeOrValue<Object> Function::New(
     const std::initializer_list<napi_value>& args) const {
   return New(args.size(), args.begin());
@@ -2684,6 +4338,39 @@ inline Buffer<T> Buffer<T>::New(napi_env env,
   }
   return Buffer(env, value, length, data);
 }
+
+template <typename T>
+template <void (*Finalizer)(Napi::Env, T*)>
+inline Buffer<T> Buffer<T>::New(napi_env env, T* data, size_t length) {
+  napi_value value;
+  napi_status status =
+      napi_create_external_buffer(env,
+                                  length * sizeof(T),
+                                  data,
+                                  details::TemplatedFinalizer<T, Finalizer>,
+                                  nullptr,
+                                  &value);
+  NAPI_THROW_IF_FAILED(env, status, Buffer());
+  return Buffer(env, value, length, data);
+}
+
+template <typename T>
+template <typename Hint, void (*Finalizer)(Napi::Env, T*, Hint*)>
+inline Buffer<T> Buffer<T>::New(napi_env env,
+                                T* data,
+                                size_t length,
+                                Hint* finalizeHint) {
+  napi_value value;
+  napi_status status = napi_create_external_buffer(
+      env,
+      length * sizeof(T),
+      data,
+      details::TemplatedFinalizerWithHint<T, Hint, Finalizer>,
+      finalizeHint,
+      &value);
+  NAPI_THROW_IF_FAILED(env, status, Buffer());
+  return Buffer(env, value, length, data);
+}
 #endif  // NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
 
 template <typename T>
@@ -2773,6 +4460,60 @@ inline Buffer<T> Buffer<T>::NewOrCopy(napi_env env,
 #endif
 }
 
+template <typename T>
+template <void (*Finalizer)(Napi::Env, T*)>
+inline Buffer<T> Buffer<T>::NewOrCopy(napi_env env, T* data, size_t length) {
+#ifndef NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+  napi_value value;
+  napi_status status =
+      napi_create_external_buffer(env,
+                                  length * sizeof(T),
+                                  data,
+                                  details::TemplatedFinalizer<T, Finalizer>,
+                                  nullptr,
+                                  &value);
+  if (status == details::napi_no_external_buffers_allowed) {
+#endif  // NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+    // If we can't create an external buffer, we'll just copy the data.
+    Buffer<T> ret = Buffer<T>::Copy(env, data, length);
+    details::TemplatedFinalizer<T, Finalizer>(env, data, nullptr);
+    return ret;
+#ifndef NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+  }
+  NAPI_THROW_IF_FAILED(env, status, Buffer());
+  return Buffer(env, value, length, data);
+#endif  // NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+}
+
+template <typename T>
+template <typename Hint, void (*Finalizer)(Napi::Env, T*, Hint*)>
+inline Buffer<T> Buffer<T>::NewOrCopy(napi_env env,
+                                      T* data,
+                                      size_t length,
+                                      Hint* finalizeHint) {
+#ifndef NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+  napi_value value;
+  napi_status status = napi_create_external_buffer(
+      env,
+      length * sizeof(T),
+      data,
+      details::TemplatedFinalizerWithHint<T, Hint, Finalizer>,
+      finalizeHint,
+      &value);
+  if (status == details::napi_no_external_buffers_allowed) {
+#endif  // NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+    // If we can't create an external buffer, we'll just copy the data.
+    Buffer<T> ret = Buffer<T>::Copy(env, data, length);
+    details::TemplatedFinalizerWithHint<T, Hint, Finalizer>(
+        env, data, finalizeHint);
+    return ret;
+#ifndef NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+  }
+  NAPI_THROW_IF_FAILED(env, status, Buffer());
+  return Buffer(env, value, length, data);
+#endif  // NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+}
+
 template <typename T>
 inline Buffer<T> Buffer<T>::Copy(napi_env env, const T* data, size_t length) {
   napi_value value;
@@ -2831,3647 +4572,3369 @@ inline void Buffer<T>::EnsureInfo() const {
   }
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Error class
-////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+// Convert<T> traits
+////////////////////////////////////////////////////////////////////////////////
+
+namespace details {
+
+inline bool ConvertTypeError(napi_env env, const char* message) {
+  NAPI_THROW(TypeError::New(env, message), false);
+}
+
+inline bool ConvertRangeError(napi_env env, const char* message) {
+  NAPI_THROW(RangeError::New(env, message), false);
+}
+
+// Typed-array type holding the same bits as a C++ element type, if any.
+template <typename T, typename Enable = void>
+struct convert_typed_array : std::false_type {};
+
+template <typename T>
+struct convert_typed_array<
+    T,
+    typename std::enable_if<std::is_integral<T>::value &&
+                            !std::is_same<T, bool>::value &&
+                            (sizeof(T) <= 4 || (NAPI_VERSION > 5 &&
+                                                sizeof(T) == 8))>::type>
+    : std::true_type {
+  static const napi_typedarray_type array_type =
+      sizeof(T) == 1   ? (std::is_signed<T>::value ? napi_int8_array
+                                                   : napi_uint8_array)
+      : sizeof(T) == 2 ? (std::is_signed<T>::value ? napi_int16_array
+                                                   : napi_uint16_array)
+      : sizeof(T) == 4 ? (std::is_signed<T>::value ? napi_int32_array
+                                                   : napi_uint32_array)
+#if NAPI_VERSION > 5
+      : std::is_signed<T>::value ? napi_bigint64_array
+                                 : napi_biguint64_array;
+#else
+                       : napi_int8_array;
+#endif  // NAPI_VERSION > 5
+};
+
+template <typename T>
+struct convert_typed_array<
+    T,
+    typename std::enable_if<std::is_same<T, float>::value ||
+                            std::is_same<T, double>::value>::type>
+    : std::true_type {
+  static const napi_typedarray_type array_type =
+      sizeof(T) == 4 ? napi_float32_array : napi_float64_array;
+};
+
+// Whether a typed-array of `type` holds elements of `T`. A Uint8ClampedArray
+// holds `uint8_t` just like a Uint8Array.
+template <typename T>
+inline bool ConvertTypedArrayMatches(napi_typedarray_type type) {
+  return type == convert_typed_array<T>::array_type ||
+         (type == napi_uint8_clamped_array && std::is_same<T, uint8_t>::value);
+}
+
+// Non-fatal counterparts of the CheckCast() of each Value subclass. Overload
+// resolution on the pointer type picks the check of the most derived class
+// that has one, so subclasses defined outside this header are covered too.
+inline bool ConvertIsValue(const Value& value, const Value* /*type*/) {
+  return !value.IsEmpty();
+}
+
+inline bool ConvertIsValue(const Value& value, const Boolean* /*type*/) {
+  return value.IsBoolean();
+}
+
+inline bool ConvertIsValue(const Value& value, const Number* /*type*/) {
+  return value.IsNumber();
+}
+
+#if NAPI_VERSION > 5
+inline bool ConvertIsValue(const Value& value, const BigInt* /*type*/) {
+  return value.IsBigInt();
+}
+#endif  // NAPI_VERSION > 5
+
+#if (NAPI_VERSION > 4)
+inline bool ConvertIsValue(const Value& value, const Date* /*type*/) {
+  return value.IsDate();
+}
+#endif
+
+inline bool ConvertIsValue(const Value& value, const Name* /*type*/) {
+  return value.IsString() || value.IsSymbol();
+}
+
+inline bool ConvertIsValue(const Value& value, const String* /*type*/) {
+  return value.IsString();
+}
+
+inline bool ConvertIsValue(const Value& value, const Symbol* /*type*/) {
+  return value.IsSymbol();
+}
+
+inline bool ConvertIsValue(const Value& value, const TypeTaggable* /*type*/) {
+  return value.IsObject() || value.IsExternal();
+}
+
+inline bool ConvertIsValue(const Value& value, const Object* /*type*/) {
+  return value.IsObject();
+}
+
+template <typename T>
+inline bool ConvertIsValue(const Value& value, const External<T>* /*type*/) {
+  return value.IsExternal();
+}
+
+inline bool ConvertIsValue(const Value& value, const Array* /*type*/) {
+  return value.IsArray();
+}
+
+#if NAPI_VERSION > 2
+inline bool ConvertIsInstance(const Value& value, napi_value constructor) {
+  bool result;
+  return value.IsObject() && constructor != nullptr &&
+         napi_instanceof(value.Env(), value, constructor, &result) ==
+             napi_ok &&
+         result;
+}
+
+inline bool ConvertIsValue(const Value& value, const Map* /*type*/) {
+  return value.IsObject() &&
+         ConvertIsInstance(value, Builtins::MapConstructor(value.Env()));
+}
+
+inline bool ConvertIsValue(const Value& value, const Set* /*type*/) {
+  return value.IsObject() &&
+         ConvertIsInstance(value, Builtins::SetConstructor(value.Env()));
+}
+#endif  // NAPI_VERSION > 2
+
+inline bool ConvertIsValue(const Value& value, const ArrayBuffer* /*type*/) {
+  return value.IsArrayBuffer();
+}
+
+inline bool ConvertIsValue(const Value& value, const TypedArray* /*type*/) {
+  return value.IsTypedArray();
+}
+
+template <typename T>
+inline bool ConvertIsValue(const Value& value,
+                           const TypedArrayOf<T>* /*type*/) {
+  if (!value.IsTypedArray()) {
+    return false;
+  }
+  return ConvertTypedArrayMatches<T>(
+      TypedArray(value.Env(), value).TypedArrayType());
+}
+
+inline bool ConvertIsValue(const Value& value, const DataView* /*type*/) {
+  return value.IsDataView();
+}
+
+inline bool ConvertIsValue(const Value& value, const Function* /*type*/) {
+  return value.IsFunction();
+}
+
+inline bool ConvertIsValue(const Value& value, const Promise* /*type*/) {
+  return value.IsPromise();
+}
+
+template <typename T>
+inline bool ConvertIsValue(const Value& value, const Buffer<T>* /*type*/) {
+  return value.IsBuffer();
+}
+
+template <typename T, typename Alloc>
+inline bool ConvertResize(std::vector<T, Alloc>* result, size_t length) {
+  result->resize(length);
+  return true;
+}
 
-inline Error Error::New(napi_env env) {
-  napi_status status;
-  napi_value error = nullptr;
-  bool is_exception_pending;
-  napi_extended_error_info last_error_info_copy;
+template <typename T, size_t N>
+inline bool ConvertResize(std::array<T, N>* /*result*/, size_t length) {
+  return length == N;
+}
 
-  {
-    // We must retrieve the last error info before doing anything else because
-    // doing anything else will replace the last error info.
-    const napi_extended_error_info* last_error_info;
-    status = napi_get_last_error_info(env, &last_error_info);
-    NAPI_FATAL_IF_FAILED(status, "Error::New", "napi_get_last_error_info");
+template <typename T, typename Container>
+inline Value SequenceToJS(napi_env env,
+                          const Container& value,
+                          std::true_type /*typed*/) {
+  size_t byte_length = value.size() * sizeof(T);
+  void* data;
+  napi_value buffer;
+  napi_status status =
+      napi_create_arraybuffer(env, byte_length, &data, &buffer);
+  NAPI_THROW_IF_FAILED(env, status, Value());
+  if (byte_length != 0) {
+    std::memcpy(data, value.data(), byte_length);
+  }
 
-    // All fields of the `napi_extended_error_info` structure gets reset in
-    // subsequent Node-API function calls on the same `env`. This includes a
-    // call to `napi_is_exception_pending()`. So here it is necessary to make a
-    // copy of the information as the `error_code` field is used later on.
-    memcpy(&last_error_info_copy,
-           last_error_info,
-           sizeof(napi_extended_error_info));
+  napi_value result;
+  status = napi_create_typedarray(env,
+                                  convert_typed_array<T>::array_type,
+                                  value.size(),
+                                  buffer,
+                                  0,
+                                  &result);
+  NAPI_THROW_IF_FAILED(env, status, Value());
+  return Value(env, result);
+}
+
+template <typename T, typename Container>
+inline Value SequenceToJS(napi_env env,
+                          const Container& value,
+                          std::false_type /*typed*/) {
+  napi_value result;
+  napi_status status =
+      napi_create_array_with_length(env, value.size(), &result);
+  NAPI_THROW_IF_FAILED(env, status, Value());
+
+  uint32_t index = 0;
+  for (const auto& item : value) {
+    Value element = Convert<T>::ToJS(env, item);
+    if (element.IsEmpty()) {
+      return Value();
+    }
+    status = napi_set_element(env, result, index++, element);
+    NAPI_THROW_IF_FAILED(env, status, Value());
+  }
+  return Value(env, result);
+}
+
+// Copies a typed-array of the element type's own type into `result`. Sets
+// `handled` to false if `value` is not such a typed-array.
+template <typename T, typename Container>
+inline bool TypedArrayFromJS(napi_env env,
+                             napi_value value,
+                             Container* result,
+                             bool* handled,
+                             std::true_type /*typed*/) {
+  bool is_typedarray;
+  napi_status status = napi_is_typedarray(env, value, &is_typedarray);
+  NAPI_THROW_IF_FAILED(env, status, false);
+  if (!is_typedarray) {
+    *handled = false;
+    return true;
   }
 
-  status = napi_is_exception_pending(env, &is_exception_pending);
-  NAPI_FATAL_IF_FAILED(status, "Error::New", "napi_is_exception_pending");
+  napi_typedarray_type type;
+  size_t length;
+  void* data;
+  status = napi_get_typedarray_info(
+      env, value, &type, &length, &data, nullptr, nullptr);
+  NAPI_THROW_IF_FAILED(env, status, false);
+  if (!ConvertTypedArrayMatches<T>(type)) {
+    *handled = false;
+    return true;
+  }
 
-  // A pending exception takes precedence over any internal error status.
-  if (is_exception_pending) {
-    status = napi_get_and_clear_last_exception(env, &error);
-    NAPI_FATAL_IF_FAILED(
-        status, "Error::New", "napi_get_and_clear_last_exception");
-  } else {
-    const char* error_message = last_error_info_copy.error_message != nullptr
-                                    ? last_error_info_copy.error_message
-                                    : "Error in native callback";
+  *handled = true;
+  if (!ConvertResize(result, length)) {
+    return ConvertTypeError(env, "Typed array length does not match.");
+  }
+  if (length != 0) {
+    std::memcpy(result->data(), data, length * sizeof(T));
+  }
+  return true;
+}
 
-    napi_value message;
-    status = napi_create_string_utf8(
-        env, error_message, std::strlen(error_message), &message);
-    NAPI_FATAL_IF_FAILED(status, "Error::New", "napi_create_string_utf8");
+template <typename T, typename Container>
+inline bool TypedArrayFromJS(napi_env /*env*/,
+                             napi_value /*value*/,
+                             Container* /*result*/,
+                             bool* handled,
+                             std::false_type /*typed*/) {
+  *handled = false;
+  return true;
+}
 
-    switch (last_error_info_copy.error_code) {
-      case napi_object_expected:
-      case napi_string_expected:
-      case napi_boolean_expected:
-      case napi_number_expected:
-        status = napi_create_type_error(env, nullptr, message, &error);
-        break;
-      default:
-        status = napi_create_error(env, nullptr, message, &error);
-        break;
-    }
-    NAPI_FATAL_IF_FAILED(status, "Error::New", "napi_create_error");
+template <typename T, typename Container>
+inline bool SequenceFromJS(const Value& value, Container* result) {
+  napi_env env = value.Env();
+  bool handled;
+  if (!TypedArrayFromJS<T>(
+          env, value, result, &handled, convert_typed_array<T>())) {
+    return false;
+  }
+  if (handled) {
+    return true;
   }
 
-  return Error(env, error);
+  bool is_array;
+  napi_status status = napi_is_array(env, value, &is_array);
+  NAPI_THROW_IF_FAILED(env, status, false);
+  if (!is_array) {
+    return ConvertTypeError(env, "An array was expected.");
+  }
+
+  uint32_t length;
+  status = napi_get_array_length(env, value, &length);
+  NAPI_THROW_IF_FAILED(env, status, false);
+  if (!ConvertResize(result, length)) {
+    return ConvertTypeError(env, "Array length does not match.");
+  }
+
+  for (uint32_t i = 0; i < length; i++) {
+    napi_value element;
+    status = napi_get_element(env, value, i, &element);
+    NAPI_THROW_IF_FAILED(env, status, false);
+    T item{};
+    if (!Convert<T>::FromJS(Value(env, element), &item)) {
+      return false;
+    }
+    (*result)[i] = std::move(item);
+  }
+  return true;
 }
 
-inline Error Error::New(napi_env env, const char* message) {
-  return Error::New<Error>(
-      env, message, std::strlen(message), napi_create_error);
+template <typename T>
+inline bool SequenceAccepts(const Value& value, std::true_type /*typed*/) {
+  return value.IsArray() ||
+         (value.IsTypedArray() && ConvertTypedArrayMatches<T>(
+                                      value.As<TypedArray>().TypedArrayType()));
 }
 
-inline Error Error::New(napi_env env, const std::string& message) {
-  return Error::New<Error>(
-      env, message.c_str(), message.size(), napi_create_error);
+template <typename T>
+inline bool SequenceAccepts(const Value& value, std::false_type /*typed*/) {
+  return value.IsArray();
 }
 
-inline NAPI_NO_RETURN void Error::Fatal(const char* location,
-                                        const char* message) {
-  napi_fatal_error(location, NAPI_AUTO_LENGTH, message, NAPI_AUTO_LENGTH);
+inline bool ConvertPropertyName(napi_env /*env*/,
+                                const std::string& key,
+                                napi_property_descriptor* descriptor) {
+  descriptor->utf8name = key.c_str();
+  return true;
 }
 
-inline Error::Error() : ObjectReference() {}
+template <typename K>
+inline bool ConvertPropertyName(napi_env env,
+                                const K& key,
+                                napi_property_descriptor* descriptor) {
+  Value name = Convert<K>::ToJS(env, key);
+  if (name.IsEmpty()) {
+    return false;
+  }
+  if (name.IsString() || name.IsSymbol()) {
+    descriptor->name = name;
+    return true;
+  }
+  napi_status status = napi_coerce_to_string(env, name, &descriptor->name);
+  NAPI_THROW_IF_FAILED(env, status, false);
+  return true;
+}
 
-inline Error::Error(napi_env env, napi_value value)
-    : ObjectReference(env, nullptr) {
-  if (value != nullptr) {
-    // Attempting to create a reference on the error object.
-    // If it's not a Object/Function/Symbol, this call will return an error
-    // status.
-    napi_status status = napi_create_reference(env, value, 1, &_ref);
+// Property names come back as strings, so numeric keys are coerced first.
+template <typename K>
+inline bool ConvertKeyFromJS(const Value& key,
+                             K* result,
+                             std::true_type /*numeric*/) {
+  napi_value number;
+  napi_status status = napi_coerce_to_number(key.Env(), key, &number);
+  NAPI_THROW_IF_FAILED(key.Env(), status, false);
+  return Convert<K>::FromJS(Value(key.Env(), number), result);
+}
 
-    if (status != napi_ok) {
-      napi_value wrappedErrorObj;
+template <typename K>
+inline bool ConvertKeyFromJS(const Value& key,
+                             K* result,
+                             std::false_type /*numeric*/) {
+  return Convert<K>::FromJS(key, result);
+}
 
-      // Create an error object
-      status = napi_create_object(env, &wrappedErrorObj);
-      NAPI_FATAL_IF_FAILED(status, "Error::Error", "napi_create_object");
+template <typename K, typename V, typename Map>
+inline Value MapToJS(napi_env env, const Map& value) {
+  napi_value result;
+  napi_status status = napi_create_object(env, &result);
+  NAPI_THROW_IF_FAILED(env, status, Value());
+
+  std::vector<napi_property_descriptor> descriptors;
+  descriptors.reserve(value.size());
+  for (const auto& entry : value) {
+    napi_property_descriptor descriptor = {};
+    if (!ConvertPropertyName(env, entry.first, &descriptor)) {
+      return Value();
+    }
+    Value item = Convert<V>::ToJS(env, entry.second);
+    if (item.IsEmpty()) {
+      return Value();
+    }
+    descriptor.value = item;
+    descriptor.attributes = static_cast<napi_property_attributes>(
+        napi_writable | napi_enumerable | napi_configurable);
+    descriptors.push_back(descriptor);
+  }
 
-      // property flag that we attach to show the error object is wrapped
-      napi_property_descriptor wrapObjFlag = {
-          ERROR_WRAP_VALUE(),  // Unique GUID identifier since Symbol isn't a
-                               // viable option
-          nullptr,
-          nullptr,
-          nullptr,
-          nullptr,
-          Value::From(env, value),
-          napi_enumerable,
-          nullptr};
+  status = napi_define_properties(
+      env, result, descriptors.size(), descriptors.data());
+  NAPI_THROW_IF_FAILED(env, status, Value());
+  return Value(env, result);
+}
 
-      status = napi_define_properties(env, wrappedErrorObj, 1, &wrapObjFlag);
-#ifdef NODE_API_SWALLOW_UNTHROWABLE_EXCEPTIONS
-      if (status == napi_pending_exception) {
-        // Test if the pending exception was reported because the environment is
-        // shutting down. We assume that a status of napi_pending_exception
-        // coupled with the absence of an actual pending exception means that
-        // the environment is shutting down. If so, we replace the
-        // napi_pending_exception status with napi_ok.
-        bool is_exception_pending = false;
-        status = napi_is_exception_pending(env, &is_exception_pending);
-        if (status == napi_ok && !is_exception_pending) {
-          status = napi_ok;
-        } else {
-          status = napi_pending_exception;
-        }
-      }
-#endif  // NODE_API_SWALLOW_UNTHROWABLE_EXCEPTIONS
-      NAPI_FATAL_IF_FAILED(status, "Error::Error", "napi_define_properties");
+template <typename K, typename V, typename Map>
+inline bool MapFromJS(const Value& value, Map* result) {
+  napi_env env = value.Env();
+  if (!value.IsObject()) {
+    return ConvertTypeError(env, "An object was expected.");
+  }
 
-      // Create a reference on the newly wrapped object
-      status = napi_create_reference(env, wrappedErrorObj, 1, &_ref);
+  napi_value keys;
+#if NAPI_VERSION > 5
+  napi_status status = napi_get_all_property_names(
+      env,
+      value,
+      napi_key_own_only,
+      static_cast<napi_key_filter>(napi_key_enumerable | napi_key_skip_symbols),
+      napi_key_numbers_to_strings,
+      &keys);
+#else
+  napi_status status = napi_get_property_names(env, value, &keys);
+#endif  // NAPI_VERSION > 5
+  NAPI_THROW_IF_FAILED(env, status, false);
+
+  uint32_t length;
+  status = napi_get_array_length(env, keys, &length);
+  NAPI_THROW_IF_FAILED(env, status, false);
+
+  result->clear();
+  for (uint32_t i = 0; i < length; i++) {
+    napi_value key;
+    status = napi_get_element(env, keys, i, &key);
+    NAPI_THROW_IF_FAILED(env, status, false);
+    napi_value item;
+    status = napi_get_property(env, value, key, &item);
+    NAPI_THROW_IF_FAILED(env, status, false);
+
+    K k{};
+    V v{};
+    if (!ConvertKeyFromJS(
+            Value(env, key),
+            &k,
+            std::integral_constant<bool,
+                                   is_convert_number<K>::value ||
+                                       std::is_enum<K>::value>()) ||
+        !Convert<V>::FromJS(Value(env, item), &v)) {
+      return false;
     }
-
-    // Avoid infinite recursion in the failure case.
-    NAPI_FATAL_IF_FAILED(status, "Error::Error", "napi_create_reference");
+    result->emplace(std::move(k), std::move(v));
   }
+  return true;
 }
 
-inline Object Error::Value() const {
-  if (_ref == nullptr) {
-    return Object(_env, nullptr);
+template <size_t I, size_t N>
+struct TupleConvert {
+  template <typename Tuple>
+  static bool ToJS(napi_env env, const Tuple& value, napi_value result) {
+    using Element = typename std::tuple_element<I, Tuple>::type;
+    Value element = Convert<Element>::ToJS(env, std::get<I>(value));
+    if (element.IsEmpty()) {
+      return false;
+    }
+    napi_status status = napi_set_element(env, result, I, element);
+    NAPI_THROW_IF_FAILED(env, status, false);
+    return TupleConvert<I + 1, N>::ToJS(env, value, result);
+  }
+
+  template <typename Tuple>
+  static bool FromJS(napi_env env, napi_value value, Tuple* result) {
+    using Element = typename std::tuple_element<I, Tuple>::type;
+    napi_value element;
+    napi_status status = napi_get_element(env, value, I, &element);
+    NAPI_THROW_IF_FAILED(env, status, false);
+    if (!Convert<Element>::FromJS(Value(env, element),
+                                  &std::get<I>(*result))) {
+      return false;
+    }
+    return TupleConvert<I + 1, N>::FromJS(env, value, result);
   }
+};
 
-  napi_value refValue;
-  napi_status status = napi_get_reference_value(_env, _ref, &refValue);
-  NAPI_THROW_IF_FAILED(_env, status, Object());
-
-  napi_valuetype type;
-  status = napi_typeof(_env, refValue, &type);
-  NAPI_THROW_IF_FAILED(_env, status, Object());
-
-  // If refValue isn't a symbol, then we proceed to whether the refValue has the
-  // wrapped error flag
-  if (type != napi_symbol) {
-    // We are checking if the object is wrapped
-    bool isWrappedObject = false;
-
-    status = napi_has_property(_env,
-                               refValue,
-                               String::From(_env, ERROR_WRAP_VALUE()),
-                               &isWrappedObject);
-
-    // Don't care about status
-    if (isWrappedObject) {
-      napi_value unwrappedValue;
-      status = napi_get_property(_env,
-                                 refValue,
-                                 String::From(_env, ERROR_WRAP_VALUE()),
-                                 &unwrappedValue);
-      NAPI_THROW_IF_FAILED(_env, status, Object());
+template <size_t N>
+struct TupleConvert<N, N> {
+  template <typename Tuple>
+  static bool ToJS(napi_env, const Tuple&, napi_value) {
+    return true;
+  }
 
-      return Object(_env, unwrappedValue);
-    }
+  template <typename Tuple>
+  static bool FromJS(napi_env, napi_value, Tuple*) {
+    return true;
   }
+};
 
-  return Object(_env, refValue);
+template <typename Tuple>
+inline Value TupleToJS(napi_env env, const Tuple& value) {
+  const size_t size = std::tuple_size<Tuple>::value;
+  napi_value result;
+  napi_status status = napi_create_array_with_length(env, size, &result);
+  NAPI_THROW_IF_FAILED(env, status, Value());
+  if (!TupleConvert<0, size>::ToJS(env, value, result)) {
+    return Value();
+  }
+  return Value(env, result);
 }
 
-inline Error::Error(Error&& other) : ObjectReference(std::move(other)) {}
-
-inline Error& Error::operator=(Error&& other) {
-  static_cast<Reference<Object>*>(this)->operator=(std::move(other));
-  return *this;
+template <typename Tuple>
+inline bool TupleFromJS(const Value& value, Tuple* result) {
+  const size_t size = std::tuple_size<Tuple>::value;
+  napi_env env = value.Env();
+  if (!value.IsArray()) {
+    return ConvertTypeError(env, "An array was expected.");
+  }
+  uint32_t length;
+  napi_status status = napi_get_array_length(env, value, &length);
+  NAPI_THROW_IF_FAILED(env, status, false);
+  if (length != size) {
+    return ConvertTypeError(env, "Array length does not match.");
+  }
+  return TupleConvert<0, size>::FromJS(env, value, result);
 }
 
-inline Error::Error(const Error& other) : ObjectReference(other) {}
+template <typename T>
+inline bool ConvertNumber(const Value& value,
+                          T* result,
+                          std::false_type /*integral*/) {
+  double number;
+  napi_status status = napi_get_value_double(value.Env(), value, &number);
+  if (status == napi_number_expected) {
+    return ConvertTypeError(value.Env(), "A number was expected.");
+  }
+  NAPI_THROW_IF_FAILED(value.Env(), status, false);
+  *result = static_cast<T>(number);
+  return true;
+}
 
-inline Error& Error::operator=(const Error& other) {
-  Reset();
+#if NAPI_VERSION > 5
+// 64-bit integers are also accepted as BigInts, as they are read from a
+// BigInt64Array or BigUint64Array.
+template <typename T>
+inline bool ConvertBigInt64(const Value& value, T* result) {
+  napi_status status;
+  bool lossless;
+  if (std::is_signed<T>::value) {
+    int64_t number;
+    status = napi_get_value_bigint_int64(
+        value.Env(), value, &number, &lossless);
+    *result = static_cast<T>(number);
+  } else {
+    uint64_t number;
+    status = napi_get_value_bigint_uint64(
+        value.Env(), value, &number, &lossless);
+    *result = static_cast<T>(number);
+  }
+  NAPI_THROW_IF_FAILED(value.Env(), status, false);
+  if (!lossless) {
+    return ConvertRangeError(value.Env(), "The BigInt is out of range.");
+  }
+  return true;
+}
+#endif  // NAPI_VERSION > 5
 
-  _env = other.Env();
-  HandleScope scope(_env);
+template <typename T>
+inline bool ConvertNumber(const Value& value,
+                          T* result,
+                          std::true_type /*integral*/) {
+  double number;
+  napi_status status = napi_get_value_double(value.Env(), value, &number);
+#if NAPI_VERSION > 5
+  if (status == napi_number_expected && sizeof(T) == sizeof(int64_t) &&
+      value.IsBigInt()) {
+    return ConvertBigInt64(value, result);
+  }
+#endif  // NAPI_VERSION > 5
+  if (status == napi_number_expected) {
+    return ConvertTypeError(value.Env(), "A number was expected.");
+  }
+  NAPI_THROW_IF_FAILED(value.Env(), status, false);
 
-  napi_value value = other.Value();
-  if (value != nullptr) {
-    napi_status status = napi_create_reference(_env, value, 1, &_ref);
-    NAPI_THROW_IF_FAILED(_env, status, *this);
+  // The bounds are powers of two, which a double represents exactly.
+  const double upper = std::ldexp(1.0, std::numeric_limits<T>::digits);
+  const double lower = std::is_signed<T>::value ? -upper : 0;
+  if (!std::isfinite(number) || std::trunc(number) != number) {
+    return ConvertRangeError(value.Env(), "An integer was expected.");
+  }
+  if (number < lower || number >= upper) {
+    return ConvertRangeError(value.Env(), "The number is out of range.");
   }
+  *result = static_cast<T>(number);
+  return true;
+}
 
-  return *this;
+inline bool ConvertMilliseconds(const Value& value, double* result) {
+  napi_status status = napi_get_value_double(value.Env(), value, result);
+  if (status == napi_number_expected) {
+    return ConvertTypeError(value.Env(), "A number was expected.");
+  }
+  NAPI_THROW_IF_FAILED(value.Env(), status, false);
+  return true;
 }
 
-inline const std::string& Error::Message() const NAPI_NOEXCEPT {
-  if (_message.size() == 0 && _env != nullptr) {
-#ifdef NAPI_CPP_EXCEPTIONS
-    try {
-      _message = Get("message").As<String>();
-    } catch (...) {
-      // Catch all errors here, to include e.g. a std::bad_alloc from
-      // the std::string::operator=, because this method may not throw.
-    }
-#else  // NAPI_CPP_EXCEPTIONS
-#if defined(NODE_ADDON_API_ENABLE_MAYBE)
-    Napi::Value message_val;
-    if (Get("message").UnwrapTo(&message_val)) {
-      _message = message_val.As<String>();
-    }
-#else
-    _message = Get("message").As<String>();
-#endif
-#endif  // NAPI_CPP_EXCEPTIONS
+#ifdef NAPI_HAS_CPP17
+template <typename T, typename Variant>
+inline bool VariantFromJS(const Value& value, Variant* result, bool* matched) {
+  if (*matched || !Convert<T>::Accepts(value)) {
+    return true;
+  }
+  *matched = true;
+  T alternative{};
+  if (!Convert<T>::FromJS(value, &alternative)) {
+    return false;
   }
-  return _message;
+  *result = std::move(alternative);
+  return true;
 }
+#endif  // NAPI_HAS_CPP17
 
-// we created an object on the &_ref
-inline void Error::ThrowAsJavaScriptException() const {
-  HandleScope scope(_env);
-  if (!IsEmpty()) {
-#ifdef NODE_API_SWALLOW_UNTHROWABLE_EXCEPTIONS
-    bool pendingException = false;
+}  // namespace details
 
-    // check if there is already a pending exception. If so don't try to throw a
-    // new one as that is not allowed/possible
-    napi_status status = napi_is_exception_pending(_env, &pendingException);
+inline Value Convert<bool>::ToJS(napi_env env, bool value) {
+  return Boolean::New(env, value);
+}
 
-    if ((status != napi_ok) ||
-        ((status == napi_ok) && (pendingException == false))) {
-      // We intentionally don't use `NAPI_THROW_*` macros here to ensure
-      // that there is no possible recursion as `ThrowAsJavaScriptException`
-      // is part of `NAPI_THROW_*` macro definition for noexcept.
+inline bool Convert<bool>::FromJS(const Value& value, bool* result) {
+  napi_status status = napi_get_value_bool(value.Env(), value, result);
+  if (status == napi_boolean_expected) {
+    return details::ConvertTypeError(value.Env(), "A boolean was expected.");
+  }
+  NAPI_THROW_IF_FAILED(value.Env(), status, false);
+  return true;
+}
 
-      status = napi_throw(_env, Value());
+inline bool Convert<bool>::Accepts(const Value& value) {
+  return value.IsBoolean();
+}
 
-      if (status == napi_pending_exception) {
-        // The environment must be terminating as we checked earlier and there
-        // was no pending exception. In this case continuing will result
-        // in a fatal error and there is nothing the author has done incorrectly
-        // in their code that is worth flagging through a fatal error
-        return;
-      }
-    } else {
-      status = napi_pending_exception;
-    }
-#else
-    // We intentionally don't use `NAPI_THROW_*` macros here to ensure
-    // that there is no possible recursion as `ThrowAsJavaScriptException`
-    // is part of `NAPI_THROW_*` macro definition for noexcept.
+template <typename T>
+inline Value Convert<
+    T,
+    typename std::enable_if<details::is_convert_number<T>::value>::type>::
+    ToJS(napi_env env, T value) {
+  return Number::New(env, static_cast<double>(value));
+}
 
-    napi_status status = napi_throw(_env, Value());
-#endif
+template <typename T>
+inline bool Convert<
+    T,
+    typename std::enable_if<details::is_convert_number<T>::value>::type>::
+    FromJS(const Value& value, T* result) {
+  return details::ConvertNumber(value, result, std::is_integral<T>());
+}
 
-#ifdef NAPI_CPP_EXCEPTIONS
-    if (status != napi_ok) {
-      throw Error::New(_env);
-    }
-#else   // NAPI_CPP_EXCEPTIONS
-    NAPI_FATAL_IF_FAILED(
-        status, "Error::ThrowAsJavaScriptException", "napi_throw");
-#endif  // NAPI_CPP_EXCEPTIONS
+template <typename T>
+inline bool Convert<
+    T,
+    typename std::enable_if<details::is_convert_number<T>::value>::type>::
+    Accepts(const Value& value) {
+#if NAPI_VERSION > 5
+  if (std::is_integral<T>::value && sizeof(T) == sizeof(int64_t) &&
+      value.IsBigInt()) {
+    return true;
   }
+#endif  // NAPI_VERSION > 5
+  return value.IsNumber();
 }
 
-#ifdef NAPI_CPP_EXCEPTIONS
+#if NAPI_VERSION > 5 && defined(NAPI_HAS_INT128)
+template <typename T>
+inline Value Convert<
+    T,
+    typename std::enable_if<details::is_int128<T>::value>::type>::
+    ToJS(napi_env env, T value) {
+  return BigInt::New(env, value);
+}
 
-inline const char* Error::what() const NAPI_NOEXCEPT {
-  return Message().c_str();
+template <typename T>
+inline bool Convert<
+    T,
+    typename std::enable_if<details::is_int128<T>::value>::type>::
+    FromJS(const Value& value, T* result) {
+  if (!value.IsBigInt()) {
+    return details::ConvertTypeError(value.Env(), "A BigInt was expected.");
+  }
+  BigInt bigint(value.Env(), value);
+  bool lossless = true;
+  if (std::is_same<T, int128_t>::value) {
+    *result = static_cast<T>(bigint.Int128Value(&lossless));
+  } else {
+    *result = static_cast<T>(bigint.Uint128Value(&lossless));
+  }
+  if (value.Env().IsExceptionPending()) {
+    return false;
+  }
+  if (!lossless) {
+    return details::ConvertRangeError(value.Env(),
+                                      "The BigInt is out of range.");
+  }
+  return true;
 }
 
-#endif  // NAPI_CPP_EXCEPTIONS
+template <typename T>
+inline bool Convert<
+    T,
+    typename std::enable_if<details::is_int128<T>::value>::type>::
+    Accepts(const Value& value) {
+  return value.IsBigInt();
+}
+#endif  // NAPI_VERSION > 5 && NAPI_HAS_INT128
 
-inline const char* Error::ERROR_WRAP_VALUE() NAPI_NOEXCEPT {
-  return "4bda9e7e-4913-4dbc-95de-891cbf66598e-errorVal";
+template <typename T>
+inline Value
+Convert<T, typename std::enable_if<std::is_enum<T>::value>::type>::ToJS(
+    napi_env env, T value) {
+  using Underlying = typename std::underlying_type<T>::type;
+  return Convert<Underlying>::ToJS(env, static_cast<Underlying>(value));
 }
 
-template <typename TError>
-inline TError Error::New(napi_env env,
-                         const char* message,
-                         size_t length,
-                         create_error_fn create_error) {
-  napi_value str;
-  napi_status status = napi_create_string_utf8(env, message, length, &str);
-  NAPI_THROW_IF_FAILED(env, status, TError());
+template <typename T>
+inline bool
+Convert<T, typename std::enable_if<std::is_enum<T>::value>::type>::FromJS(
+    const Value& value, T* result) {
+  using Underlying = typename std::underlying_type<T>::type;
+  Underlying underlying{};
+  if (!Convert<Underlying>::FromJS(value, &underlying)) {
+    return false;
+  }
+  *result = static_cast<T>(underlying);
+  return true;
+}
 
-  napi_value error;
-  status = create_error(env, nullptr, str, &error);
-  NAPI_THROW_IF_FAILED(env, status, TError());
+template <typename T>
+inline bool
+Convert<T, typename std::enable_if<std::is_enum<T>::value>::type>::Accepts(
+    const Value& value) {
+  return value.IsNumber();
+}
 
-  return TError(env, error);
+inline Value Convert<std::string>::ToJS(napi_env env,
+                                        const std::string& value) {
+  return String::New(env, value);
 }
 
-inline TypeError TypeError::New(napi_env env, const char* message) {
-  return Error::New<TypeError>(
-      env, message, std::strlen(message), napi_create_type_error);
+inline bool Convert<std::string>::FromJS(const Value& value,
+                                         std::string* result) {
+  if (!value.IsString()) {
+    return details::ConvertTypeError(value.Env(), "A string was expected.");
+  }
+  *result = value.As<String>().Utf8Value();
+  return true;
 }
 
-inline TypeError TypeError::New(napi_env env, const std::string& message) {
-  return Error::New<TypeError>(
-      env, message.c_str(), message.size(), napi_create_type_error);
+inline bool Convert<std::string>::Accepts(const Value& value) {
+  return value.IsString();
 }
 
-inline TypeError::TypeError() : Error() {}
+inline Value Convert<std::u16string>::ToJS(napi_env env,
+                                           const std::u16string& value) {
+  return String::New(env, value);
+}
 
-inline TypeError::TypeError(napi_env env, napi_value value)
-    : Error(env, value) {}
+inline bool Convert<std::u16string>::FromJS(const Value& value,
+                                            std::u16string* result) {
+  if (!value.IsString()) {
+    return details::ConvertTypeError(value.Env(), "A string was expected.");
+  }
+  *result = value.As<String>().Utf16Value();
+  return true;
+}
 
-inline RangeError RangeError::New(napi_env env, const char* message) {
-  return Error::New<RangeError>(
-      env, message, std::strlen(message), napi_create_range_error);
+inline bool Convert<std::u16string>::Accepts(const Value& value) {
+  return value.IsString();
 }
 
-inline RangeError RangeError::New(napi_env env, const std::string& message) {
-  return Error::New<RangeError>(
-      env, message.c_str(), message.size(), napi_create_range_error);
+template <typename T>
+inline Value
+Convert<T, typename std::enable_if<std::is_base_of<Value, T>::value>::type>::
+    ToJS(napi_env /*env*/, const T& value) {
+  return value;
 }
 
-inline RangeError::RangeError() : Error() {}
+template <typename T>
+inline bool
+Convert<T, typename std::enable_if<std::is_base_of<Value, T>::value>::type>::
+    FromJS(const Value& value, T* result) {
+  if (!Accepts(value)) {
+    if (value.Env().IsExceptionPending()) {
+      return false;
+    }
+    return details::ConvertTypeError(value.Env(),
+                                      "A value of another type was expected.");
+  }
+  *result = T(value.Env(), value);
+  return true;
+}
 
-inline RangeError::RangeError(napi_env env, napi_value value)
-    : Error(env, value) {}
+template <typename T>
+inline bool
+Convert<T, typename std::enable_if<std::is_base_of<Value, T>::value>::type>::
+    Accepts(const Value& value) {
+  return details::ConvertIsValue(value, static_cast<const T*>(nullptr));
+}
 
-////////////////////////////////////////////////////////////////////////////////
-// Reference<T> class
-////////////////////////////////////////////////////////////////////////////////
+template <typename T, typename Alloc>
+inline Value Convert<std::vector<T, Alloc>>::ToJS(
+    napi_env env, const std::vector<T, Alloc>& value) {
+  return details::SequenceToJS<T>(
+      env, value, details::convert_typed_array<T>());
+}
 
-template <typename T>
-inline Reference<T> Reference<T>::New(const T& value,
-                                      uint32_t initialRefcount) {
-  napi_env env = value.Env();
-  napi_value val = value;
+template <typename T, typename Alloc>
+inline bool Convert<std::vector<T, Alloc>>::FromJS(
+    const Value& value, std::vector<T, Alloc>* result) {
+  return details::SequenceFromJS<T>(value, result);
+}
 
-  if (val == nullptr) {
-    return Reference<T>(env, nullptr);
-  }
+template <typename T, typename Alloc>
+inline bool Convert<std::vector<T, Alloc>>::Accepts(const Value& value) {
+  return details::SequenceAccepts<T>(value,
+                                     details::convert_typed_array<T>());
+}
 
-  napi_ref ref;
-  napi_status status = napi_create_reference(env, value, initialRefcount, &ref);
-  NAPI_THROW_IF_FAILED(env, status, Reference<T>());
+template <typename T, size_t N>
+inline Value Convert<std::array<T, N>>::ToJS(napi_env env,
+                                             const std::array<T, N>& value) {
+  return details::SequenceToJS<T>(
+      env, value, details::convert_typed_array<T>());
+}
 
-  return Reference<T>(env, ref);
+template <typename T, size_t N>
+inline bool Convert<std::array<T, N>>::FromJS(const Value& value,
+                                              std::array<T, N>* result) {
+  return details::SequenceFromJS<T>(value, result);
 }
 
-template <typename T>
-inline Reference<T>::Reference()
-    : _env(nullptr), _ref(nullptr), _suppressDestruct(false) {}
+template <typename T, size_t N>
+inline bool Convert<std::array<T, N>>::Accepts(const Value& value) {
+  return details::SequenceAccepts<T>(value,
+                                     details::convert_typed_array<T>());
+}
 
-template <typename T>
-inline Reference<T>::Reference(napi_env env, napi_ref ref)
-    : _env(env), _ref(ref), _suppressDestruct(false) {}
+template <typename K, typename V, typename Compare, typename Alloc>
+inline Value Convert<std::map<K, V, Compare, Alloc>>::ToJS(
+    napi_env env, const std::map<K, V, Compare, Alloc>& value) {
+  return details::MapToJS<K, V>(env, value);
+}
 
-template <typename T>
-inline Reference<T>::~Reference() {
-  if (_ref != nullptr) {
-    if (!_suppressDestruct) {
-      napi_delete_reference(_env, _ref);
-    }
+template <typename K, typename V, typename Compare, typename Alloc>
+inline bool Convert<std::map<K, V, Compare, Alloc>>::FromJS(
+    const Value& value, std::map<K, V, Compare, Alloc>* result) {
+  return details::MapFromJS<K, V>(value, result);
+}
 
-    _ref = nullptr;
-  }
+template <typename K, typename V, typename Compare, typename Alloc>
+inline bool Convert<std::map<K, V, Compare, Alloc>>::Accepts(
+    const Value& value) {
+  return value.IsObject();
 }
 
-template <typename T>
-inline Reference<T>::Reference(Reference<T>&& other)
-    : _env(other._env),
-      _ref(other._ref),
-      _suppressDestruct(other._suppressDestruct) {
-  other._env = nullptr;
-  other._ref = nullptr;
-  other._suppressDestruct = false;
+template <typename K, typename V, typename Hash, typename Eq, typename Alloc>
+inline Value Convert<std::unordered_map<K, V, Hash, Eq, Alloc>>::ToJS(
+    napi_env env, const std::unordered_map<K, V, Hash, Eq, Alloc>& value) {
+  return details::MapToJS<K, V>(env, value);
 }
 
-template <typename T>
-inline Reference<T>& Reference<T>::operator=(Reference<T>&& other) {
-  Reset();
-  _env = other._env;
-  _ref = other._ref;
-  _suppressDestruct = other._suppressDestruct;
-  other._env = nullptr;
-  other._ref = nullptr;
-  other._suppressDestruct = false;
-  return *this;
+template <typename K, typename V, typename Hash, typename Eq, typename Alloc>
+inline bool Convert<std::unordered_map<K, V, Hash, Eq, Alloc>>::FromJS(
+    const Value& value, std::unordered_map<K, V, Hash, Eq, Alloc>* result) {
+  return details::MapFromJS<K, V>(value, result);
 }
 
-template <typename T>
-inline Reference<T>::Reference(const Reference<T>& other)
-    : _env(other._env), _ref(nullptr), _suppressDestruct(false) {
-  HandleScope scope(_env);
+template <typename K, typename V, typename Hash, typename Eq, typename Alloc>
+inline bool Convert<std::unordered_map<K, V, Hash, Eq, Alloc>>::Accepts(
+    const Value& value) {
+  return value.IsObject();
+}
 
-  napi_value value = other.Value();
-  if (value != nullptr) {
-    // Copying is a limited scenario (currently only used for Error object) and
-    // always creates a strong reference to the given value even if the incoming
-    // reference is weak.
-    napi_status status = napi_create_reference(_env, value, 1, &_ref);
-    NAPI_FATAL_IF_FAILED(
-        status, "Reference<T>::Reference", "napi_create_reference");
-  }
+template <typename First, typename Second>
+inline Value Convert<std::pair<First, Second>>::ToJS(
+    napi_env env, const std::pair<First, Second>& value) {
+  return details::TupleToJS(env, value);
 }
 
-template <typename T>
-inline Reference<T>::operator napi_ref() const {
-  return _ref;
+template <typename First, typename Second>
+inline bool Convert<std::pair<First, Second>>::FromJS(
+    const Value& value, std::pair<First, Second>* result) {
+  return details::TupleFromJS(value, result);
 }
 
-template <typename T>
-inline bool Reference<T>::operator==(const Reference<T>& other) const {
-  HandleScope scope(_env);
-  return this->Value().StrictEquals(other.Value());
+template <typename First, typename Second>
+inline bool Convert<std::pair<First, Second>>::Accepts(const Value& value) {
+  return value.IsArray();
 }
 
-template <typename T>
-inline bool Reference<T>::operator!=(const Reference<T>& other) const {
-  return !this->operator==(other);
+template <typename... Ts>
+inline Value Convert<std::tuple<Ts...>>::ToJS(napi_env env,
+                                              const std::tuple<Ts...>& value) {
+  return details::TupleToJS(env, value);
 }
 
-template <typename T>
-inline Napi::Env Reference<T>::Env() const {
-  return Napi::Env(_env);
+template <typename... Ts>
+inline bool Convert<std::tuple<Ts...>>::FromJS(const Value& value,
+                                               std::tuple<Ts...>* result) {
+  return details::TupleFromJS(value, result);
 }
 
-template <typename T>
-inline bool Reference<T>::IsEmpty() const {
-  return _ref == nullptr;
+template <typename... Ts>
+inline bool Convert<std::tuple<Ts...>>::Accepts(const Value& value) {
+  return value.IsArray();
 }
 
-template <typename T>
-inline T Reference<T>::Value() const {
-  if (_ref == nullptr) {
-    return T(_env, nullptr);
+template <typename Rep, typename Period>
+inline Value Convert<std::chrono::duration<Rep, Period>>::ToJS(
+    napi_env env, const std::chrono::duration<Rep, Period>& value) {
+  return Number::New(
+      env, std::chrono::duration<double, std::milli>(value).count());
+}
+
+template <typename Rep, typename Period>
+inline bool Convert<std::chrono::duration<Rep, Period>>::FromJS(
+    const Value& value, std::chrono::duration<Rep, Period>* result) {
+  double milliseconds;
+  if (!details::ConvertMilliseconds(value, &milliseconds)) {
+    return false;
   }
+  *result = std::chrono::duration_cast<std::chrono::duration<Rep, Period>>(
+      std::chrono::duration<double, std::milli>(milliseconds));
+  return true;
+}
 
-  napi_value value;
-  napi_status status = napi_get_reference_value(_env, _ref, &value);
-  NAPI_THROW_IF_FAILED(_env, status, T());
-  return T(_env, value);
+template <typename Rep, typename Period>
+inline bool Convert<std::chrono::duration<Rep, Period>>::Accepts(
+    const Value& value) {
+  return value.IsNumber();
 }
 
-template <typename T>
-inline uint32_t Reference<T>::Ref() const {
-  uint32_t result;
-  napi_status status = napi_reference_ref(_env, _ref, &result);
-  NAPI_THROW_IF_FAILED(_env, status, 0);
-  return result;
+#if (NAPI_VERSION > 4)
+template <typename Duration>
+inline Value
+Convert<std::chrono::time_point<std::chrono::system_clock, Duration>>::ToJS(
+    napi_env env, const TimePoint& value) {
+  return Date::New(env, value);
+}
+
+template <typename Duration>
+inline bool
+Convert<std::chrono::time_point<std::chrono::system_clock, Duration>>::FromJS(
+    const Value& value, TimePoint* result) {
+  double milliseconds;
+  if (value.IsDate()) {
+    napi_status status =
+        napi_get_date_value(value.Env(), value, &milliseconds);
+    NAPI_THROW_IF_FAILED(value.Env(), status, false);
+  } else if (!details::ConvertMilliseconds(value, &milliseconds)) {
+    return false;
+  }
+  // Like Date::TimePointValue(), but also rejects the numbers that would make
+  // an invalid Date, since those are accepted in place of one.
+  if (!(std::fabs(milliseconds) <= 8.64e15)) {
+    return details::ConvertRangeError(value.Env(), "Invalid Date");
+  }
+  Duration duration;
+  if (!details::MillisecondsToDuration(milliseconds, &duration)) {
+    return details::ConvertRangeError(
+        value.Env(), "The Date is out of range of the time point.");
+  }
+  *result = TimePoint(duration);
+  return true;
 }
 
-template <typename T>
-inline uint32_t Reference<T>::Unref() const {
-  uint32_t result;
-  napi_status status = napi_reference_unref(_env, _ref, &result);
-  NAPI_THROW_IF_FAILED(_env, status, 0);
-  return result;
+template <typename Duration>
+inline bool
+Convert<std::chrono::time_point<std::chrono::system_clock, Duration>>::Accepts(
+    const Value& value) {
+  return value.IsDate() || value.IsNumber();
 }
+#endif  // NAPI_VERSION > 4
 
+#ifdef NAPI_HAS_CPP17
 template <typename T>
-inline void Reference<T>::Reset() {
-  if (_ref != nullptr) {
-    napi_status status = napi_delete_reference(_env, _ref);
-    NAPI_THROW_IF_FAILED_VOID(_env, status);
-    _ref = nullptr;
+inline Value Convert<std::optional<T>>::ToJS(napi_env env,
+                                             const std::optional<T>& value) {
+  if (!value.has_value()) {
+    return Env(env).Undefined();
   }
+  return Convert<T>::ToJS(env, *value);
 }
 
 template <typename T>
-inline void Reference<T>::Reset(const T& value, uint32_t refcount) {
-  Reset();
-  _env = value.Env();
-
-  napi_value val = value;
-  if (val != nullptr) {
-    napi_status status = napi_create_reference(_env, value, refcount, &_ref);
-    NAPI_THROW_IF_FAILED_VOID(_env, status);
+inline bool Convert<std::optional<T>>::FromJS(const Value& value,
+                                              std::optional<T>* result) {
+  if (value.IsUndefined() || value.IsNull()) {
+    result->reset();
+    return true;
   }
+  T item{};
+  if (!Convert<T>::FromJS(value, &item)) {
+    return false;
+  }
+  *result = std::move(item);
+  return true;
 }
 
 template <typename T>
-inline void Reference<T>::SuppressDestruct() {
-  _suppressDestruct = true;
+inline bool Convert<std::optional<T>>::Accepts(const Value& value) {
+  return value.IsUndefined() || value.IsNull() || Convert<T>::Accepts(value);
 }
 
-template <typename T>
-inline Reference<T> Weak(T value) {
-  return Reference<T>::New(value, 0);
+template <typename... Ts>
+inline Value Convert<std::variant<Ts...>>::ToJS(
+    napi_env env, const std::variant<Ts...>& value) {
+  return std::visit(
+      [env](const auto& alternative) -> Value {
+        using T = std::decay_t<decltype(alternative)>;
+        return Convert<T>::ToJS(env, alternative);
+      },
+      value);
 }
 
-inline ObjectReference Weak(Object value) {
-  return Reference<Object>::New(value, 0);
+template <typename... Ts>
+inline bool Convert<std::variant<Ts...>>::FromJS(
+    const Value& value, std::variant<Ts...>* result) {
+  bool matched = false;
+  if (!(details::VariantFromJS<Ts>(value, result, &matched) && ...)) {
+    return false;
+  }
+  if (!matched) {
+    return details::ConvertTypeError(
+        value.Env(), "Value does not match any variant alternative.");
+  }
+  return true;
 }
 
-inline FunctionReference Weak(Function value) {
-  return Reference<Function>::New(value, 0);
+template <typename... Ts>
+inline bool Convert<std::variant<Ts...>>::Accepts(const Value& value) {
+  return (Convert<Ts>::Accepts(value) || ...);
 }
+#endif  // NAPI_HAS_CPP17
 
-template <typename T>
-inline Reference<T> Persistent(T value) {
-  return Reference<T>::New(value, 1);
+namespace details {
+
+// The state shared by all copies of a `SharedReference<T>`, and by copies of
+// an `Error` when NODE_ADDON_API_SHARE_ERROR_REFERENCES is defined.
+struct SharedReferenceBlock {
+  napi_env env;
+  napi_ref ref;
+  uint32_t count;
+};
+
+inline SharedReferenceBlock* RetainSharedReference(
+    SharedReferenceBlock* block) {
+  if (block != nullptr) {
+    block->count++;
+  }
+  return block;
 }
 
-inline ObjectReference Persistent(Object value) {
-  return Reference<Object>::New(value, 1);
+// Out of line so that compilers which inline several releases of the same
+// block do not see a `delete` followed by another use of the block.
+inline NAPI_NOINLINE void DestroySharedReference(SharedReferenceBlock* block) {
+  napi_delete_reference(block->env, block->ref);
+  delete block;
 }
 
-inline FunctionReference Persistent(Function value) {
-  return Reference<Function>::New(value, 1);
+inline void ReleaseSharedReference(SharedReferenceBlock* block) {
+  if (block != nullptr && --block->count == 0) {
+    DestroySharedReference(block);
+  }
 }
 
+}  // namespace details
+
 ////////////////////////////////////////////////////////////////////////////////
-// ObjectReference class
+// Error class
 ////////////////////////////////////////////////////////////////////////////////
 
-inline ObjectReference::ObjectReference() : Reference<Object>() {}
-
-inline ObjectReference::ObjectReference(napi_env env, napi_ref ref)
-    : Reference<Object>(env, ref) {}
+inline Error Error::New(napi_env env) {
+  napi_status status;
+  napi_value error = nullptr;
+  bool is_exception_pending;
+  napi_extended_error_info last_error_info_copy;
 
-inline ObjectReference::ObjectReference(Reference<Object>&& other)
-    : Reference<Object>(std::move(other)) {}
+  {
+    // We must retrieve the last error info before doing anything else because
+    // doing anything else will replace the last error info.
+    const napi_extended_error_info* last_error_info;
+    status = napi_get_last_error_info(env, &last_error_info);
+    NAPI_FATAL_IF_FAILED(status, "Error::New", "napi_get_last_error_info");
 
-inline ObjectReference& ObjectReference::operator=(Reference<Object>&& other) {
-  static_cast<Reference<Object>*>(this)->operator=(std::move(other));
-  return *this;
-}
+    // All fields of the `napi_extended_error_info` structure gets reset in
+    // subsequent Node-API function calls on the same `env`. This includes a
+    // call to `napi_is_exception_pending()`. So here it is necessary to make a
+    // copy of the information as the `error_code` field is used later on.
+    memcpy(&last_error_info_copy,
+           last_error_info,
+           sizeof(napi_extended_error_info));
+  }
 
-inline ObjectReference::ObjectReference(ObjectReference&& other)
-    : Reference<Object>(std::move(other)) {}
+  status = napi_is_exception_pending(env, &is_exception_pending);
+  NAPI_FATAL_IF_FAILED(status, "Error::New", "napi_is_exception_pending");
 
-inline ObjectReference& ObjectReference::operator=(ObjectReference&& other) {
-  static_cast<Reference<Object>*>(this)->operator=(std::move(other));
-  return *this;
-}
+  // A pending exception takes precedence over any internal error status.
+  if (is_exception_pending) {
+    status = napi_get_and_clear_last_exception(env, &error);
+    NAPI_FATAL_IF_FAILED(
+        status, "Error::New", "napi_get_and_clear_last_exception");
+  } else {
+    const char* error_message = last_error_info_copy.error_message != nullptr
+                                    ? last_error_info_copy.error_message
+                                    : "Error in native callback";
 
-inline ObjectReference::ObjectReference(const ObjectReference& other)
-    : Reference<Object>(other) {}
+    napi_value message;
+    status = napi_create_string_utf8(
+        env, error_message, std::strlen(error_message), &message);
+    NAPI_FATAL_IF_FAILED(status, "Error::New", "napi_create_string_utf8");
 
-inline MaybeOrValue<Napi::Value> ObjectReference::Get(
-    const char* utf8name) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result = Value().Get(utf8name);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
-  }
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
+    switch (last_error_info_copy.error_code) {
+      case napi_object_expected:
+      case napi_string_expected:
+      case napi_boolean_expected:
+      case napi_number_expected:
+        status = napi_create_type_error(env, nullptr, message, &error);
+        break;
+      default:
+        status = napi_create_error(env, nullptr, message, &error);
+        break;
+    }
+    NAPI_FATAL_IF_FAILED(status, "Error::New", "napi_create_error");
   }
-  return scope.Escape(result);
-#endif
-}
 
-inline MaybeOrValue<Napi::Value> ObjectReference::Get(
-    const std::string& utf8name) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result = Value().Get(utf8name);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
-  }
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
-  }
-  return scope.Escape(result);
-#endif
+  return Error(env, error);
 }
 
-inline MaybeOrValue<bool> ObjectReference::Set(const char* utf8name,
-                                               napi_value value) const {
-  HandleScope scope(_env);
-  return Value().Set(utf8name, value);
+inline Error Error::New(napi_env env, const char* message) {
+  return Error::New<Error>(
+      env, message, std::strlen(message), napi_create_error);
 }
 
-inline MaybeOrValue<bool> ObjectReference::Set(const char* utf8name,
-                                               Napi::Value value) const {
-  HandleScope scope(_env);
-  return Value().Set(utf8name, value);
+inline Error Error::New(napi_env env, const std::string& message) {
+  return Error::New<Error>(
+      env, message.c_str(), message.size(), napi_create_error);
 }
 
-inline MaybeOrValue<bool> ObjectReference::Set(const char* utf8name,
-                                               const char* utf8value) const {
-  HandleScope scope(_env);
-  return Value().Set(utf8name, utf8value);
+inline NAPI_NO_RETURN void Error::Fatal(const char* location,
+                                        const char* message) {
+  napi_fatal_error(location, NAPI_AUTO_LENGTH, message, NAPI_AUTO_LENGTH);
 }
 
-inline MaybeOrValue<bool> ObjectReference::Set(const char* utf8name,
-                                               bool boolValue) const {
-  HandleScope scope(_env);
-  return Value().Set(utf8name, boolValue);
-}
+inline Error::Error() : ObjectReference() {}
 
-inline MaybeOrValue<bool> ObjectReference::Set(const char* utf8name,
-                                               double numberValue) const {
-  HandleScope scope(_env);
-  return Value().Set(utf8name, numberValue);
-}
+inline Error::Error(napi_env env, napi_value value)
+    : ObjectReference(env, nullptr) {
+  if (value != nullptr) {
+    // Attempting to create a reference on the error object.
+    // If it's not a Object/Function/Symbol, this call will return an error
+    // status.
+    napi_status status = napi_create_reference(env, value, 1, &_ref);
 
-inline MaybeOrValue<bool> ObjectReference::Set(const std::string& utf8name,
-                                               napi_value value) const {
-  HandleScope scope(_env);
-  return Value().Set(utf8name, value);
-}
+    if (status != napi_ok) {
+      napi_value wrappedErrorObj;
 
-inline MaybeOrValue<bool> ObjectReference::Set(const std::string& utf8name,
-                                               Napi::Value value) const {
-  HandleScope scope(_env);
-  return Value().Set(utf8name, value);
-}
+      // Create an error object
+      status = napi_create_object(env, &wrappedErrorObj);
+      NAPI_FATAL_IF_FAILED(status, "Error::Error", "napi_create_object");
 
-inline MaybeOrValue<bool> ObjectReference::Set(const std::string& utf8name,
-                                               std::string& utf8value) const {
-  HandleScope scope(_env);
-  return Value().Set(utf8name, utf8value);
-}
+      // property flag that we attach to show the error object is wrapped
+      napi_property_descriptor wrapObjFlag = {
+          ERROR_WRAP_VALUE(),  // Unique GUID identifier since Symbol isn't a
+                               // viable option
+          nullptr,
+          nullptr,
+          nullptr,
+          nullptr,
+          Value::From(env, value),
+          napi_enumerable,
+          nullptr};
 
-inline MaybeOrValue<bool> ObjectReference::Set(const std::string& utf8name,
-                                               bool boolValue) const {
-  HandleScope scope(_env);
-  return Value().Set(utf8name, boolValue);
-}
+      status = napi_define_properties(env, wrappedErrorObj, 1, &wrapObjFlag);
+#ifdef NODE_API_SWALLOW_UNTHROWABLE_EXCEPTIONS
+      if (status == napi_pending_exception) {
+        // Test if the pending exception was reported because the environment is
+        // shutting down. We assume that a status of napi_pending_exception
+        // coupled with the absence of an actual pending exception means that
+        // the environment is shutting down. If so, we replace the
+        // napi_pending_exception status with napi_ok.
+        bool is_exception_pending = false;
+        status = napi_is_exception_pending(env, &is_exception_pending);
+        if (status == napi_ok && !is_exception_pending) {
+          status = napi_ok;
+        } else {
+          status = napi_pending_exception;
+        }
+      }
+#endif  // NODE_API_SWALLOW_UNTHROWABLE_EXCEPTIONS
+      NAPI_FATAL_IF_FAILED(status, "Error::Error", "napi_define_properties");
 
-inline MaybeOrValue<bool> ObjectReference::Set(const std::string& utf8name,
-                                               double numberValue) const {
-  HandleScope scope(_env);
-  return Value().Set(utf8name, numberValue);
+      // Create a reference on the newly wrapped object
+      status = napi_create_reference(env, wrappedErrorObj, 1, &_ref);
+    }
+
+    // Avoid infinite recursion in the failure case.
+    NAPI_FATAL_IF_FAILED(status, "Error::Error", "napi_create_reference");
+  }
 }
 
-inline MaybeOrValue<Napi::Value> ObjectReference::Get(uint32_t index) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result = Value().Get(index);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
+inline Object Error::Value() const {
+  if (_ref == nullptr) {
+    return Object(_env, nullptr);
   }
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
+
+  napi_value refValue;
+  napi_status status = napi_get_reference_value(_env, _ref, &refValue);
+  NAPI_THROW_IF_FAILED(_env, status, Object());
+
+  napi_valuetype type;
+  status = napi_typeof(_env, refValue, &type);
+  NAPI_THROW_IF_FAILED(_env, status, Object());
+
+  // If refValue isn't a symbol, then we proceed to whether the refValue has the
+  // wrapped error flag
+  if (type != napi_symbol) {
+    // We are checking if the object is wrapped
+    bool isWrappedObject = false;
+
+    status = napi_has_property(_env,
+                               refValue,
+                               String::From(_env, ERROR_WRAP_VALUE()),
+                               &isWrappedObject);
+
+    // Don't care about status
+    if (isWrappedObject) {
+      napi_value unwrappedValue;
+      status = napi_get_property(_env,
+                                 refValue,
+                                 String::From(_env, ERROR_WRAP_VALUE()),
+                                 &unwrappedValue);
+      NAPI_THROW_IF_FAILED(_env, status, Object());
+
+      return Object(_env, unwrappedValue);
+    }
   }
-  return scope.Escape(result);
-#endif
-}
 
-inline MaybeOrValue<bool> ObjectReference::Set(uint32_t index,
-                                               napi_value value) const {
-  HandleScope scope(_env);
-  return Value().Set(index, value);
+  return Object(_env, refValue);
 }
 
-inline MaybeOrValue<bool> ObjectReference::Set(uint32_t index,
-                                               Napi::Value value) const {
-  HandleScope scope(_env);
-  return Value().Set(index, value);
-}
+inline Error::Error(Error&& other) : ObjectReference(std::move(other)) {}
 
-inline MaybeOrValue<bool> ObjectReference::Set(uint32_t index,
-                                               const char* utf8value) const {
-  HandleScope scope(_env);
-  return Value().Set(index, utf8value);
+inline Error& Error::operator=(Error&& other) {
+  static_cast<Reference<Object>*>(this)->operator=(std::move(other));
+  return *this;
 }
 
-inline MaybeOrValue<bool> ObjectReference::Set(
-    uint32_t index, const std::string& utf8value) const {
-  HandleScope scope(_env);
-  return Value().Set(index, utf8value);
-}
+#ifdef NODE_ADDON_API_SHARE_ERROR_REFERENCES
 
-inline MaybeOrValue<bool> ObjectReference::Set(uint32_t index,
-                                               bool boolValue) const {
-  HandleScope scope(_env);
-  return Value().Set(index, boolValue);
+// Copies share the `napi_ref` of the original instead of creating their own.
+inline Error::Error(const Error& other) : ObjectReference() {
+  _shared = other.Share();
+  _env = other._env;
+  _ref = other._ref;
 }
 
-inline MaybeOrValue<bool> ObjectReference::Set(uint32_t index,
-                                               double numberValue) const {
-  HandleScope scope(_env);
-  return Value().Set(index, numberValue);
+inline Error& Error::operator=(const Error& other) {
+  if (this != &other) {
+    Reset();
+    _shared = other.Share();
+    _env = other._env;
+    _ref = other._ref;
+  }
+  return *this;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// FunctionReference class
-////////////////////////////////////////////////////////////////////////////////
-
-inline FunctionReference::FunctionReference() : Reference<Function>() {}
+#else  // NODE_ADDON_API_SHARE_ERROR_REFERENCES
 
-inline FunctionReference::FunctionReference(napi_env env, napi_ref ref)
-    : Reference<Function>(env, ref) {}
+inline Error::Error(const Error& other) : ObjectReference(other) {}
 
-inline FunctionReference::FunctionReference(Reference<Function>&& other)
-    : Reference<Function>(std::move(other)) {}
+inline Error& Error::operator=(const Error& other) {
+  Reset();
 
-inline FunctionReference& FunctionReference::operator=(
-    Reference<Function>&& other) {
-  static_cast<Reference<Function>*>(this)->operator=(std::move(other));
-  return *this;
-}
+  _env = other.Env();
+  HandleScope scope(_env);
 
-inline FunctionReference::FunctionReference(FunctionReference&& other)
-    : Reference<Function>(std::move(other)) {}
+  napi_value value = other.Value();
+  if (value != nullptr) {
+    napi_status status = napi_create_reference(_env, value, 1, &_ref);
+    NAPI_THROW_IF_FAILED(_env, status, *this);
+  }
 
-inline FunctionReference& FunctionReference::operator=(
-    FunctionReference&& other) {
-  static_cast<Reference<Function>*>(this)->operator=(std::move(other));
   return *this;
 }
 
-inline MaybeOrValue<Napi::Value> FunctionReference::operator()(
-    const std::initializer_list<napi_value>& args) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result = Value()(args);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
-  }
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
-  }
-  return scope.Escape(result);
-#endif
-}
+#endif  // NODE_ADDON_API_SHARE_ERROR_REFERENCES
 
-inline MaybeOrValue<Napi::Value> FunctionReference::Call(
-    const std::initializer_list<napi_value>& args) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result = Value().Call(args);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
-  }
-  return result;
+inline const std::string& Error::Message() const NAPI_NOEXCEPT {
+  if (_message.size() == 0 && _env != nullptr) {
+#ifdef NAPI_CPP_EXCEPTIONS
+    try {
+      _message = Get("message").As<String>();
+    } catch (...) {
+      // Catch all errors here, to include e.g. a std::bad_alloc from
+      // the std::string::operator=, because this method may not throw.
+    }
+#else  // NAPI_CPP_EXCEPTIONS
+#if defined(NODE_ADDON_API_ENABLE_MAYBE)
+    Napi::Value message_val;
+    if (Get("message").UnwrapTo(&message_val)) {
+      _message = message_val.As<String>();
+    }
 #else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
-  }
-  return scope.Escape(result);
+    _message = Get("message").As<String>();
 #endif
+#endif  // NAPI_CPP_EXCEPTIONS
+  }
+  return _message;
 }
 
-inline MaybeOrValue<Napi::Value> FunctionReference::Call(
-    const std::vector<napi_value>& args) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result = Value().Call(args);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
-  }
-  return result;
+// we created an object on the &_ref
+inline void Error::ThrowAsJavaScriptException() const {
+  HandleScope scope(_env);
+  if (!IsEmpty()) {
+#ifdef NODE_API_SWALLOW_UNTHROWABLE_EXCEPTIONS
+    bool pendingException = false;
+
+    // check if there is already a pending exception. If so don't try to throw a
+    // new one as that is not allowed/possible
+    napi_status status = napi_is_exception_pending(_env, &pendingException);
+
+    if ((status != napi_ok) ||
+        ((status == napi_ok) && (pendingException == false))) {
+      // We intentionally don't use `NAPI_THROW_*` macros here to ensure
+      // that there is no possible recursion as `ThrowAsJavaScriptException`
+      // is part of `NAPI_THROW_*` macro definition for noexcept.
+
+      status = napi_throw(_env, Value());
+
+      if (status == napi_pending_exception) {
+        // The environment must be terminating as we checked earlier and there
+        // was no pending exception. In this case continuing will result
+        // in a fatal error and there is nothing the author has done incorrectly
+        // in their code that is worth flagging through a fatal error
+        return;
+      }
+    } else {
+      status = napi_pending_exception;
+    }
 #else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
-  }
-  return scope.Escape(result);
+    // We intentionally don't use `NAPI_THROW_*` macros here to ensure
+    // that there is no possible recursion as `ThrowAsJavaScriptException`
+    // is part of `NAPI_THROW_*` macro definition for noexcept.
+
+    napi_status status = napi_throw(_env, Value());
 #endif
-}
 
-inline MaybeOrValue<Napi::Value> FunctionReference::Call(
-    napi_value recv, const std::initializer_list<napi_value>& args) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result = Value().Call(recv, args);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
-  }
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
+#ifdef NAPI_CPP_EXCEPTIONS
+    if (status != napi_ok) {
+      throw Error::New(_env);
+    }
+#else   // NAPI_CPP_EXCEPTIONS
+    NAPI_FATAL_IF_FAILED(
+        status, "Error::ThrowAsJavaScriptException", "napi_throw");
+#endif  // NAPI_CPP_EXCEPTIONS
   }
-  return scope.Escape(result);
-#endif
 }
 
-inline MaybeOrValue<Napi::Value> FunctionReference::Call(
-    napi_value recv, const std::vector<napi_value>& args) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result = Value().Call(recv, args);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
-  }
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
-  }
-  return scope.Escape(result);
-#endif
+#ifdef NAPI_CPP_EXCEPTIONS
+
+inline const char* Error::what() const NAPI_NOEXCEPT {
+  return Message().c_str();
 }
 
-inline MaybeOrValue<Napi::Value> FunctionReference::Call(
-    napi_value recv, size_t argc, const napi_value* args) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result = Value().Call(recv, argc, args);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
-  }
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
-  }
-  return scope.Escape(result);
-#endif
+#endif  // NAPI_CPP_EXCEPTIONS
+
+inline const char* Error::ERROR_WRAP_VALUE() NAPI_NOEXCEPT {
+  return "4bda9e7e-4913-4dbc-95de-891cbf66598e-errorVal";
 }
 
-inline MaybeOrValue<Napi::Value> FunctionReference::MakeCallback(
-    napi_value recv,
-    const std::initializer_list<napi_value>& args,
-    napi_async_context context) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result = Value().MakeCallback(recv, args, context);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
-  }
+template <typename TError>
+inline TError Error::New(napi_env env,
+                         const char* message,
+                         size_t length,
+                         create_error_fn create_error) {
+  napi_value str;
+  napi_status status = napi_create_string_utf8(env, message, length, &str);
+  NAPI_THROW_IF_FAILED(env, status, TError());
 
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
-  }
-  return scope.Escape(result);
-#endif
+  napi_value error;
+  status = create_error(env, nullptr, str, &error);
+  NAPI_THROW_IF_FAILED(env, status, TError());
+
+  return TError(env, error);
 }
 
-inline MaybeOrValue<Napi::Value> FunctionReference::MakeCallback(
-    napi_value recv,
-    const std::vector<napi_value>& args,
-    napi_async_context context) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result = Value().MakeCallback(recv, args, context);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
-  }
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
-  }
-  return scope.Escape(result);
-#endif
+inline TypeError TypeError::New(napi_env env, const char* message) {
+  return Error::New<TypeError>(
+      env, message, std::strlen(message), napi_create_type_error);
 }
 
-inline MaybeOrValue<Napi::Value> FunctionReference::MakeCallback(
-    napi_value recv,
-    size_t argc,
-    const napi_value* args,
-    napi_async_context context) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Napi::Value> result =
-      Value().MakeCallback(recv, argc, args, context);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()));
-  }
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Value();
-  }
-  return scope.Escape(result);
-#endif
+inline TypeError TypeError::New(napi_env env, const std::string& message) {
+  return Error::New<TypeError>(
+      env, message.c_str(), message.size(), napi_create_type_error);
 }
 
-inline MaybeOrValue<Object> FunctionReference::New(
-    const std::initializer_list<napi_value>& args) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Object> result = Value().New(args);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()).As<Object>());
-  }
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Object();
-  }
-  return scope.Escape(result).As<Object>();
-#endif
+inline TypeError::TypeError() : Error() {}
+
+inline TypeError::TypeError(napi_env env, napi_value value)
+    : Error(env, value) {}
+
+inline RangeError RangeError::New(napi_env env, const char* message) {
+  return Error::New<RangeError>(
+      env, message, std::strlen(message), napi_create_range_error);
 }
 
-inline MaybeOrValue<Object> FunctionReference::New(
-    const std::vector<napi_value>& args) const {
-  EscapableHandleScope scope(_env);
-  MaybeOrValue<Object> result = Value().New(args);
-#ifdef NODE_ADDON_API_ENABLE_MAYBE
-  if (result.IsJust()) {
-    return Just(scope.Escape(result.Unwrap()).As<Object>());
-  }
-  return result;
-#else
-  if (scope.Env().IsExceptionPending()) {
-    return Object();
-  }
-  return scope.Escape(result).As<Object>();
-#endif
+inline RangeError RangeError::New(napi_env env, const std::string& message) {
+  return Error::New<RangeError>(
+      env, message.c_str(), message.size(), napi_create_range_error);
 }
 
+inline RangeError::RangeError() : Error() {}
+
+inline RangeError::RangeError(napi_env env, napi_value value)
+    : Error(env, value) {}
+
 ////////////////////////////////////////////////////////////////////////////////
-// CallbackInfo class
+// Reference<T> class
 ////////////////////////////////////////////////////////////////////////////////
 
-inline CallbackInfo::CallbackInfo(napi_env env, napi_callback_info info)
-    : _env(env),
-      _info(info),
-      _this(nullptr),
-      _dynamicArgs(nullptr),
-      _data(nullptr) {
-  _argc = _staticArgCount;
-  _argv = _staticArgs;
-  napi_status status =
-      napi_get_cb_info(env, info, &_argc, _argv, &_this, &_data);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
-
-  if (_argc > _staticArgCount) {
-    // Use either a fixed-size array (on the stack) or a dynamically-allocated
-    // array (on the heap) depending on the number of args.
-    _dynamicArgs = new napi_value[_argc];
-    _argv = _dynamicArgs;
+template <typename T>
+inline Reference<T> Reference<T>::New(const T& value,
+                                      uint32_t initialRefcount) {
+  napi_env env = value.Env();
+  napi_value val = value;
 
-    status = napi_get_cb_info(env, info, &_argc, _argv, nullptr, nullptr);
-    NAPI_THROW_IF_FAILED_VOID(_env, status);
+  if (val == nullptr) {
+    return Reference<T>(env, nullptr);
   }
+
+  napi_ref ref;
+  napi_status status = napi_create_reference(env, value, initialRefcount, &ref);
+  NAPI_THROW_IF_FAILED(env, status, Reference<T>());
+
+  return Reference<T>(env, ref);
 }
 
-inline CallbackInfo::~CallbackInfo() {
-  if (_dynamicArgs != nullptr) {
-    delete[] _dynamicArgs;
+template <typename T>
+inline Reference<T>::Reference()
+    : _env(nullptr), _ref(nullptr), _suppressDestruct(false) {}
+
+template <typename T>
+inline Reference<T>::Reference(napi_env env, napi_ref ref)
+    : _env(env), _ref(ref), _suppressDestruct(false) {}
+
+template <typename T>
+inline Reference<T>::~Reference() {
+  if (_ref != nullptr) {
+    if (!_suppressDestruct) {
+#ifdef NODE_ADDON_API_SHARE_ERROR_REFERENCES
+      if (_shared != nullptr) {
+        ReleaseShare();
+        return;
+      }
+#endif  // NODE_ADDON_API_SHARE_ERROR_REFERENCES
+      napi_delete_reference(_env, _ref);
+    }
+
+    _ref = nullptr;
   }
 }
 
-inline CallbackInfo::operator napi_callback_info() const {
-  return _info;
+template <typename T>
+inline Reference<T>::Reference(Reference<T>&& other)
+    : _env(other._env),
+      _ref(other._ref),
+      _suppressDestruct(other._suppressDestruct) {
+#ifdef NODE_ADDON_API_SHARE_ERROR_REFERENCES
+  _shared = other._shared;
+  other._shared = nullptr;
+#endif  // NODE_ADDON_API_SHARE_ERROR_REFERENCES
+  other._env = nullptr;
+  other._ref = nullptr;
+  other._suppressDestruct = false;
 }
 
-inline Value CallbackInfo::NewTarget() const {
-  napi_value newTarget;
-  napi_status status = napi_get_new_target(_env, _info, &newTarget);
-  NAPI_THROW_IF_FAILED(_env, status, Value());
-  return Value(_env, newTarget);
+template <typename T>
+inline Reference<T>& Reference<T>::operator=(Reference<T>&& other) {
+  Reset();
+  _env = other._env;
+  _ref = other._ref;
+  _suppressDestruct = other._suppressDestruct;
+#ifdef NODE_ADDON_API_SHARE_ERROR_REFERENCES
+  _shared = other._shared;
+  other._shared = nullptr;
+#endif  // NODE_ADDON_API_SHARE_ERROR_REFERENCES
+  other._env = nullptr;
+  other._ref = nullptr;
+  other._suppressDestruct = false;
+  return *this;
 }
 
-inline bool CallbackInfo::IsConstructCall() const {
-  return !NewTarget().IsEmpty();
-}
+template <typename T>
+inline Reference<T>::Reference(const Reference<T>& other)
+    : _env(other._env), _ref(nullptr), _suppressDestruct(false) {
+  HandleScope scope(_env);
 
-inline Napi::Env CallbackInfo::Env() const {
-  return Napi::Env(_env);
+  napi_value value = other.Value();
+  if (value != nullptr) {
+    // Copying is a limited scenario (currently only used for Error object) and
+    // always creates a strong reference to the given value even if the incoming
+    // reference is weak.
+    napi_status status = napi_create_reference(_env, value, 1, &_ref);
+    NAPI_FATAL_IF_FAILED(
+        status, "Reference<T>::Reference", "napi_create_reference");
+  }
 }
 
-inline size_t CallbackInfo::Length() const {
-  return _argc;
+template <typename T>
+inline Reference<T>::operator napi_ref() const {
+  return _ref;
 }
 
-inline const Value CallbackInfo::operator[](size_t index) const {
-  return index < _argc ? Value(_env, _argv[index]) : Env().Undefined();
+template <typename T>
+inline bool Reference<T>::operator==(const Reference<T>& other) const {
+  HandleScope scope(_env);
+  return this->Value().StrictEquals(other.Value());
 }
 
-inline Value CallbackInfo::This() const {
-  if (_this == nullptr) {
-    return Env().Undefined();
-  }
-  return Object(_env, _this);
+template <typename T>
+inline bool Reference<T>::operator!=(const Reference<T>& other) const {
+  return !this->operator==(other);
 }
 
-inline void* CallbackInfo::Data() const {
-  return _data;
+template <typename T>
+inline Napi::Env Reference<T>::Env() const {
+  return Napi::Env(_env);
 }
 
-inline void CallbackInfo::SetData(void* data) {
-  _data = data;
+template <typename T>
+inline bool Reference<T>::IsEmpty() const {
+  return _ref == nullptr;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// PropertyDescriptor class
-////////////////////////////////////////////////////////////////////////////////
-
-template <typename PropertyDescriptor::GetterCallback Getter>
-PropertyDescriptor PropertyDescriptor::Accessor(
-    const char* utf8name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-
-  desc.utf8name = utf8name;
-  desc.getter = details::TemplatedCallback<Getter>;
-  desc.attributes = attributes;
-  desc.data = data;
+template <typename T>
+inline T Reference<T>::Value() const {
+  if (_ref == nullptr) {
+    return T(_env, nullptr);
+  }
 
-  return desc;
+  napi_value value;
+  napi_status status = napi_get_reference_value(_env, _ref, &value);
+  NAPI_THROW_IF_FAILED(_env, status, T());
+  return T(_env, value);
 }
 
-template <typename PropertyDescriptor::GetterCallback Getter>
-PropertyDescriptor PropertyDescriptor::Accessor(
-    const std::string& utf8name,
-    napi_property_attributes attributes,
-    void* data) {
-  return Accessor<Getter>(utf8name.c_str(), attributes, data);
+template <typename T>
+inline uint32_t Reference<T>::Ref() const {
+  uint32_t result;
+  napi_status status = napi_reference_ref(_env, _ref, &result);
+  NAPI_THROW_IF_FAILED(_env, status, 0);
+  return result;
 }
 
-template <typename PropertyDescriptor::GetterCallback Getter>
-PropertyDescriptor PropertyDescriptor::Accessor(
-    Name name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-
-  desc.name = name;
-  desc.getter = details::TemplatedCallback<Getter>;
-  desc.attributes = attributes;
-  desc.data = data;
+template <typename T>
+inline uint32_t Reference<T>::Unref() const {
+  uint32_t result;
+  napi_status status = napi_reference_unref(_env, _ref, &result);
+  NAPI_THROW_IF_FAILED(_env, status, 0);
+  return result;
+}
 
-  return desc;
+template <typename T>
+inline void Reference<T>::Reset() {
+#ifdef NODE_ADDON_API_SHARE_ERROR_REFERENCES
+  if (_shared != nullptr) {
+    ReleaseShare();
+    return;
+  }
+#endif  // NODE_ADDON_API_SHARE_ERROR_REFERENCES
+  if (_ref != nullptr) {
+    napi_status status = napi_delete_reference(_env, _ref);
+    NAPI_THROW_IF_FAILED_VOID(_env, status);
+    _ref = nullptr;
+  }
 }
 
-template <typename PropertyDescriptor::GetterCallback Getter,
-          typename PropertyDescriptor::SetterCallback Setter>
-PropertyDescriptor PropertyDescriptor::Accessor(
-    const char* utf8name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
+template <typename T>
+inline void Reference<T>::Reset(const T& value, uint32_t refcount) {
+  Reset();
+  _env = value.Env();
 
-  desc.utf8name = utf8name;
-  desc.getter = details::TemplatedCallback<Getter>;
-  desc.setter = details::TemplatedVoidCallback<Setter>;
-  desc.attributes = attributes;
-  desc.data = data;
+  napi_value val = value;
+  if (val != nullptr) {
+    napi_status status = napi_create_reference(_env, value, refcount, &_ref);
+    NAPI_THROW_IF_FAILED_VOID(_env, status);
+  }
+}
 
-  return desc;
+template <typename T>
+inline void Reference<T>::SuppressDestruct() {
+  _suppressDestruct = true;
 }
 
-template <typename PropertyDescriptor::GetterCallback Getter,
-          typename PropertyDescriptor::SetterCallback Setter>
-PropertyDescriptor PropertyDescriptor::Accessor(
-    const std::string& utf8name,
-    napi_property_attributes attributes,
-    void* data) {
-  return Accessor<Getter, Setter>(utf8name.c_str(), attributes, data);
+#ifdef NODE_ADDON_API_SHARE_ERROR_REFERENCES
+// The first copy moves `_ref` into a block that all copies share.
+template <typename T>
+inline details::SharedReferenceBlock* Reference<T>::Share() const {
+  if (_ref == nullptr) {
+    return nullptr;
+  }
+  if (_shared == nullptr) {
+    _shared = new details::SharedReferenceBlock{_env, _ref, 1};
+  }
+  return details::RetainSharedReference(_shared);
 }
 
-template <typename PropertyDescriptor::GetterCallback Getter,
-          typename PropertyDescriptor::SetterCallback Setter>
-PropertyDescriptor PropertyDescriptor::Accessor(
-    Name name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
+// Drops this reference's share. The `napi_ref` is deleted with the last one.
+template <typename T>
+inline void Reference<T>::ReleaseShare() {
+  details::ReleaseSharedReference(_shared);
+  _shared = nullptr;
+  _ref = nullptr;
+}
+#endif  // NODE_ADDON_API_SHARE_ERROR_REFERENCES
 
-  desc.name = name;
-  desc.getter = details::TemplatedCallback<Getter>;
-  desc.setter = details::TemplatedVoidCallback<Setter>;
-  desc.attributes = attributes;
-  desc.data = data;
+template <typename T>
+inline Reference<T> Weak(T value) {
+  return Reference<T>::New(value, 0);
+}
 
-  return desc;
+inline ObjectReference Weak(Object value) {
+  return Reference<Object>::New(value, 0);
 }
 
-template <typename Getter>
-inline PropertyDescriptor PropertyDescriptor::Accessor(
-    Napi::Env env,
-    Napi::Object object,
-    const char* utf8name,
-    Getter getter,
-    napi_property_attributes attributes,
-    void* data) {
-  using CbData = details::CallbackData<Getter, Napi::Value>;
-  auto callbackData = new CbData({getter, data});
+inline FunctionReference Weak(Function value) {
+  return Reference<Function>::New(value, 0);
+}
 
-  napi_status status = AttachData(env, object, callbackData);
-  if (status != napi_ok) {
-    delete callbackData;
-    NAPI_THROW_IF_FAILED(env, status, napi_property_descriptor());
-  }
+template <typename T>
+inline Reference<T> Persistent(T value) {
+  return Reference<T>::New(value, 1);
+}
 
-  return PropertyDescriptor({utf8name,
-                             nullptr,
-                             nullptr,
-                             CbData::Wrapper,
-                             nullptr,
-                             nullptr,
-                             attributes,
-                             callbackData});
+inline ObjectReference Persistent(Object value) {
+  return Reference<Object>::New(value, 1);
 }
 
-template <typename Getter>
-inline PropertyDescriptor PropertyDescriptor::Accessor(
-    Napi::Env env,
-    Napi::Object object,
-    const std::string& utf8name,
-    Getter getter,
-    napi_property_attributes attributes,
-    void* data) {
-  return Accessor(env, object, utf8name.c_str(), getter, attributes, data);
+inline FunctionReference Persistent(Function value) {
+  return Reference<Function>::New(value, 1);
 }
 
-template <typename Getter>
-inline PropertyDescriptor PropertyDescriptor::Accessor(
-    Napi::Env env,
-    Napi::Object object,
-    Name name,
-    Getter getter,
-    napi_property_attributes attributes,
-    void* data) {
-  using CbData = details::CallbackData<Getter, Napi::Value>;
-  auto callbackData = new CbData({getter, data});
+////////////////////////////////////////////////////////////////////////////////
+// SharedReference<T> class
+////////////////////////////////////////////////////////////////////////////////
 
-  napi_status status = AttachData(env, object, callbackData);
-  if (status != napi_ok) {
-    delete callbackData;
-    NAPI_THROW_IF_FAILED(env, status, napi_property_descriptor());
+template <typename T>
+inline SharedReference<T> SharedReference<T>::New(const T& value) {
+  napi_env env = value.Env();
+  napi_value val = value;
+  if (val == nullptr) {
+    return SharedReference<T>();
   }
 
-  return PropertyDescriptor({nullptr,
-                             name,
-                             nullptr,
-                             CbData::Wrapper,
-                             nullptr,
-                             nullptr,
-                             attributes,
-                             callbackData});
+  napi_ref ref;
+  napi_status status = napi_create_reference(env, val, 1, &ref);
+  NAPI_THROW_IF_FAILED(env, status, SharedReference<T>());
+  return SharedReference<T>(Reference<T>(env, ref));
 }
 
-template <typename Getter, typename Setter>
-inline PropertyDescriptor PropertyDescriptor::Accessor(
-    Napi::Env env,
-    Napi::Object object,
-    const char* utf8name,
-    Getter getter,
-    Setter setter,
-    napi_property_attributes attributes,
-    void* data) {
-  using CbData = details::AccessorCallbackData<Getter, Setter>;
-  auto callbackData = new CbData({getter, setter, data});
+template <typename T>
+inline SharedReference<T>::SharedReference() : _block(nullptr) {}
 
-  napi_status status = AttachData(env, object, callbackData);
-  if (status != napi_ok) {
-    delete callbackData;
-    NAPI_THROW_IF_FAILED(env, status, napi_property_descriptor());
+template <typename T>
+inline SharedReference<T>::SharedReference(Reference<T>&& reference)
+    : _block(nullptr) {
+  Reference<T> owned(std::move(reference));
+  napi_ref ref = owned;
+  if (ref != nullptr) {
+    // The block takes over deleting the `napi_ref`.
+    owned.SuppressDestruct();
+    _block = new details::SharedReferenceBlock{owned.Env(), ref, 1};
   }
-
-  return PropertyDescriptor({utf8name,
-                             nullptr,
-                             nullptr,
-                             CbData::GetterWrapper,
-                             CbData::SetterWrapper,
-                             nullptr,
-                             attributes,
-                             callbackData});
 }
 
-template <typename Getter, typename Setter>
-inline PropertyDescriptor PropertyDescriptor::Accessor(
-    Napi::Env env,
-    Napi::Object object,
-    const std::string& utf8name,
-    Getter getter,
-    Setter setter,
-    napi_property_attributes attributes,
-    void* data) {
-  return Accessor(
-      env, object, utf8name.c_str(), getter, setter, attributes, data);
+template <typename T>
+inline SharedReference<T>::~SharedReference() {
+  details::ReleaseSharedReference(_block);
 }
 
-template <typename Getter, typename Setter>
-inline PropertyDescriptor PropertyDescriptor::Accessor(
-    Napi::Env env,
-    Napi::Object object,
-    Name name,
-    Getter getter,
-    Setter setter,
-    napi_property_attributes attributes,
-    void* data) {
-  using CbData = details::AccessorCallbackData<Getter, Setter>;
-  auto callbackData = new CbData({getter, setter, data});
-
-  napi_status status = AttachData(env, object, callbackData);
-  if (status != napi_ok) {
-    delete callbackData;
-    NAPI_THROW_IF_FAILED(env, status, napi_property_descriptor());
-  }
+template <typename T>
+inline SharedReference<T>::SharedReference(const SharedReference<T>& other)
+    : _block(details::RetainSharedReference(other._block)) {}
 
-  return PropertyDescriptor({nullptr,
-                             name,
-                             nullptr,
-                             CbData::GetterWrapper,
-                             CbData::SetterWrapper,
-                             nullptr,
-                             attributes,
-                             callbackData});
+template <typename T>
+inline SharedReference<T>& SharedReference<T>::operator=(
+    const SharedReference<T>& other) {
+  details::SharedReferenceBlock* block =
+      details::RetainSharedReference(other._block);
+  details::ReleaseSharedReference(_block);
+  _block = block;
+  return *this;
 }
 
-template <typename Callable>
-inline PropertyDescriptor PropertyDescriptor::Function(
-    Napi::Env env,
-    Napi::Object /*object*/,
-    const char* utf8name,
-    Callable cb,
-    napi_property_attributes attributes,
-    void* data) {
-  return PropertyDescriptor({utf8name,
-                             nullptr,
-                             nullptr,
-                             nullptr,
-                             nullptr,
-                             Napi::Function::New(env, cb, utf8name, data),
-                             attributes,
-                             nullptr});
+template <typename T>
+inline SharedReference<T>::SharedReference(SharedReference<T>&& other)
+    : _block(other._block) {
+  other._block = nullptr;
 }
 
-template <typename Callable>
-inline PropertyDescriptor PropertyDescriptor::Function(
-    Napi::Env env,
-    Napi::Object object,
-    const std::string& utf8name,
-    Callable cb,
-    napi_property_attributes attributes,
-    void* data) {
-  return Function(env, object, utf8name.c_str(), cb, attributes, data);
+template <typename T>
+inline SharedReference<T>& SharedReference<T>::operator=(
+    SharedReference<T>&& other) {
+  if (this != &other) {
+    details::ReleaseSharedReference(_block);
+    _block = other._block;
+    other._block = nullptr;
+  }
+  return *this;
 }
 
-template <typename Callable>
-inline PropertyDescriptor PropertyDescriptor::Function(
-    Napi::Env env,
-    Napi::Object /*object*/,
-    Name name,
-    Callable cb,
-    napi_property_attributes attributes,
-    void* data) {
-  return PropertyDescriptor({nullptr,
-                             name,
-                             nullptr,
-                             nullptr,
-                             nullptr,
-                             Napi::Function::New(env, cb, nullptr, data),
-                             attributes,
-                             nullptr});
+template <typename T>
+inline SharedReference<T>::operator napi_ref() const {
+  return _block != nullptr ? _block->ref : nullptr;
 }
 
-inline PropertyDescriptor PropertyDescriptor::Value(
-    const char* utf8name,
-    napi_value value,
-    napi_property_attributes attributes) {
-  return PropertyDescriptor({utf8name,
-                             nullptr,
-                             nullptr,
-                             nullptr,
-                             nullptr,
-                             value,
-                             attributes,
-                             nullptr});
+template <typename T>
+inline bool SharedReference<T>::operator==(
+    const SharedReference<T>& other) const {
+  if (_block == other._block) {
+    return true;
+  }
+  if (_block == nullptr || other._block == nullptr) {
+    return false;
+  }
+  HandleScope scope(_block->env);
+  return Value().StrictEquals(other.Value());
 }
 
-inline PropertyDescriptor PropertyDescriptor::Value(
-    const std::string& utf8name,
-    napi_value value,
-    napi_property_attributes attributes) {
-  return Value(utf8name.c_str(), value, attributes);
+template <typename T>
+inline bool SharedReference<T>::operator!=(
+    const SharedReference<T>& other) const {
+  return !this->operator==(other);
 }
 
-inline PropertyDescriptor PropertyDescriptor::Value(
-    napi_value name, napi_value value, napi_property_attributes attributes) {
-  return PropertyDescriptor(
-      {nullptr, name, nullptr, nullptr, nullptr, value, attributes, nullptr});
+template <typename T>
+inline Napi::Env SharedReference<T>::Env() const {
+  return Napi::Env(_block != nullptr ? _block->env : nullptr);
 }
 
-inline PropertyDescriptor PropertyDescriptor::Value(
-    Name name, Napi::Value value, napi_property_attributes attributes) {
-  napi_value nameValue = name;
-  napi_value valueValue = value;
-  return PropertyDescriptor::Value(nameValue, valueValue, attributes);
+template <typename T>
+inline bool SharedReference<T>::IsEmpty() const {
+  return _block == nullptr;
 }
 
-inline PropertyDescriptor::PropertyDescriptor(napi_property_descriptor desc)
-    : _desc(desc) {}
+template <typename T>
+inline T SharedReference<T>::Value() const {
+  if (_block == nullptr) {
+    return T();
+  }
 
-inline PropertyDescriptor::operator napi_property_descriptor&() {
-  return _desc;
+  napi_value value;
+  napi_status status =
+      napi_get_reference_value(_block->env, _block->ref, &value);
+  NAPI_THROW_IF_FAILED(_block->env, status, T());
+  return T(_block->env, value);
 }
 
-inline PropertyDescriptor::operator const napi_property_descriptor&() const {
-  return _desc;
+template <typename T>
+inline uint32_t SharedReference<T>::UseCount() const {
+  return _block != nullptr ? _block->count : 0;
+}
+
+template <typename T>
+inline void SharedReference<T>::Reset() {
+  details::ReleaseSharedReference(_block);
+  _block = nullptr;
 }
 
+#if NAPI_VERSION > 2
 ////////////////////////////////////////////////////////////////////////////////
-// InstanceWrap<T> class
+// Builtins class
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
-inline void InstanceWrap<T>::AttachPropData(
-    napi_env env, napi_value value, const napi_property_descriptor* prop) {
-  napi_status status;
-  if (!(prop->attributes & napi_static)) {
-    if (prop->method == T::InstanceVoidMethodCallbackWrapper) {
-      status = Napi::details::AttachData(
-          env, value, static_cast<InstanceVoidMethodCallbackData*>(prop->data));
-      NAPI_THROW_IF_FAILED_VOID(env, status);
-    } else if (prop->method == T::InstanceMethodCallbackWrapper) {
-      status = Napi::details::AttachData(
-          env, value, static_cast<InstanceMethodCallbackData*>(prop->data));
-      NAPI_THROW_IF_FAILED_VOID(env, status);
-    } else if (prop->getter == T::InstanceGetterCallbackWrapper ||
-               prop->setter == T::InstanceSetterCallbackWrapper) {
-      status = Napi::details::AttachData(
-          env, value, static_cast<InstanceAccessorCallbackData*>(prop->data));
-      NAPI_THROW_IF_FAILED_VOID(env, status);
-    }
-  }
+inline Function Builtins::JsonParse(napi_env env) {
+  return Get(env, kJsonParse);
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceMethod(
-    const char* utf8name,
-    InstanceVoidMethodCallback method,
-    napi_property_attributes attributes,
-    void* data) {
-  InstanceVoidMethodCallbackData* callbackData =
-      new InstanceVoidMethodCallbackData({method, data});
+inline Function Builtins::JsonStringify(napi_env env) {
+  return Get(env, kJsonStringify);
+}
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.method = T::InstanceVoidMethodCallbackWrapper;
-  desc.data = callbackData;
-  desc.attributes = attributes;
-  return desc;
+inline Function Builtins::ArrayFrom(napi_env env) {
+  return Get(env, kArrayFrom);
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceMethod(
-    const char* utf8name,
-    InstanceMethodCallback method,
-    napi_property_attributes attributes,
-    void* data) {
-  InstanceMethodCallbackData* callbackData =
-      new InstanceMethodCallbackData({method, data});
+inline Function Builtins::ArrayFlat(napi_env env) {
+  return Get(env, kArrayFlat);
+}
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.method = T::InstanceMethodCallbackWrapper;
-  desc.data = callbackData;
-  desc.attributes = attributes;
-  return desc;
+inline Function Builtins::ArrayPush(napi_env env) {
+  return Get(env, kArrayPush);
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceMethod(
-    Symbol name,
-    InstanceVoidMethodCallback method,
-    napi_property_attributes attributes,
-    void* data) {
-  InstanceVoidMethodCallbackData* callbackData =
-      new InstanceVoidMethodCallbackData({method, data});
+inline Function Builtins::MapConstructor(napi_env env) {
+  return Get(env, kMapConstructor);
+}
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.method = T::InstanceVoidMethodCallbackWrapper;
-  desc.data = callbackData;
-  desc.attributes = attributes;
-  return desc;
+inline Function Builtins::MapGet(napi_env env) {
+  return Get(env, kMapGet);
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceMethod(
-    Symbol name,
-    InstanceMethodCallback method,
-    napi_property_attributes attributes,
-    void* data) {
-  InstanceMethodCallbackData* callbackData =
-      new InstanceMethodCallbackData({method, data});
+inline Function Builtins::MapSet(napi_env env) {
+  return Get(env, kMapSet);
+}
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.method = T::InstanceMethodCallbackWrapper;
-  desc.data = callbackData;
-  desc.attributes = attributes;
-  return desc;
+inline Function Builtins::MapHas(napi_env env) {
+  return Get(env, kMapHas);
 }
 
-template <typename T>
-template <typename InstanceWrap<T>::InstanceVoidMethodCallback method>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceMethod(
-    const char* utf8name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.method = details::TemplatedInstanceVoidCallback<T, method>;
-  desc.data = data;
-  desc.attributes = attributes;
-  return desc;
+inline Function Builtins::MapDelete(napi_env env) {
+  return Get(env, kMapDelete);
 }
 
-template <typename T>
-template <typename InstanceWrap<T>::InstanceMethodCallback method>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceMethod(
-    const char* utf8name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.method = details::TemplatedInstanceCallback<T, method>;
-  desc.data = data;
-  desc.attributes = attributes;
-  return desc;
+inline Function Builtins::SetConstructor(napi_env env) {
+  return Get(env, kSetConstructor);
 }
 
-template <typename T>
-template <typename InstanceWrap<T>::InstanceVoidMethodCallback method>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceMethod(
-    Symbol name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.method = details::TemplatedInstanceVoidCallback<T, method>;
-  desc.data = data;
-  desc.attributes = attributes;
-  return desc;
+inline Function Builtins::SetAdd(napi_env env) {
+  return Get(env, kSetAdd);
 }
 
-template <typename T>
-template <typename InstanceWrap<T>::InstanceMethodCallback method>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceMethod(
-    Symbol name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.method = details::TemplatedInstanceCallback<T, method>;
-  desc.data = data;
-  desc.attributes = attributes;
-  return desc;
+inline Function Builtins::SetHas(napi_env env) {
+  return Get(env, kSetHas);
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceAccessor(
-    const char* utf8name,
-    InstanceGetterCallback getter,
-    InstanceSetterCallback setter,
-    napi_property_attributes attributes,
-    void* data) {
-  InstanceAccessorCallbackData* callbackData =
-      new InstanceAccessorCallbackData({getter, setter, data});
+inline Function Builtins::SetDelete(napi_env env) {
+  return Get(env, kSetDelete);
+}
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.getter = getter != nullptr ? T::InstanceGetterCallbackWrapper : nullptr;
-  desc.setter = setter != nullptr ? T::InstanceSetterCallbackWrapper : nullptr;
-  desc.data = callbackData;
-  desc.attributes = attributes;
-  return desc;
+inline Function Builtins::SymbolFor(napi_env env) {
+  return Get(env, kSymbolFor);
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceAccessor(
-    Symbol name,
-    InstanceGetterCallback getter,
-    InstanceSetterCallback setter,
-    napi_property_attributes attributes,
-    void* data) {
-  InstanceAccessorCallbackData* callbackData =
-      new InstanceAccessorCallbackData({getter, setter, data});
+inline Symbol Builtins::WellKnownSymbol(napi_env env, const std::string& name) {
+  return GetSymbol(env, false, name);
+}
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.getter = getter != nullptr ? T::InstanceGetterCallbackWrapper : nullptr;
-  desc.setter = setter != nullptr ? T::InstanceSetterCallbackWrapper : nullptr;
-  desc.data = callbackData;
-  desc.attributes = attributes;
-  return desc;
+inline Symbol Builtins::RegisteredSymbol(napi_env env,
+                                         const std::string& description) {
+  return GetSymbol(env, true, description);
 }
 
-template <typename T>
-template <typename InstanceWrap<T>::InstanceGetterCallback getter,
-          typename InstanceWrap<T>::InstanceSetterCallback setter>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceAccessor(
-    const char* utf8name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.getter = details::TemplatedInstanceCallback<T, getter>;
-  desc.setter = This::WrapSetter(This::SetterTag<setter>());
-  desc.data = data;
-  desc.attributes = attributes;
-  return desc;
+inline Builtins::Builtins(napi_env env) : _env(env), _refs() {}
+
+inline Builtins::~Builtins() {
+  for (napi_ref ref : _refs) {
+    if (ref != nullptr) {
+      napi_delete_reference(_env, ref);
+    }
+  }
+  for (const auto& entry : _wellKnownSymbols) {
+    napi_delete_reference(_env, entry.second);
+  }
+  for (const auto& entry : _registeredSymbols) {
+    napi_delete_reference(_env, entry.second);
+  }
 }
 
-template <typename T>
-template <typename InstanceWrap<T>::InstanceGetterCallback getter,
-          typename InstanceWrap<T>::InstanceSetterCallback setter>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceAccessor(
-    Symbol name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.getter = details::TemplatedInstanceCallback<T, getter>;
-  desc.setter = This::WrapSetter(This::SetterTag<setter>());
-  desc.data = data;
-  desc.attributes = attributes;
-  return desc;
+inline std::unordered_map<napi_env, Builtins*>& Builtins::Instances() {
+  // An environment is only ever used from the thread that runs it, so a
+  // per-thread table needs no locking.
+  static thread_local std::unordered_map<napi_env, Builtins*> instances;
+  return instances;
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceValue(
-    const char* utf8name,
-    Napi::Value value,
-    napi_property_attributes attributes) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.value = value;
-  desc.attributes = attributes;
-  return desc;
+inline Builtins* Builtins::For(napi_env env) {
+  std::unordered_map<napi_env, Builtins*>& instances = Instances();
+  auto it = instances.find(env);
+  if (it != instances.end()) {
+    return it->second;
+  }
+
+  Builtins* builtins = new Builtins(env);
+  napi_status status = napi_add_env_cleanup_hook(env, Cleanup, builtins);
+  if (status != napi_ok) {
+    delete builtins;
+    NAPI_THROW_IF_FAILED(env, status, nullptr);
+  }
+  instances.emplace(env, builtins);
+  return builtins;
+}
+
+inline void Builtins::Cleanup(void* data) {
+  Builtins* builtins = static_cast<Builtins*>(data);
+  Instances().erase(builtins->_env);
+  delete builtins;
+}
+
+inline Function Builtins::Get(napi_env env, Slot slot) {
+  // The property path leading from the global object to each intrinsic.
+  static const char* const paths[kSlotCount][3] = {
+      {"JSON", "parse", nullptr},
+      {"JSON", "stringify", nullptr},
+      {"Array", "from", nullptr},
+      {"Array", "prototype", "flat"},
+      {"Array", "prototype", "push"},
+      {"Map", nullptr, nullptr},
+      {"Map", "prototype", "get"},
+      {"Map", "prototype", "set"},
+      {"Map", "prototype", "has"},
+      {"Map", "prototype", "delete"},
+      {"Set", nullptr, nullptr},
+      {"Set", "prototype", "add"},
+      {"Set", "prototype", "has"},
+      {"Set", "prototype", "delete"},
+      {"Symbol", "for", nullptr},
+  };
+
+  Builtins* builtins = For(env);
+  if (builtins == nullptr) {
+    return Function();
+  }
+
+  napi_status status;
+  napi_value value;
+  napi_ref& ref = builtins->_refs[slot];
+  if (ref != nullptr) {
+    status = napi_get_reference_value(env, ref, &value);
+    NAPI_THROW_IF_FAILED(env, status, Function());
+    return Function(env, value);
+  }
+
+  status = napi_get_global(env, &value);
+  NAPI_THROW_IF_FAILED(env, status, Function());
+  for (const char* name : paths[slot]) {
+    if (name == nullptr) {
+      break;
+    }
+    status = napi_get_named_property(env, value, name, &value);
+    NAPI_THROW_IF_FAILED(env, status, Function());
+  }
+
+  napi_valuetype type;
+  status = napi_typeof(env, value, &type);
+  NAPI_THROW_IF_FAILED(env, status, Function());
+  if (type != napi_function) {
+    NAPI_THROW(TypeError::New(env, "Builtin is not a function."), Function());
+  }
+
+  status = napi_create_reference(env, value, 1, &ref);
+  NAPI_THROW_IF_FAILED(env, status, Function());
+  return Function(env, value);
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> InstanceWrap<T>::InstanceValue(
-    Symbol name, Napi::Value value, napi_property_attributes attributes) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.value = value;
-  desc.attributes = attributes;
-  return desc;
+inline Symbol Builtins::GetSymbol(napi_env env,
+                                  bool registered,
+                                  const std::string& key) {
+  Builtins* builtins = For(env);
+  if (builtins == nullptr) {
+    return Symbol();
+  }
+
+  std::unordered_map<std::string, napi_ref>& symbols =
+      registered ? builtins->_registeredSymbols : builtins->_wellKnownSymbols;
+  napi_status status;
+  napi_value value;
+  auto it = symbols.find(key);
+  if (it != symbols.end()) {
+    status = napi_get_reference_value(env, it->second, &value);
+    NAPI_THROW_IF_FAILED(env, status, Symbol());
+    return Symbol(env, value);
+  }
+
+  if (registered) {
+    Function symbolFor = Get(env, kSymbolFor);
+    if (symbolFor.IsEmpty()) {
+      return Symbol();
+    }
+    napi_value description;
+    status =
+        napi_create_string_utf8(env, key.data(), key.size(), &description);
+    NAPI_THROW_IF_FAILED(env, status, Symbol());
+    status = napi_call_function(
+        env, Env(env).Undefined(), symbolFor, 1, &description, &value);
+  } else {
+    status = napi_get_global(env, &value);
+    NAPI_THROW_IF_FAILED(env, status, Symbol());
+    status = napi_get_named_property(env, value, "Symbol", &value);
+    NAPI_THROW_IF_FAILED(env, status, Symbol());
+    status = napi_get_named_property(env, value, key.c_str(), &value);
+  }
+  NAPI_THROW_IF_FAILED(env, status, Symbol());
+
+  // Only symbols are cached. Anything else, such as `undefined` for a name
+  // that is not a well-known symbol, is returned as it is.
+  napi_valuetype type;
+  status = napi_typeof(env, value, &type);
+  NAPI_THROW_IF_FAILED(env, status, Symbol());
+  if (type != napi_symbol) {
+    return Symbol(env, value);
+  }
+
+  napi_ref ref;
+  status = napi_create_reference(env, value, 1, &ref);
+  NAPI_THROW_IF_FAILED(env, status, Symbol());
+  symbols.emplace(key, ref);
+  return Symbol(env, value);
 }
 
-template <typename T>
-inline napi_value InstanceWrap<T>::InstanceVoidMethodCallbackWrapper(
-    napi_env env, napi_callback_info info) {
-  return details::WrapCallback([&] {
-    CallbackInfo callbackInfo(env, info);
-    InstanceVoidMethodCallbackData* callbackData =
-        reinterpret_cast<InstanceVoidMethodCallbackData*>(callbackInfo.Data());
-    callbackInfo.SetData(callbackData->data);
-    T* instance = T::Unwrap(callbackInfo.This().As<Object>());
-    auto cb = callbackData->callback;
-    if (instance) (instance->*cb)(callbackInfo);
-    return nullptr;
-  });
+////////////////////////////////////////////////////////////////////////////////
+// Json class
+////////////////////////////////////////////////////////////////////////////////
+
+inline MaybeOrValue<Value> Json::Parse(napi_env env, napi_value json) {
+  return Builtins::JsonParse(env).Call(Env(env).Undefined(), {json});
 }
 
-template <typename T>
-inline napi_value InstanceWrap<T>::InstanceMethodCallbackWrapper(
-    napi_env env, napi_callback_info info) {
-  return details::WrapCallback([&] {
-    CallbackInfo callbackInfo(env, info);
-    InstanceMethodCallbackData* callbackData =
-        reinterpret_cast<InstanceMethodCallbackData*>(callbackInfo.Data());
-    callbackInfo.SetData(callbackData->data);
-    T* instance = T::Unwrap(callbackInfo.This().As<Object>());
-    auto cb = callbackData->callback;
-    return instance ? (instance->*cb)(callbackInfo) : Napi::Value();
-  });
+inline MaybeOrValue<Value> Json::Parse(napi_env env, const String& json) {
+  return Parse(env, static_cast<napi_value>(json));
 }
 
-template <typename T>
-inline napi_value InstanceWrap<T>::InstanceGetterCallbackWrapper(
-    napi_env env, napi_callback_info info) {
-  return details::WrapCallback([&] {
-    CallbackInfo callbackInfo(env, info);
-    InstanceAccessorCallbackData* callbackData =
-        reinterpret_cast<InstanceAccessorCallbackData*>(callbackInfo.Data());
-    callbackInfo.SetData(callbackData->data);
-    T* instance = T::Unwrap(callbackInfo.This().As<Object>());
-    auto cb = callbackData->getterCallback;
-    return instance ? (instance->*cb)(callbackInfo) : Napi::Value();
-  });
+inline MaybeOrValue<Value> Json::Parse(napi_env env,
+                                       const char* utf8json,
+                                       size_t length) {
+  return Parse(env,
+               static_cast<napi_value>(String::New(env, utf8json, length)));
 }
 
-template <typename T>
-inline napi_value InstanceWrap<T>::InstanceSetterCallbackWrapper(
-    napi_env env, napi_callback_info info) {
-  return details::WrapCallback([&] {
-    CallbackInfo callbackInfo(env, info);
-    InstanceAccessorCallbackData* callbackData =
-        reinterpret_cast<InstanceAccessorCallbackData*>(callbackInfo.Data());
-    callbackInfo.SetData(callbackData->data);
-    T* instance = T::Unwrap(callbackInfo.This().As<Object>());
-    auto cb = callbackData->setterCallback;
-    if (instance) (instance->*cb)(callbackInfo, callbackInfo[0]);
-    return nullptr;
-  });
+inline MaybeOrValue<Value> Json::Parse(napi_env env, const std::string& json) {
+  return Parse(env, json.data(), json.size());
 }
 
-template <typename T>
-template <typename InstanceWrap<T>::InstanceSetterCallback method>
-inline napi_value InstanceWrap<T>::WrappedMethod(
-    napi_env env, napi_callback_info info) NAPI_NOEXCEPT {
-  return details::WrapCallback([&] {
-    const CallbackInfo cbInfo(env, info);
-    T* instance = T::Unwrap(cbInfo.This().As<Object>());
-    if (instance) (instance->*method)(cbInfo, cbInfo[0]);
-    return nullptr;
-  });
+#ifdef NAPI_HAS_CPP17
+inline MaybeOrValue<Value> Json::Parse(napi_env env, std::string_view json) {
+  return Parse(env, json.data(), json.size());
+}
+#endif  // NAPI_HAS_CPP17
+
+inline MaybeOrValue<Value> Json::Stringify(napi_env env, napi_value value) {
+  return Builtins::JsonStringify(env).Call(Env(env).Undefined(), {value});
 }
 
+inline MaybeOrValue<Value> Json::Stringify(napi_env env,
+                                           napi_value value,
+                                           napi_value replacer,
+                                           napi_value space) {
+  return Builtins::JsonStringify(env).Call(Env(env).Undefined(),
+                                           {value, replacer, space});
+}
+#endif  // NAPI_VERSION > 2
+
 ////////////////////////////////////////////////////////////////////////////////
-// ObjectWrap<T> class
+// ObjectReference class
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
-inline ObjectWrap<T>::ObjectWrap(const Napi::CallbackInfo& callbackInfo) {
-  napi_env env = callbackInfo.Env();
-  napi_value wrapper = callbackInfo.This();
-  napi_status status;
-  napi_ref ref;
-  T* instance = static_cast<T*>(this);
-  status = napi_wrap(env, wrapper, instance, FinalizeCallback, nullptr, &ref);
-  NAPI_THROW_IF_FAILED_VOID(env, status);
+inline ObjectReference::ObjectReference() : Reference<Object>() {}
+
+inline ObjectReference::ObjectReference(napi_env env, napi_ref ref)
+    : Reference<Object>(env, ref) {}
+
+inline ObjectReference::ObjectReference(Reference<Object>&& other)
+    : Reference<Object>(std::move(other)) {}
 
-  Reference<Object>* instanceRef = instance;
-  *instanceRef = Reference<Object>(env, ref);
+inline ObjectReference& ObjectReference::operator=(Reference<Object>&& other) {
+  static_cast<Reference<Object>*>(this)->operator=(std::move(other));
+  return *this;
 }
 
-template <typename T>
-inline ObjectWrap<T>::~ObjectWrap() {
-  // If the JS object still exists at this point, remove the finalizer added
-  // through `napi_wrap()`.
-  if (!IsEmpty()) {
-    Object object = Value();
-    // It is not valid to call `napi_remove_wrap()` with an empty `object`.
-    // This happens e.g. during garbage collection.
-    if (!object.IsEmpty() && _construction_failed) {
-      napi_remove_wrap(Env(), object, nullptr);
-    }
+inline ObjectReference::ObjectReference(ObjectReference&& other)
+    : Reference<Object>(std::move(other)) {}
+
+inline ObjectReference& ObjectReference::operator=(ObjectReference&& other) {
+  static_cast<Reference<Object>*>(this)->operator=(std::move(other));
+  return *this;
+}
+
+inline ObjectReference::ObjectReference(const ObjectReference& other)
+    : Reference<Object>(other) {}
+
+inline MaybeOrValue<Napi::Value> ObjectReference::Get(
+    const char* utf8name) const {
+  EscapableHandleScope scope(_env);
+  MaybeOrValue<Napi::Value> result = Value().Get(utf8name);
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  if (result.IsJust()) {
+    return Just(scope.Escape(result.Unwrap()));
+  }
+  return result;
+#else
+  if (scope.Env().IsExceptionPending()) {
+    return Value();
+  }
+  return scope.Escape(result);
+#endif
+}
+
+inline MaybeOrValue<Napi::Value> ObjectReference::Get(
+    const std::string& utf8name) const {
+  EscapableHandleScope scope(_env);
+  MaybeOrValue<Napi::Value> result = Value().Get(utf8name);
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  if (result.IsJust()) {
+    return Just(scope.Escape(result.Unwrap()));
+  }
+  return result;
+#else
+  if (scope.Env().IsExceptionPending()) {
+    return Value();
   }
+  return scope.Escape(result);
+#endif
 }
 
-template <typename T>
-inline T* ObjectWrap<T>::Unwrap(Object wrapper) {
-  void* unwrapped;
-  napi_status status = napi_unwrap(wrapper.Env(), wrapper, &unwrapped);
-  NAPI_THROW_IF_FAILED(wrapper.Env(), status, nullptr);
-  return static_cast<T*>(unwrapped);
+inline MaybeOrValue<bool> ObjectReference::Set(const char* utf8name,
+                                               napi_value value) const {
+  HandleScope scope(_env);
+  return Value().Set(utf8name, value);
 }
 
-template <typename T>
-inline Function ObjectWrap<T>::DefineClass(
-    Napi::Env env,
-    const char* utf8name,
-    const size_t props_count,
-    const napi_property_descriptor* descriptors,
-    void* data) {
-  napi_status status;
-  std::vector<napi_property_descriptor> props(props_count);
-
-  // We copy the descriptors to a local array because before defining the class
-  // we must replace static method property descriptors with value property
-  // descriptors such that the value is a function-valued `napi_value` created
-  // with `CreateFunction()`.
-  //
-  // This replacement could be made for instance methods as well, but V8 aborts
-  // if we do that, because it expects methods defined on the prototype template
-  // to have `FunctionTemplate`s.
-  for (size_t index = 0; index < props_count; index++) {
-    props[index] = descriptors[index];
-    napi_property_descriptor* prop = &props[index];
-    if (prop->method == T::StaticMethodCallbackWrapper) {
-      status =
-          CreateFunction(env,
-                         utf8name,
-                         prop->method,
-                         static_cast<StaticMethodCallbackData*>(prop->data),
-                         &(prop->value));
-      NAPI_THROW_IF_FAILED(env, status, Function());
-      prop->method = nullptr;
-      prop->data = nullptr;
-    } else if (prop->method == T::StaticVoidMethodCallbackWrapper) {
-      status =
-          CreateFunction(env,
-                         utf8name,
-                         prop->method,
-                         static_cast<StaticVoidMethodCallbackData*>(prop->data),
-                         &(prop->value));
-      NAPI_THROW_IF_FAILED(env, status, Function());
-      prop->method = nullptr;
-      prop->data = nullptr;
-    }
-  }
-
-  napi_value value;
-  status = napi_define_class(env,
-                             utf8name,
-                             NAPI_AUTO_LENGTH,
-                             T::ConstructorCallbackWrapper,
-                             data,
-                             props_count,
-                             props.data(),
-                             &value);
-  NAPI_THROW_IF_FAILED(env, status, Function());
-
-  // After defining the class we iterate once more over the property descriptors
-  // and attach the data associated with accessors and instance methods to the
-  // newly created JavaScript class.
-  for (size_t idx = 0; idx < props_count; idx++) {
-    const napi_property_descriptor* prop = &props[idx];
-
-    if (prop->getter == T::StaticGetterCallbackWrapper ||
-        prop->setter == T::StaticSetterCallbackWrapper) {
-      status = Napi::details::AttachData(
-          env, value, static_cast<StaticAccessorCallbackData*>(prop->data));
-      NAPI_THROW_IF_FAILED(env, status, Function());
-    } else {
-      // InstanceWrap<T>::AttachPropData is responsible for attaching the data
-      // of instance methods and accessors.
-      T::AttachPropData(env, value, prop);
-    }
-  }
+inline MaybeOrValue<bool> ObjectReference::Set(const char* utf8name,
+                                               Napi::Value value) const {
+  HandleScope scope(_env);
+  return Value().Set(utf8name, value);
+}
 
-  return Function(env, value);
+inline MaybeOrValue<bool> ObjectReference::Set(const char* utf8name,
+                                               const char* utf8value) const {
+  HandleScope scope(_env);
+  return Value().Set(utf8name, utf8value);
 }
 
-template <typename T>
-inline Function ObjectWrap<T>::DefineClass(
-    Napi::Env env,
-    const char* utf8name,
-    const std::initializer_list<ClassPropertyDescriptor<T>>& properties,
-    void* data) {
-  return DefineClass(
-      env,
-      utf8name,
-      properties.size(),
-      reinterpret_cast<const napi_property_descriptor*>(properties.begin()),
-      data);
+inline MaybeOrValue<bool> ObjectReference::Set(const char* utf8name,
+                                               bool boolValue) const {
+  HandleScope scope(_env);
+  return Value().Set(utf8name, boolValue);
 }
 
-template <typename T>
-inline Function ObjectWrap<T>::DefineClass(
-    Napi::Env env,
-    const char* utf8name,
-    const std::vector<ClassPropertyDescriptor<T>>& properties,
-    void* data) {
-  return DefineClass(
-      env,
-      utf8name,
-      properties.size(),
-      reinterpret_cast<const napi_property_descriptor*>(properties.data()),
-      data);
+inline MaybeOrValue<bool> ObjectReference::Set(const char* utf8name,
+                                               double numberValue) const {
+  HandleScope scope(_env);
+  return Value().Set(utf8name, numberValue);
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticMethod(
-    const char* utf8name,
-    StaticVoidMethodCallback method,
-    napi_property_attributes attributes,
-    void* data) {
-  StaticVoidMethodCallbackData* callbackData =
-      new StaticVoidMethodCallbackData({method, data});
+inline MaybeOrValue<bool> ObjectReference::Set(const std::string& utf8name,
+                                               napi_value value) const {
+  HandleScope scope(_env);
+  return Value().Set(utf8name, value);
+}
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.method = T::StaticVoidMethodCallbackWrapper;
-  desc.data = callbackData;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
+inline MaybeOrValue<bool> ObjectReference::Set(const std::string& utf8name,
+                                               Napi::Value value) const {
+  HandleScope scope(_env);
+  return Value().Set(utf8name, value);
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticMethod(
-    const char* utf8name,
-    StaticMethodCallback method,
-    napi_property_attributes attributes,
-    void* data) {
-  StaticMethodCallbackData* callbackData =
-      new StaticMethodCallbackData({method, data});
+inline MaybeOrValue<bool> ObjectReference::Set(const std::string& utf8name,
+                                               std::string& utf8value) const {
+  HandleScope scope(_env);
+  return Value().Set(utf8name, utf8value);
+}
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.method = T::StaticMethodCallbackWrapper;
-  desc.data = callbackData;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
+inline MaybeOrValue<bool> ObjectReference::Set(const std::string& utf8name,
+                                               bool boolValue) const {
+  HandleScope scope(_env);
+  return Value().Set(utf8name, boolValue);
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticMethod(
-    Symbol name,
-    StaticVoidMethodCallback method,
-    napi_property_attributes attributes,
-    void* data) {
-  StaticVoidMethodCallbackData* callbackData =
-      new StaticVoidMethodCallbackData({method, data});
+inline MaybeOrValue<bool> ObjectReference::Set(const std::string& utf8name,
+                                               double numberValue) const {
+  HandleScope scope(_env);
+  return Value().Set(utf8name, numberValue);
+}
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.method = T::StaticVoidMethodCallbackWrapper;
-  desc.data = callbackData;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
+inline MaybeOrValue<Napi::Value> ObjectReference::Get(uint32_t index) const {
+  EscapableHandleScope scope(_env);
+  MaybeOrValue<Napi::Value> result = Value().Get(index);
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  if (result.IsJust()) {
+    return Just(scope.Escape(result.Unwrap()));
+  }
+  return result;
+#else
+  if (scope.Env().IsExceptionPending()) {
+    return Value();
+  }
+  return scope.Escape(result);
+#endif
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticMethod(
-    Symbol name,
-    StaticMethodCallback method,
-    napi_property_attributes attributes,
-    void* data) {
-  StaticMethodCallbackData* callbackData =
-      new StaticMethodCallbackData({method, data});
+inline MaybeOrValue<bool> ObjectReference::Set(uint32_t index,
+                                               napi_value value) const {
+  HandleScope scope(_env);
+  return Value().Set(index, value);
+}
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.method = T::StaticMethodCallbackWrapper;
-  desc.data = callbackData;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
+inline MaybeOrValue<bool> ObjectReference::Set(uint32_t index,
+                                               Napi::Value value) const {
+  HandleScope scope(_env);
+  return Value().Set(index, value);
 }
 
-template <typename T>
-template <typename ObjectWrap<T>::StaticVoidMethodCallback method>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticMethod(
-    const char* utf8name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.method = details::TemplatedVoidCallback<method>;
-  desc.data = data;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
+inline MaybeOrValue<bool> ObjectReference::Set(uint32_t index,
+                                               const char* utf8value) const {
+  HandleScope scope(_env);
+  return Value().Set(index, utf8value);
 }
 
-template <typename T>
-template <typename ObjectWrap<T>::StaticVoidMethodCallback method>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticMethod(
-    Symbol name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.method = details::TemplatedVoidCallback<method>;
-  desc.data = data;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
+inline MaybeOrValue<bool> ObjectReference::Set(
+    uint32_t index, const std::string& utf8value) const {
+  HandleScope scope(_env);
+  return Value().Set(index, utf8value);
 }
 
-template <typename T>
-template <typename ObjectWrap<T>::StaticMethodCallback method>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticMethod(
-    const char* utf8name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.method = details::TemplatedCallback<method>;
-  desc.data = data;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
+inline MaybeOrValue<bool> ObjectReference::Set(uint32_t index,
+                                               bool boolValue) const {
+  HandleScope scope(_env);
+  return Value().Set(index, boolValue);
 }
 
-template <typename T>
-template <typename ObjectWrap<T>::StaticMethodCallback method>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticMethod(
-    Symbol name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.method = details::TemplatedCallback<method>;
-  desc.data = data;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
+inline MaybeOrValue<bool> ObjectReference::Set(uint32_t index,
+                                               double numberValue) const {
+  HandleScope scope(_env);
+  return Value().Set(index, numberValue);
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticAccessor(
-    const char* utf8name,
-    StaticGetterCallback getter,
-    StaticSetterCallback setter,
-    napi_property_attributes attributes,
-    void* data) {
-  StaticAccessorCallbackData* callbackData =
-      new StaticAccessorCallbackData({getter, setter, data});
+////////////////////////////////////////////////////////////////////////////////
+// FunctionReference class
+////////////////////////////////////////////////////////////////////////////////
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.getter = getter != nullptr ? T::StaticGetterCallbackWrapper : nullptr;
-  desc.setter = setter != nullptr ? T::StaticSetterCallbackWrapper : nullptr;
-  desc.data = callbackData;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
-}
+inline FunctionReference::FunctionReference() : Reference<Function>() {}
 
-template <typename T>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticAccessor(
-    Symbol name,
-    StaticGetterCallback getter,
-    StaticSetterCallback setter,
-    napi_property_attributes attributes,
-    void* data) {
-  StaticAccessorCallbackData* callbackData =
-      new StaticAccessorCallbackData({getter, setter, data});
+inline FunctionReference::FunctionReference(napi_env env, napi_ref ref)
+    : Reference<Function>(env, ref) {}
 
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.getter = getter != nullptr ? T::StaticGetterCallbackWrapper : nullptr;
-  desc.setter = setter != nullptr ? T::StaticSetterCallbackWrapper : nullptr;
-  desc.data = callbackData;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
-}
+inline FunctionReference::FunctionReference(Reference<Function>&& other)
+    : Reference<Function>(std::move(other)) {}
 
-template <typename T>
-template <typename ObjectWrap<T>::StaticGetterCallback getter,
-          typename ObjectWrap<T>::StaticSetterCallback setter>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticAccessor(
-    const char* utf8name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.getter = details::TemplatedCallback<getter>;
-  desc.setter = This::WrapStaticSetter(This::StaticSetterTag<setter>());
-  desc.data = data;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
+inline FunctionReference& FunctionReference::operator=(
+    Reference<Function>&& other) {
+  static_cast<Reference<Function>*>(this)->operator=(std::move(other));
+  return *this;
 }
 
-template <typename T>
-template <typename ObjectWrap<T>::StaticGetterCallback getter,
-          typename ObjectWrap<T>::StaticSetterCallback setter>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticAccessor(
-    Symbol name, napi_property_attributes attributes, void* data) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.getter = details::TemplatedCallback<getter>;
-  desc.setter = This::WrapStaticSetter(This::StaticSetterTag<setter>());
-  desc.data = data;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
-}
+inline FunctionReference::FunctionReference(FunctionReference&& other)
+    : Reference<Function>(std::move(other)) {}
 
-template <typename T>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticValue(
-    const char* utf8name,
-    Napi::Value value,
-    napi_property_attributes attributes) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.utf8name = utf8name;
-  desc.value = value;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
+inline FunctionReference& FunctionReference::operator=(
+    FunctionReference&& other) {
+  static_cast<Reference<Function>*>(this)->operator=(std::move(other));
+  return *this;
 }
 
-template <typename T>
-inline ClassPropertyDescriptor<T> ObjectWrap<T>::StaticValue(
-    Symbol name, Napi::Value value, napi_property_attributes attributes) {
-  napi_property_descriptor desc = napi_property_descriptor();
-  desc.name = name;
-  desc.value = value;
-  desc.attributes =
-      static_cast<napi_property_attributes>(attributes | napi_static);
-  return desc;
-}
+namespace details {
 
+// Escapes the result of a call made inside `scope`. A failed call has already
+// left its exception pending (or thrown it), so an empty result is returned
+// as is rather than asking Node-API whether an exception is pending.
 template <typename T>
-inline Value ObjectWrap<T>::OnCalledAsFunction(
-    const Napi::CallbackInfo& callbackInfo) {
-  NAPI_THROW(
-      TypeError::New(callbackInfo.Env(),
-                     "Class constructors cannot be invoked without 'new'"),
-      Napi::Value());
+inline MaybeOrValue<T> EscapeCallResult(EscapableHandleScope& scope,
+                                        const MaybeOrValue<T>& result) {
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  if (result.IsJust()) {
+    return Just(T(scope.Env(), scope.Escape(result.Unwrap())));
+  }
+  return result;
+#else
+  if (result.IsEmpty()) {
+    return T();
+  }
+  return T(scope.Env(), scope.Escape(result));
+#endif
 }
 
-template <typename T>
-inline void ObjectWrap<T>::Finalize(Napi::Env /*env*/) {}
+}  // namespace details
 
-template <typename T>
-inline napi_value ObjectWrap<T>::ConstructorCallbackWrapper(
-    napi_env env, napi_callback_info info) {
-  napi_value new_target;
-  napi_status status = napi_get_new_target(env, info, &new_target);
-  if (status != napi_ok) return nullptr;
+inline MaybeOrValue<Napi::Value> FunctionReference::operator()(
+    const std::initializer_list<napi_value>& args) const {
+  return Call(args);
+}
 
-  bool isConstructCall = (new_target != nullptr);
-  if (!isConstructCall) {
-    return details::WrapCallback(
-        [&] { return T::OnCalledAsFunction(CallbackInfo(env, info)); });
-  }
+inline MaybeOrValue<Napi::Value> FunctionReference::Call(
+    const std::initializer_list<napi_value>& args) const {
+  EscapableHandleScope scope(_env);
+  return details::EscapeCallResult<Napi::Value>(
+      scope, CallNoScope(Env().Undefined(), args.size(), args.begin()));
+}
 
-  napi_value wrapper = details::WrapCallback([&] {
-    CallbackInfo callbackInfo(env, info);
-    T* instance = new T(callbackInfo);
-#ifdef NAPI_CPP_EXCEPTIONS
-    instance->_construction_failed = false;
-#else
-    if (callbackInfo.Env().IsExceptionPending()) {
-      // We need to clear the exception so that removing the wrap might work.
-      Error e = callbackInfo.Env().GetAndClearPendingException();
-      delete instance;
-      e.ThrowAsJavaScriptException();
-    } else {
-      instance->_construction_failed = false;
-    }
-#endif  // NAPI_CPP_EXCEPTIONS
-    return callbackInfo.This();
-  });
+inline MaybeOrValue<Napi::Value> FunctionReference::Call(
+    const std::vector<napi_value>& args) const {
+  EscapableHandleScope scope(_env);
+  return details::EscapeCallResult<Napi::Value>(
+      scope, CallNoScope(Env().Undefined(), args.size(), args.data()));
+}
+
+inline MaybeOrValue<Napi::Value> FunctionReference::Call(
+    napi_value recv, const std::initializer_list<napi_value>& args) const {
+  return Call(recv, args.size(), args.begin());
+}
 
-  return wrapper;
+inline MaybeOrValue<Napi::Value> FunctionReference::Call(
+    napi_value recv, const std::vector<napi_value>& args) const {
+  return Call(recv, args.size(), args.data());
 }
 
-template <typename T>
-inline napi_value ObjectWrap<T>::StaticVoidMethodCallbackWrapper(
-    napi_env env, napi_callback_info info) {
-  return details::WrapCallback([&] {
-    CallbackInfo callbackInfo(env, info);
-    StaticVoidMethodCallbackData* callbackData =
-        reinterpret_cast<StaticVoidMethodCallbackData*>(callbackInfo.Data());
-    callbackInfo.SetData(callbackData->data);
-    callbackData->callback(callbackInfo);
-    return nullptr;
-  });
+inline MaybeOrValue<Napi::Value> FunctionReference::Call(
+    napi_value recv, size_t argc, const napi_value* args) const {
+  EscapableHandleScope scope(_env);
+  return details::EscapeCallResult<Napi::Value>(
+      scope, CallNoScope(recv, argc, args));
 }
 
-template <typename T>
-inline napi_value ObjectWrap<T>::StaticMethodCallbackWrapper(
-    napi_env env, napi_callback_info info) {
-  return details::WrapCallback([&] {
-    CallbackInfo callbackInfo(env, info);
-    StaticMethodCallbackData* callbackData =
-        reinterpret_cast<StaticMethodCallbackData*>(callbackInfo.Data());
-    callbackInfo.SetData(callbackData->data);
-    return callbackData->callback(callbackInfo);
-  });
+template <typename... Args, typename>
+inline MaybeOrValue<Napi::Value> FunctionReference::Call(
+    napi_value recv, const Args&... args) const {
+  EscapableHandleScope scope(_env);
+  return details::EscapeCallResult<Napi::Value>(scope,
+                                                CallNoScope(recv, args...));
 }
 
-template <typename T>
-inline napi_value ObjectWrap<T>::StaticGetterCallbackWrapper(
-    napi_env env, napi_callback_info info) {
-  return details::WrapCallback([&] {
-    CallbackInfo callbackInfo(env, info);
-    StaticAccessorCallbackData* callbackData =
-        reinterpret_cast<StaticAccessorCallbackData*>(callbackInfo.Data());
-    callbackInfo.SetData(callbackData->data);
-    return callbackData->getterCallback(callbackInfo);
-  });
+inline MaybeOrValue<Napi::Value> FunctionReference::MakeCallback(
+    napi_value recv,
+    const std::initializer_list<napi_value>& args,
+    napi_async_context context) const {
+  return MakeCallback(recv, args.size(), args.begin(), context);
 }
 
-template <typename T>
-inline napi_value ObjectWrap<T>::StaticSetterCallbackWrapper(
-    napi_env env, napi_callback_info info) {
-  return details::WrapCallback([&] {
-    CallbackInfo callbackInfo(env, info);
-    StaticAccessorCallbackData* callbackData =
-        reinterpret_cast<StaticAccessorCallbackData*>(callbackInfo.Data());
-    callbackInfo.SetData(callbackData->data);
-    callbackData->setterCallback(callbackInfo, callbackInfo[0]);
-    return nullptr;
-  });
+inline MaybeOrValue<Napi::Value> FunctionReference::MakeCallback(
+    napi_value recv,
+    const std::vector<napi_value>& args,
+    napi_async_context context) const {
+  return MakeCallback(recv, args.size(), args.data(), context);
 }
 
-template <typename T>
-inline void ObjectWrap<T>::FinalizeCallback(napi_env env,
-                                            void* data,
-                                            void* /*hint*/) {
-  HandleScope scope(env);
-  T* instance = static_cast<T*>(data);
-  instance->Finalize(Napi::Env(env));
-  delete instance;
+inline MaybeOrValue<Napi::Value> FunctionReference::MakeCallback(
+    napi_value recv,
+    size_t argc,
+    const napi_value* args,
+    napi_async_context context) const {
+  EscapableHandleScope scope(_env);
+  return details::EscapeCallResult<Napi::Value>(
+      scope, MakeCallbackNoScope(recv, argc, args, context));
 }
 
-template <typename T>
-template <typename ObjectWrap<T>::StaticSetterCallback method>
-inline napi_value ObjectWrap<T>::WrappedMethod(
-    napi_env env, napi_callback_info info) NAPI_NOEXCEPT {
-  return details::WrapCallback([&] {
-    const CallbackInfo cbInfo(env, info);
-    method(cbInfo, cbInfo[0]);
-    return nullptr;
-  });
+template <typename... Args, typename>
+inline MaybeOrValue<Napi::Value> FunctionReference::MakeCallback(
+    napi_value recv, napi_async_context context, const Args&... args) const {
+  EscapableHandleScope scope(_env);
+  return details::EscapeCallResult<Napi::Value>(
+      scope, Value().MakeCallback(recv, context, args...));
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// HandleScope class
-////////////////////////////////////////////////////////////////////////////////
+inline MaybeOrValue<Object> FunctionReference::New(
+    const std::initializer_list<napi_value>& args) const {
+  EscapableHandleScope scope(_env);
+  return details::EscapeCallResult<Object>(scope, Value().New(args));
+}
 
-inline HandleScope::HandleScope(napi_env env, napi_handle_scope scope)
-    : _env(env), _scope(scope) {}
+inline MaybeOrValue<Object> FunctionReference::New(
+    const std::vector<napi_value>& args) const {
+  EscapableHandleScope scope(_env);
+  return details::EscapeCallResult<Object>(scope, Value().New(args));
+}
 
-inline HandleScope::HandleScope(Napi::Env env) : _env(env) {
-  napi_status status = napi_open_handle_scope(_env, &_scope);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
+inline MaybeOrValue<Napi::Value> FunctionReference::CallNoScope(
+    napi_value recv, size_t argc, const napi_value* args) const {
+  napi_value function;
+  napi_value result = nullptr;
+  napi_status status = napi_get_reference_value(_env, _ref, &function);
+  if (status == napi_ok) {
+    status = napi_call_function(_env, recv, function, argc, args, &result);
+  }
+  NAPI_RETURN_OR_THROW_IF_FAILED(
+      _env, status, Napi::Value(_env, result), Napi::Value);
 }
 
-inline HandleScope::~HandleScope() {
-  napi_status status = napi_close_handle_scope(_env, _scope);
-  NAPI_FATAL_IF_FAILED(
-      status, "HandleScope::~HandleScope", "napi_close_handle_scope");
+inline MaybeOrValue<Napi::Value> FunctionReference::CallNoScope(
+    napi_value recv, const std::initializer_list<napi_value>& args) const {
+  return CallNoScope(recv, args.size(), args.begin());
 }
 
-inline HandleScope::operator napi_handle_scope() const {
-  return _scope;
+template <typename... Args, typename>
+inline MaybeOrValue<Napi::Value> FunctionReference::CallNoScope(
+    napi_value recv, const Args&... args) const {
+  return details::CallWithArgs(
+      _env,
+      [&](size_t argc, const napi_value* argv) {
+        return CallNoScope(recv, argc, argv);
+      },
+      args...);
 }
 
-inline Napi::Env HandleScope::Env() const {
-  return Napi::Env(_env);
+inline MaybeOrValue<Napi::Value> FunctionReference::MakeCallbackNoScope(
+    napi_value recv,
+    size_t argc,
+    const napi_value* args,
+    napi_async_context context) const {
+  napi_value function;
+  napi_value result = nullptr;
+  napi_status status = napi_get_reference_value(_env, _ref, &function);
+  if (status == napi_ok) {
+    status = napi_make_callback(
+        _env, context, recv, function, argc, args, &result);
+  }
+  NAPI_RETURN_OR_THROW_IF_FAILED(
+      _env, status, Napi::Value(_env, result), Napi::Value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// EscapableHandleScope class
+// CallbackInfo class
 ////////////////////////////////////////////////////////////////////////////////
 
-inline EscapableHandleScope::EscapableHandleScope(
-    napi_env env, napi_escapable_handle_scope scope)
-    : _env(env), _scope(scope) {}
-
-inline EscapableHandleScope::EscapableHandleScope(Napi::Env env) : _env(env) {
-  napi_status status = napi_open_escapable_handle_scope(_env, &_scope);
+inline CallbackInfo::CallbackInfo(napi_env env, napi_callback_info info)
+    : _env(env),
+      _info(info),
+      _this(nullptr),
+      _dynamicArgs(nullptr),
+      _data(nullptr) {
+  _argc = _staticArgCount;
+  _argv = _staticArgs;
+  napi_status status =
+      napi_get_cb_info(env, info, &_argc, _argv, &_this, &_data);
   NAPI_THROW_IF_FAILED_VOID(_env, status);
-}
 
-inline EscapableHandleScope::~EscapableHandleScope() {
-  napi_status status = napi_close_escapable_handle_scope(_env, _scope);
-  NAPI_FATAL_IF_FAILED(status,
-                       "EscapableHandleScope::~EscapableHandleScope",
-                       "napi_close_escapable_handle_scope");
+  if (_argc > _staticArgCount) {
+    // Use either a fixed-size array (on the stack) or a dynamically-allocated
+    // array (on the heap) depending on the number of args.
+    _dynamicArgs = new napi_value[_argc];
+    _argv = _dynamicArgs;
+
+    status = napi_get_cb_info(env, info, &_argc, _argv, nullptr, nullptr);
+    NAPI_THROW_IF_FAILED_VOID(_env, status);
+  }
 }
 
-inline EscapableHandleScope::operator napi_escapable_handle_scope() const {
-  return _scope;
+inline CallbackInfo::~CallbackInfo() {
+  if (_dynamicArgs != nullptr) {
+    delete[] _dynamicArgs;
+  }
 }
 
-inline Napi::Env EscapableHandleScope::Env() const {
-  return Napi::Env(_env);
+inline CallbackInfo::operator napi_callback_info() const {
+  return _info;
 }
 
-inline Value EscapableHandleScope::Escape(napi_value escapee) {
-  napi_value result;
-  napi_status status = napi_escape_handle(_env, _scope, escapee, &result);
+inline Value CallbackInfo::NewTarget() const {
+  napi_value newTarget;
+  napi_status status = napi_get_new_target(_env, _info, &newTarget);
   NAPI_THROW_IF_FAILED(_env, status, Value());
-  return Value(_env, result);
+  return Value(_env, newTarget);
 }
 
-#if (NAPI_VERSION > 2)
-////////////////////////////////////////////////////////////////////////////////
-// CallbackScope class
-////////////////////////////////////////////////////////////////////////////////
+inline bool CallbackInfo::IsConstructCall() const {
+  return !NewTarget().IsEmpty();
+}
 
-inline CallbackScope::CallbackScope(napi_env env, napi_callback_scope scope)
-    : _env(env), _scope(scope) {}
+inline Napi::Env CallbackInfo::Env() const {
+  return Napi::Env(_env);
+}
 
-inline CallbackScope::CallbackScope(napi_env env, napi_async_context context)
-    : _env(env) {
-  napi_status status =
-      napi_open_callback_scope(_env, Object::New(env), context, &_scope);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
+inline size_t CallbackInfo::Length() const {
+  return _argc;
 }
 
-inline CallbackScope::~CallbackScope() {
-  napi_status status = napi_close_callback_scope(_env, _scope);
-  NAPI_FATAL_IF_FAILED(
-      status, "CallbackScope::~CallbackScope", "napi_close_callback_scope");
+inline const Value CallbackInfo::operator[](size_t index) const {
+  return index < _argc ? Value(_env, _argv[index]) : Env().Undefined();
 }
 
-inline CallbackScope::operator napi_callback_scope() const {
-  return _scope;
+inline Value CallbackInfo::This() const {
+  if (_this == nullptr) {
+    return Env().Undefined();
+  }
+  return Object(_env, _this);
 }
 
-inline Napi::Env CallbackScope::Env() const {
-  return Napi::Env(_env);
+inline void* CallbackInfo::Data() const {
+  return _data;
+}
+
+inline void CallbackInfo::SetData(void* data) {
+  _data = data;
 }
-#endif
 
 ////////////////////////////////////////////////////////////////////////////////
-// AsyncContext class
+// PropertyDescriptor class
 ////////////////////////////////////////////////////////////////////////////////
 
-inline AsyncContext::AsyncContext(napi_env env, const char* resource_name)
-    : AsyncContext(env, resource_name, Object::New(env)) {}
+template <typename PropertyDescriptor::GetterCallback Getter>
+PropertyDescriptor PropertyDescriptor::Accessor(
+    const char* utf8name, napi_property_attributes attributes, void* data) {
+  napi_property_descriptor desc = napi_property_descriptor();
 
-inline AsyncContext::AsyncContext(napi_env env,
-                                  const char* resource_name,
-                                  const Object& resource)
-    : _env(env), _context(nullptr) {
-  napi_value resource_id;
-  napi_status status = napi_create_string_utf8(
-      _env, resource_name, NAPI_AUTO_LENGTH, &resource_id);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
+  desc.utf8name = utf8name;
+  desc.getter = details::TemplatedCallback<Getter>;
+  desc.attributes = attributes;
+  desc.data = data;
 
-  status = napi_async_init(_env, resource, resource_id, &_context);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
+  return desc;
 }
 
-inline AsyncContext::~AsyncContext() {
-  if (_context != nullptr) {
-    napi_async_destroy(_env, _context);
-    _context = nullptr;
-  }
+template <typename PropertyDescriptor::GetterCallback Getter>
+PropertyDescriptor PropertyDescriptor::Accessor(
+    const std::string& utf8name,
+    napi_property_attributes attributes,
+    void* data) {
+  return Accessor<Getter>(utf8name.c_str(), attributes, data);
 }
 
-inline AsyncContext::AsyncContext(AsyncContext&& other) {
-  _env = other._env;
-  other._env = nullptr;
-  _context = other._context;
-  other._context = nullptr;
-}
+template <typename PropertyDescriptor::GetterCallback Getter>
+PropertyDescriptor PropertyDescriptor::Accessor(
+    Name name, napi_property_attributes attributes, void* data) {
+  napi_property_descriptor desc = napi_property_descriptor();
 
-inline AsyncContext& AsyncContext::operator=(AsyncContext&& other) {
-  _env = other._env;
-  other._env = nullptr;
-  _context = other._context;
-  other._context = nullptr;
-  return *this;
+  desc.name = name;
+  desc.getter = details::TemplatedCallback<Getter>;
+  desc.attributes = attributes;
+  desc.data = data;
+
+  return desc;
 }
 
-inline AsyncContext::operator napi_async_context() const {
-  return _context;
+template <typename PropertyDescriptor::GetterCallback Getter,
+          typename PropertyDescriptor::SetterCallback Setter>
+PropertyDescriptor PropertyDescriptor::Accessor(
+    const char* utf8name, napi_property_attributes attributes, void* data) {
+  napi_property_descriptor desc = napi_property_descriptor();
+
+  desc.utf8name = utf8name;
+  desc.getter = details::TemplatedCallback<Getter>;
+  desc.setter = details::TemplatedVoidCallback<Setter>;
+  desc.attributes = attributes;
+  desc.data = data;
+
+  return desc;
 }
 
-inline Napi::Env AsyncContext::Env() const {
-  return Napi::Env(_env);
+template <typename PropertyDescriptor::GetterCallback Getter,
+          typename PropertyDescriptor::SetterCallback Setter>
+PropertyDescriptor PropertyDescriptor::Accessor(
+    const std::string& utf8name,
+    napi_property_attributes attributes,
+    void* data) {
+  return Accessor<Getter, Setter>(utf8name.c_str(), attributes, data);
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// AsyncWorker class
-////////////////////////////////////////////////////////////////////////////////
+template <typename PropertyDescriptor::GetterCallback Getter,
+          typename PropertyDescriptor::SetterCallback Setter>
+PropertyDescriptor PropertyDescriptor::Accessor(
+    Name name, napi_property_attributes attributes, void* data) {
+  napi_property_descriptor desc = napi_property_descriptor();
 
-#if NAPI_HAS_THREADS
+  desc.name = name;
+  desc.getter = details::TemplatedCallback<Getter>;
+  desc.setter = details::TemplatedVoidCallback<Setter>;
+  desc.attributes = attributes;
+  desc.data = data;
 
-inline AsyncWorker::AsyncWorker(const Function& callback)
-    : AsyncWorker(callback, "generic") {}
-
-inline AsyncWorker::AsyncWorker(const Function& callback,
-                                const char* resource_name)
-    : AsyncWorker(callback, resource_name, Object::New(callback.Env())) {}
-
-inline AsyncWorker::AsyncWorker(const Function& callback,
-                                const char* resource_name,
-                                const Object& resource)
-    : AsyncWorker(
-          Object::New(callback.Env()), callback, resource_name, resource) {}
-
-inline AsyncWorker::AsyncWorker(const Object& receiver,
-                                const Function& callback)
-    : AsyncWorker(receiver, callback, "generic") {}
-
-inline AsyncWorker::AsyncWorker(const Object& receiver,
-                                const Function& callback,
-                                const char* resource_name)
-    : AsyncWorker(
-          receiver, callback, resource_name, Object::New(callback.Env())) {}
-
-inline AsyncWorker::AsyncWorker(const Object& receiver,
-                                const Function& callback,
-                                const char* resource_name,
-                                const Object& resource)
-    : _env(callback.Env()),
-      _receiver(Napi::Persistent(receiver)),
-      _callback(Napi::Persistent(callback)),
-      _suppress_destruct(false) {
-  napi_value resource_id;
-  napi_status status = napi_create_string_latin1(
-      _env, resource_name, NAPI_AUTO_LENGTH, &resource_id);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
+  return desc;
+}
+
+template <typename Getter>
+inline PropertyDescriptor PropertyDescriptor::Accessor(
+    Napi::Env env,
+    Napi::Object object,
+    const char* utf8name,
+    Getter getter,
+    napi_property_attributes attributes,
+    void* data) {
+  napi_property_descriptor desc = napi_property_descriptor();
+  desc.utf8name = utf8name;
+  auto callbackData = details::PrepareCallable<Napi::Value>(
+      getter,
+      data,
+      &desc.getter,
+      &desc.data,
+      details::CallableStorageOf<Getter, Napi::Value>());
+  desc.attributes = attributes;
+
+  // Stateless getters need no storage. Any other is freed with the object.
+  if (callbackData != nullptr) {
+    napi_status status = AttachData(env, object, callbackData);
+    if (status != napi_ok) {
+      delete callbackData;
+      NAPI_THROW_IF_FAILED(env, status, napi_property_descriptor());
+    }
+  }
 
-  status = napi_create_async_work(_env,
-                                  resource,
-                                  resource_id,
-                                  OnAsyncWorkExecute,
-                                  OnAsyncWorkComplete,
-                                  this,
-                                  &_work);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
+  return desc;
 }
 
-inline AsyncWorker::AsyncWorker(Napi::Env env) : AsyncWorker(env, "generic") {}
+template <typename Getter>
+inline PropertyDescriptor PropertyDescriptor::Accessor(
+    Napi::Env env,
+    Napi::Object object,
+    const std::string& utf8name,
+    Getter getter,
+    napi_property_attributes attributes,
+    void* data) {
+  return Accessor(env, object, utf8name.c_str(), getter, attributes, data);
+}
 
-inline AsyncWorker::AsyncWorker(Napi::Env env, const char* resource_name)
-    : AsyncWorker(env, resource_name, Object::New(env)) {}
+template <typename Getter>
+inline PropertyDescriptor PropertyDescriptor::Accessor(
+    Napi::Env env,
+    Napi::Object object,
+    Name name,
+    Getter getter,
+    napi_property_attributes attributes,
+    void* data) {
+  napi_property_descriptor desc = napi_property_descriptor();
+  desc.name = name;
+  auto callbackData = details::PrepareCallable<Napi::Value>(
+      getter,
+      data,
+      &desc.getter,
+      &desc.data,
+      details::CallableStorageOf<Getter, Napi::Value>());
+  desc.attributes = attributes;
 
-inline AsyncWorker::AsyncWorker(Napi::Env env,
-                                const char* resource_name,
-                                const Object& resource)
-    : _env(env), _receiver(), _callback(), _suppress_destruct(false) {
-  napi_value resource_id;
-  napi_status status = napi_create_string_latin1(
-      _env, resource_name, NAPI_AUTO_LENGTH, &resource_id);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
+  // Stateless getters need no storage. Any other is freed with the object.
+  if (callbackData != nullptr) {
+    napi_status status = AttachData(env, object, callbackData);
+    if (status != napi_ok) {
+      delete callbackData;
+      NAPI_THROW_IF_FAILED(env, status, napi_property_descriptor());
+    }
+  }
 
-  status = napi_create_async_work(_env,
-                                  resource,
-                                  resource_id,
-                                  OnAsyncWorkExecute,
-                                  OnAsyncWorkComplete,
-                                  this,
-                                  &_work);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
+  return desc;
 }
 
-inline AsyncWorker::~AsyncWorker() {
-  if (_work != nullptr) {
-    napi_delete_async_work(_env, _work);
-    _work = nullptr;
+template <typename Getter, typename Setter>
+inline PropertyDescriptor PropertyDescriptor::Accessor(
+    Napi::Env env,
+    Napi::Object object,
+    const char* utf8name,
+    Getter getter,
+    Setter setter,
+    napi_property_attributes attributes,
+    void* data) {
+  napi_property_descriptor desc = napi_property_descriptor();
+  desc.utf8name = utf8name;
+  auto callbackData = details::PrepareAccessor(
+      getter,
+      setter,
+      data,
+      &desc,
+      details::IsStatelessAccessor<Getter, Setter>());
+  desc.attributes = attributes;
+
+  if (callbackData != nullptr) {
+    napi_status status = AttachData(env, object, callbackData);
+    if (status != napi_ok) {
+      delete callbackData;
+      NAPI_THROW_IF_FAILED(env, status, napi_property_descriptor());
+    }
   }
-}
 
-inline void AsyncWorker::Destroy() {
-  delete this;
+  return desc;
 }
 
-inline AsyncWorker::operator napi_async_work() const {
-  return _work;
+template <typename Getter, typename Setter>
+inline PropertyDescriptor PropertyDescriptor::Accessor(
+    Napi::Env env,
+    Napi::Object object,
+    const std::string& utf8name,
+    Getter getter,
+    Setter setter,
+    napi_property_attributes attributes,
+    void* data) {
+  return Accessor(
+      env, object, utf8name.c_str(), getter, setter, attributes, data);
 }
 
-inline Napi::Env AsyncWorker::Env() const {
-  return Napi::Env(_env);
-}
+template <typename Getter, typename Setter>
+inline PropertyDescriptor PropertyDescriptor::Accessor(
+    Napi::Env env,
+    Napi::Object object,
+    Name name,
+    Getter getter,
+    Setter setter,
+    napi_property_attributes attributes,
+    void* data) {
+  napi_property_descriptor desc = napi_property_descriptor();
+  desc.name = name;
+  auto callbackData = details::PrepareAccessor(
+      getter,
+      setter,
+      data,
+      &desc,
+      details::IsStatelessAccessor<Getter, Setter>());
+  desc.attributes = attributes;
 
-inline void AsyncWorker::Queue() {
-  napi_status status = napi_queue_async_work(_env, _work);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
-}
+  if (callbackData != nullptr) {
+    napi_status status = AttachData(env, object, callbackData);
+    if (status != napi_ok) {
+      delete callbackData;
+      NAPI_THROW_IF_FAILED(env, status, napi_property_descriptor());
+    }
+  }
 
-inline void AsyncWorker::Cancel() {
-  napi_status status = napi_cancel_async_work(_env, _work);
-  NAPI_THROW_IF_FAILED_VOID(_env, status);
+  return desc;
 }
 
-inline ObjectReference& AsyncWorker::Receiver() {
-  return _receiver;
+template <typename Callable>
+inline PropertyDescriptor PropertyDescriptor::Function(
+    Napi::Env env,
+    Napi::Object /*object*/,
+    const char* utf8name,
+    Callable cb,
+    napi_property_attributes attributes,
+    void* data) {
+  return PropertyDescriptor({utf8name,
+                             nullptr,
+                             nullptr,
+                             nullptr,
+                             nullptr,
+                             Napi::Function::New(env, cb, utf8name, data),
+                             attributes,
+                             nullptr});
 }
 
-inline FunctionReference& AsyncWorker::Callback() {
-  return _callback;
+template <typename Callable>
+inline PropertyDescriptor PropertyDescriptor::Function(
+    Napi::Env env,
+    Napi::Object object,
+    const std::string& utf8name,
+    Callable cb,
+    napi_property_attributes attributes,
+    void* data) {
+  return Function(env, object, utf8name.c_str(), cb, attributes, data);
 }
 
-inline void AsyncWorker::SuppressDestruct() {
-  _suppress_destruct = true;
+template <typename Callable>
+inline PropertyDescriptor PropertyDescriptor::Function(
+    Napi::Env env,
+    Napi::Object /*object*/,
+    Name name,
+    Callable cb,
+    napi_property_attributes attributes,
+    void* data) {
+  return PropertyDescriptor({nullptr,
+                             name,
+                             nullptr,
+                             nullptr,
+                             nullptr,
+                             Napi::Function::New(env, cb, nullptr, data),
+                             attributes,
+                             nullptr});
 }
 
-inline void AsyncWorker::OnOK() {
-  if (!_callback.IsEmpty()) {
-    _callback.Call(_receiver.Value(), GetResult(_callback.Env()));
-  }
+inline PropertyDescriptor PropertyDescriptor::Value(
+    const char* utf8name,
+    napi_value value,
+    napi_property_attributes attributes) {
+  return PropertyDescriptor({utf8name,
+                             nullptr,
+                             nullptr,
+                             nullptr,
+                             nullptr,
+                             value,
+                             attributes,
+                             nullptr});
 }
 
-inline void AsyncWorker::OnError(const Error& e) {
-  if (!_callback.IsEmpty()) {
-    _callback.Call(_receiver.Value(),
-                   std::initializer_list<napi_value>{e.Value()});
-  }
+inline PropertyDescriptor PropertyDescriptor::Value(
+    const std::string& utf8name,
+    napi_value value,
+    napi_property_attributes attributes) {
+  return Value(utf8name.c_str(), value, attributes);
 }
 
-inline void AsyncWorker::SetError(const std::string& error) {
-  _error = error;
+inline PropertyDescriptor PropertyDescriptor::Value(
+    napi_value name, napi_value value, napi_property_attributes attributes) {
+  return PropertyDescriptor(
+      {nullptr, name, nullptr, nullptr, nullptr, value, attributes, nullptr});
 }
 
-inline std::vector<napi_value> AsyncWorker::GetResult(Napi::Env /*env*/) {
-  return {};
-}
-// The OnAsyncWorkExecute method receives an napi_env argument. However, do NOT
-// use it within this method, as it does not run on the JavaScript thread and
-// must not run any method that would cause JavaScript to run. In practice,
-// this means that almost any use of napi_env will be incorrect.
-inline void AsyncWorker::OnAsyncWorkExecute(napi_env env, void* asyncworker) {
-  AsyncWorker* self = static_cast<AsyncWorker*>(asyncworker);
-  self->OnExecute(env);
-}
-// The OnExecute method receives an napi_env argument. However, do NOT
-// use it within this method, as it does not run on the JavaScript thread and
-// must not run any method that would cause JavaScript to run. In practice,
-// this means that almost any use of napi_env will be incorrect.
-inline void AsyncWorker::OnExecute(Napi::Env /*DO_NOT_USE*/) {
-#ifdef NAPI_CPP_EXCEPTIONS
-  try {
-    Execute();
-  } catch (const std::exception& e) {
-    SetError(e.what());
-  }
-#else   // NAPI_CPP_EXCEPTIONS
-  Execute();
-#endif  // NAPI_CPP_EXCEPTIONS
+inline PropertyDescriptor PropertyDescriptor::Value(
+    Name name, Napi::Value value, napi_property_attributes attributes) {
+  napi_value nameValue = name;
+  napi_value valueValue = value;
+  return PropertyDescriptor::Value(nameValue, valueValue, attributes);
 }
 
-inline void AsyncWorker::OnAsyncWorkComplete(napi_env env,
-                                             napi_status status,
-                                             void* asyncworker) {
-  AsyncWorker* self = static_cast<AsyncWorker*>(asyncworker);
-  self->OnWorkComplete(env, status);
-}
-inline void AsyncWorker::OnWorkComplete(Napi::Env /*env*/, napi_status status) {
-  if (status != napi_cancelled) {
-    HandleScope scope(_env);
-    details::WrapCallback([&] {
-      if (_error.size() == 0) {
-        OnOK();
-      } else {
-        OnError(Error::New(_env, _error));
-      }
-      return nullptr;
-    });
-  }
-  if (!_suppress_destruct) {
-    Destroy();
-  }
+inline PropertyDescriptor::PropertyDescriptor(napi_property_descriptor desc)
+    : _desc(desc) {}
+
+inline PropertyDescriptor::operator napi_property_descriptor&() {
+  return _desc;
 }
 
-#endif  // NAPI_HAS_THREADS
+inline PropertyDescriptor::operator const napi_property_descriptor&() const {
+  return _desc;
+}
 
-#if (NAPI_VERSION > 3 && NAPI_HAS_THREADS)
 ////////////////////////////////////////////////////////////////////////////////
-// TypedThreadSafeFunction<ContextType,DataType,CallJs> class
+// LazyExports class
 ////////////////////////////////////////////////////////////////////////////////
 
-// Starting with NAPI 5, the JavaScript function `func` parameter of
-// `napi_create_threadsafe_function` is optional.
-#if NAPI_VERSION > 4
-// static, with Callback [missing] Resource [missing] Finalizer [missing]
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-template <typename ResourceString>
-inline TypedThreadSafeFunction<ContextType, DataType, CallJs>
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::New(
-    napi_env env,
-    ResourceString resourceName,
-    size_t maxQueueSize,
-    size_t initialThreadCount,
-    ContextType* context) {
-  TypedThreadSafeFunction<ContextType, DataType, CallJs> tsfn;
+namespace details {
 
-  napi_status status =
-      napi_create_threadsafe_function(env,
-                                      nullptr,
-                                      nullptr,
-                                      String::From(env, resourceName),
-                                      maxQueueSize,
-                                      initialThreadCount,
-                                      nullptr,
-                                      nullptr,
-                                      context,
-                                      CallJsInternal,
-                                      &tsfn._tsfn);
-  if (status != napi_ok) {
-    NAPI_THROW_IF_FAILED(
-        env, status, TypedThreadSafeFunction<ContextType, DataType, CallJs>());
+struct LazyExportTable {
+  std::vector<std::string> names;
+  std::vector<LazyExports::Entry> entries;
+
+  static void Delete(void* data) {
+    delete static_cast<LazyExportTable*>(data);
   }
+};
 
-  return tsfn;
+inline napi_property_attributes LazyAccessorAttributes() {
+  return static_cast<napi_property_attributes>(napi_enumerable |
+                                               napi_configurable);
 }
 
-// static, with Callback [missing] Resource [passed] Finalizer [missing]
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-template <typename ResourceString>
-inline TypedThreadSafeFunction<ContextType, DataType, CallJs>
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::New(
-    napi_env env,
-    const Object& resource,
-    ResourceString resourceName,
-    size_t maxQueueSize,
-    size_t initialThreadCount,
-    ContextType* context) {
-  TypedThreadSafeFunction<ContextType, DataType, CallJs> tsfn;
-
-  napi_status status =
-      napi_create_threadsafe_function(env,
-                                      nullptr,
-                                      resource,
-                                      String::From(env, resourceName),
-                                      maxQueueSize,
-                                      initialThreadCount,
-                                      nullptr,
-                                      nullptr,
-                                      context,
-                                      CallJsInternal,
-                                      &tsfn._tsfn);
-  if (status != napi_ok) {
-    NAPI_THROW_IF_FAILED(
-        env, status, TypedThreadSafeFunction<ContextType, DataType, CallJs>());
-  }
-
-  return tsfn;
-}
-
-// static, with Callback [missing] Resource [missing] Finalizer [passed]
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-template <typename ResourceString,
-          typename Finalizer,
-          typename FinalizerDataType>
-inline TypedThreadSafeFunction<ContextType, DataType, CallJs>
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::New(
-    napi_env env,
-    ResourceString resourceName,
-    size_t maxQueueSize,
-    size_t initialThreadCount,
-    ContextType* context,
-    Finalizer finalizeCallback,
-    FinalizerDataType* data) {
-  TypedThreadSafeFunction<ContextType, DataType, CallJs> tsfn;
-
-  auto* finalizeData = new details::
-      ThreadSafeFinalize<ContextType, Finalizer, FinalizerDataType>(
-          {data, finalizeCallback});
-  napi_status status = napi_create_threadsafe_function(
-      env,
+// Replaces the lazy accessor `utf8name` on the receiver with a data property.
+inline napi_value DefineLazyValue(const CallbackInfo& info,
+                                  const char* utf8name,
+                                  Napi::Value value) {
+  napi_env env = info.Env();
+  if (info.Env().IsExceptionPending()) {
+    return nullptr;
+  }
+  if (value.IsEmpty()) {
+    value = info.Env().Undefined();
+  }
+  napi_property_descriptor desc = {
+      utf8name,
       nullptr,
       nullptr,
-      String::From(env, resourceName),
-      maxQueueSize,
-      initialThreadCount,
-      finalizeData,
-      details::ThreadSafeFinalize<ContextType, Finalizer, FinalizerDataType>::
-          FinalizeFinalizeWrapperWithDataAndContext,
-      context,
-      CallJsInternal,
-      &tsfn._tsfn);
-  if (status != napi_ok) {
-    delete finalizeData;
-    NAPI_THROW_IF_FAILED(
-        env, status, TypedThreadSafeFunction<ContextType, DataType, CallJs>());
-  }
-
-  return tsfn;
-}
-
-// static, with Callback [missing] Resource [passed] Finalizer [passed]
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-template <typename ResourceString,
-          typename Finalizer,
-          typename FinalizerDataType>
-inline TypedThreadSafeFunction<ContextType, DataType, CallJs>
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::New(
-    napi_env env,
-    const Object& resource,
-    ResourceString resourceName,
-    size_t maxQueueSize,
-    size_t initialThreadCount,
-    ContextType* context,
-    Finalizer finalizeCallback,
-    FinalizerDataType* data) {
-  TypedThreadSafeFunction<ContextType, DataType, CallJs> tsfn;
-
-  auto* finalizeData = new details::
-      ThreadSafeFinalize<ContextType, Finalizer, FinalizerDataType>(
-          {data, finalizeCallback});
-  napi_status status = napi_create_threadsafe_function(
-      env,
       nullptr,
-      resource,
-      String::From(env, resourceName),
-      maxQueueSize,
-      initialThreadCount,
-      finalizeData,
-      details::ThreadSafeFinalize<ContextType, Finalizer, FinalizerDataType>::
-          FinalizeFinalizeWrapperWithDataAndContext,
-      context,
-      CallJsInternal,
-      &tsfn._tsfn);
-  if (status != napi_ok) {
-    delete finalizeData;
-    NAPI_THROW_IF_FAILED(
-        env, status, TypedThreadSafeFunction<ContextType, DataType, CallJs>());
-  }
-
-  return tsfn;
+      nullptr,
+      value,
+      static_cast<napi_property_attributes>(napi_writable | napi_enumerable |
+                                            napi_configurable),
+      nullptr};
+  napi_status status = napi_define_properties(env, info.This(), 1, &desc);
+  NAPI_THROW_IF_FAILED(env, status, nullptr);
+  return value;
 }
-#endif
 
-// static, with Callback [passed] Resource [missing] Finalizer [missing]
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-template <typename ResourceString>
-inline TypedThreadSafeFunction<ContextType, DataType, CallJs>
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::New(
-    napi_env env,
-    const Function& callback,
-    ResourceString resourceName,
-    size_t maxQueueSize,
-    size_t initialThreadCount,
-    ContextType* context) {
-  TypedThreadSafeFunction<ContextType, DataType, CallJs> tsfn;
+}  // namespace details
 
-  napi_status status =
-      napi_create_threadsafe_function(env,
-                                      callback,
-                                      nullptr,
-                                      String::From(env, resourceName),
-                                      maxQueueSize,
-                                      initialThreadCount,
-                                      nullptr,
-                                      nullptr,
-                                      context,
-                                      CallJsInternal,
-                                      &tsfn._tsfn);
-  if (status != napi_ok) {
-    NAPI_THROW_IF_FAILED(
-        env, status, TypedThreadSafeFunction<ContextType, DataType, CallJs>());
+inline Object LazyExports::Define(napi_env env,
+                                  napi_value exports,
+                                  const std::initializer_list<Entry>& entries) {
+  details::LazyExportTable* table = new details::LazyExportTable();
+  table->names.reserve(entries.size());
+  table->entries.reserve(entries.size());
+  for (const Entry& entry : entries) {
+    table->names.emplace_back(entry.utf8name);
+  }
+  size_t index = 0;
+  for (const Entry& entry : entries) {
+    table->entries.push_back({table->names[index++].c_str(), entry.callback});
   }
 
-  return tsfn;
-}
-
-// static, with Callback [passed] Resource [passed] Finalizer [missing]
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-template <typename ResourceString>
-inline TypedThreadSafeFunction<ContextType, DataType, CallJs>
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::New(
-    napi_env env,
-    const Function& callback,
-    const Object& resource,
-    ResourceString resourceName,
-    size_t maxQueueSize,
-    size_t initialThreadCount,
-    ContextType* context) {
-  TypedThreadSafeFunction<ContextType, DataType, CallJs> tsfn;
-
+  // The accessors can be taken out of `exports` with
+  // `Object.getOwnPropertyDescriptor()` and outlive it, so the copy is kept
+  // until no JavaScript can call them any more.
+#if NAPI_VERSION > 2
   napi_status status =
-      napi_create_threadsafe_function(env,
-                                      callback,
-                                      resource,
-                                      String::From(env, resourceName),
-                                      maxQueueSize,
-                                      initialThreadCount,
-                                      nullptr,
-                                      nullptr,
-                                      context,
-                                      CallJsInternal,
-                                      &tsfn._tsfn);
-  if (status != napi_ok) {
-    NAPI_THROW_IF_FAILED(
-        env, status, TypedThreadSafeFunction<ContextType, DataType, CallJs>());
-  }
-
-  return tsfn;
-}
-
-// static, with Callback [passed] Resource [missing] Finalizer [passed]
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-template <typename ResourceString,
-          typename Finalizer,
-          typename FinalizerDataType>
-inline TypedThreadSafeFunction<ContextType, DataType, CallJs>
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::New(
-    napi_env env,
-    const Function& callback,
-    ResourceString resourceName,
-    size_t maxQueueSize,
-    size_t initialThreadCount,
-    ContextType* context,
-    Finalizer finalizeCallback,
-    FinalizerDataType* data) {
-  TypedThreadSafeFunction<ContextType, DataType, CallJs> tsfn;
-
-  auto* finalizeData = new details::
-      ThreadSafeFinalize<ContextType, Finalizer, FinalizerDataType>(
-          {data, finalizeCallback});
-  napi_status status = napi_create_threadsafe_function(
-      env,
-      callback,
-      nullptr,
-      String::From(env, resourceName),
-      maxQueueSize,
-      initialThreadCount,
-      finalizeData,
-      details::ThreadSafeFinalize<ContextType, Finalizer, FinalizerDataType>::
-          FinalizeFinalizeWrapperWithDataAndContext,
-      context,
-      CallJsInternal,
-      &tsfn._tsfn);
-  if (status != napi_ok) {
-    delete finalizeData;
-    NAPI_THROW_IF_FAILED(
-        env, status, TypedThreadSafeFunction<ContextType, DataType, CallJs>());
-  }
-
-  return tsfn;
-}
-
-// static, with: Callback [passed] Resource [passed] Finalizer [passed]
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-template <typename CallbackType,
-          typename ResourceString,
-          typename Finalizer,
-          typename FinalizerDataType>
-inline TypedThreadSafeFunction<ContextType, DataType, CallJs>
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::New(
-    napi_env env,
-    CallbackType callback,
-    const Object& resource,
-    ResourceString resourceName,
-    size_t maxQueueSize,
-    size_t initialThreadCount,
-    ContextType* context,
-    Finalizer finalizeCallback,
-    FinalizerDataType* data) {
-  TypedThreadSafeFunction<ContextType, DataType, CallJs> tsfn;
-
-  auto* finalizeData = new details::
-      ThreadSafeFinalize<ContextType, Finalizer, FinalizerDataType>(
-          {data, finalizeCallback});
-  napi_status status = napi_create_threadsafe_function(
-      env,
-      details::DefaultCallbackWrapper<
-          CallbackType,
-          TypedThreadSafeFunction<ContextType, DataType, CallJs>>(env,
-                                                                  callback),
-      resource,
-      String::From(env, resourceName),
-      maxQueueSize,
-      initialThreadCount,
-      finalizeData,
-      details::ThreadSafeFinalize<ContextType, Finalizer, FinalizerDataType>::
-          FinalizeFinalizeWrapperWithDataAndContext,
-      context,
-      CallJsInternal,
-      &tsfn._tsfn);
+      napi_add_env_cleanup_hook(env, details::LazyExportTable::Delete, table);
   if (status != napi_ok) {
-    delete finalizeData;
-    NAPI_THROW_IF_FAILED(
-        env, status, TypedThreadSafeFunction<ContextType, DataType, CallJs>());
-  }
-
-  return tsfn;
-}
-
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-inline TypedThreadSafeFunction<ContextType, DataType, CallJs>::
-    TypedThreadSafeFunction()
-    : _tsfn() {}
-
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-inline TypedThreadSafeFunction<ContextType, DataType, CallJs>::
-    TypedThreadSafeFunction(napi_threadsafe_function tsfn)
-    : _tsfn(tsfn) {}
-
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-inline TypedThreadSafeFunction<ContextType, DataType, CallJs>::
-operator napi_threadsafe_function() const {
-  return _tsfn;
-}
-
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-inline napi_status
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::BlockingCall(
-    DataType* data) const {
-  return napi_call_threadsafe_function(_tsfn, data, napi_tsfn_blocking);
-}
-
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-inline napi_status
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::NonBlockingCall(
-    DataType* data) const {
-  return napi_call_threadsafe_function(_tsfn, data, napi_tsfn_nonblocking);
-}
-
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-inline void TypedThreadSafeFunction<ContextType, DataType, CallJs>::Ref(
-    napi_env env) const {
-  if (_tsfn != nullptr) {
-    napi_status status = napi_ref_threadsafe_function(env, _tsfn);
-    NAPI_THROW_IF_FAILED_VOID(env, status);
-  }
-}
-
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-inline void TypedThreadSafeFunction<ContextType, DataType, CallJs>::Unref(
-    napi_env env) const {
-  if (_tsfn != nullptr) {
-    napi_status status = napi_unref_threadsafe_function(env, _tsfn);
-    NAPI_THROW_IF_FAILED_VOID(env, status);
-  }
-}
-
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-inline napi_status
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::Acquire() const {
-  return napi_acquire_threadsafe_function(_tsfn);
-}
-
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-inline napi_status
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::Release() const {
-  return napi_release_threadsafe_function(_tsfn, napi_tsfn_release);
-}
-
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-inline napi_status
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::Abort() const {
-  return napi_release_threadsafe_function(_tsfn, napi_tsfn_abort);
-}
-
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-inline ContextType*
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::GetContext() const {
-  void* context;
-  napi_status status = napi_get_threadsafe_function_context(_tsfn, &context);
-  NAPI_FATAL_IF_FAILED(status,
-                       "TypedThreadSafeFunction::GetContext",
-                       "napi_get_threadsafe_function_context");
-  return static_cast<ContextType*>(context);
-}
-
-// static
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-void TypedThreadSafeFunction<ContextType, DataType, CallJs>::CallJsInternal(
-    napi_env env, napi_value jsCallback, void* context, void* data) {
-  details::CallJsWrapper<ContextType, DataType, decltype(CallJs), CallJs>(
-      env, jsCallback, context, data);
-}
-
-#if NAPI_VERSION == 4
-// static
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-Napi::Function
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::EmptyFunctionFactory(
-    Napi::Env env) {
-  return Napi::Function::New(env, [](const CallbackInfo& cb) {});
-}
-
-// static
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-Napi::Function
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::FunctionOrEmpty(
-    Napi::Env env, Napi::Function& callback) {
-  if (callback.IsEmpty()) {
-    return EmptyFunctionFactory(env);
+    delete table;
+    NAPI_THROW_IF_FAILED(env, status, Object());
   }
-  return callback;
-}
-
-#else
-// static
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-std::nullptr_t
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::EmptyFunctionFactory(
-    Napi::Env /*env*/) {
-  return nullptr;
-}
-
-// static
-template <typename ContextType,
-          typename DataType,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*)>
-Napi::Function
-TypedThreadSafeFunction<ContextType, DataType, CallJs>::FunctionOrEmpty(
-    Napi::Env /*env*/, Napi::Function& callback) {
-  return callback;
-}
-
-#endif
-
-////////////////////////////////////////////////////////////////////////////////
-// ThreadSafeFunction class
-////////////////////////////////////////////////////////////////////////////////
-
-// static
-template <typename ResourceString>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount) {
-  return New(
-      env, callback, Object(), resourceName, maxQueueSize, initialThreadCount);
-}
-
-// static
-template <typename ResourceString, typename ContextType>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount,
-                                                  ContextType* context) {
-  return New(env,
-             callback,
-             Object(),
-             resourceName,
-             maxQueueSize,
-             initialThreadCount,
-             context);
-}
-
-// static
-template <typename ResourceString, typename Finalizer>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount,
-                                                  Finalizer finalizeCallback) {
-  return New(env,
-             callback,
-             Object(),
-             resourceName,
-             maxQueueSize,
-             initialThreadCount,
-             finalizeCallback);
-}
-
-// static
-template <typename ResourceString,
-          typename Finalizer,
-          typename FinalizerDataType>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount,
-                                                  Finalizer finalizeCallback,
-                                                  FinalizerDataType* data) {
-  return New(env,
-             callback,
-             Object(),
-             resourceName,
-             maxQueueSize,
-             initialThreadCount,
-             finalizeCallback,
-             data);
-}
-
-// static
-template <typename ResourceString, typename ContextType, typename Finalizer>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount,
-                                                  ContextType* context,
-                                                  Finalizer finalizeCallback) {
-  return New(env,
-             callback,
-             Object(),
-             resourceName,
-             maxQueueSize,
-             initialThreadCount,
-             context,
-             finalizeCallback);
-}
-
-// static
-template <typename ResourceString,
-          typename ContextType,
-          typename Finalizer,
-          typename FinalizerDataType>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount,
-                                                  ContextType* context,
-                                                  Finalizer finalizeCallback,
-                                                  FinalizerDataType* data) {
-  return New(env,
-             callback,
-             Object(),
-             resourceName,
-             maxQueueSize,
-             initialThreadCount,
-             context,
-             finalizeCallback,
-             data);
-}
-
-// static
-template <typename ResourceString>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  const Object& resource,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount) {
-  return New(env,
-             callback,
-             resource,
-             resourceName,
-             maxQueueSize,
-             initialThreadCount,
-             static_cast<void*>(nullptr) /* context */);
-}
-
-// static
-template <typename ResourceString, typename ContextType>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  const Object& resource,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount,
-                                                  ContextType* context) {
-  return New(env,
-             callback,
-             resource,
-             resourceName,
-             maxQueueSize,
-             initialThreadCount,
-             context,
-             [](Env, ContextType*) {} /* empty finalizer */);
-}
-
-// static
-template <typename ResourceString, typename Finalizer>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  const Object& resource,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount,
-                                                  Finalizer finalizeCallback) {
-  return New(env,
-             callback,
-             resource,
-             resourceName,
-             maxQueueSize,
-             initialThreadCount,
-             static_cast<void*>(nullptr) /* context */,
-             finalizeCallback,
-             static_cast<void*>(nullptr) /* data */,
-             details::ThreadSafeFinalize<void, Finalizer>::Wrapper);
-}
-
-// static
-template <typename ResourceString,
-          typename Finalizer,
-          typename FinalizerDataType>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  const Object& resource,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount,
-                                                  Finalizer finalizeCallback,
-                                                  FinalizerDataType* data) {
-  return New(env,
-             callback,
-             resource,
-             resourceName,
-             maxQueueSize,
-             initialThreadCount,
-             static_cast<void*>(nullptr) /* context */,
-             finalizeCallback,
-             data,
-             details::ThreadSafeFinalize<void, Finalizer, FinalizerDataType>::
-                 FinalizeWrapperWithData);
-}
-
-// static
-template <typename ResourceString, typename ContextType, typename Finalizer>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  const Object& resource,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount,
-                                                  ContextType* context,
-                                                  Finalizer finalizeCallback) {
-  return New(
-      env,
-      callback,
-      resource,
-      resourceName,
-      maxQueueSize,
-      initialThreadCount,
-      context,
-      finalizeCallback,
-      static_cast<void*>(nullptr) /* data */,
-      details::ThreadSafeFinalize<ContextType,
-                                  Finalizer>::FinalizeWrapperWithContext);
-}
-
-// static
-template <typename ResourceString,
-          typename ContextType,
-          typename Finalizer,
-          typename FinalizerDataType>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  const Object& resource,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount,
-                                                  ContextType* context,
-                                                  Finalizer finalizeCallback,
-                                                  FinalizerDataType* data) {
-  return New(
-      env,
-      callback,
-      resource,
-      resourceName,
-      maxQueueSize,
-      initialThreadCount,
-      context,
-      finalizeCallback,
-      data,
-      details::ThreadSafeFinalize<ContextType, Finalizer, FinalizerDataType>::
-          FinalizeFinalizeWrapperWithDataAndContext);
-}
-
-inline ThreadSafeFunction::ThreadSafeFunction() : _tsfn() {}
-
-inline ThreadSafeFunction::ThreadSafeFunction(napi_threadsafe_function tsfn)
-    : _tsfn(tsfn) {}
-
-inline ThreadSafeFunction::operator napi_threadsafe_function() const {
-  return _tsfn;
-}
-
-inline napi_status ThreadSafeFunction::BlockingCall() const {
-  return CallInternal(nullptr, napi_tsfn_blocking);
+#endif  // NAPI_VERSION > 2
+  return Define(env, exports, table->entries.data(), table->entries.size());
+}
+
+inline Object LazyExports::Define(napi_env env,
+                                  napi_value exports,
+                                  const Entry* entries,
+                                  size_t count) {
+  std::vector<napi_property_descriptor> properties(count);
+  for (size_t index = 0; index < count; index++) {
+    napi_property_descriptor& desc = properties[index];
+    desc.utf8name = entries[index].utf8name;
+    desc.getter = Getter;
+    desc.setter = Setter;
+    desc.data = const_cast<Entry*>(&entries[index]);
+    desc.attributes = details::LazyAccessorAttributes();
+  }
+  napi_status status =
+      napi_define_properties(env, exports, count, properties.data());
+  NAPI_THROW_IF_FAILED(env, status, Object());
+  return Object(env, exports);
 }
 
-template <>
-inline napi_status ThreadSafeFunction::BlockingCall(void* data) const {
-  return napi_call_threadsafe_function(_tsfn, data, napi_tsfn_blocking);
+inline napi_value LazyExports::Getter(napi_env env, napi_callback_info info) {
+  return details::WrapCallback([&]() -> napi_value {
+    CallbackInfo callbackInfo(env, info);
+    const Entry* entry = static_cast<const Entry*>(callbackInfo.Data());
+    return details::DefineLazyValue(
+        callbackInfo, entry->utf8name, entry->callback(callbackInfo.Env()));
+  });
 }
 
-template <typename Callback>
-inline napi_status ThreadSafeFunction::BlockingCall(Callback callback) const {
-  return CallInternal(new CallbackWrapper(callback), napi_tsfn_blocking);
+inline napi_value LazyExports::Setter(napi_env env, napi_callback_info info) {
+  return details::WrapCallback([&]() -> napi_value {
+    CallbackInfo callbackInfo(env, info);
+    const Entry* entry = static_cast<const Entry*>(callbackInfo.Data());
+    details::DefineLazyValue(callbackInfo, entry->utf8name, callbackInfo[0]);
+    return nullptr;
+  });
 }
 
-template <typename DataType, typename Callback>
-inline napi_status ThreadSafeFunction::BlockingCall(DataType* data,
-                                                    Callback callback) const {
-  auto wrapper = [data, callback](Env env, Function jsCallback) {
-    callback(env, jsCallback, data);
-  };
-  return CallInternal(new CallbackWrapper(wrapper), napi_tsfn_blocking);
-}
+#if NAPI_VERSION > 2
+////////////////////////////////////////////////////////////////////////////////
+// Transferable<T> class
+////////////////////////////////////////////////////////////////////////////////
 
-inline napi_status ThreadSafeFunction::NonBlockingCall() const {
-  return CallInternal(nullptr, napi_tsfn_nonblocking);
-}
+namespace details {
 
-template <>
-inline napi_status ThreadSafeFunction::NonBlockingCall(void* data) const {
-  return napi_call_threadsafe_function(_tsfn, data, napi_tsfn_nonblocking);
-}
+// Payloads published by Transferable<T> wait here until they are adopted.
+// Tokens come from a single process-wide counter, and each entry records the
+// payload type it was published with, so that a token is never adopted as
+// another type. Each entry also records the environment that published it:
+// when that environment is torn down, the payloads it published and nobody
+// adopted are released with it.
+class TransferTable {
+ public:
+  template <typename T>
+  static const void* TypeKey() {
+    static const char key = 0;
+    return &key;
+  }
 
-template <typename Callback>
-inline napi_status ThreadSafeFunction::NonBlockingCall(
-    Callback callback) const {
-  return CallInternal(new CallbackWrapper(callback), napi_tsfn_nonblocking);
-}
+  static TransferTable& Instance() {
+    static TransferTable table;
+    return table;
+  }
 
-template <typename DataType, typename Callback>
-inline napi_status ThreadSafeFunction::NonBlockingCall(
-    DataType* data, Callback callback) const {
-  auto wrapper = [data, callback](Env env, Function jsCallback) {
-    callback(env, jsCallback, data);
-  };
-  return CallInternal(new CallbackWrapper(wrapper), napi_tsfn_nonblocking);
-}
+  napi_status Publish(napi_env env,
+                      const void* type,
+                      std::shared_ptr<void> payload,
+                      uint64_t* token) {
+    napi_status status = WatchEnv(env);
+    if (status != napi_ok) return status;
 
-inline void ThreadSafeFunction::Ref(napi_env env) const {
-  if (_tsfn != nullptr) {
-    napi_status status = napi_ref_threadsafe_function(env, _tsfn);
-    NAPI_THROW_IF_FAILED_VOID(env, status);
+#if NAPI_HAS_THREADS
+    std::lock_guard<std::mutex> lock(_mutex);
+#endif  // NAPI_HAS_THREADS
+    *token = ++_next;
+    _entries.emplace(*token, Entry{type, env, std::move(payload)});
+    return napi_ok;
   }
-}
 
-inline void ThreadSafeFunction::Unref(napi_env env) const {
-  if (_tsfn != nullptr) {
-    napi_status status = napi_unref_threadsafe_function(env, _tsfn);
-    NAPI_THROW_IF_FAILED_VOID(env, status);
+  std::shared_ptr<void> Take(const void* type, uint64_t token) {
+#if NAPI_HAS_THREADS
+    std::lock_guard<std::mutex> lock(_mutex);
+#endif  // NAPI_HAS_THREADS
+    std::shared_ptr<void> payload;
+    auto entry = _entries.find(token);
+    if (entry != _entries.end() && entry->second.type == type) {
+      payload = std::move(entry->second.payload);
+      _entries.erase(entry);
+    }
+    return payload;
   }
-}
-
-inline napi_status ThreadSafeFunction::Acquire() const {
-  return napi_acquire_threadsafe_function(_tsfn);
-}
 
-inline napi_status ThreadSafeFunction::Release() const {
-  return napi_release_threadsafe_function(_tsfn, napi_tsfn_release);
-}
+ private:
+  struct Entry {
+    const void* type;
+    napi_env owner;
+    std::shared_ptr<void> payload;
+  };
 
-inline napi_status ThreadSafeFunction::Abort() const {
-  return napi_release_threadsafe_function(_tsfn, napi_tsfn_abort);
-}
+  // Environments are bound to a thread, so the set of environments with a
+  // cleanup hook is kept per thread and needs no locking.
+  static std::unordered_set<napi_env>& WatchedEnvs() {
+    static thread_local std::unordered_set<napi_env> envs;
+    return envs;
+  }
 
-inline ThreadSafeFunction::ConvertibleContext ThreadSafeFunction::GetContext()
-    const {
-  void* context;
-  napi_status status = napi_get_threadsafe_function_context(_tsfn, &context);
-  NAPI_FATAL_IF_FAILED(status,
-                       "ThreadSafeFunction::GetContext",
-                       "napi_get_threadsafe_function_context");
-  return ConvertibleContext({context});
-}
-
-// static
-template <typename ResourceString,
-          typename ContextType,
-          typename Finalizer,
-          typename FinalizerDataType>
-inline ThreadSafeFunction ThreadSafeFunction::New(napi_env env,
-                                                  const Function& callback,
-                                                  const Object& resource,
-                                                  ResourceString resourceName,
-                                                  size_t maxQueueSize,
-                                                  size_t initialThreadCount,
-                                                  ContextType* context,
-                                                  Finalizer finalizeCallback,
-                                                  FinalizerDataType* data,
-                                                  napi_finalize wrapper) {
-  static_assert(details::can_make_string<ResourceString>::value ||
-                    std::is_convertible<ResourceString, napi_value>::value,
-                "Resource name should be convertible to the string type");
-
-  ThreadSafeFunction tsfn;
-  auto* finalizeData = new details::
-      ThreadSafeFinalize<ContextType, Finalizer, FinalizerDataType>(
-          {data, finalizeCallback});
-  napi_status status =
-      napi_create_threadsafe_function(env,
-                                      callback,
-                                      resource,
-                                      Value::From(env, resourceName),
-                                      maxQueueSize,
-                                      initialThreadCount,
-                                      finalizeData,
-                                      wrapper,
-                                      context,
-                                      CallJS,
-                                      &tsfn._tsfn);
-  if (status != napi_ok) {
-    delete finalizeData;
-    NAPI_THROW_IF_FAILED(env, status, ThreadSafeFunction());
+  static napi_status WatchEnv(napi_env env) {
+    std::unordered_set<napi_env>& envs = WatchedEnvs();
+    if (envs.find(env) != envs.end()) return napi_ok;
+    napi_status status = napi_add_env_cleanup_hook(env, ReleaseEnv, env);
+    if (status == napi_ok) envs.insert(env);
+    return status;
   }
 
-  return tsfn;
-}
+  static void ReleaseEnv(void* data) {
+    napi_env env = static_cast<napi_env>(data);
+    WatchedEnvs().erase(env);
 
-inline napi_status ThreadSafeFunction::CallInternal(
-    CallbackWrapper* callbackWrapper,
-    napi_threadsafe_function_call_mode mode) const {
-  napi_status status =
-      napi_call_threadsafe_function(_tsfn, callbackWrapper, mode);
-  if (status != napi_ok && callbackWrapper != nullptr) {
-    delete callbackWrapper;
+    // The payloads are destroyed outside the lock, since their destructors may
+    // publish or adopt other payloads.
+    std::vector<std::shared_ptr<void>> released;
+    TransferTable& table = Instance();
+    {
+#if NAPI_HAS_THREADS
+      std::lock_guard<std::mutex> lock(table._mutex);
+#endif  // NAPI_HAS_THREADS
+      for (auto entry = table._entries.begin();
+           entry != table._entries.end();) {
+        if (entry->second.owner == env) {
+          released.push_back(std::move(entry->second.payload));
+          entry = table._entries.erase(entry);
+        } else {
+          ++entry;
+        }
+      }
+    }
   }
 
-  return status;
-}
+#if NAPI_HAS_THREADS
+  std::mutex _mutex;
+#endif  // NAPI_HAS_THREADS
+  uint64_t _next = 0;
+  std::unordered_map<uint64_t, Entry> _entries;
+};
 
-// static
-inline void ThreadSafeFunction::CallJS(napi_env env,
-                                       napi_value jsCallback,
-                                       void* /* context */,
-                                       void* data) {
-  if (env == nullptr && jsCallback == nullptr) {
-    return;
+// Tokens are exposed to JavaScript as integral numbers, which represent every
+// token up to 2^53 exactly.
+inline bool TransferTokenFromValue(napi_env env,
+                                   napi_value value,
+                                   uint64_t* token) {
+  napi_valuetype type;
+  double number;
+  if (napi_typeof(env, value, &type) != napi_ok || type != napi_number ||
+      napi_get_value_double(env, value, &number) != napi_ok) {
+    return false;
   }
-
-  if (data != nullptr) {
-    auto* callbackWrapper = static_cast<CallbackWrapper*>(data);
-    (*callbackWrapper)(env, Function(env, jsCallback));
-    delete callbackWrapper;
-  } else if (jsCallback != nullptr) {
-    Function(env, jsCallback).Call({});
+  if (!(number >= 1 && number <= 9007199254740992.0) ||
+      std::floor(number) != number) {
+    return false;
   }
+  *token = static_cast<uint64_t>(number);
+  return true;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Async Progress Worker Base class
-////////////////////////////////////////////////////////////////////////////////
-template <typename DataType>
-inline AsyncProgressWorkerBase<DataType>::AsyncProgressWorkerBase(
-    const Object& receiver,
-    const Function& callback,
-    const char* resource_name,
-    const Object& resource,
-    size_t queue_size)
-    : AsyncWorker(receiver, callback, resource_name, resource) {
-  // Fill all possible arguments to work around ambiguous
-  // ThreadSafeFunction::New signatures.
-  _tsfn = ThreadSafeFunction::New(callback.Env(),
-                                  callback,
-                                  resource,
-                                  resource_name,
-                                  queue_size,
-                                  /** initialThreadCount */ 1,
-                                  /** context */ this,
-                                  OnThreadSafeFunctionFinalize,
-                                  /** finalizeData */ this);
+}  // namespace details
+
+template <typename T>
+inline Transferable<T>::Transferable() {}
+
+template <typename T>
+inline Transferable<T>::Transferable(std::shared_ptr<T> payload)
+    : _payload(std::move(payload)) {}
+
+template <typename T>
+template <typename... Args>
+inline Transferable<T> Transferable<T>::New(Args&&... args) {
+  return Transferable(std::make_shared<T>(std::forward<Args>(args)...));
 }
 
-#if NAPI_VERSION > 4
-template <typename DataType>
-inline AsyncProgressWorkerBase<DataType>::AsyncProgressWorkerBase(
-    Napi::Env env,
-    const char* resource_name,
-    const Object& resource,
-    size_t queue_size)
-    : AsyncWorker(env, resource_name, resource) {
-  // TODO: Once the changes to make the callback optional for threadsafe
-  // functions are available on all versions we can remove the dummy Function
-  // here.
-  Function callback;
-  // Fill all possible arguments to work around ambiguous
-  // ThreadSafeFunction::New signatures.
-  _tsfn = ThreadSafeFunction::New(env,
-                                  callback,
-                                  resource,
-                                  resource_name,
-                                  queue_size,
-                                  /** initialThreadCount */ 1,
-                                  /** context */ this,
-                                  OnThreadSafeFunctionFinalize,
-                                  /** finalizeData */ this);
+template <typename T>
+inline bool Transferable<T>::IsEmpty() const {
+  return _payload == nullptr;
 }
-#endif
 
-template <typename DataType>
-inline AsyncProgressWorkerBase<DataType>::~AsyncProgressWorkerBase() {
-  // Abort pending tsfn call.
-  // Don't send progress events after we've already completed.
-  // It's ok to call ThreadSafeFunction::Abort and ThreadSafeFunction::Release
-  // duplicated.
-  _tsfn.Abort();
+template <typename T>
+inline T* Transferable<T>::Get() const {
+  return _payload.get();
 }
 
-template <typename DataType>
-inline void AsyncProgressWorkerBase<DataType>::OnAsyncWorkProgress(
-    Napi::Env /* env */, Napi::Function /* jsCallback */, void* data) {
-  ThreadSafeData* tsd = static_cast<ThreadSafeData*>(data);
-  tsd->asyncprogressworker()->OnWorkProgress(tsd->data());
-  delete tsd;
+template <typename T>
+inline T& Transferable<T>::operator*() const {
+  return *_payload;
 }
 
-template <typename DataType>
-inline napi_status AsyncProgressWorkerBase<DataType>::NonBlockingCall(
-    DataType* data) {
-  auto tsd = new AsyncProgressWorkerBase::ThreadSafeData(this, data);
-  auto ret = _tsfn.NonBlockingCall(tsd, OnAsyncWorkProgress);
-  if (ret != napi_ok) {
-    delete tsd;
-  }
-  return ret;
+template <typename T>
+inline T* Transferable<T>::operator->() const {
+  return _payload.get();
 }
 
-template <typename DataType>
-inline void AsyncProgressWorkerBase<DataType>::OnWorkComplete(
-    Napi::Env /* env */, napi_status status) {
-  _work_completed = true;
-  _complete_status = status;
-  _tsfn.Release();
+template <typename T>
+inline const std::shared_ptr<T>& Transferable<T>::Payload() const {
+  return _payload;
 }
 
-template <typename DataType>
-inline void AsyncProgressWorkerBase<DataType>::OnThreadSafeFunctionFinalize(
-    Napi::Env env, void* /* data */, AsyncProgressWorkerBase* context) {
-  if (context->_work_completed) {
-    context->AsyncWorker::OnWorkComplete(env, context->_complete_status);
+template <typename T>
+inline MaybeOrValue<Number> Transferable<T>::Detach(napi_env env) {
+  MaybeOrValue<Number> token = Publish(env, _payload);
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  if (token.IsJust()) {
+    _payload.reset();
+  }
+#else
+  if (!token.IsEmpty()) {
+    _payload.reset();
   }
+#endif
+  return token;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Async Progress Worker class
-////////////////////////////////////////////////////////////////////////////////
-template <class T>
-inline AsyncProgressWorker<T>::AsyncProgressWorker(const Function& callback)
-    : AsyncProgressWorker(callback, "generic") {}
-
-template <class T>
-inline AsyncProgressWorker<T>::AsyncProgressWorker(const Function& callback,
-                                                   const char* resource_name)
-    : AsyncProgressWorker(
-          callback, resource_name, Object::New(callback.Env())) {}
-
-template <class T>
-inline AsyncProgressWorker<T>::AsyncProgressWorker(const Function& callback,
-                                                   const char* resource_name,
-                                                   const Object& resource)
-    : AsyncProgressWorker(
-          Object::New(callback.Env()), callback, resource_name, resource) {}
-
-template <class T>
-inline AsyncProgressWorker<T>::AsyncProgressWorker(const Object& receiver,
-                                                   const Function& callback)
-    : AsyncProgressWorker(receiver, callback, "generic") {}
-
-template <class T>
-inline AsyncProgressWorker<T>::AsyncProgressWorker(const Object& receiver,
-                                                   const Function& callback,
-                                                   const char* resource_name)
-    : AsyncProgressWorker(
-          receiver, callback, resource_name, Object::New(callback.Env())) {}
-
-template <class T>
-inline AsyncProgressWorker<T>::AsyncProgressWorker(const Object& receiver,
-                                                   const Function& callback,
-                                                   const char* resource_name,
-                                                   const Object& resource)
-    : AsyncProgressWorkerBase(receiver, callback, resource_name, resource),
-      _asyncdata(nullptr),
-      _asyncsize(0),
-      _signaled(false) {}
-
-#if NAPI_VERSION > 4
-template <class T>
-inline AsyncProgressWorker<T>::AsyncProgressWorker(Napi::Env env)
-    : AsyncProgressWorker(env, "generic") {}
-
-template <class T>
-inline AsyncProgressWorker<T>::AsyncProgressWorker(Napi::Env env,
-                                                   const char* resource_name)
-    : AsyncProgressWorker(env, resource_name, Object::New(env)) {}
+template <typename T>
+inline MaybeOrValue<Number> Transferable<T>::Share(napi_env env) const {
+  return Publish(env, _payload);
+}
 
-template <class T>
-inline AsyncProgressWorker<T>::AsyncProgressWorker(Napi::Env env,
-                                                   const char* resource_name,
-                                                   const Object& resource)
-    : AsyncProgressWorkerBase(env, resource_name, resource),
-      _asyncdata(nullptr),
-      _asyncsize(0) {}
+template <typename T>
+inline MaybeOrValue<Transferable<T>> Transferable<T>::Adopt(napi_env env,
+                                                           napi_value token) {
+  uint64_t id;
+  std::shared_ptr<T> payload;
+  if (details::TransferTokenFromValue(env, token, &id)) {
+    payload = std::static_pointer_cast<T>(
+        details::TransferTable::Instance().Take(
+            details::TransferTable::TypeKey<T>(), id));
+  }
+  if (payload == nullptr) {
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+    NAPI_THROW(Error::New(env, "Invalid or already adopted transfer token"),
+               Nothing<Transferable>());
+#else
+    NAPI_THROW(Error::New(env, "Invalid or already adopted transfer token"),
+               Transferable());
 #endif
-
-template <class T>
-inline AsyncProgressWorker<T>::~AsyncProgressWorker() {
-  {
-    std::lock_guard<std::mutex> lock(this->_mutex);
-    _asyncdata = nullptr;
-    _asyncsize = 0;
   }
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  return Just(Transferable(std::move(payload)));
+#else
+  return Transferable(std::move(payload));
+#endif
 }
 
-template <class T>
-inline void AsyncProgressWorker<T>::Execute() {
-  ExecutionProgress progress(this);
-  Execute(progress);
+template <typename T>
+inline bool Transferable<T>::Discard(napi_env env, napi_value token) {
+  uint64_t id;
+  return details::TransferTokenFromValue(env, token, &id) &&
+         details::TransferTable::Instance().Take(
+             details::TransferTable::TypeKey<T>(), id) != nullptr;
 }
 
-template <class T>
-inline void AsyncProgressWorker<T>::OnWorkProgress(void*) {
-  T* data;
-  size_t size;
-  bool signaled;
-  {
-    std::lock_guard<std::mutex> lock(this->_mutex);
-    data = this->_asyncdata;
-    size = this->_asyncsize;
-    signaled = this->_signaled;
-    this->_asyncdata = nullptr;
-    this->_asyncsize = 0;
-    this->_signaled = false;
-  }
-
-  /**
-   * The callback of ThreadSafeFunction is not been invoked immediately on the
-   * callback of uv_async_t (uv io poll), rather the callback of TSFN is
-   * invoked on the right next uv idle callback. There are chances that during
-   * the deferring the signal of uv_async_t is been sent again, i.e. potential
-   * not coalesced two calls of the TSFN callback.
-   */
-  if (data == nullptr && !signaled) {
-    return;
+template <typename T>
+inline MaybeOrValue<Number> Transferable<T>::Publish(
+    napi_env env, std::shared_ptr<T> payload) {
+  if (payload == nullptr) {
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+    NAPI_THROW(Error::New(env, "The transferable is empty"), Nothing<Number>());
+#else
+    NAPI_THROW(Error::New(env, "The transferable is empty"), Number());
+#endif
   }
 
-  this->OnProgress(data, size);
-  delete[] data;
+  details::TransferTable& table = details::TransferTable::Instance();
+  const void* type = details::TransferTable::TypeKey<T>();
+  uint64_t id;
+  napi_status status = table.Publish(env, type, std::move(payload), &id);
+  NAPI_MAYBE_THROW_IF_FAILED(env, status, Number);
+
+  napi_value token;
+  status = napi_create_double(env, static_cast<double>(id), &token);
+  if (status != napi_ok) {
+    table.Take(type, id);
+  }
+  NAPI_MAYBE_THROW_IF_FAILED(env, status, Number);
+
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  return Just(Number(env, token));
+#else
+  return Number(env, token);
+#endif
 }
+#endif  // NAPI_VERSION > 2
 
-template <class T>
-inline void AsyncProgressWorker<T>::SendProgress_(const T* data, size_t count) {
-  T* new_data = new T[count];
-  std::copy(data, data + count, new_data);
+////////////////////////////////////////////////////////////////////////////////
+// HandleScope class
+////////////////////////////////////////////////////////////////////////////////
 
-  T* old_data;
-  {
-    std::lock_guard<std::mutex> lock(this->_mutex);
-    old_data = _asyncdata;
-    _asyncdata = new_data;
-    _asyncsize = count;
-    _signaled = false;
-  }
-  this->NonBlockingCall(nullptr);
+inline HandleScope::HandleScope(napi_env env, napi_handle_scope scope)
+    : _env(env), _scope(scope) {}
 
-  delete[] old_data;
+inline HandleScope::HandleScope(Napi::Env env) : _env(env) {
+  napi_status status = napi_open_handle_scope(_env, &_scope);
+  NAPI_THROW_IF_FAILED_VOID(_env, status);
 }
 
-template <class T>
-inline void AsyncProgressWorker<T>::Signal() {
-  {
-    std::lock_guard<std::mutex> lock(this->_mutex);
-    _signaled = true;
-  }
-  this->NonBlockingCall(static_cast<T*>(nullptr));
+inline HandleScope::~HandleScope() {
+  napi_status status = napi_close_handle_scope(_env, _scope);
+  NAPI_FATAL_IF_FAILED(
+      status, "HandleScope::~HandleScope", "napi_close_handle_scope");
 }
 
-template <class T>
-inline void AsyncProgressWorker<T>::ExecutionProgress::Signal() const {
-  this->_worker->Signal();
+inline HandleScope::operator napi_handle_scope() const {
+  return _scope;
 }
 
-template <class T>
-inline void AsyncProgressWorker<T>::ExecutionProgress::Send(
-    const T* data, size_t count) const {
-  _worker->SendProgress_(data, count);
+inline Napi::Env HandleScope::Env() const {
+  return Napi::Env(_env);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Async Progress Queue Worker class
+// EscapableHandleScope class
 ////////////////////////////////////////////////////////////////////////////////
-template <class T>
-inline AsyncProgressQueueWorker<T>::AsyncProgressQueueWorker(
-    const Function& callback)
-    : AsyncProgressQueueWorker(callback, "generic") {}
 
-template <class T>
-inline AsyncProgressQueueWorker<T>::AsyncProgressQueueWorker(
-    const Function& callback, const char* resource_name)
-    : AsyncProgressQueueWorker(
-          callback, resource_name, Object::New(callback.Env())) {}
+inline EscapableHandleScope::EscapableHandleScope(
+    napi_env env, napi_escapable_handle_scope scope)
+    : _env(env), _scope(scope) {}
 
-template <class T>
-inline AsyncProgressQueueWorker<T>::AsyncProgressQueueWorker(
-    const Function& callback, const char* resource_name, const Object& resource)
-    : AsyncProgressQueueWorker(
-          Object::New(callback.Env()), callback, resource_name, resource) {}
+inline EscapableHandleScope::EscapableHandleScope(Napi::Env env) : _env(env) {
+  napi_status status = napi_open_escapable_handle_scope(_env, &_scope);
+  NAPI_THROW_IF_FAILED_VOID(_env, status);
+}
 
-template <class T>
-inline AsyncProgressQueueWorker<T>::AsyncProgressQueueWorker(
-    const Object& receiver, const Function& callback)
-    : AsyncProgressQueueWorker(receiver, callback, "generic") {}
+inline EscapableHandleScope::~EscapableHandleScope() {
+  napi_status status = napi_close_escapable_handle_scope(_env, _scope);
+  NAPI_FATAL_IF_FAILED(status,
+                       "EscapableHandleScope::~EscapableHandleScope",
+                       "napi_close_escapable_handle_scope");
+}
 
-template <class T>
-inline AsyncProgressQueueWorker<T>::AsyncProgressQueueWorker(
-    const Object& receiver, const Function& callback, const char* resource_name)
-    : AsyncProgressQueueWorker(
-          receiver, callback, resource_name, Object::New(callback.Env())) {}
+inline EscapableHandleScope::operator napi_escapable_handle_scope() const {
+  return _scope;
+}
 
-template <class T>
-inline AsyncProgressQueueWorker<T>::AsyncProgressQueueWorker(
-    const Object& receiver,
-    const Function& callback,
-    const char* resource_name,
-    const Object& resource)
-    : AsyncProgressWorkerBase<std::pair<T*, size_t>>(
-          receiver,
-          callback,
-          resource_name,
-          resource,
-          /** unlimited queue size */ 0) {}
+inline Napi::Env EscapableHandleScope::Env() const {
+  return Napi::Env(_env);
+}
 
-#if NAPI_VERSION > 4
-template <class T>
-inline AsyncProgressQueueWorker<T>::AsyncProgressQueueWorker(Napi::Env env)
-    : AsyncProgressQueueWorker(env, "generic") {}
+inline Value EscapableHandleScope::Escape(napi_value escapee) {
+  napi_value result;
+  napi_status status = napi_escape_handle(_env, _scope, escapee, &result);
+  NAPI_THROW_IF_FAILED(_env, status, Value());
+  return Value(_env, result);
+}
 
-template <class T>
-inline AsyncProgressQueueWorker<T>::AsyncProgressQueueWorker(
-    Napi::Env env, const char* resource_name)
-    : AsyncProgressQueueWorker(env, resource_name, Object::New(env)) {}
+////////////////////////////////////////////////////////////////////////////////
+// ScopedLoop class
+////////////////////////////////////////////////////////////////////////////////
 
-template <class T>
-inline AsyncProgressQueueWorker<T>::AsyncProgressQueueWorker(
-    Napi::Env env, const char* resource_name, const Object& resource)
-    : AsyncProgressWorkerBase<std::pair<T*, size_t>>(
-          env, resource_name, resource, /** unlimited queue size */ 0) {}
-#endif
+inline ScopedLoop::ScopedLoop(Napi::Env env, size_t chunkSize)
+    : _env(env),
+      _chunkSize(chunkSize == 0 ? 1 : chunkSize),
+      _iterations(0),
+      _escaped(false),
+      _scope(nullptr) {
+  Open();
+}
 
-template <class T>
-inline void AsyncProgressQueueWorker<T>::Execute() {
-  ExecutionProgress progress(this);
-  Execute(progress);
+inline ScopedLoop::~ScopedLoop() {
+  Close();
 }
 
-template <class T>
-inline void AsyncProgressQueueWorker<T>::OnWorkProgress(
-    std::pair<T*, size_t>* datapair) {
-  if (datapair == nullptr) {
-    return;
-  }
+inline void ScopedLoop::Open() {
+  napi_status status = napi_open_escapable_handle_scope(_env, &_scope);
+  NAPI_THROW_IF_FAILED_VOID(_env, status);
+}
 
-  T* data = datapair->first;
-  size_t size = datapair->second;
+inline void ScopedLoop::Close() {
+  if (_scope != nullptr) {
+    napi_status status = napi_close_escapable_handle_scope(_env, _scope);
+    NAPI_FATAL_IF_FAILED(
+        status, "ScopedLoop::Close", "napi_close_escapable_handle_scope");
+    _scope = nullptr;
+  }
+}
 
-  this->OnProgress(data, size);
-  delete datapair;
-  delete[] data;
+inline void ScopedLoop::Next() {
+  // A scope can only escape one value, so an escape also ends the chunk.
+  if (++_iterations < _chunkSize && !_escaped) {
+    return;
+  }
+  Close();
+  _iterations = 0;
+  _escaped = false;
+  Open();
 }
 
-template <class T>
-inline void AsyncProgressQueueWorker<T>::SendProgress_(const T* data,
-                                                       size_t count) {
-  T* new_data = new T[count];
-  std::copy(data, data + count, new_data);
+inline Value ScopedLoop::Escape(napi_value escapee) {
+  napi_value result;
+  napi_status status = napi_escape_handle(_env, _scope, escapee, &result);
+  NAPI_THROW_IF_FAILED(_env, status, Value());
+  _escaped = true;
+  return Value(_env, result);
+}
 
-  auto pair = new std::pair<T*, size_t>(new_data, count);
-  this->NonBlockingCall(pair);
+inline Napi::Env ScopedLoop::Env() const {
+  return Napi::Env(_env);
 }
 
-template <class T>
-inline void AsyncProgressQueueWorker<T>::Signal() const {
-  this->SendProgress_(static_cast<T*>(nullptr), 0);
+inline size_t ScopedLoop::ChunkSize() const {
+  return _chunkSize;
 }
 
-template <class T>
-inline void AsyncProgressQueueWorker<T>::OnWorkComplete(Napi::Env env,
-                                                        napi_status status) {
-  // Draining queued items in TSFN.
-  AsyncProgressWorkerBase<std::pair<T*, size_t>>::OnWorkComplete(env, status);
+namespace details {
+
+// Prefers `callback(element, loop)` and falls back to `callback(element)`.
+template <typename Callback, typename Element>
+inline auto InvokeScoped(Callback& callback,
+                         Element&& element,
+                         ScopedLoop& loop,
+                         int)
+    -> decltype(callback(std::forward<Element>(element), loop)) {
+  return callback(std::forward<Element>(element), loop);
+}
+
+template <typename Callback, typename Element>
+inline auto InvokeScoped(Callback& callback,
+                         Element&& element,
+                         ScopedLoop&,
+                         long)
+    -> decltype(callback(std::forward<Element>(element))) {
+  return callback(std::forward<Element>(element));
+}
+
+template <typename Callback, typename Element>
+using ScopedResult = decltype(InvokeScoped(std::declval<Callback&>(),
+                                           std::declval<Element>(),
+                                           std::declval<ScopedLoop&>(),
+                                           0));
+
+// Returns whether the iteration should continue. Only callbacks that return
+// `bool` can stop it.
+template <typename Callback, typename Element>
+inline typename std::enable_if<
+    std::is_same<ScopedResult<Callback, Element>, bool>::value,
+    bool>::type
+StepScoped(Callback& callback, Element&& element, ScopedLoop& loop) {
+  return InvokeScoped(callback, std::forward<Element>(element), loop, 0);
+}
+
+template <typename Callback, typename Element>
+inline typename std::enable_if<
+    !std::is_same<ScopedResult<Callback, Element>, bool>::value,
+    bool>::type
+StepScoped(Callback& callback, Element&& element, ScopedLoop& loop) {
+  InvokeScoped(callback, std::forward<Element>(element), loop, 0);
+  return true;
 }
 
-template <class T>
-inline void AsyncProgressQueueWorker<T>::ExecutionProgress::Signal() const {
-  _worker->SendProgress_(static_cast<T*>(nullptr), 0);
+}  // namespace details
+
+template <typename Range, typename Callback>
+inline void ForEachScoped(Napi::Env env,
+                          Range&& range,
+                          Callback callback,
+                          size_t chunkSize) {
+  ScopedLoop loop(env, chunkSize);
+  for (auto&& element : range) {
+    if (!details::StepScoped(
+            callback, std::forward<decltype(element)>(element), loop)) {
+      break;
+    }
+    loop.Next();
+  }
 }
 
-template <class T>
-inline void AsyncProgressQueueWorker<T>::ExecutionProgress::Send(
-    const T* data, size_t count) const {
-  _worker->SendProgress_(data, count);
+// Defined here rather than with the rest of Object because it builds on the
+// ScopedLoop helpers above.
+template <typename Callback>
+inline MaybeOrValue<bool> Object::ForEachEntry(Callback callback,
+                                               EntryKeys keys,
+                                               size_t chunkSize) const {
+  napi_value names;
+  uint32_t length = 0;
+  napi_status status = details::GetEntryKeys(_env, _value, keys, &names);
+  if (status == napi_ok) {
+    status = napi_get_array_length(_env, names, &length);
+  }
+  NAPI_MAYBE_THROW_IF_FAILED(_env, status, bool);
+
+  bool completed = true;
+  ScopedLoop loop(_env, chunkSize);
+  for (uint32_t index = 0; index < length; index++, loop.Next()) {
+    napi_value key;
+    napi_value value;
+    status = details::GetEntry(_env, _value, names, index, &key, &value);
+    NAPI_MAYBE_THROW_IF_FAILED(_env, status, bool);
+    const Entry entry{Value(_env, key), Value(_env, value)};
+    if (!details::StepScoped(callback, entry, loop)) {
+      completed = false;
+      break;
+    }
+  }
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  return Just(completed);
+#else
+  return completed;
+#endif
 }
-#endif  // NAPI_VERSION > 3 && NAPI_HAS_THREADS
 
 ////////////////////////////////////////////////////////////////////////////////
 // Memory Management class
@@ -6504,45 +7967,6 @@ inline const napi_node_version* VersionManagement::GetNodeVersion(Env env) {
   return result;
 }
 
-#if NAPI_VERSION > 5
-////////////////////////////////////////////////////////////////////////////////
-// Addon<T> class
-////////////////////////////////////////////////////////////////////////////////
-
-template <typename T>
-inline Object Addon<T>::Init(Env env, Object exports) {
-  T* addon = new T(env, exports);
-  env.SetInstanceData(addon);
-  return addon->entry_point_;
-}
-
-template <typename T>
-inline T* Addon<T>::Unwrap(Object wrapper) {
-  return wrapper.Env().GetInstanceData<T>();
-}
-
-template <typename T>
-inline void Addon<T>::DefineAddon(
-    Object exports, const std::initializer_list<AddonProp>& props) {
-  DefineProperties(exports, props);
-  entry_point_ = exports;
-}
-
-template <typename T>
-inline Napi::Object Addon<T>::DefineProperties(
-    Object object, const std::initializer_list<AddonProp>& props) {
-  const napi_property_descriptor* properties =
-      reinterpret_cast<const napi_property_descriptor*>(props.begin());
-  size_t size = props.size();
-  napi_status status =
-      napi_define_properties(object.Env(), object, size, properties);
-  NAPI_THROW_IF_FAILED(object.Env(), status, object);
-  for (size_t idx = 0; idx < size; idx++)
-    T::AttachPropData(object.Env(), object, &properties[idx]);
-  return object;
-}
-#endif  // NAPI_VERSION > 5
-
 #if NAPI_VERSION > 2
 template <typename Hook, typename Arg>
 Env::CleanupHook<Hook, Arg> Env::AddCleanupHook(Hook hook, Arg* arg) {
@@ -6595,6 +8019,32 @@ bool Env::CleanupHook<Hook, Arg>::IsEmpty() const {
 }
 #endif  // NAPI_VERSION > 2
 
+#ifdef NODE_ADDON_API_EXTERN_TEMPLATES
+// Commonly used specializations are compiled once, in napi.cc, rather than in
+// every translation unit that uses them.
+#ifdef NODE_ADDON_API_INSTANTIATE_TEMPLATES
+#define NAPI_TEMPLATE_INSTANTIATION template
+#else
+#define NAPI_TEMPLATE_INSTANTIATION extern template
+#endif
+NAPI_TEMPLATE_INSTANTIATION class Reference<Object>;
+NAPI_TEMPLATE_INSTANTIATION class Reference<Function>;
+NAPI_TEMPLATE_INSTANTIATION class Buffer<uint8_t>;
+NAPI_TEMPLATE_INSTANTIATION class TypedArrayOf<int8_t>;
+NAPI_TEMPLATE_INSTANTIATION class TypedArrayOf<uint8_t>;
+NAPI_TEMPLATE_INSTANTIATION class TypedArrayOf<int16_t>;
+NAPI_TEMPLATE_INSTANTIATION class TypedArrayOf<uint16_t>;
+NAPI_TEMPLATE_INSTANTIATION class TypedArrayOf<int32_t>;
+NAPI_TEMPLATE_INSTANTIATION class TypedArrayOf<uint32_t>;
+NAPI_TEMPLATE_INSTANTIATION class TypedArrayOf<float>;
+NAPI_TEMPLATE_INSTANTIATION class TypedArrayOf<double>;
+#if NAPI_VERSION > 5
+NAPI_TEMPLATE_INSTANTIATION class TypedArrayOf<int64_t>;
+NAPI_TEMPLATE_INSTANTIATION class TypedArrayOf<uint64_t>;
+#endif  // NAPI_VERSION > 5
+#undef NAPI_TEMPLATE_INSTANTIATION
+#endif  // NODE_ADDON_API_EXTERN_TEMPLATES
+
 #ifdef NAPI_CPP_CUSTOM_NAMESPACE
 }  // namespace NAPI_CPP_CUSTOM_NAMESPACE
 #endif
@@ -0,0 +1,417 @@
+#ifndef SRC_NAPI_OBJECTWRAP_H_
+#define SRC_NAPI_OBJECTWRAP_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// Node-API C++ Wrapper Classes: class wrapping
+//
+// InstanceWrap<T>, ObjectWrap<T> and Addon<T>.
+//
+// Included by "napi.h" unless NODE_ADDON_API_MODULAR_HEADERS is defined. In
+// that case, include this header in the translation units that use it.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "napi.h"
+
+namespace Napi {
+
+#ifdef NAPI_CPP_CUSTOM_NAMESPACE
+namespace NAPI_CPP_CUSTOM_NAMESPACE {
+#endif
+
+/// Property descriptor for use with `ObjectWrap::DefineClass()`.
+///
+/// This is different from the standalone `PropertyDescriptor` because it is
+/// specific to each `ObjectWrap<T>` subclass. This prevents using descriptors
+/// from a different class when defining a new class (preventing the callbacks
+/// from having incorrect `this` pointers).
+template <typename T>
+class ClassPropertyDescriptor {
+ public:
+  ClassPropertyDescriptor(napi_property_descriptor desc) : _desc(desc) {}
+
+  operator napi_property_descriptor&() { return _desc; }
+  operator const napi_property_descriptor&() const { return _desc; }
+
+ private:
+  napi_property_descriptor _desc;
+};
+
+template <typename T, typename TCallback>
+struct MethodCallbackData {
+  TCallback callback;
+  void* data;
+  // The instance to call an instance method on when it is known in advance,
+  // as for `Addon<T>`. Otherwise it is unwrapped from `this` on each call.
+  T* instance;
+};
+
+template <typename T, typename TGetterCallback, typename TSetterCallback>
+struct AccessorCallbackData {
+  TGetterCallback getterCallback;
+  TSetterCallback setterCallback;
+  void* data;
+  // See `MethodCallbackData::instance`.
+  T* instance;
+};
+
+template <typename T>
+class InstanceWrap {
+ public:
+  using InstanceVoidMethodCallback = void (T::*)(const CallbackInfo& info);
+  using InstanceMethodCallback = Napi::Value (T::*)(const CallbackInfo& info);
+  using InstanceGetterCallback = Napi::Value (T::*)(const CallbackInfo& info);
+  using InstanceSetterCallback = void (T::*)(const CallbackInfo& info,
+                                             const Napi::Value& value);
+
+  using PropertyDescriptor = ClassPropertyDescriptor<T>;
+
+  static PropertyDescriptor InstanceMethod(
+      const char* utf8name,
+      InstanceVoidMethodCallback method,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor InstanceMethod(
+      const char* utf8name,
+      InstanceMethodCallback method,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor InstanceMethod(
+      Symbol name,
+      InstanceVoidMethodCallback method,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor InstanceMethod(
+      Symbol name,
+      InstanceMethodCallback method,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <InstanceVoidMethodCallback method>
+  static PropertyDescriptor InstanceMethod(
+      const char* utf8name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <InstanceMethodCallback method>
+  static PropertyDescriptor InstanceMethod(
+      const char* utf8name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <InstanceVoidMethodCallback method>
+  static PropertyDescriptor InstanceMethod(
+      Symbol name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <InstanceMethodCallback method>
+  static PropertyDescriptor InstanceMethod(
+      Symbol name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor InstanceAccessor(
+      const char* utf8name,
+      InstanceGetterCallback getter,
+      InstanceSetterCallback setter,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor InstanceAccessor(
+      Symbol name,
+      InstanceGetterCallback getter,
+      InstanceSetterCallback setter,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <InstanceGetterCallback getter,
+            InstanceSetterCallback setter = nullptr>
+  static PropertyDescriptor InstanceAccessor(
+      const char* utf8name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <InstanceGetterCallback getter,
+            InstanceSetterCallback setter = nullptr>
+  static PropertyDescriptor InstanceAccessor(
+      Symbol name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor InstanceValue(
+      const char* utf8name,
+      Napi::Value value,
+      napi_property_attributes attributes = napi_default);
+  static PropertyDescriptor InstanceValue(
+      Symbol name,
+      Napi::Value value,
+      napi_property_attributes attributes = napi_default);
+
+ protected:
+  static void AttachPropData(napi_env env,
+                             napi_value value,
+                             const napi_property_descriptor* prop);
+  // Binds `instance` to the callback data of an instance method or accessor,
+  // so that calls to it need not unwrap the instance from `this`.
+  static void BindPropData(const napi_property_descriptor* prop, T* instance);
+
+ private:
+  using This = InstanceWrap<T>;
+
+  using InstanceVoidMethodCallbackData =
+      MethodCallbackData<T, InstanceVoidMethodCallback>;
+  using InstanceMethodCallbackData =
+      MethodCallbackData<T, InstanceMethodCallback>;
+  using InstanceAccessorCallbackData =
+      AccessorCallbackData<T, InstanceGetterCallback, InstanceSetterCallback>;
+
+  static napi_value InstanceVoidMethodCallbackWrapper(napi_env env,
+                                                      napi_callback_info info);
+  static napi_value InstanceMethodCallbackWrapper(napi_env env,
+                                                  napi_callback_info info);
+  static napi_value InstanceGetterCallbackWrapper(napi_env env,
+                                                  napi_callback_info info);
+  static napi_value InstanceSetterCallbackWrapper(napi_env env,
+                                                  napi_callback_info info);
+
+  template <InstanceSetterCallback method>
+  static napi_value WrappedMethod(napi_env env,
+                                  napi_callback_info info) NAPI_NOEXCEPT;
+
+  template <InstanceSetterCallback setter>
+  struct SetterTag {};
+
+  template <InstanceSetterCallback setter>
+  static napi_callback WrapSetter(SetterTag<setter>) NAPI_NOEXCEPT {
+    return &This::WrappedMethod<setter>;
+  }
+  static napi_callback WrapSetter(SetterTag<nullptr>) NAPI_NOEXCEPT {
+    return nullptr;
+  }
+};
+
+/// Base class to be extended by C++ classes exposed to JavaScript; each C++
+/// class instance gets "wrapped" by a JavaScript object that is managed by this
+/// class.
+///
+/// At initialization time, the `DefineClass()` method must be used to
+/// hook up the accessor and method callbacks. It takes a list of
+/// property descriptors, which can be constructed via the various
+/// static methods on the base class.
+///
+/// #### Example:
+///
+///     class Example: public Napi::ObjectWrap<Example> {
+///       public:
+///         static void Initialize(Napi::Env& env, Napi::Object& target) {
+///           Napi::Function constructor = DefineClass(env, "Example", {
+///             InstanceAccessor<&Example::GetSomething,
+///             &Example::SetSomething>("value"),
+///             InstanceMethod<&Example::DoSomething>("doSomething"),
+///           });
+///           target.Set("Example", constructor);
+///         }
+///
+///         Example(const Napi::CallbackInfo& info); // Constructor
+///         Napi::Value GetSomething(const Napi::CallbackInfo& info);
+///         void SetSomething(const Napi::CallbackInfo& info, const Napi::Value&
+///         value); Napi::Value DoSomething(const Napi::CallbackInfo& info);
+///     }
+template <typename T>
+class ObjectWrap : public InstanceWrap<T>, public Reference<Object> {
+ public:
+  ObjectWrap(const CallbackInfo& callbackInfo);
+  virtual ~ObjectWrap();
+
+  static T* Unwrap(Object wrapper);
+
+  /// Whether instances hold a weak reference to their JavaScript object.
+  /// Classes that never need to get back from an instance to its object can
+  /// declare `static constexpr bool kWrapReference = false;` so that wrapping
+  /// them creates no reference. `Value()`, `Ref()` and `Unref()` then fail to
+  /// compile.
+  static constexpr bool kWrapReference = true;
+
+  Object Value() const;
+  uint32_t Ref() const;
+  uint32_t Unref() const;
+
+  // Methods exposed to JavaScript must conform to one of these callback
+  // signatures.
+  using StaticVoidMethodCallback = void (*)(const CallbackInfo& info);
+  using StaticMethodCallback = Napi::Value (*)(const CallbackInfo& info);
+  using StaticGetterCallback = Napi::Value (*)(const CallbackInfo& info);
+  using StaticSetterCallback = void (*)(const CallbackInfo& info,
+                                        const Napi::Value& value);
+
+  using PropertyDescriptor = ClassPropertyDescriptor<T>;
+
+  static Function DefineClass(
+      Napi::Env env,
+      const char* utf8name,
+      const std::initializer_list<PropertyDescriptor>& properties,
+      void* data = nullptr);
+  static Function DefineClass(Napi::Env env,
+                              const char* utf8name,
+                              const std::vector<PropertyDescriptor>& properties,
+                              void* data = nullptr);
+  static PropertyDescriptor StaticMethod(
+      const char* utf8name,
+      StaticVoidMethodCallback method,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor StaticMethod(
+      const char* utf8name,
+      StaticMethodCallback method,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor StaticMethod(
+      Symbol name,
+      StaticVoidMethodCallback method,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor StaticMethod(
+      Symbol name,
+      StaticMethodCallback method,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <StaticVoidMethodCallback method>
+  static PropertyDescriptor StaticMethod(
+      const char* utf8name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <StaticVoidMethodCallback method>
+  static PropertyDescriptor StaticMethod(
+      Symbol name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <StaticMethodCallback method>
+  static PropertyDescriptor StaticMethod(
+      const char* utf8name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <StaticMethodCallback method>
+  static PropertyDescriptor StaticMethod(
+      Symbol name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor StaticAccessor(
+      const char* utf8name,
+      StaticGetterCallback getter,
+      StaticSetterCallback setter,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor StaticAccessor(
+      Symbol name,
+      StaticGetterCallback getter,
+      StaticSetterCallback setter,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <StaticGetterCallback getter, StaticSetterCallback setter = nullptr>
+  static PropertyDescriptor StaticAccessor(
+      const char* utf8name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  template <StaticGetterCallback getter, StaticSetterCallback setter = nullptr>
+  static PropertyDescriptor StaticAccessor(
+      Symbol name,
+      napi_property_attributes attributes = napi_default,
+      void* data = nullptr);
+  static PropertyDescriptor StaticValue(
+      const char* utf8name,
+      Napi::Value value,
+      napi_property_attributes attributes = napi_default);
+  static PropertyDescriptor StaticValue(
+      Symbol name,
+      Napi::Value value,
+      napi_property_attributes attributes = napi_default);
+  static Napi::Value OnCalledAsFunction(const Napi::CallbackInfo& callbackInfo);
+  virtual void Finalize(Napi::Env env);
+
+#if NAPI_VERSION > 2
+  /// Returns the constructor most recently created by `DefineClass()` in
+  /// `env`. Each environment, such as each worker thread, has its own entry.
+  static Function Constructor(napi_env env);
+#endif  // NAPI_VERSION > 2
+
+ private:
+  using This = ObjectWrap<T>;
+
+  static napi_value ConstructorCallbackWrapper(napi_env env,
+                                               napi_callback_info info);
+  static napi_value StaticVoidMethodCallbackWrapper(napi_env env,
+                                                    napi_callback_info info);
+  static napi_value StaticMethodCallbackWrapper(napi_env env,
+                                                napi_callback_info info);
+  static napi_value StaticGetterCallbackWrapper(napi_env env,
+                                                napi_callback_info info);
+  static napi_value StaticSetterCallbackWrapper(napi_env env,
+                                                napi_callback_info info);
+  static void FinalizeCallback(napi_env env, void* data, void* hint);
+  static Function DefineClass(Napi::Env env,
+                              const char* utf8name,
+                              const size_t props_count,
+                              const napi_property_descriptor* props,
+                              void* data = nullptr);
+#if NAPI_VERSION > 2
+  static std::unordered_map<napi_env, napi_ref>& Constructors();
+  static napi_status RememberConstructor(napi_env env, napi_value constructor);
+  static void ForgetConstructor(void* env);
+#endif  // NAPI_VERSION > 2
+
+  using StaticVoidMethodCallbackData =
+      MethodCallbackData<T, StaticVoidMethodCallback>;
+  using StaticMethodCallbackData = MethodCallbackData<T, StaticMethodCallback>;
+
+  using StaticAccessorCallbackData =
+      AccessorCallbackData<T, StaticGetterCallback, StaticSetterCallback>;
+
+  template <StaticSetterCallback method>
+  static napi_value WrappedMethod(napi_env env,
+                                  napi_callback_info info) NAPI_NOEXCEPT;
+
+  template <StaticSetterCallback setter>
+  struct StaticSetterTag {};
+
+  template <StaticSetterCallback setter>
+  static napi_callback WrapStaticSetter(StaticSetterTag<setter>) NAPI_NOEXCEPT {
+    return &This::WrappedMethod<setter>;
+  }
+  static napi_callback WrapStaticSetter(StaticSetterTag<nullptr>)
+      NAPI_NOEXCEPT {
+    return nullptr;
+  }
+
+  bool _construction_failed = true;
+};
+
+#if NAPI_VERSION > 5
+template <typename T>
+class Addon : public InstanceWrap<T> {
+ public:
+  static inline Object Init(Env env, Object exports);
+  static T* Unwrap(Object wrapper);
+
+ protected:
+  using AddonProp = ClassPropertyDescriptor<T>;
+  using LazyValueCallback = Napi::Value (T::*)(Napi::Env env);
+
+  void DefineAddon(Object exports,
+                   const std::initializer_list<AddonProp>& props);
+  Napi::Object DefineProperties(Object object,
+                                const std::initializer_list<AddonProp>& props);
+
+  /// A property whose value is created by `method` on first access, as with
+  /// `Napi::LazyExports`. The name must have static storage duration.
+  template <LazyValueCallback method>
+  static AddonProp LazyValue(const char* utf8name);
+
+ private:
+  template <LazyValueCallback method>
+  static napi_value LazyValueGetter(napi_env env, napi_callback_info info);
+  static napi_value LazyValueSetter(napi_env env, napi_callback_info info);
+
+  Object entry_point_;
+};
+#endif  // NAPI_VERSION > 5
+
+#ifdef NAPI_CPP_CUSTOM_NAMESPACE
+}  // namespace NAPI_CPP_CUSTOM_NAMESPACE
+#endif
+
+}  // namespace Napi
+
+#include "napi-objectwrap-inl.h"
+
+#endif  // SRC_NAPI_OBJECTWRAP_H_
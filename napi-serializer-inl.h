@@ -0,0 +1,841 @@
+#ifndef SRC_NAPI_SERIALIZER_INL_H_
+#define SRC_NAPI_SERIALIZER_INL_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// Node-API C++ Wrapper Classes: serialization
+//
+// Inline header-only implementations; see "napi-serializer.h".
+////////////////////////////////////////////////////////////////////////////////
+
+// Note: Do not include this file directly! Include "napi-serializer.h" instead.
+
+namespace Napi {
+
+#ifdef NAPI_CPP_CUSTOM_NAMESPACE
+namespace NAPI_CPP_CUSTOM_NAMESPACE {
+#endif
+
+#if NAPI_VERSION > 5
+////////////////////////////////////////////////////////////////////////////////
+// Serializer class
+////////////////////////////////////////////////////////////////////////////////
+
+namespace details {
+
+// Every serialized buffer starts with kSerializationMagic followed by
+// kSerializationVersion. Values are then written as a tag byte followed by
+// the tag's payload. Lengths, counts and indices are unsigned LEB128 varints.
+static const uint8_t kSerializationMagic = 'N';
+static const uint8_t kSerializationVersion = 1;
+static const uint32_t kMaxSerializationDepth = 4096;
+
+enum SerializationTag : uint8_t {
+  kSerializedUndefined = '_',
+  kSerializedNull = '0',
+  kSerializedTrue = 'T',
+  kSerializedFalse = 'F',
+  // Zig-zag encoded varint.
+  kSerializedInt32 = 'I',
+  // Eight bytes, host byte order.
+  kSerializedDouble = 'N',
+  // Length, then one byte per UTF-16 code unit.
+  kSerializedLatin1String = '"',
+  // Length in code units, then two bytes per code unit.
+  kSerializedTwoByteString = 'c',
+  // Index of a property name written earlier in the same value.
+  kSerializedKeyReference = 'k',
+  // Sign byte, word count, then eight bytes per word.
+  kSerializedBigInt = 'Z',
+  // Time value as a double.
+  kSerializedDate = 'D',
+  // Element count, then the elements.
+  kSerializedArray = 'A',
+  // Property count, then name/value pairs.
+  kSerializedObject = 'o',
+  // Byte length, then the bytes.
+  kSerializedBuffer = 'B',
+  kSerializedArrayBuffer = 'a',
+  kSerializedDataView = 'W',
+  // napi_typedarray_type byte, element count, then the bytes.
+  kSerializedTypedArray = 'V',
+  // Index of an object written earlier in the same value.
+  kSerializedBackReference = '^'
+};
+
+inline bool IsSerializableInt32(double value) {
+  return value >= -2147483648.0 && value <= 2147483647.0 &&
+         static_cast<double>(static_cast<int32_t>(value)) == value &&
+         !(value == 0 && std::signbit(value));
+}
+
+inline napi_status ThrowSerializationError(napi_env env,
+                                           napi_status (*thrower)(napi_env,
+                                                                  const char*,
+                                                                  const char*),
+                                           const char* message) {
+  napi_status status = thrower(env, nullptr, message);
+  return status == napi_ok ? napi_pending_exception : status;
+}
+
+}  // namespace details
+
+inline Serializer::Serializer(napi_env env)
+    : _env(env),
+      _seen(nullptr),
+      _seenGet(nullptr),
+      _seenSet(nullptr),
+      _bufferPrototype(nullptr),
+      _nextId(0) {}
+
+inline MaybeOrValue<bool> Serializer::WriteValue(napi_value value) {
+  napi_status status = Write(value);
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, true, bool);
+}
+
+inline const std::vector<uint8_t>& Serializer::Data() const {
+  return _data;
+}
+
+inline std::vector<uint8_t> Serializer::Release() {
+  std::vector<uint8_t> result;
+  result.swap(_data);
+  return result;
+}
+
+inline Napi::Env Serializer::Env() const {
+  return Napi::Env(_env);
+}
+
+inline MaybeOrValue<Buffer<uint8_t>> Serializer::Serialize(napi_env env,
+                                                           napi_value value) {
+  Serializer serializer(env);
+  napi_status status = serializer.Write(value);
+  NAPI_RETURN_OR_THROW_IF_FAILED(
+      env,
+      status,
+      Buffer<uint8_t>::Copy(
+          env, serializer._data.data(), serializer._data.size()),
+      Buffer<uint8_t>);
+}
+
+inline napi_status Serializer::Write(napi_value value) {
+  size_t mark = _data.size();
+  if (mark == 0) {
+    WriteTag(details::kSerializationMagic);
+    WriteTag(details::kSerializationVersion);
+  }
+
+  // Object identities and interned keys are scoped to a single value.
+  _keys.clear();
+  _seen = nullptr;
+  _nextId = 0;
+
+  napi_status status = WriteValueImpl(value, 0);
+  if (status != napi_ok) {
+    _data.resize(mark);
+  }
+  _seen = nullptr;
+  return status;
+}
+
+inline napi_status Serializer::WriteValueImpl(napi_value value,
+                                              uint32_t depth) {
+  napi_valuetype type;
+  napi_status status = napi_typeof(_env, value, &type);
+  if (status != napi_ok) return status;
+
+  switch (type) {
+    case napi_undefined:
+      WriteTag(details::kSerializedUndefined);
+      return napi_ok;
+    case napi_null:
+      WriteTag(details::kSerializedNull);
+      return napi_ok;
+    case napi_boolean: {
+      bool result;
+      status = napi_get_value_bool(_env, value, &result);
+      if (status != napi_ok) return status;
+      WriteTag(result ? details::kSerializedTrue : details::kSerializedFalse);
+      return napi_ok;
+    }
+    case napi_number: {
+      double result;
+      status = napi_get_value_double(_env, value, &result);
+      if (status != napi_ok) return status;
+      if (details::IsSerializableInt32(result)) {
+        int32_t integer = static_cast<int32_t>(result);
+        WriteTag(details::kSerializedInt32);
+        WriteVarint((static_cast<uint32_t>(integer) << 1) ^
+                    static_cast<uint32_t>(integer >> 31));
+      } else {
+        WriteTag(details::kSerializedDouble);
+        WriteDouble(result);
+      }
+      return napi_ok;
+    }
+    case napi_string:
+      return WriteString(value, false);
+    case napi_bigint:
+      return WriteBigInt(value);
+    case napi_object:
+      return WriteObject(value, depth);
+    case napi_function:
+      return details::ThrowSerializationError(
+          _env, napi_throw_type_error, "Functions cannot be serialized");
+    case napi_symbol:
+      return details::ThrowSerializationError(
+          _env, napi_throw_type_error, "Symbols cannot be serialized");
+    default:
+      return details::ThrowSerializationError(
+          _env, napi_throw_type_error, "Externals cannot be serialized");
+  }
+}
+
+inline napi_status Serializer::WriteObject(napi_value value, uint32_t depth) {
+  if (depth >= details::kMaxSerializationDepth) {
+    return details::ThrowSerializationError(
+        _env, napi_throw_range_error, "Maximum serialization depth exceeded");
+  }
+
+  bool found;
+  napi_status status = LookupObject(value, &found);
+  if (status != napi_ok || found) return status;
+
+  bool is;
+  status = napi_is_date(_env, value, &is);
+  if (status != napi_ok) return status;
+  if (is) {
+    double time;
+    status = napi_get_date_value(_env, value, &time);
+    if (status != napi_ok) return status;
+    WriteTag(details::kSerializedDate);
+    WriteDouble(time);
+    return napi_ok;
+  }
+
+  status = napi_is_typedarray(_env, value, &is);
+  if (status != napi_ok) return status;
+  if (is) return WriteTypedArray(value);
+
+  status = napi_is_dataview(_env, value, &is);
+  if (status != napi_ok) return status;
+  if (is) return WriteDataView(value);
+
+  status = napi_is_arraybuffer(_env, value, &is);
+  if (status != napi_ok) return status;
+  if (is) return WriteArrayBuffer(value);
+
+  // The handles created for elements and properties are only needed while
+  // they are written. Objects stay alive through the identity map.
+  HandleScope scope(_env);
+
+  status = napi_is_array(_env, value, &is);
+  if (status != napi_ok) return status;
+  if (is) {
+    uint32_t length;
+    status = napi_get_array_length(_env, value, &length);
+    if (status != napi_ok) return status;
+    WriteTag(details::kSerializedArray);
+    WriteVarint(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      napi_value element;
+      status = napi_get_element(_env, value, i, &element);
+      if (status != napi_ok) return status;
+      status = WriteValueImpl(element, depth + 1);
+      if (status != napi_ok) return status;
+    }
+    return napi_ok;
+  }
+
+  napi_value keys;
+  status = napi_get_all_property_names(
+      _env,
+      value,
+      napi_key_own_only,
+      static_cast<napi_key_filter>(napi_key_enumerable | napi_key_skip_symbols),
+      napi_key_numbers_to_strings,
+      &keys);
+  if (status != napi_ok) return status;
+
+  uint32_t count;
+  status = napi_get_array_length(_env, keys, &count);
+  if (status != napi_ok) return status;
+  WriteTag(details::kSerializedObject);
+  WriteVarint(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    napi_value key;
+    status = napi_get_element(_env, keys, i, &key);
+    if (status != napi_ok) return status;
+    status = WriteString(key, true);
+    if (status != napi_ok) return status;
+
+    napi_value property;
+    status = napi_get_property(_env, value, key, &property);
+    if (status != napi_ok) return status;
+    status = WriteValueImpl(property, depth + 1);
+    if (status != napi_ok) return status;
+  }
+  return napi_ok;
+}
+
+inline napi_status Serializer::WriteString(napi_value value, bool isKey) {
+  size_t length;
+  napi_status status =
+      napi_get_value_string_utf16(_env, value, nullptr, 0, &length);
+  if (status != napi_ok) return status;
+  _scratch.resize(length + 1);
+  status = napi_get_value_string_utf16(
+      _env, value, &_scratch[0], _scratch.size(), nullptr);
+  if (status != napi_ok) return status;
+  _scratch.resize(length);
+
+  if (isKey) {
+    auto interned = _keys.find(_scratch);
+    if (interned != _keys.end()) {
+      WriteTag(details::kSerializedKeyReference);
+      WriteVarint(interned->second);
+      return napi_ok;
+    }
+    uint32_t index = static_cast<uint32_t>(_keys.size());
+    _keys.emplace(_scratch, index);
+  }
+
+  bool latin1 = true;
+  for (char16_t unit : _scratch) {
+    if (unit > 0xFF) {
+      latin1 = false;
+      break;
+    }
+  }
+
+  if (latin1) {
+    WriteTag(details::kSerializedLatin1String);
+    WriteVarint(length);
+    size_t offset = _data.size();
+    _data.resize(offset + length);
+    for (size_t i = 0; i < length; ++i) {
+      _data[offset + i] = static_cast<uint8_t>(_scratch[i]);
+    }
+  } else {
+    WriteTag(details::kSerializedTwoByteString);
+    WriteVarint(length);
+    WriteBytes(_scratch.data(), length * sizeof(char16_t));
+  }
+  return napi_ok;
+}
+
+inline napi_status Serializer::WriteBigInt(napi_value value) {
+  size_t count;
+  napi_status status =
+      napi_get_value_bigint_words(_env, value, nullptr, &count, nullptr);
+  if (status != napi_ok) return status;
+
+  int sign = 0;
+  if (count > 0) {
+    _words.resize(count);
+    status = napi_get_value_bigint_words(
+        _env, value, &sign, &count, _words.data());
+    if (status != napi_ok) return status;
+  }
+
+  WriteTag(details::kSerializedBigInt);
+  WriteTag(static_cast<uint8_t>(sign != 0));
+  WriteVarint(count);
+  WriteBytes(_words.data(), count * sizeof(uint64_t));
+  return napi_ok;
+}
+
+inline napi_status Serializer::WriteTypedArray(napi_value value) {
+  napi_typedarray_type type;
+  size_t length;
+  void* data;
+  napi_status status = napi_get_typedarray_info(
+      _env, value, &type, &length, &data, nullptr, nullptr);
+  if (status != napi_ok) return status;
+
+  uint8_t size = details::TypedArrayElementSize(type);
+  if (size == 0) {
+    return details::ThrowSerializationError(
+        _env, napi_throw_type_error, "Unsupported typed array type");
+  }
+
+  // napi_is_buffer() accepts any view, so Buffers are told apart from other
+  // Uint8Arrays by their prototype.
+  if (type == napi_uint8_array) {
+    napi_value prototype;
+    status = napi_get_prototype(_env, value, &prototype);
+    if (status != napi_ok) return status;
+    bool isBuffer;
+    status = napi_strict_equals(_env, prototype, _bufferPrototype, &isBuffer);
+    if (status != napi_ok) return status;
+    if (isBuffer) {
+      WriteTag(details::kSerializedBuffer);
+      WriteVarint(length);
+      WriteBytes(data, length);
+      return napi_ok;
+    }
+  }
+
+  WriteTag(details::kSerializedTypedArray);
+  WriteTag(static_cast<uint8_t>(type));
+  WriteVarint(length);
+  WriteBytes(data, length * size);
+  return napi_ok;
+}
+
+inline napi_status Serializer::WriteDataView(napi_value value) {
+  size_t length;
+  void* data;
+  napi_status status = napi_get_dataview_info(
+      _env, value, &length, &data, nullptr, nullptr);
+  if (status != napi_ok) return status;
+  WriteTag(details::kSerializedDataView);
+  WriteVarint(length);
+  WriteBytes(data, length);
+  return napi_ok;
+}
+
+inline napi_status Serializer::WriteArrayBuffer(napi_value value) {
+  void* data;
+  size_t length;
+  napi_status status = napi_get_arraybuffer_info(_env, value, &data, &length);
+  if (status != napi_ok) return status;
+  WriteTag(details::kSerializedArrayBuffer);
+  WriteVarint(length);
+  WriteBytes(data, length);
+  return napi_ok;
+}
+
+// Objects are identified through a JavaScript `Map` from object to the index
+// it was first written at, since Node-API offers no native object identity.
+// The handles set up here are created before any nested handle scope is
+// opened, so they stay valid for the whole value.
+inline napi_status Serializer::LookupObject(napi_value value, bool* found) {
+  napi_status status;
+  if (_seen == nullptr) {
+    Function constructor = Builtins::MapConstructor(_env);
+    Function get = Builtins::MapGet(_env);
+    Function set = Builtins::MapSet(_env);
+    if (constructor.IsEmpty() || get.IsEmpty() || set.IsEmpty()) {
+      return napi_pending_exception;
+    }
+    status = napi_new_instance(_env, constructor, 0, nullptr, &_seen);
+    if (status != napi_ok) return status;
+    _seenGet = get;
+    _seenSet = set;
+
+    napi_value buffer;
+    status = napi_create_buffer(_env, 0, nullptr, &buffer);
+    if (status != napi_ok) return status;
+    status = napi_get_prototype(_env, buffer, &_bufferPrototype);
+    if (status != napi_ok) return status;
+  }
+
+  napi_value id;
+  status = napi_call_function(_env, _seen, _seenGet, 1, &value, &id);
+  if (status != napi_ok) return status;
+
+  napi_valuetype type;
+  status = napi_typeof(_env, id, &type);
+  if (status != napi_ok) return status;
+  if (type == napi_number) {
+    uint32_t index;
+    status = napi_get_value_uint32(_env, id, &index);
+    if (status != napi_ok) return status;
+    WriteTag(details::kSerializedBackReference);
+    WriteVarint(index);
+    *found = true;
+    return napi_ok;
+  }
+
+  napi_value args[2] = {value, nullptr};
+  status = napi_create_uint32(_env, _nextId++, &args[1]);
+  if (status != napi_ok) return status;
+  status = napi_call_function(_env, _seen, _seenSet, 2, args, &id);
+  *found = false;
+  return status;
+}
+
+inline void Serializer::WriteTag(uint8_t tag) {
+  _data.push_back(tag);
+}
+
+inline void Serializer::WriteVarint(uint64_t value) {
+  while (value >= 0x80) {
+    _data.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  _data.push_back(static_cast<uint8_t>(value));
+}
+
+inline void Serializer::WriteBytes(const void* data, size_t length) {
+  if (length == 0) return;
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  _data.insert(_data.end(), bytes, bytes + length);
+}
+
+inline void Serializer::WriteDouble(double value) {
+  WriteBytes(&value, sizeof(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Deserializer class
+////////////////////////////////////////////////////////////////////////////////
+
+inline Deserializer::Deserializer(napi_env env,
+                                  const uint8_t* data,
+                                  size_t length)
+    : _env(env), _data(data), _length(length), _offset(0) {
+  // A buffer with an unknown header is left at offset 0, which makes the next
+  // read fail.
+  if (length >= 2 && data[0] == details::kSerializationMagic &&
+      data[1] == details::kSerializationVersion) {
+    _offset = 2;
+  }
+}
+
+inline MaybeOrValue<Value> Deserializer::ReadValue() {
+  napi_value result = nullptr;
+  napi_status status = Read(&result);
+  NAPI_RETURN_OR_THROW_IF_FAILED(
+      _env, status, Napi::Value(_env, result), Napi::Value);
+}
+
+inline bool Deserializer::AtEnd() const {
+  return _offset >= _length;
+}
+
+inline Napi::Env Deserializer::Env() const {
+  return Napi::Env(_env);
+}
+
+inline MaybeOrValue<Value> Deserializer::Deserialize(napi_env env,
+                                                     const uint8_t* data,
+                                                     size_t length) {
+  Deserializer deserializer(env, data, length);
+  return deserializer.ReadValue();
+}
+
+inline napi_status Deserializer::Read(napi_value* result) {
+  napi_status status;
+  if (_offset == 0 || AtEnd()) {
+    status = Invalid();
+  } else {
+    _objects.clear();
+    _keys.clear();
+    _properties.clear();
+    status = ReadValueImpl(0, result);
+  }
+
+  // Stop at the first error so that loops on AtEnd() terminate.
+  if (status != napi_ok) {
+    _offset = _length;
+  }
+  return status;
+}
+
+inline napi_status Deserializer::ReadValueImpl(uint32_t depth,
+                                               napi_value* result) {
+  const uint8_t* tag;
+  if (!ReadBytes(1, &tag)) return Invalid();
+
+  switch (*tag) {
+    case details::kSerializedUndefined:
+      return napi_get_undefined(_env, result);
+    case details::kSerializedNull:
+      return napi_get_null(_env, result);
+    case details::kSerializedTrue:
+      return napi_get_boolean(_env, true, result);
+    case details::kSerializedFalse:
+      return napi_get_boolean(_env, false, result);
+    case details::kSerializedInt32: {
+      uint64_t value;
+      if (!ReadVarint(&value) || value > UINT32_MAX) return Invalid();
+      uint32_t zigzag = static_cast<uint32_t>(value);
+      return napi_create_int32(
+          _env,
+          static_cast<int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1)),
+          result);
+    }
+    case details::kSerializedDouble: {
+      double value;
+      if (!ReadDouble(&value)) return Invalid();
+      return napi_create_double(_env, value, result);
+    }
+    case details::kSerializedLatin1String:
+    case details::kSerializedTwoByteString:
+      return ReadString(*tag, result);
+    case details::kSerializedBigInt:
+      return ReadBigInt(result);
+    case details::kSerializedDate: {
+      double value;
+      if (!ReadDouble(&value)) return Invalid();
+      return Register(napi_create_date(_env, value, result), result);
+    }
+    case details::kSerializedArray:
+      return ReadArray(depth, result);
+    case details::kSerializedObject:
+      return ReadObject(depth, result);
+    case details::kSerializedBuffer:
+    case details::kSerializedArrayBuffer:
+    case details::kSerializedDataView:
+    case details::kSerializedTypedArray:
+      return ReadBinary(*tag, result);
+    case details::kSerializedBackReference: {
+      uint64_t index;
+      if (!ReadVarint(&index) || index >= _objects.size()) return Invalid();
+      *result = _objects[static_cast<size_t>(index)];
+      return napi_ok;
+    }
+    default:
+      return Invalid();
+  }
+}
+
+inline napi_status Deserializer::ReadObject(uint32_t depth,
+                                            napi_value* result) {
+  if (depth >= details::kMaxSerializationDepth) {
+    return details::ThrowSerializationError(
+        _env, napi_throw_range_error, "Maximum serialization depth exceeded");
+  }
+
+  // Every property takes at least two bytes.
+  uint64_t count;
+  if (!ReadVarint(&count) || count > (_length - _offset) / 2) {
+    return Invalid();
+  }
+
+  napi_status status = Register(napi_create_object(_env, result), result);
+  if (status != napi_ok) return status;
+
+  // Properties are collected on a stack shared with nested objects and defined
+  // in one call once all of them have been read.
+  size_t start = _properties.size();
+  for (uint64_t i = 0; i < count; ++i) {
+    napi_value key;
+    status = ReadKey(&key);
+    if (status != napi_ok) return status;
+    napi_value value;
+    status = ReadValueImpl(depth + 1, &value);
+    if (status != napi_ok) return status;
+    _properties.push_back({nullptr,
+                           key,
+                           nullptr,
+                           nullptr,
+                           nullptr,
+                           value,
+                           static_cast<napi_property_attributes>(
+                               napi_writable | napi_enumerable |
+                               napi_configurable),
+                           nullptr});
+  }
+
+  if (count > 0) {
+    status = napi_define_properties(_env,
+                                    *result,
+                                    static_cast<size_t>(count),
+                                    _properties.data() + start);
+  }
+  _properties.resize(start);
+  return status;
+}
+
+inline napi_status Deserializer::ReadArray(uint32_t depth,
+                                           napi_value* result) {
+  if (depth >= details::kMaxSerializationDepth) {
+    return details::ThrowSerializationError(
+        _env, napi_throw_range_error, "Maximum serialization depth exceeded");
+  }
+
+  // Every element takes at least one byte.
+  uint64_t length;
+  if (!ReadVarint(&length) || length > _length - _offset ||
+      length > UINT32_MAX) {
+    return Invalid();
+  }
+
+  napi_status status = Register(
+      napi_create_array_with_length(_env, static_cast<size_t>(length), result),
+      result);
+  if (status != napi_ok) return status;
+
+  for (uint32_t i = 0; i < length; ++i) {
+    napi_value element;
+    status = ReadValueImpl(depth + 1, &element);
+    if (status != napi_ok) return status;
+    status = napi_set_element(_env, *result, i, element);
+    if (status != napi_ok) return status;
+  }
+  return napi_ok;
+}
+
+inline napi_status Deserializer::ReadString(uint8_t tag, napi_value* result) {
+  uint64_t length;
+  if (!ReadVarint(&length)) return Invalid();
+
+  const uint8_t* bytes;
+  if (tag == details::kSerializedLatin1String) {
+    if (!ReadBytes(static_cast<size_t>(length), &bytes)) return Invalid();
+    return napi_create_string_latin1(_env,
+                                     reinterpret_cast<const char*>(bytes),
+                                     static_cast<size_t>(length),
+                                     result);
+  }
+
+  if (length > (_length - _offset) / sizeof(char16_t) ||
+      !ReadBytes(static_cast<size_t>(length) * sizeof(char16_t), &bytes)) {
+    return Invalid();
+  }
+  // The code units are copied out because the input may not be aligned.
+  _scratch.resize(static_cast<size_t>(length));
+  if (length > 0) {
+    std::memcpy(_scratch.data(), bytes, _scratch.size() * sizeof(char16_t));
+  }
+  return napi_create_string_utf16(
+      _env, _scratch.data(), _scratch.size(), result);
+}
+
+inline napi_status Deserializer::ReadKey(napi_value* result) {
+  const uint8_t* tag;
+  if (!ReadBytes(1, &tag)) return Invalid();
+
+  if (*tag == details::kSerializedKeyReference) {
+    uint64_t index;
+    if (!ReadVarint(&index) || index >= _keys.size()) return Invalid();
+    *result = _keys[static_cast<size_t>(index)];
+    return napi_ok;
+  }
+
+  if (*tag != details::kSerializedLatin1String &&
+      *tag != details::kSerializedTwoByteString) {
+    return Invalid();
+  }
+  napi_status status = ReadString(*tag, result);
+  if (status != napi_ok) return status;
+  _keys.push_back(*result);
+  return napi_ok;
+}
+
+inline napi_status Deserializer::ReadBigInt(napi_value* result) {
+  const uint8_t* sign;
+  uint64_t count;
+  const uint8_t* bytes;
+  if (!ReadBytes(1, &sign) || *sign > 1 || !ReadVarint(&count) ||
+      count > (_length - _offset) / sizeof(uint64_t) ||
+      !ReadBytes(static_cast<size_t>(count) * sizeof(uint64_t), &bytes)) {
+    return Invalid();
+  }
+
+  // napi_create_bigint_words() rejects a null pointer even for zero words.
+  _words.resize(static_cast<size_t>(count) + 1);
+  if (count > 0) {
+    std::memcpy(_words.data(), bytes, count * sizeof(uint64_t));
+  }
+  return napi_create_bigint_words(
+      _env, *sign, static_cast<size_t>(count), _words.data(), result);
+}
+
+inline napi_status Deserializer::ReadBinary(uint8_t tag, napi_value* result) {
+  napi_typedarray_type type = napi_uint8_array;
+  uint8_t size = 1;
+  if (tag == details::kSerializedTypedArray) {
+    const uint8_t* typeByte;
+    if (!ReadBytes(1, &typeByte)) return Invalid();
+    type = static_cast<napi_typedarray_type>(*typeByte);
+    size = details::TypedArrayElementSize(type);
+    if (size == 0) return Invalid();
+  }
+
+  uint64_t length;
+  const uint8_t* bytes;
+  if (!ReadVarint(&length) || length > (_length - _offset) / size ||
+      !ReadBytes(static_cast<size_t>(length) * size, &bytes)) {
+    return Invalid();
+  }
+  size_t byteLength = static_cast<size_t>(length) * size;
+
+  if (tag == details::kSerializedBuffer) {
+    return Register(
+        napi_create_buffer_copy(_env, byteLength, bytes, nullptr, result),
+        result);
+  }
+
+  void* data;
+  napi_value arrayBuffer;
+  napi_status status =
+      napi_create_arraybuffer(_env, byteLength, &data, &arrayBuffer);
+  if (status != napi_ok) return status;
+  if (byteLength > 0) {
+    std::memcpy(data, bytes, byteLength);
+  }
+
+  switch (tag) {
+    case details::kSerializedArrayBuffer:
+      *result = arrayBuffer;
+      return Register(napi_ok, result);
+    case details::kSerializedDataView:
+      return Register(
+          napi_create_dataview(_env, byteLength, arrayBuffer, 0, result),
+          result);
+    default:
+      return Register(napi_create_typedarray(_env,
+                                             type,
+                                             static_cast<size_t>(length),
+                                             arrayBuffer,
+                                             0,
+                                             result),
+                      result);
+  }
+}
+
+inline bool Deserializer::ReadVarint(uint64_t* value) {
+  uint64_t result = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (_offset >= _length) return false;
+    uint8_t byte = _data[_offset++];
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+inline bool Deserializer::ReadBytes(size_t length, const uint8_t** bytes) {
+  if (length > _length - _offset) return false;
+  *bytes = _data + _offset;
+  _offset += length;
+  return true;
+}
+
+inline bool Deserializer::ReadDouble(double* value) {
+  const uint8_t* bytes;
+  if (!ReadBytes(sizeof(double), &bytes)) return false;
+  std::memcpy(value, bytes, sizeof(double));
+  return true;
+}
+
+// Objects are registered as soon as they are created, before their contents
+// are read, so that back references from within them resolve.
+inline napi_status Deserializer::Register(napi_status status,
+                                          napi_value* value) {
+  if (status == napi_ok) {
+    _objects.push_back(*value);
+  }
+  return status;
+}
+
+inline napi_status Deserializer::Invalid() {
+  return details::ThrowSerializationError(
+      _env, napi_throw_error, "Invalid serialized data");
+}
+#endif  // NAPI_VERSION > 5
+
+#ifdef NAPI_CPP_CUSTOM_NAMESPACE
+}  // namespace NAPI_CPP_CUSTOM_NAMESPACE
+#endif
+
+}  // namespace Napi
+
+#endif  // SRC_NAPI_SERIALIZER_INL_H_
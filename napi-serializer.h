@@ -0,0 +1,139 @@
+#ifndef SRC_NAPI_SERIALIZER_H_
+#define SRC_NAPI_SERIALIZER_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// Node-API C++ Wrapper Classes: serialization
+//
+// Serializer and Deserializer.
+//
+// Included by "napi.h" unless NODE_ADDON_API_MODULAR_HEADERS is defined. In
+// that case, include this header in the translation units that use it.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "napi.h"
+
+namespace Napi {
+
+#ifdef NAPI_CPP_CUSTOM_NAMESPACE
+namespace NAPI_CPP_CUSTOM_NAMESPACE {
+#endif
+
+#if NAPI_VERSION > 5
+/// Writes JavaScript values into a compact binary format that
+/// `Napi::Deserializer` turns back into equivalent values, in the same or in
+/// another environment.
+///
+/// Supported values are primitives other than symbols, `BigInt`s, `Date`s,
+/// arrays, plain objects (own enumerable string-keyed properties), Buffers,
+/// typed arrays, `DataView`s and `ArrayBuffer`s. Objects seen more than once
+/// are written once and referenced afterwards, so shared subgraphs and cycles
+/// are preserved. Binary data is stored as raw bytes in host byte order, and
+/// repeated property names are written only once per value.
+///
+/// Functions, symbols and externals cannot be serialized; a `TypeError` is
+/// thrown (or returned as a pending exception when C++ exceptions are
+/// disabled) and the buffer is left as it was before the call.
+class Serializer {
+ public:
+  explicit Serializer(napi_env env);
+  NAPI_DISALLOW_ASSIGN_COPY(Serializer)
+
+  /// Appends one value to the buffer. Each value is self-contained.
+  MaybeOrValue<bool> WriteValue(napi_value value);
+
+  const std::vector<uint8_t>& Data() const;
+  /// Moves the serialized bytes out, leaving the serializer empty.
+  std::vector<uint8_t> Release();
+  Napi::Env Env() const;
+
+  /// Serializes a single value into a new `Napi::Buffer`.
+  static MaybeOrValue<Buffer<uint8_t>> Serialize(napi_env env,
+                                                 napi_value value);
+
+ private:
+  napi_status Write(napi_value value);
+  napi_status WriteValueImpl(napi_value value, uint32_t depth);
+  napi_status WriteObject(napi_value value, uint32_t depth);
+  napi_status WriteString(napi_value value, bool isKey);
+  napi_status WriteBigInt(napi_value value);
+  napi_status WriteTypedArray(napi_value value);
+  napi_status WriteDataView(napi_value value);
+  napi_status WriteArrayBuffer(napi_value value);
+  napi_status LookupObject(napi_value value, bool* found);
+
+  void WriteTag(uint8_t tag);
+  void WriteVarint(uint64_t value);
+  void WriteBytes(const void* data, size_t length);
+  void WriteDouble(double value);
+
+  napi_env _env;
+  std::vector<uint8_t> _data;
+  std::unordered_map<std::u16string, uint32_t> _keys;
+  napi_value _seen;
+  napi_value _seenGet;
+  napi_value _seenSet;
+  napi_value _bufferPrototype;
+  uint32_t _nextId;
+  std::u16string _scratch;
+  std::vector<uint64_t> _words;
+};
+
+/// Reads values written by `Napi::Serializer`.
+///
+/// Objects are created empty and their properties are defined with a single
+/// `napi_define_properties()` call once all of them have been read. Malformed
+/// input results in an `Error`.
+class Deserializer {
+ public:
+  /// The data must stay alive for the lifetime of the deserializer.
+  Deserializer(napi_env env, const uint8_t* data, size_t length);
+  NAPI_DISALLOW_ASSIGN_COPY(Deserializer)
+
+  /// Reads the next value from the buffer.
+  MaybeOrValue<Value> ReadValue();
+  /// Returns `true` once every value in the buffer has been read.
+  bool AtEnd() const;
+  Napi::Env Env() const;
+
+  /// Deserializes a single value.
+  static MaybeOrValue<Value> Deserialize(napi_env env,
+                                         const uint8_t* data,
+                                         size_t length);
+
+ private:
+  napi_status Read(napi_value* result);
+  napi_status ReadValueImpl(uint32_t depth, napi_value* result);
+  napi_status ReadObject(uint32_t depth, napi_value* result);
+  napi_status ReadArray(uint32_t depth, napi_value* result);
+  napi_status ReadString(uint8_t tag, napi_value* result);
+  napi_status ReadKey(napi_value* result);
+  napi_status ReadBigInt(napi_value* result);
+  napi_status ReadBinary(uint8_t tag, napi_value* result);
+
+  bool ReadVarint(uint64_t* value);
+  bool ReadBytes(size_t length, const uint8_t** bytes);
+  bool ReadDouble(double* value);
+  napi_status Register(napi_status status, napi_value* value);
+  napi_status Invalid();
+
+  napi_env _env;
+  const uint8_t* _data;
+  size_t _length;
+  size_t _offset;
+  std::vector<napi_value> _objects;
+  std::vector<napi_value> _keys;
+  std::vector<napi_property_descriptor> _properties;
+  std::vector<char16_t> _scratch;
+  std::vector<uint64_t> _words;
+};
+#endif  // NAPI_VERSION > 5
+
+#ifdef NAPI_CPP_CUSTOM_NAMESPACE
+}  // namespace NAPI_CPP_CUSTOM_NAMESPACE
+#endif
+
+}  // namespace Napi
+
+#include "napi-serializer-inl.h"
+
+#endif  // SRC_NAPI_SERIALIZER_H_
@@ -0,0 +1,11 @@
+////////////////////////////////////////////////////////////////////////////////
+// Node-API C++ Wrapper Classes
+//
+// Optional translation unit for addons built with
+// NODE_ADDON_API_EXTERN_TEMPLATES. It compiles the template specializations
+// that "napi.h" then only declares, so it must be built with the same
+// preprocessor definitions and compiler flags as the rest of the addon.
+////////////////////////////////////////////////////////////////////////////////
+
+#define NODE_ADDON_API_INSTANTIATE_TEMPLATES
+#include "napi.h"
@@ -10,14 +10,39 @@
 #endif
 #endif
 
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define NAPI_HAS_CPP17 1
+#endif
+
+#if defined(__SIZEOF_INT128__)
+#define NAPI_HAS_INT128 1
+#endif
+
 #include <node_api.h>
+#include <array>
+#include <chrono>
 #include <functional>
 #include <initializer_list>
+#include <map>
 #include <memory>
 #if NAPI_HAS_THREADS
 #include <mutex>
 #endif  // NAPI_HAS_THREADS
+#include <new>
+#ifdef NAPI_HAS_CPP17
+#include <optional>
+#endif  // NAPI_HAS_CPP17
 #include <string>
+#ifdef NAPI_HAS_CPP17
+#include <string_view>
+#endif  // NAPI_HAS_CPP17
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#ifdef NAPI_HAS_CPP17
+#include <variant>
+#endif  // NAPI_HAS_CPP17
 #include <vector>
 
 // VS2015 RTM has bugs with constexpr, so require min of VS2015 Update 3 (known
@@ -61,6 +86,15 @@ static_assert(sizeof(char16_t) == sizeof(wchar_t),
 #define NAPI_NOEXCEPT noexcept
 #endif
 
+// Keeps rarely taken paths, such as freeing shared state, out of the callers.
+#if defined(__GNUC__)
+#define NAPI_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define NAPI_NOINLINE __declspec(noinline)
+#else
+#define NAPI_NOINLINE
+#endif
+
 #ifdef NAPI_CPP_EXCEPTIONS
 
 // When C++ exceptions are enabled, Errors are thrown directly. There is no need
@@ -169,10 +203,15 @@ namespace NAPI_CPP_CUSTOM_NAMESPACE {
 // Forward declarations
 class Env;
 class Value;
+class ClassifiedValue;
 class Boolean;
 class Number;
 #if NAPI_VERSION > 5
 class BigInt;
+#ifdef NAPI_HAS_INT128
+__extension__ typedef __int128 int128_t;            ///< Signed 128-bit int
+__extension__ typedef unsigned __int128 uint128_t;  ///< Unsigned 128-bit int
+#endif  // NAPI_HAS_INT128
 #endif  // NAPI_VERSION > 5
 #if (NAPI_VERSION > 4)
 class Date;
@@ -400,6 +439,7 @@ class Value {
   /// - std::u16string
   /// - napi::Value
   /// - napi_value
+  /// - Any type with a `Napi::Convert<T>` specialization, e.g. `std::vector`
   template <typename T>
   static Value From(napi_env env, const T& value);
 
@@ -458,6 +498,18 @@ class Value {
   bool IsBuffer() const;      ///< Tests if a value is a Node buffer.
   bool IsExternal() const;  ///< Tests if a value is a pointer to external data.
 
+  /// Classifies the value with a single `napi_typeof` call, followed by
+  /// object subtype checks only when the value is an object.
+  ///
+  /// The result answers every `Is*()` query without further Node-API calls.
+  ClassifiedValue Classify() const;
+
+  /// Classifies the value and calls `visitor` with it cast to its most
+  /// specific type. See `ClassifiedValue::Visit()`.
+  template <typename Visitor>
+  auto Visit(Visitor&& visitor) const
+      -> decltype(visitor(std::declval<Value>()));
+
   /// Casts to another type of `Napi::Value`, when the actual type is known or
   /// assumed.
   ///
@@ -478,6 +530,14 @@ class Value {
   MaybeOrValue<Object> ToObject()
       const;  ///< Coerces a value to a JavaScript object.
 
+  /// Converts to a C++ value using the `Napi::Convert<T>` trait.
+  ///
+  /// Unlike `ToNumber()` and friends this does not coerce: a value of the
+  /// wrong JavaScript type results in a `TypeError`. `T` must be default
+  /// constructible.
+  template <typename T>
+  MaybeOrValue<T> To() const;
+
  protected:
   /// !cond INTERNAL
   napi_env _env;
@@ -485,6 +545,97 @@ class Value {
   /// !endcond
 };
 
+/// The type of a JavaScript value, as computed by `Value::Classify()`.
+///
+/// Polymorphic argument parsers typically test a value against several types.
+/// Each `Value::Is*()` method makes at least one Node-API call, whereas a
+/// `ClassifiedValue` is computed once and then answers all of them for free.
+///
+///     Napi::ClassifiedValue arg = info[0].Classify();
+///     if (arg.IsString()) {
+///       ...
+///     } else if (arg.IsTypedArray() || arg.IsArrayBuffer()) {
+///       ...
+///     }
+class ClassifiedValue {
+ public:
+  /// Distinguishes the kinds of JavaScript objects that have a Node-API type
+  /// check. Values that are not objects, functions and all other objects have
+  /// the subtype `None`.
+  enum class Subtype {
+    None,
+    Array,
+    ArrayBuffer,
+    TypedArray,
+    DataView,
+#if (NAPI_VERSION > 4)
+    Date,
+#endif
+    Promise
+  };
+
+  ClassifiedValue();  ///< Creates a new _empty_ ClassifiedValue instance.
+
+  Napi::Value Value() const;  ///< Gets the classified value.
+  Napi::Env Env() const;      ///< Gets the environment of the value.
+
+  napi_valuetype Type() const;  ///< Gets the `typeof` type of the value.
+  Subtype GetSubtype() const;   ///< Gets the object subtype of the value.
+
+  bool IsEmpty() const;
+  bool IsUndefined() const;
+  bool IsNull() const;
+  bool IsBoolean() const;
+  bool IsNumber() const;
+#if NAPI_VERSION > 5
+  bool IsBigInt() const;
+#endif  // NAPI_VERSION > 5
+#if (NAPI_VERSION > 4)
+  bool IsDate() const;
+#endif
+  bool IsString() const;
+  bool IsSymbol() const;
+  bool IsArray() const;
+  bool IsArrayBuffer() const;
+  bool IsTypedArray() const;
+  bool IsObject() const;
+  bool IsFunction() const;
+  bool IsPromise() const;
+  bool IsDataView() const;
+  bool IsBuffer() const;
+  bool IsExternal() const;
+
+  /// Calls `visitor` with the value cast to its most specific type and
+  /// returns the result.
+  ///
+  /// `visitor` is called with one of `Napi::Boolean`, `Napi::Number`,
+  /// `Napi::BigInt`, `Napi::String`, `Napi::Symbol`, `Napi::Function`,
+  /// `Napi::External<void>`, `Napi::Array`, `Napi::ArrayBuffer`,
+  /// `Napi::TypedArray`, `Napi::DataView`, `Napi::Date`, `Napi::Promise` or
+  /// `Napi::Object`. `undefined`, `null` and empty values are passed as
+  /// `Napi::Value`. Overload resolution picks the most derived parameter
+  /// type, so a visitor only needs overloads for the types it handles plus
+  /// one taking `Napi::Value`, which also determines the return type.
+  template <typename Visitor>
+  auto Visit(Visitor&& visitor) const
+      -> decltype(visitor(std::declval<Napi::Value>()));
+
+ private:
+  friend class Napi::Value;
+
+  ClassifiedValue(napi_env env,
+                  napi_value value,
+                  napi_valuetype type,
+                  Subtype subtype,
+                  bool isBuffer);
+
+  napi_env _env;
+  napi_value _value;
+  napi_valuetype _type;
+  Subtype _subtype;
+  bool _isBuffer;
+};
+
 /// A JavaScript boolean value.
 class Boolean : public Value {
  public:
@@ -548,6 +699,14 @@ class BigInt : public Value {
   static BigInt New(napi_env env,   ///< Node-API environment
                     uint64_t value  ///< Number value
   );
+#ifdef NAPI_HAS_INT128
+  static BigInt New(napi_env env,   ///< Node-API environment
+                    int128_t value  ///< Number value
+  );
+  static BigInt New(napi_env env,    ///< Node-API environment
+                    uint128_t value  ///< Number value
+  );
+#endif  // NAPI_HAS_INT128
 
   /// Creates a new BigInt object using a specified sign bit and a
   /// specified list of digits/words.
@@ -569,6 +728,12 @@ class BigInt : public Value {
       const;  ///< Converts a BigInt value to a 64-bit signed integer value.
   uint64_t Uint64Value(bool* lossless)
       const;  ///< Converts a BigInt value to a 64-bit unsigned integer value.
+#ifdef NAPI_HAS_INT128
+  int128_t Int128Value(bool* lossless)
+      const;  ///< Converts a BigInt value to a 128-bit signed integer value.
+  uint128_t Uint128Value(bool* lossless)
+      const;  ///< Converts a BigInt value to a 128-bit unsigned integer value.
+#endif  // NAPI_HAS_INT128
 
   size_t WordCount() const;  ///< The number of 64-bit words needed to store
                              ///< the result of ToWords().
@@ -580,6 +745,11 @@ class BigInt : public Value {
   /// Upon return, it will be set to the actual number of words that would
   /// be needed to store this BigInt (i.e. the return value of `WordCount()`).
   void ToWords(int* sign_bit, size_t* word_count, uint64_t* words);
+
+  /// Writes the contents of this BigInt to `words`, resizing it to the number
+  /// of words needed. A single Node-API call is made when `words` already has
+  /// enough capacity, so reusing the vector avoids querying `WordCount()`.
+  void ToWords(int* sign_bit, std::vector<uint64_t>* words) const;
 };
 #endif  // NAPI_VERSION > 5
 
@@ -587,11 +757,41 @@ class BigInt : public Value {
 /// A JavaScript date value.
 class Date : public Value {
  public:
+  template <typename Duration>
+  using TimePoint =
+      std::chrono::time_point<std::chrono::system_clock, Duration>;
+
   /// Creates a new Date value from a double primitive.
   static Date New(napi_env env,  ///< Node-API environment
                   double value   ///< Number value
   );
 
+  /// Creates a new Date value from a time point. JavaScript dates have
+  /// millisecond precision, so the time point is rounded down to the
+  /// millisecond that contains it.
+  template <typename Duration>
+  static Date New(napi_env env, const TimePoint<Duration>& value);
+
+  /// Creates an array of Dates from a column of time points. The array is
+  /// allocated once and the Dates are created in nested handle scopes.
+  template <typename Duration>
+  static Array NewArray(napi_env env,
+                        const TimePoint<Duration>* values,
+                        size_t count);
+  template <typename Duration>
+  static Array NewArray(napi_env env,
+                        const std::vector<TimePoint<Duration>>& values);
+
+  /// Creates a Float64Array of milliseconds since the epoch from a column of
+  /// time points, without creating any Date objects.
+  template <typename Duration>
+  static Float64Array NewEpochArray(napi_env env,
+                                    const TimePoint<Duration>* values,
+                                    size_t count);
+  template <typename Duration>
+  static Float64Array NewEpochArray(
+      napi_env env, const std::vector<TimePoint<Duration>>& values);
+
   static void CheckCast(napi_env env, napi_value value);
 
   Date();  ///< Creates a new _empty_ Date instance.
@@ -599,6 +799,11 @@ class Date : public Value {
   operator double() const;  ///< Converts a Date value to double primitive
 
   double ValueOf() const;  ///< Converts a Date value to a double primitive.
+
+  /// Converts a Date value to a time point. Throws a `RangeError` for an
+  /// invalid date.
+  template <typename Duration = std::chrono::system_clock::duration>
+  TimePoint<Duration> TimePointValue() const;
 };
 #endif
 
@@ -742,6 +947,26 @@ class TypeTaggable : public Value {
   TypeTaggable(napi_env env, napi_value value);
 };
 
+namespace details {
+
+// The form in which Object::PropertyLValue keeps its key. Names are converted
+// to a JavaScript string once, when the PropertyLValue is created, so that
+// every read and write through it reuses the same key.
+template <typename Key>
+struct PropertyLValueKey {
+  using Type = Key;
+  static const Key& From(napi_env env, const Key& key);
+};
+
+template <>
+struct PropertyLValueKey<std::string> {
+  using Type = napi_value;
+  static napi_value From(napi_env env, const char* utf8name);
+  static napi_value From(napi_env env, const std::string& utf8name);
+};
+
+}  // namespace details
+
 /// A JavaScript object value.
 class Object : public TypeTaggable {
  public:
@@ -770,12 +995,22 @@ class Object : public TypeTaggable {
     template <typename ValueType>
     PropertyLValue& operator=(ValueType value);
 
+    /// Adds `delta` to the value of the property, reading and writing it once
+    /// each. A value that is not a number is converted to one first, as by
+    /// the JavaScript `++` operator, so strings are never concatenated.
+    PropertyLValue& operator+=(double delta);
+
+    /// Adds `delta` to the value of the property like `operator+=`, and
+    /// returns the new value.
+    MaybeOrValue<double> Increment(double delta = 1);
+
    private:
     PropertyLValue() = delete;
-    PropertyLValue(Object object, Key key);
+    template <typename KeyArg>
+    PropertyLValue(Object object, const KeyArg& key);
     napi_env _env;
     napi_value _object;
-    Key _key;
+    typename details::PropertyLValueKey<Key>::Type _key;
 
     friend class Napi::Object;
   };
@@ -946,6 +1181,42 @@ class Object : public TypeTaggable {
   /// https://tc39.es/ecma262/#sec-proxy-object-internal-methods-and-internal-slots-getownproperty-p
   MaybeOrValue<Array> GetPropertyNames() const;  ///< Get all property names
 
+  /// Selects the keys visited by `GetEntries()` and `ForEachEntry()`.
+  enum class EntryKeys {
+    /// Enumerable string keys of the object and its prototype chain, like
+    /// `GetPropertyNames()` and `for...in`.
+    Enumerable,
+#if NAPI_VERSION > 5
+    /// Own enumerable string keys only, like `Object.keys()`.
+    OwnEnumerable,
+#endif  // NAPI_VERSION > 5
+  };
+
+  /// A property key together with the value read for it.
+  struct Entry {
+    Value key;
+    Value value;
+  };
+
+  /// Reads the keys selected by `keys` and the value of every key, and
+  /// returns them as a vector. All handles are created in the current scope.
+  ///
+  /// This operation can fail in case of Proxy.[[OwnPropertyKeys]] and
+  /// Proxy.[[Get]] calling into JavaScript, or of getters that throw.
+  MaybeOrValue<std::vector<Entry>> GetEntries(
+      EntryKeys keys = EntryKeys::Enumerable) const;
+
+  /// Calls `callback(entry)` or `callback(entry, loop)` for every entry, with
+  /// `chunkSize` consecutive entries sharing one handle scope of a
+  /// `ScopedLoop`. A callback that returns `false` stops the iteration.
+  ///
+  /// Returns `true` if every entry was visited and `false` if the callback
+  /// stopped the iteration.
+  template <typename Callback>
+  MaybeOrValue<bool> ForEachEntry(Callback callback,
+                                  EntryKeys keys = EntryKeys::Enumerable,
+                                  size_t chunkSize = 1024) const;
+
   /// Defines a property on the object.
   ///
   /// This operation can fail in case of Proxy.[[DefineOwnProperty]] calling
@@ -1024,9 +1295,16 @@ class Object : public TypeTaggable {
 #endif  // NAPI_VERSION >= 8
 };
 
+namespace details {
+template <typename T>
+class ExternalSlab;
+}  // namespace details
+
 template <typename T>
 class External : public TypeTaggable {
  public:
+  class Pool;
+
   static External New(napi_env env, T* data);
 
   // Finalizer must implement `void operator()(Env env, T* data)`.
@@ -1039,12 +1317,57 @@ class External : public TypeTaggable {
                       Finalizer finalizeCallback,
                       Hint* finalizeHint);
 
+  // The finalizer is known at compile time, so no state has to be allocated
+  // for it.
+  template <void (*Finalizer)(Napi::Env env, T* data)>
+  static External New(napi_env env, T* data);
+  template <typename Hint,
+            void (*Finalizer)(Napi::Env env, T* data, Hint* hint)>
+  static External New(napi_env env, T* data, Hint* finalizeHint);
+
   static void CheckCast(napi_env env, napi_value value);
 
   External();
   External(napi_env env, napi_value value);
 
   T* Data() const;
+
+#if NAPI_VERSION >= 8
+  /// The type tag that identifies externals whose data is a `T`. Externals
+  /// are tagged with it on creation when NODE_ADDON_API_EXTERNAL_TYPE_TAGS is
+  /// defined.
+  static const napi_type_tag* DataTypeTag();
+
+  /// Returns the data if the value is an external tagged with `DataTypeTag()`,
+  /// or `nullptr` otherwise.
+  T* TryData() const;
+#endif  // NAPI_VERSION >= 8
+
+ private:
+  static External Created(napi_env env, napi_value value);
+};
+
+/// Allocates the data of externals from shared slabs instead of one heap
+/// allocation each. The data is destroyed and its slot reused when the
+/// external is garbage-collected. A pool may only be used on the thread of the
+/// environments in which its externals are created.
+template <typename T>
+class External<T>::Pool {
+ public:
+  explicit Pool(size_t slabSize = 256);
+  ~Pool();
+
+  NAPI_DISALLOW_ASSIGN_COPY(Pool)
+
+  /// Constructs a `T` from `args` in the pool and returns an external for it.
+  template <typename... Args>
+  External New(napi_env env, Args&&... args);
+
+  /// The number of externals created by this pool whose data is still alive.
+  size_t Size() const;
+
+ private:
+  details::ExternalSlab<T>* _slab;
 };
 
 class Array : public Object {
@@ -1058,7 +1381,132 @@ class Array : public Object {
   Array(napi_env env, napi_value value);
 
   uint32_t Length() const;
+
+  /// Reads `count` elements starting at `start` into `out`, which must have
+  /// room for `count` values. The values belong to the current handle scope.
+  /// Node-API has no bulk element read, so this is a tight loop of
+  /// `napi_get_element` calls that stops at the first failure.
+  MaybeOrValue<bool> GetRange(uint32_t start,
+                              uint32_t count,
+                              napi_value* out) const;
+
+  /// Writes `count` values to the elements starting at `start`, stopping at
+  /// the first failure.
+  MaybeOrValue<bool> SetRange(uint32_t start,
+                              uint32_t count,
+                              const napi_value* values) const;
+
+#if NAPI_VERSION > 2
+  /// Appends the values, converted with `Value::From`, with a single call to
+  /// the `Array.prototype.push` intrinsic cached in `Napi::Builtins`. Returns
+  /// the new length of the array.
+  template <typename... Args>
+  MaybeOrValue<uint32_t> Push(const Args&... values) const;
+
+  /// Appends a range of values, converted with `Value::From`, by calling
+  /// `Array.prototype.push` once per chunk of values. Returns the new length
+  /// of the array.
+  template <typename Iterator>
+  MaybeOrValue<uint32_t> Append(Iterator first, Iterator last) const;
+  template <typename Range>
+  MaybeOrValue<uint32_t> Append(const Range& range) const;
+#endif  // NAPI_VERSION > 2
+};
+
+#if NAPI_VERSION > 2
+/// A JavaScript `Map`.
+///
+/// The methods call the `Map.prototype` intrinsics cached in `Napi::Builtins`
+/// directly, so they do not look up the method on the instance on each call.
+class Map : public Object {
+ public:
+  static Map New(napi_env env);
+
+  /// Creates a `Map` from a range of key/value pairs with a single call to
+  /// the `Map` constructor. Keys and values are converted with `Value::From`.
+  template <typename Iterator>
+  static Map FromRange(napi_env env, Iterator first, Iterator last);
+  template <typename Range>
+  static Map FromRange(napi_env env, const Range& range);
+
+  static void CheckCast(napi_env env, napi_value value);
+
+  Map();
+  Map(napi_env env, napi_value value);
+
+  MaybeOrValue<Value> Get(napi_value key) const;
+  template <typename Key>
+  MaybeOrValue<Value> Get(const Key& key) const;
+
+  MaybeOrValue<bool> Set(napi_value key, napi_value value) const;
+  template <typename Key, typename ValueType>
+  MaybeOrValue<bool> Set(const Key& key, const ValueType& value) const;
+
+  MaybeOrValue<bool> Has(napi_value key) const;
+  template <typename Key>
+  MaybeOrValue<bool> Has(const Key& key) const;
+
+  MaybeOrValue<bool> Delete(napi_value key) const;
+  template <typename Key>
+  MaybeOrValue<bool> Delete(const Key& key) const;
+
+  uint32_t Size() const;
+
+  /// Calls `callback(key, value)` for each entry in insertion order until it
+  /// returns `false`. The entries are snapshotted into an array first, so the
+  /// iteration itself does not call into JavaScript, but every key and value
+  /// is still read with its own `napi_get_element()`. Returns whether every
+  /// entry was visited.
+  template <typename Callback>
+  MaybeOrValue<bool> ForEach(Callback callback) const;
+
+  /// Converts every entry with `Napi::Convert<K>` and `Napi::Convert<V>`.
+  template <typename K, typename V>
+  MaybeOrValue<std::unordered_map<K, V>> ToUnorderedMap() const;
+};
+
+/// A JavaScript `Set`.
+class Set : public Object {
+ public:
+  static Set New(napi_env env);
+
+  /// Creates a `Set` from a range of values with a single call to the `Set`
+  /// constructor. Values are converted with `Value::From`.
+  template <typename Iterator>
+  static Set FromRange(napi_env env, Iterator first, Iterator last);
+  template <typename Range>
+  static Set FromRange(napi_env env, const Range& range);
+
+  static void CheckCast(napi_env env, napi_value value);
+
+  Set();
+  Set(napi_env env, napi_value value);
+
+  MaybeOrValue<bool> Add(napi_value value) const;
+  template <typename ValueType>
+  MaybeOrValue<bool> Add(const ValueType& value) const;
+
+  MaybeOrValue<bool> Has(napi_value value) const;
+  template <typename ValueType>
+  MaybeOrValue<bool> Has(const ValueType& value) const;
+
+  MaybeOrValue<bool> Delete(napi_value value) const;
+  template <typename ValueType>
+  MaybeOrValue<bool> Delete(const ValueType& value) const;
+
+  uint32_t Size() const;
+
+  /// Calls `callback(value)` for each value in insertion order until it
+  /// returns `false`. The values are snapshotted into an array first and read
+  /// from it one at a time. Returns whether every value was visited.
+  template <typename Callback>
+  MaybeOrValue<bool> ForEach(Callback callback) const;
+
+  /// Converts every value with `Napi::Convert<T>`.
+  template <typename T>
+  MaybeOrValue<std::vector<T>> ToVector() const;
 };
+#endif  // NAPI_VERSION > 2
 
 #ifdef NAPI_CPP_EXCEPTIONS
 class Object::const_iterator {
@@ -1163,6 +1611,22 @@ class ArrayBuffer : public Object {
       Hint* finalizeHint  ///< Hint (second parameter) to be passed to the
                           ///< finalize callback
   );
+
+  /// Creates a new ArrayBuffer instance, using an external buffer with
+  /// specified byte length. The finalizer is known at compile time, so no
+  /// state has to be allocated for it.
+  template <void (*Finalizer)(Napi::Env env, void* externalData)>
+  static ArrayBuffer New(napi_env env, void* externalData, size_t byteLength);
+
+  /// Creates a new ArrayBuffer instance, using an external buffer with
+  /// specified byte length. The finalizer is known at compile time, so no
+  /// state has to be allocated for it.
+  template <typename Hint,
+            void (*Finalizer)(Napi::Env env, void* externalData, Hint* hint)>
+  static ArrayBuffer New(napi_env env,
+                         void* externalData,
+                         size_t byteLength,
+                         Hint* finalizeHint);
 #endif  // NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
 
   static void CheckCast(napi_env env, napi_value value);
@@ -1381,6 +1845,37 @@ class DataView : public Object {
   size_t _length;
 };
 
+namespace details {
+template <typename... Args>
+struct are_call_args : std::true_type {};
+
+template <typename Arg, typename... Args>
+struct are_call_args<Arg, Args...>
+    : std::integral_constant<
+          bool,
+          !std::is_convertible<const Arg&, const napi_value*>::value &&
+              !std::is_convertible<const Arg&, napi_async_context>::value &&
+              are_call_args<Args...>::value> {};
+
+template <typename... Args>
+struct is_argument_list : std::false_type {};
+
+template <typename Arg>
+struct is_argument_list<Arg>
+    : std::integral_constant<
+          bool,
+          std::is_same<Arg, std::initializer_list<napi_value>>::value ||
+              std::is_same<Arg, std::vector<napi_value>>::value ||
+              std::is_same<Arg, std::vector<Value>>::value> {};
+
+// Enables the variadic call overloads only for arguments that are not
+// already handled by the argument-list overloads.
+template <typename... Args>
+using enable_if_call_args =
+    typename std::enable_if<are_call_args<Args...>::value &&
+                            !is_argument_list<Args...>::value>::type;
+}  // namespace details
+
 class Function : public Object {
  public:
   using VoidCallback = void (*)(const CallbackInfo& info);
@@ -1443,6 +1938,12 @@ class Function : public Object {
                            size_t argc,
                            const napi_value* args) const;
 
+  /// Calls the function with each argument converted by `Value::From()` into
+  /// an array on the stack, without an intermediate argument vector.
+  template <typename... Args,
+            typename = details::enable_if_call_args<Args...>>
+  MaybeOrValue<Value> Call(napi_value recv, const Args&... args) const;
+
   MaybeOrValue<Value> MakeCallback(
       napi_value recv,
       const std::initializer_list<napi_value>& args,
@@ -1455,6 +1956,14 @@ class Function : public Object {
                                    const napi_value* args,
                                    napi_async_context context = nullptr) const;
 
+  /// Variadic form of `MakeCallback()`; arguments are converted as in the
+  /// variadic `Call()`.
+  template <typename... Args,
+            typename = details::enable_if_call_args<Args...>>
+  MaybeOrValue<Value> MakeCallback(napi_value recv,
+                                   napi_async_context context,
+                                   const Args&... args) const;
+
   MaybeOrValue<Object> New(const std::initializer_list<napi_value>& args) const;
   MaybeOrValue<Object> New(const std::vector<napi_value>& args) const;
   MaybeOrValue<Object> New(size_t argc, const napi_value* args) const;
@@ -1504,6 +2013,17 @@ class Buffer : public Uint8Array {
                        size_t length,
                        Finalizer finalizeCallback,
                        Hint* finalizeHint);
+
+  // The finalizer is known at compile time, so no state has to be allocated
+  // for it.
+  template <void (*Finalizer)(Napi::Env env, T* data)>
+  static Buffer<T> New(napi_env env, T* data, size_t length);
+  template <typename Hint,
+            void (*Finalizer)(Napi::Env env, T* data, Hint* hint)>
+  static Buffer<T> New(napi_env env,
+                       T* data,
+                       size_t length,
+                       Hint* finalizeHint);
 #endif  // NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
 
   static Buffer<T> NewOrCopy(napi_env env, T* data, size_t length);
@@ -1520,6 +2040,14 @@ class Buffer : public Uint8Array {
                              size_t length,
                              Finalizer finalizeCallback,
                              Hint* finalizeHint);
+  template <void (*Finalizer)(Napi::Env env, T* data)>
+  static Buffer<T> NewOrCopy(napi_env env, T* data, size_t length);
+  template <typename Hint,
+            void (*Finalizer)(Napi::Env env, T* data, Hint* hint)>
+  static Buffer<T> NewOrCopy(napi_env env,
+                             T* data,
+                             size_t length,
+                             Hint* finalizeHint);
 
   static Buffer<T> Copy(napi_env env, const T* data, size_t length);
 
@@ -1538,6 +2066,209 @@ class Buffer : public Uint8Array {
   void EnsureInfo() const;
 };
 
+/// Traits for converting between C++ types and JavaScript values.
+///
+/// `Convert<T>` is an open trait: specializing it for a custom type makes that
+/// type usable with `Value::From()`, `Value::To<T>()` and as an element of the
+/// container specializations below. A specialization provides:
+///
+///     static Napi::Value ToJS(napi_env env, const T& value);
+///     static bool FromJS(const Napi::Value& value, T* result);
+///     static bool Accepts(const Napi::Value& value);
+///
+/// `ToJS` returns an _empty_ value and `FromJS` returns `false` on failure,
+/// after throwing (or scheduling) a JavaScript exception. `Accepts` checks,
+/// without throwing, whether a value has the shape `FromJS` expects; it is used
+/// to select the alternative of a `std::variant`.
+///
+/// Specializations are provided for `bool`, arithmetic types, enums,
+/// `std::string`, `std::u16string`, `Napi::Value` and its subclasses,
+/// `std::vector`, `std::array`, `std::map`, `std::unordered_map`, `std::pair`,
+/// `std::tuple`, `std::chrono::duration`, `std::chrono::system_clock` time
+/// points and, when compiled as C++17, `std::optional` and `std::variant`.
+template <typename T, typename Enable = void>
+struct Convert;
+
+namespace details {
+template <typename T>
+struct is_int128 : std::false_type {};
+#if NAPI_VERSION > 5 && defined(NAPI_HAS_INT128)
+template <>
+struct is_int128<int128_t> : std::true_type {};
+template <>
+struct is_int128<uint128_t> : std::true_type {};
+#endif  // NAPI_VERSION > 5 && NAPI_HAS_INT128
+
+template <typename T>
+struct is_convert_number
+    : std::integral_constant<bool,
+                             std::is_arithmetic<T>::value &&
+                                 !std::is_same<T, bool>::value &&
+                                 !is_int128<T>::value> {};
+}  // namespace details
+
+template <>
+struct Convert<bool> {
+  static Value ToJS(napi_env env, bool value);
+  static bool FromJS(const Value& value, bool* result);
+  static bool Accepts(const Value& value);
+};
+
+/// Integral and floating point types map to JavaScript numbers.
+template <typename T>
+struct Convert<
+    T,
+    typename std::enable_if<details::is_convert_number<T>::value>::type> {
+  static Value ToJS(napi_env env, T value);
+  static bool FromJS(const Value& value, T* result);
+  static bool Accepts(const Value& value);
+};
+
+/// Enums are converted through their underlying type.
+template <typename T>
+struct Convert<T, typename std::enable_if<std::is_enum<T>::value>::type> {
+  static Value ToJS(napi_env env, T value);
+  static bool FromJS(const Value& value, T* result);
+  static bool Accepts(const Value& value);
+};
+
+#if NAPI_VERSION > 5 && defined(NAPI_HAS_INT128)
+/// 128-bit integers map to JavaScript BigInts.
+template <typename T>
+struct Convert<T, typename std::enable_if<details::is_int128<T>::value>::type> {
+  static Value ToJS(napi_env env, T value);
+  static bool FromJS(const Value& value, T* result);
+  static bool Accepts(const Value& value);
+};
+#endif  // NAPI_VERSION > 5 && NAPI_HAS_INT128
+
+template <>
+struct Convert<std::string> {
+  static Value ToJS(napi_env env, const std::string& value);
+  static bool FromJS(const Value& value, std::string* result);
+  static bool Accepts(const Value& value);
+};
+
+template <>
+struct Convert<std::u16string> {
+  static Value ToJS(napi_env env, const std::u16string& value);
+  static bool FromJS(const Value& value, std::u16string* result);
+  static bool Accepts(const Value& value);
+};
+
+/// `Napi::Value` and its subclasses are passed through unchanged.
+template <typename T>
+struct Convert<
+    T,
+    typename std::enable_if<std::is_base_of<Value, T>::value>::type> {
+  static Value ToJS(napi_env env, const T& value);
+  static bool FromJS(const Value& value, T* result);
+  static bool Accepts(const Value& value);
+};
+
+/// Vectors of numbers that have a matching typed-array type (8, 16 and 32-bit
+/// integers, `float`, `double` and, with BigInt support, 64-bit integers) map
+/// to a typed-array whose contents are copied in a single `memcpy`. Other
+/// vectors map to a JavaScript array. `FromJS` accepts either form.
+template <typename T, typename Alloc>
+struct Convert<std::vector<T, Alloc>> {
+  static Value ToJS(napi_env env, const std::vector<T, Alloc>& value);
+  static bool FromJS(const Value& value, std::vector<T, Alloc>* result);
+  static bool Accepts(const Value& value);
+};
+
+/// Same mapping as `std::vector`; `FromJS` requires exactly `N` elements.
+template <typename T, size_t N>
+struct Convert<std::array<T, N>> {
+  static Value ToJS(napi_env env, const std::array<T, N>& value);
+  static bool FromJS(const Value& value, std::array<T, N>* result);
+  static bool Accepts(const Value& value);
+};
+
+/// Maps convert to plain objects. All properties are created with a single
+/// `napi_define_properties` call. Keys that are not strings are converted to
+/// property names with `ToString()`; `FromJS` reads the object's enumerable
+/// string keys and converts them back to the key type.
+template <typename K, typename V, typename Compare, typename Alloc>
+struct Convert<std::map<K, V, Compare, Alloc>> {
+  static Value ToJS(napi_env env, const std::map<K, V, Compare, Alloc>& value);
+  static bool FromJS(const Value& value,
+                     std::map<K, V, Compare, Alloc>* result);
+  static bool Accepts(const Value& value);
+};
+
+template <typename K, typename V, typename Hash, typename Eq, typename Alloc>
+struct Convert<std::unordered_map<K, V, Hash, Eq, Alloc>> {
+  static Value ToJS(napi_env env,
+                    const std::unordered_map<K, V, Hash, Eq, Alloc>& value);
+  static bool FromJS(const Value& value,
+                     std::unordered_map<K, V, Hash, Eq, Alloc>* result);
+  static bool Accepts(const Value& value);
+};
+
+/// Pairs and tuples map to JavaScript arrays of fixed length.
+template <typename First, typename Second>
+struct Convert<std::pair<First, Second>> {
+  static Value ToJS(napi_env env, const std::pair<First, Second>& value);
+  static bool FromJS(const Value& value, std::pair<First, Second>* result);
+  static bool Accepts(const Value& value);
+};
+
+template <typename... Ts>
+struct Convert<std::tuple<Ts...>> {
+  static Value ToJS(napi_env env, const std::tuple<Ts...>& value);
+  static bool FromJS(const Value& value, std::tuple<Ts...>* result);
+  static bool Accepts(const Value& value);
+};
+
+/// Durations map to a number of milliseconds, following the JavaScript
+/// convention used by `Date` and timers.
+template <typename Rep, typename Period>
+struct Convert<std::chrono::duration<Rep, Period>> {
+  static Value ToJS(napi_env env,
+                    const std::chrono::duration<Rep, Period>& value);
+  static bool FromJS(const Value& value,
+                     std::chrono::duration<Rep, Period>* result);
+  static bool Accepts(const Value& value);
+};
+
+#if (NAPI_VERSION > 4)
+/// System clock time points map to JavaScript dates. `FromJS` also accepts a
+/// number of milliseconds since the epoch.
+template <typename Duration>
+struct Convert<std::chrono::time_point<std::chrono::system_clock, Duration>> {
+  using TimePoint =
+      std::chrono::time_point<std::chrono::system_clock, Duration>;
+  static Value ToJS(napi_env env, const TimePoint& value);
+  static bool FromJS(const Value& value, TimePoint* result);
+  static bool Accepts(const Value& value);
+};
+#endif  // NAPI_VERSION > 4
+
+#ifdef NAPI_HAS_CPP17
+/// An empty optional maps to `undefined`; `FromJS` maps both `undefined` and
+/// `null` to an empty optional.
+template <typename T>
+struct Convert<std::optional<T>> {
+  static Value ToJS(napi_env env, const std::optional<T>& value);
+  static bool FromJS(const Value& value, std::optional<T>* result);
+  static bool Accepts(const Value& value);
+};
+
+/// `FromJS` picks the first alternative whose `Convert<T>::Accepts()` returns
+/// `true` for the value.
+template <typename... Ts>
+struct Convert<std::variant<Ts...>> {
+  static Value ToJS(napi_env env, const std::variant<Ts...>& value);
+  static bool FromJS(const Value& value, std::variant<Ts...>* result);
+  static bool Accepts(const Value& value);
+};
+#endif  // NAPI_HAS_CPP17
+
+namespace details {
+struct SharedReferenceBlock;
+}  // namespace details
+
 /// Holds a counted reference to a value; initially a weak reference unless
 /// otherwise specified, may be changed to/from a strong reference by adjusting
 /// the refcount.
@@ -1588,6 +2319,16 @@ class Reference {
   /// !cond INTERNAL
   napi_env _env;
   napi_ref _ref;
+
+#ifdef NODE_ADDON_API_SHARE_ERROR_REFERENCES
+  // Copies of an `Error` share `_ref` through this block. Resetting, moving or
+  // destroying a reference, also through a base class, then only affects its
+  // own share.
+  details::SharedReferenceBlock* Share() const;
+  void ReleaseShare();
+
+  mutable details::SharedReferenceBlock* _shared = nullptr;
+#endif  // NODE_ADDON_API_SHARE_ERROR_REFERENCES
   /// !endcond
 
  private:
@@ -1657,6 +2398,9 @@ class FunctionReference : public Reference<Function> {
   MaybeOrValue<Napi::Value> Call(napi_value recv,
                                  size_t argc,
                                  const napi_value* args) const;
+  template <typename... Args,
+            typename = details::enable_if_call_args<Args...>>
+  MaybeOrValue<Napi::Value> Call(napi_value recv, const Args&... args) const;
 
   MaybeOrValue<Napi::Value> MakeCallback(
       napi_value recv,
@@ -1671,9 +2415,35 @@ class FunctionReference : public Reference<Function> {
       size_t argc,
       const napi_value* args,
       napi_async_context context = nullptr) const;
+  template <typename... Args,
+            typename = details::enable_if_call_args<Args...>>
+  MaybeOrValue<Napi::Value> MakeCallback(napi_value recv,
+                                         napi_async_context context,
+                                         const Args&... args) const;
 
   MaybeOrValue<Object> New(const std::initializer_list<napi_value>& args) const;
   MaybeOrValue<Object> New(const std::vector<napi_value>& args) const;
+
+  /// Calls the function without opening a handle scope of its own.
+  ///
+  /// `Call()` and `MakeCallback()` open an `EscapableHandleScope` for each
+  /// call. Callers that invoke a callback in a loop and already manage their
+  /// own `HandleScope` can use these variants to skip that work; the result is
+  /// then created in the caller's current scope.
+  MaybeOrValue<Napi::Value> CallNoScope(napi_value recv,
+                                        size_t argc,
+                                        const napi_value* args) const;
+  MaybeOrValue<Napi::Value> CallNoScope(
+      napi_value recv, const std::initializer_list<napi_value>& args) const;
+  template <typename... Args,
+            typename = details::enable_if_call_args<Args...>>
+  MaybeOrValue<Napi::Value> CallNoScope(napi_value recv,
+                                        const Args&... args) const;
+  MaybeOrValue<Napi::Value> MakeCallbackNoScope(
+      napi_value recv,
+      size_t argc,
+      const napi_value* args,
+      napi_async_context context = nullptr) const;
 };
 
 // Shortcuts to creating a new reference with inferred type and refcount = 0.
@@ -1688,6 +2458,154 @@ Reference<T> Persistent(T value);
 ObjectReference Persistent(Object value);
 FunctionReference Persistent(Function value);
 
+/// A copyable handle to a single `napi_ref`.
+///
+/// Copying a `Napi::Reference<T>` creates a new `napi_ref`. All copies of a
+/// `SharedReference<T>` instead share one `napi_ref` through a reference count
+/// that is kept in native memory, so that copying only increments that count
+/// and the `napi_ref` is deleted when the last copy is destroyed or reset.
+///
+/// The count is not atomic: like the `napi_ref` itself, a `SharedReference<T>`
+/// and all its copies may only be used on the thread of the environment that
+/// created it.
+template <typename T>
+class SharedReference {
+ public:
+  /// Creates a strong reference to `value`.
+  static SharedReference<T> New(const T& value);
+
+  SharedReference();
+  /// Takes over the `napi_ref` held by `reference`, keeping its refcount.
+  SharedReference(Reference<T>&& reference);
+  ~SharedReference();
+
+  SharedReference(const SharedReference<T>& other);
+  SharedReference<T>& operator=(const SharedReference<T>& other);
+  SharedReference(SharedReference<T>&& other);
+  SharedReference<T>& operator=(SharedReference<T>&& other);
+
+  operator napi_ref() const;
+  bool operator==(const SharedReference<T>& other) const;
+  bool operator!=(const SharedReference<T>& other) const;
+
+  Napi::Env Env() const;
+  bool IsEmpty() const;
+
+  // As with `Reference<T>`, getting the value is usually best done within a
+  // HandleScope.
+  T Value() const;
+
+  /// Returns the number of handles sharing the `napi_ref`, or 0 if empty.
+  uint32_t UseCount() const;
+
+  /// Releases this handle's share. The `napi_ref` is deleted if no other
+  /// handle shares it.
+  void Reset();
+
+ private:
+  details::SharedReferenceBlock* _block;
+};
+
+#if NAPI_VERSION > 2
+/// A per-environment cache of JavaScript intrinsics.
+///
+/// Each intrinsic is looked up from the global object the first time it is
+/// requested in an environment and is then held by a strong reference until
+/// the environment is torn down. Code that would otherwise evaluate
+/// `global.JSON.parse` or `Map.prototype.get` on every call can use the cached
+/// functions instead. Intrinsics replaced by JavaScript code before their first
+/// use are cached as replaced.
+///
+/// Well-known symbols, such as `Symbol.iterator`, and symbols from the global
+/// registry are cached the same way, keyed by name and by description. Each
+/// distinct description stays in the cache until the environment is torn
+/// down.
+///
+/// If the lookup fails, an empty `Function` or `Symbol` is returned (or a
+/// `Napi::Error` is thrown when C++ exceptions are enabled).
+class Builtins {
+ public:
+  static Function JsonParse(napi_env env);
+  static Function JsonStringify(napi_env env);
+  static Function ArrayFrom(napi_env env);
+  static Function ArrayFlat(napi_env env);
+  static Function ArrayPush(napi_env env);
+  static Function MapConstructor(napi_env env);
+  static Function MapGet(napi_env env);
+  static Function MapSet(napi_env env);
+  static Function MapHas(napi_env env);
+  static Function MapDelete(napi_env env);
+  static Function SetConstructor(napi_env env);
+  static Function SetAdd(napi_env env);
+  static Function SetHas(napi_env env);
+  static Function SetDelete(napi_env env);
+  static Function SymbolFor(napi_env env);
+
+  /// Returns `Symbol[name]`, such as `Symbol.iterator` for `"iterator"`.
+  static Symbol WellKnownSymbol(napi_env env, const std::string& name);
+  /// Returns `Symbol.for(description)`.
+  static Symbol RegisteredSymbol(napi_env env, const std::string& description);
+
+ private:
+  enum Slot {
+    kJsonParse,
+    kJsonStringify,
+    kArrayFrom,
+    kArrayFlat,
+    kArrayPush,
+    kMapConstructor,
+    kMapGet,
+    kMapSet,
+    kMapHas,
+    kMapDelete,
+    kSetConstructor,
+    kSetAdd,
+    kSetHas,
+    kSetDelete,
+    kSymbolFor,
+    kSlotCount
+  };
+
+  explicit Builtins(napi_env env);
+  ~Builtins();
+  NAPI_DISALLOW_ASSIGN_COPY(Builtins)
+
+  static std::unordered_map<napi_env, Builtins*>& Instances();
+  static Builtins* For(napi_env env);
+  static void Cleanup(void* data);
+  static Function Get(napi_env env, Slot slot);
+  static Symbol GetSymbol(napi_env env,
+                          bool registered,
+                          const std::string& key);
+
+  napi_env _env;
+  napi_ref _refs[kSlotCount];
+  std::unordered_map<std::string, napi_ref> _wellKnownSymbols;
+  std::unordered_map<std::string, napi_ref> _registeredSymbols;
+};
+
+/// Wrappers for `JSON.parse()` and `JSON.stringify()` using the intrinsics
+/// cached in `Napi::Builtins`.
+class Json {
+ public:
+  static MaybeOrValue<Value> Parse(napi_env env, napi_value json);
+  static MaybeOrValue<Value> Parse(napi_env env, const String& json);
+  static MaybeOrValue<Value> Parse(napi_env env,
+                                   const char* utf8json,
+                                   size_t length);
+  static MaybeOrValue<Value> Parse(napi_env env, const std::string& json);
+#ifdef NAPI_HAS_CPP17
+  static MaybeOrValue<Value> Parse(napi_env env, std::string_view json);
+#endif  // NAPI_HAS_CPP17
+
+  static MaybeOrValue<Value> Stringify(napi_env env, napi_value value);
+  static MaybeOrValue<Value> Stringify(napi_env env,
+                                       napi_value value,
+                                       napi_value replacer,
+                                       napi_value space);
+};
+#endif  // NAPI_VERSION > 2
+
 /// A persistent reference to a JavaScript error object. Use of this class
 /// depends somewhat on whether C++ exceptions are enabled at compile time.
 ///
@@ -2104,333 +3022,95 @@ class PropertyDescriptor {
   napi_property_descriptor _desc;
 };
 
-/// Property descriptor for use with `ObjectWrap::DefineClass()`.
+/// Defines module exports whose values are only created when first accessed.
 ///
-/// This is different from the standalone `PropertyDescriptor` because it is
-/// specific to each `ObjectWrap<T>` subclass. This prevents using descriptors
-/// from a different class when defining a new class (preventing the callbacks
-/// from having incorrect `this` pointers).
-template <typename T>
-class ClassPropertyDescriptor {
- public:
-  ClassPropertyDescriptor(napi_property_descriptor desc) : _desc(desc) {}
-
-  operator napi_property_descriptor&() { return _desc; }
-  operator const napi_property_descriptor&() const { return _desc; }
-
- private:
-  napi_property_descriptor _desc;
-};
-
-template <typename T, typename TCallback>
-struct MethodCallbackData {
-  TCallback callback;
-  void* data;
-};
-
-template <typename T, typename TGetterCallback, typename TSetterCallback>
-struct AccessorCallbackData {
-  TGetterCallback getterCallback;
-  TSetterCallback setterCallback;
-  void* data;
-};
-
-template <typename T>
-class InstanceWrap {
+/// Each export is installed as an accessor property. The first read calls the
+/// export's callback and replaces the accessor with an ordinary data property
+/// holding the result, so later reads cost no more than for any other
+/// property. Assigning to the export before it has been read replaces the
+/// accessor with the assigned value. If the callback throws, the accessor is
+/// kept and the next read calls the callback again.
+///
+///     Napi::Object Init(Napi::Env env, Napi::Object exports) {
+///       return Napi::LazyExports::Define(env, exports, {
+///           {"Parser", [](Napi::Env env) -> Napi::Value {
+///             return Parser::DefineClass(env, "Parser", {...});
+///           }},
+///       });
+///     }
+class LazyExports {
  public:
-  using InstanceVoidMethodCallback = void (T::*)(const CallbackInfo& info);
-  using InstanceMethodCallback = Napi::Value (T::*)(const CallbackInfo& info);
-  using InstanceGetterCallback = Napi::Value (T::*)(const CallbackInfo& info);
-  using InstanceSetterCallback = void (T::*)(const CallbackInfo& info,
-                                             const Napi::Value& value);
-
-  using PropertyDescriptor = ClassPropertyDescriptor<T>;
+  using Callback = Napi::Value (*)(Napi::Env env);
 
-  static PropertyDescriptor InstanceMethod(
-      const char* utf8name,
-      InstanceVoidMethodCallback method,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor InstanceMethod(
-      const char* utf8name,
-      InstanceMethodCallback method,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor InstanceMethod(
-      Symbol name,
-      InstanceVoidMethodCallback method,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor InstanceMethod(
-      Symbol name,
-      InstanceMethodCallback method,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <InstanceVoidMethodCallback method>
-  static PropertyDescriptor InstanceMethod(
-      const char* utf8name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <InstanceMethodCallback method>
-  static PropertyDescriptor InstanceMethod(
-      const char* utf8name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <InstanceVoidMethodCallback method>
-  static PropertyDescriptor InstanceMethod(
-      Symbol name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <InstanceMethodCallback method>
-  static PropertyDescriptor InstanceMethod(
-      Symbol name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor InstanceAccessor(
-      const char* utf8name,
-      InstanceGetterCallback getter,
-      InstanceSetterCallback setter,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor InstanceAccessor(
-      Symbol name,
-      InstanceGetterCallback getter,
-      InstanceSetterCallback setter,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <InstanceGetterCallback getter,
-            InstanceSetterCallback setter = nullptr>
-  static PropertyDescriptor InstanceAccessor(
-      const char* utf8name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <InstanceGetterCallback getter,
-            InstanceSetterCallback setter = nullptr>
-  static PropertyDescriptor InstanceAccessor(
-      Symbol name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor InstanceValue(
-      const char* utf8name,
-      Napi::Value value,
-      napi_property_attributes attributes = napi_default);
-  static PropertyDescriptor InstanceValue(
-      Symbol name,
-      Napi::Value value,
-      napi_property_attributes attributes = napi_default);
+  struct Entry {
+    const char* utf8name;
+    Callback callback;
+  };
 
- protected:
-  static void AttachPropData(napi_env env,
-                             napi_value value,
-                             const napi_property_descriptor* prop);
+  /// Copies the entries. The copy is released when the environment is torn
+  /// down.
+  static Object Define(napi_env env,
+                       napi_value exports,
+                       const std::initializer_list<Entry>& entries);
+  /// Uses the entries in place. They must outlive the environment, for
+  /// example by being stored in a static array.
+  static Object Define(napi_env env,
+                       napi_value exports,
+                       const Entry* entries,
+                       size_t count);
 
  private:
-  using This = InstanceWrap<T>;
-
-  using InstanceVoidMethodCallbackData =
-      MethodCallbackData<T, InstanceVoidMethodCallback>;
-  using InstanceMethodCallbackData =
-      MethodCallbackData<T, InstanceMethodCallback>;
-  using InstanceAccessorCallbackData =
-      AccessorCallbackData<T, InstanceGetterCallback, InstanceSetterCallback>;
-
-  static napi_value InstanceVoidMethodCallbackWrapper(napi_env env,
-                                                      napi_callback_info info);
-  static napi_value InstanceMethodCallbackWrapper(napi_env env,
-                                                  napi_callback_info info);
-  static napi_value InstanceGetterCallbackWrapper(napi_env env,
-                                                  napi_callback_info info);
-  static napi_value InstanceSetterCallbackWrapper(napi_env env,
-                                                  napi_callback_info info);
-
-  template <InstanceSetterCallback method>
-  static napi_value WrappedMethod(napi_env env,
-                                  napi_callback_info info) NAPI_NOEXCEPT;
-
-  template <InstanceSetterCallback setter>
-  struct SetterTag {};
-
-  template <InstanceSetterCallback setter>
-  static napi_callback WrapSetter(SetterTag<setter>) NAPI_NOEXCEPT {
-    return &This::WrappedMethod<setter>;
-  }
-  static napi_callback WrapSetter(SetterTag<nullptr>) NAPI_NOEXCEPT {
-    return nullptr;
-  }
+  static napi_value Getter(napi_env env, napi_callback_info info);
+  static napi_value Setter(napi_env env, napi_callback_info info);
 };
 
-/// Base class to be extended by C++ classes exposed to JavaScript; each C++
-/// class instance gets "wrapped" by a JavaScript object that is managed by this
-/// class.
-///
-/// At initialization time, the `DefineClass()` method must be used to
-/// hook up the accessor and method callbacks. It takes a list of
-/// property descriptors, which can be constructed via the various
-/// static methods on the base class.
-///
-/// #### Example:
-///
-///     class Example: public Napi::ObjectWrap<Example> {
-///       public:
-///         static void Initialize(Napi::Env& env, Napi::Object& target) {
-///           Napi::Function constructor = DefineClass(env, "Example", {
-///             InstanceAccessor<&Example::GetSomething,
-///             &Example::SetSomething>("value"),
-///             InstanceMethod<&Example::DoSomething>("doSomething"),
-///           });
-///           target.Set("Example", constructor);
-///         }
+#if NAPI_VERSION > 2
+/// Thread-safe, reference-counted ownership of a native payload that can be
+/// moved from one environment to another without copying it.
 ///
-///         Example(const Napi::CallbackInfo& info); // Constructor
-///         Napi::Value GetSomething(const Napi::CallbackInfo& info);
-///         void SetSomething(const Napi::CallbackInfo& info, const Napi::Value&
-///         value); Napi::Value DoSomething(const Napi::CallbackInfo& info);
-///     }
+/// A wrapper in one environment detaches its payload, which yields a numeric
+/// token. The token can be posted to a worker thread, where it is adopted,
+/// typically by the constructor of an `ObjectWrap<T>` class looked up with
+/// `ObjectWrap<T>::Constructor(env)`. Tokens can be adopted once, in any
+/// environment of the process, and only as the same payload type, until the
+/// environment that published them is torn down. The payload itself is not
+/// synchronized; payloads shared between threads must be safe to use
+/// concurrently.
 template <typename T>
-class ObjectWrap : public InstanceWrap<T>, public Reference<Object> {
+class Transferable {
  public:
-  ObjectWrap(const CallbackInfo& callbackInfo);
-  virtual ~ObjectWrap();
+  Transferable();
+  explicit Transferable(std::shared_ptr<T> payload);
 
-  static T* Unwrap(Object wrapper);
+  template <typename... Args>
+  static Transferable New(Args&&... args);
 
-  // Methods exposed to JavaScript must conform to one of these callback
-  // signatures.
-  using StaticVoidMethodCallback = void (*)(const CallbackInfo& info);
-  using StaticMethodCallback = Napi::Value (*)(const CallbackInfo& info);
-  using StaticGetterCallback = Napi::Value (*)(const CallbackInfo& info);
-  using StaticSetterCallback = void (*)(const CallbackInfo& info,
-                                        const Napi::Value& value);
-
-  using PropertyDescriptor = ClassPropertyDescriptor<T>;
-
-  static Function DefineClass(
-      Napi::Env env,
-      const char* utf8name,
-      const std::initializer_list<PropertyDescriptor>& properties,
-      void* data = nullptr);
-  static Function DefineClass(Napi::Env env,
-                              const char* utf8name,
-                              const std::vector<PropertyDescriptor>& properties,
-                              void* data = nullptr);
-  static PropertyDescriptor StaticMethod(
-      const char* utf8name,
-      StaticVoidMethodCallback method,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor StaticMethod(
-      const char* utf8name,
-      StaticMethodCallback method,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor StaticMethod(
-      Symbol name,
-      StaticVoidMethodCallback method,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor StaticMethod(
-      Symbol name,
-      StaticMethodCallback method,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <StaticVoidMethodCallback method>
-  static PropertyDescriptor StaticMethod(
-      const char* utf8name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <StaticVoidMethodCallback method>
-  static PropertyDescriptor StaticMethod(
-      Symbol name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <StaticMethodCallback method>
-  static PropertyDescriptor StaticMethod(
-      const char* utf8name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <StaticMethodCallback method>
-  static PropertyDescriptor StaticMethod(
-      Symbol name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor StaticAccessor(
-      const char* utf8name,
-      StaticGetterCallback getter,
-      StaticSetterCallback setter,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor StaticAccessor(
-      Symbol name,
-      StaticGetterCallback getter,
-      StaticSetterCallback setter,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <StaticGetterCallback getter, StaticSetterCallback setter = nullptr>
-  static PropertyDescriptor StaticAccessor(
-      const char* utf8name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  template <StaticGetterCallback getter, StaticSetterCallback setter = nullptr>
-  static PropertyDescriptor StaticAccessor(
-      Symbol name,
-      napi_property_attributes attributes = napi_default,
-      void* data = nullptr);
-  static PropertyDescriptor StaticValue(
-      const char* utf8name,
-      Napi::Value value,
-      napi_property_attributes attributes = napi_default);
-  static PropertyDescriptor StaticValue(
-      Symbol name,
-      Napi::Value value,
-      napi_property_attributes attributes = napi_default);
-  static Napi::Value OnCalledAsFunction(const Napi::CallbackInfo& callbackInfo);
-  virtual void Finalize(Napi::Env env);
+  bool IsEmpty() const;
+  T* Get() const;
+  T& operator*() const;
+  T* operator->() const;
+  const std::shared_ptr<T>& Payload() const;
+
+  /// Moves the payload into the process-wide transfer table, leaving this
+  /// object empty, and returns the token for it.
+  MaybeOrValue<Number> Detach(napi_env env);
+  /// Adds a reference to the payload to the transfer table and returns the
+  /// token for it. This object keeps its reference.
+  MaybeOrValue<Number> Share(napi_env env) const;
+
+  /// Takes the payload published under `token`.
+  static MaybeOrValue<Transferable> Adopt(napi_env env, napi_value token);
+  /// Drops the payload published under `token` without adopting it. Returns
+  /// `false` if the token is unknown or was already adopted.
+  static bool Discard(napi_env env, napi_value token);
 
  private:
-  using This = ObjectWrap<T>;
-
-  static napi_value ConstructorCallbackWrapper(napi_env env,
-                                               napi_callback_info info);
-  static napi_value StaticVoidMethodCallbackWrapper(napi_env env,
-                                                    napi_callback_info info);
-  static napi_value StaticMethodCallbackWrapper(napi_env env,
-                                                napi_callback_info info);
-  static napi_value StaticGetterCallbackWrapper(napi_env env,
-                                                napi_callback_info info);
-  static napi_value StaticSetterCallbackWrapper(napi_env env,
-                                                napi_callback_info info);
-  static void FinalizeCallback(napi_env env, void* data, void* hint);
-  static Function DefineClass(Napi::Env env,
-                              const char* utf8name,
-                              const size_t props_count,
-                              const napi_property_descriptor* props,
-                              void* data = nullptr);
-
-  using StaticVoidMethodCallbackData =
-      MethodCallbackData<T, StaticVoidMethodCallback>;
-  using StaticMethodCallbackData = MethodCallbackData<T, StaticMethodCallback>;
-
-  using StaticAccessorCallbackData =
-      AccessorCallbackData<T, StaticGetterCallback, StaticSetterCallback>;
-
-  template <StaticSetterCallback method>
-  static napi_value WrappedMethod(napi_env env,
-                                  napi_callback_info info) NAPI_NOEXCEPT;
-
-  template <StaticSetterCallback setter>
-  struct StaticSetterTag {};
-
-  template <StaticSetterCallback setter>
-  static napi_callback WrapStaticSetter(StaticSetterTag<setter>) NAPI_NOEXCEPT {
-    return &This::WrappedMethod<setter>;
-  }
-  static napi_callback WrapStaticSetter(StaticSetterTag<nullptr>)
-      NAPI_NOEXCEPT {
-    return nullptr;
-  }
+  static MaybeOrValue<Number> Publish(napi_env env,
+                                      std::shared_ptr<T> payload);
 
-  bool _construction_failed = true;
+  std::shared_ptr<T> _payload;
 };
+#endif  // NAPI_VERSION > 2
 
 class HandleScope {
  public:
@@ -2469,683 +3149,44 @@ class EscapableHandleScope {
   napi_escapable_handle_scope _scope;
 };
 
-#if (NAPI_VERSION > 2)
-class CallbackScope {
- public:
-  CallbackScope(napi_env env, napi_callback_scope scope);
-  CallbackScope(napi_env env, napi_async_context context);
-  virtual ~CallbackScope();
-
-  // Disallow copying to prevent double close of napi_callback_scope
-  NAPI_DISALLOW_ASSIGN_COPY(CallbackScope)
-
-  operator napi_callback_scope() const;
-
-  Napi::Env Env() const;
-
- private:
-  napi_env _env;
-  napi_callback_scope _scope;
-};
-#endif
-
-class AsyncContext {
- public:
-  explicit AsyncContext(napi_env env, const char* resource_name);
-  explicit AsyncContext(napi_env env,
-                        const char* resource_name,
-                        const Object& resource);
-  virtual ~AsyncContext();
-
-  AsyncContext(AsyncContext&& other);
-  AsyncContext& operator=(AsyncContext&& other);
-  NAPI_DISALLOW_ASSIGN_COPY(AsyncContext)
-
-  operator napi_async_context() const;
-
-  Napi::Env Env() const;
-
- private:
-  napi_env _env;
-  napi_async_context _context;
-};
-
-#if NAPI_HAS_THREADS
-class AsyncWorker {
+/// Opens a fresh handle scope every `chunkSize` iterations of a native loop,
+/// so that at most one chunk's worth of handles is alive at a time.
+///
+/// Call `Next()` at the end of every iteration. `Escape()` moves one value per
+/// iteration to the scope that encloses the loop.
+class ScopedLoop {
  public:
-  virtual ~AsyncWorker();
+  explicit ScopedLoop(Napi::Env env, size_t chunkSize = 1024);
+  ~ScopedLoop();
 
-  NAPI_DISALLOW_ASSIGN_COPY(AsyncWorker)
+  // Disallow copying to prevent double close of napi_escapable_handle_scope
+  NAPI_DISALLOW_ASSIGN_COPY(ScopedLoop)
 
-  operator napi_async_work() const;
+  void Next();
+  Value Escape(napi_value escapee);
 
   Napi::Env Env() const;
-
-  void Queue();
-  void Cancel();
-  void SuppressDestruct();
-
-  ObjectReference& Receiver();
-  FunctionReference& Callback();
-
-  virtual void OnExecute(Napi::Env env);
-  virtual void OnWorkComplete(Napi::Env env, napi_status status);
-
- protected:
-  explicit AsyncWorker(const Function& callback);
-  explicit AsyncWorker(const Function& callback, const char* resource_name);
-  explicit AsyncWorker(const Function& callback,
-                       const char* resource_name,
-                       const Object& resource);
-  explicit AsyncWorker(const Object& receiver, const Function& callback);
-  explicit AsyncWorker(const Object& receiver,
-                       const Function& callback,
-                       const char* resource_name);
-  explicit AsyncWorker(const Object& receiver,
-                       const Function& callback,
-                       const char* resource_name,
-                       const Object& resource);
-
-  explicit AsyncWorker(Napi::Env env);
-  explicit AsyncWorker(Napi::Env env, const char* resource_name);
-  explicit AsyncWorker(Napi::Env env,
-                       const char* resource_name,
-                       const Object& resource);
-
-  virtual void Execute() = 0;
-  virtual void OnOK();
-  virtual void OnError(const Error& e);
-  virtual void Destroy();
-  virtual std::vector<napi_value> GetResult(Napi::Env env);
-
-  void SetError(const std::string& error);
+  size_t ChunkSize() const;
 
  private:
-  static inline void OnAsyncWorkExecute(napi_env env, void* asyncworker);
-  static inline void OnAsyncWorkComplete(napi_env env,
-                                         napi_status status,
-                                         void* asyncworker);
+  void Open();
+  void Close();
 
   napi_env _env;
-  napi_async_work _work;
-  ObjectReference _receiver;
-  FunctionReference _callback;
-  std::string _error;
-  bool _suppress_destruct;
-};
-#endif  // NAPI_HAS_THREADS
-
-#if (NAPI_VERSION > 3 && NAPI_HAS_THREADS)
-class ThreadSafeFunction {
- public:
-  // This API may only be called from the main thread.
-  template <typename ResourceString>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount);
-
-  // This API may only be called from the main thread.
-  template <typename ResourceString, typename ContextType>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount,
-                                ContextType* context);
-
-  // This API may only be called from the main thread.
-  template <typename ResourceString, typename Finalizer>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount,
-                                Finalizer finalizeCallback);
-
-  // This API may only be called from the main thread.
-  template <typename ResourceString,
-            typename Finalizer,
-            typename FinalizerDataType>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount,
-                                Finalizer finalizeCallback,
-                                FinalizerDataType* data);
-
-  // This API may only be called from the main thread.
-  template <typename ResourceString, typename ContextType, typename Finalizer>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount,
-                                ContextType* context,
-                                Finalizer finalizeCallback);
-
-  // This API may only be called from the main thread.
-  template <typename ResourceString,
-            typename ContextType,
-            typename Finalizer,
-            typename FinalizerDataType>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount,
-                                ContextType* context,
-                                Finalizer finalizeCallback,
-                                FinalizerDataType* data);
-
-  // This API may only be called from the main thread.
-  template <typename ResourceString>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                const Object& resource,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount);
-
-  // This API may only be called from the main thread.
-  template <typename ResourceString, typename ContextType>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                const Object& resource,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount,
-                                ContextType* context);
-
-  // This API may only be called from the main thread.
-  template <typename ResourceString, typename Finalizer>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                const Object& resource,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount,
-                                Finalizer finalizeCallback);
-
-  // This API may only be called from the main thread.
-  template <typename ResourceString,
-            typename Finalizer,
-            typename FinalizerDataType>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                const Object& resource,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount,
-                                Finalizer finalizeCallback,
-                                FinalizerDataType* data);
-
-  // This API may only be called from the main thread.
-  template <typename ResourceString, typename ContextType, typename Finalizer>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                const Object& resource,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount,
-                                ContextType* context,
-                                Finalizer finalizeCallback);
-
-  // This API may only be called from the main thread.
-  template <typename ResourceString,
-            typename ContextType,
-            typename Finalizer,
-            typename FinalizerDataType>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                const Object& resource,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount,
-                                ContextType* context,
-                                Finalizer finalizeCallback,
-                                FinalizerDataType* data);
-
-  ThreadSafeFunction();
-  ThreadSafeFunction(napi_threadsafe_function tsFunctionValue);
-
-  operator napi_threadsafe_function() const;
-
-  // This API may be called from any thread.
-  napi_status BlockingCall() const;
-
-  // This API may be called from any thread.
-  template <typename Callback>
-  napi_status BlockingCall(Callback callback) const;
-
-  // This API may be called from any thread.
-  template <typename DataType, typename Callback>
-  napi_status BlockingCall(DataType* data, Callback callback) const;
-
-  // This API may be called from any thread.
-  napi_status NonBlockingCall() const;
-
-  // This API may be called from any thread.
-  template <typename Callback>
-  napi_status NonBlockingCall(Callback callback) const;
-
-  // This API may be called from any thread.
-  template <typename DataType, typename Callback>
-  napi_status NonBlockingCall(DataType* data, Callback callback) const;
-
-  // This API may only be called from the main thread.
-  void Ref(napi_env env) const;
-
-  // This API may only be called from the main thread.
-  void Unref(napi_env env) const;
-
-  // This API may be called from any thread.
-  napi_status Acquire() const;
-
-  // This API may be called from any thread.
-  napi_status Release() const;
-
-  // This API may be called from any thread.
-  napi_status Abort() const;
-
-  struct ConvertibleContext {
-    template <class T>
-    operator T*() {
-      return static_cast<T*>(context);
-    }
-    void* context;
-  };
-
-  // This API may be called from any thread.
-  ConvertibleContext GetContext() const;
-
- private:
-  using CallbackWrapper = std::function<void(Napi::Env, Napi::Function)>;
-
-  template <typename ResourceString,
-            typename ContextType,
-            typename Finalizer,
-            typename FinalizerDataType>
-  static ThreadSafeFunction New(napi_env env,
-                                const Function& callback,
-                                const Object& resource,
-                                ResourceString resourceName,
-                                size_t maxQueueSize,
-                                size_t initialThreadCount,
-                                ContextType* context,
-                                Finalizer finalizeCallback,
-                                FinalizerDataType* data,
-                                napi_finalize wrapper);
-
-  napi_status CallInternal(CallbackWrapper* callbackWrapper,
-                           napi_threadsafe_function_call_mode mode) const;
-
-  static void CallJS(napi_env env,
-                     napi_value jsCallback,
-                     void* context,
-                     void* data);
-
-  napi_threadsafe_function _tsfn;
-};
-
-// A TypedThreadSafeFunction by default has no context (nullptr) and can
-// accept any type (void) to its CallJs.
-template <typename ContextType = std::nullptr_t,
-          typename DataType = void,
-          void (*CallJs)(Napi::Env, Napi::Function, ContextType*, DataType*) =
-              nullptr>
-class TypedThreadSafeFunction {
- public:
-  // This API may only be called from the main thread.
-  // Helper function that returns nullptr if running Node-API 5+, otherwise a
-  // non-empty, no-op Function. This provides the ability to specify at
-  // compile-time a callback parameter to `New` that safely does no action
-  // when targeting _any_ Node-API version.
-#if NAPI_VERSION > 4
-  static std::nullptr_t EmptyFunctionFactory(Napi::Env env);
-#else
-  static Napi::Function EmptyFunctionFactory(Napi::Env env);
-#endif
-  static Napi::Function FunctionOrEmpty(Napi::Env env,
-                                        Napi::Function& callback);
-
-#if NAPI_VERSION > 4
-  // This API may only be called from the main thread.
-  // Creates a new threadsafe function with:
-  //   Callback [missing] Resource [missing] Finalizer [missing]
-  template <typename ResourceString>
-  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
-      napi_env env,
-      ResourceString resourceName,
-      size_t maxQueueSize,
-      size_t initialThreadCount,
-      ContextType* context = nullptr);
-
-  // This API may only be called from the main thread.
-  // Creates a new threadsafe function with:
-  //   Callback [missing] Resource [passed] Finalizer [missing]
-  template <typename ResourceString>
-  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
-      napi_env env,
-      const Object& resource,
-      ResourceString resourceName,
-      size_t maxQueueSize,
-      size_t initialThreadCount,
-      ContextType* context = nullptr);
-
-  // This API may only be called from the main thread.
-  // Creates a new threadsafe function with:
-  //   Callback [missing] Resource [missing] Finalizer [passed]
-  template <typename ResourceString,
-            typename Finalizer,
-            typename FinalizerDataType = void>
-  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
-      napi_env env,
-      ResourceString resourceName,
-      size_t maxQueueSize,
-      size_t initialThreadCount,
-      ContextType* context,
-      Finalizer finalizeCallback,
-      FinalizerDataType* data = nullptr);
-
-  // This API may only be called from the main thread.
-  // Creates a new threadsafe function with:
-  //   Callback [missing] Resource [passed] Finalizer [passed]
-  template <typename ResourceString,
-            typename Finalizer,
-            typename FinalizerDataType = void>
-  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
-      napi_env env,
-      const Object& resource,
-      ResourceString resourceName,
-      size_t maxQueueSize,
-      size_t initialThreadCount,
-      ContextType* context,
-      Finalizer finalizeCallback,
-      FinalizerDataType* data = nullptr);
-#endif
-
-  // This API may only be called from the main thread.
-  // Creates a new threadsafe function with:
-  //   Callback [passed] Resource [missing] Finalizer [missing]
-  template <typename ResourceString>
-  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
-      napi_env env,
-      const Function& callback,
-      ResourceString resourceName,
-      size_t maxQueueSize,
-      size_t initialThreadCount,
-      ContextType* context = nullptr);
-
-  // This API may only be called from the main thread.
-  // Creates a new threadsafe function with:
-  //   Callback [passed] Resource [passed] Finalizer [missing]
-  template <typename ResourceString>
-  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
-      napi_env env,
-      const Function& callback,
-      const Object& resource,
-      ResourceString resourceName,
-      size_t maxQueueSize,
-      size_t initialThreadCount,
-      ContextType* context = nullptr);
-
-  // This API may only be called from the main thread.
-  // Creates a new threadsafe function with:
-  //   Callback [passed] Resource [missing] Finalizer [passed]
-  template <typename ResourceString,
-            typename Finalizer,
-            typename FinalizerDataType = void>
-  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
-      napi_env env,
-      const Function& callback,
-      ResourceString resourceName,
-      size_t maxQueueSize,
-      size_t initialThreadCount,
-      ContextType* context,
-      Finalizer finalizeCallback,
-      FinalizerDataType* data = nullptr);
-
-  // This API may only be called from the main thread.
-  // Creates a new threadsafe function with:
-  //   Callback [passed] Resource [passed] Finalizer [passed]
-  template <typename CallbackType,
-            typename ResourceString,
-            typename Finalizer,
-            typename FinalizerDataType>
-  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
-      napi_env env,
-      CallbackType callback,
-      const Object& resource,
-      ResourceString resourceName,
-      size_t maxQueueSize,
-      size_t initialThreadCount,
-      ContextType* context,
-      Finalizer finalizeCallback,
-      FinalizerDataType* data = nullptr);
-
-  TypedThreadSafeFunction();
-  TypedThreadSafeFunction(napi_threadsafe_function tsFunctionValue);
-
-  operator napi_threadsafe_function() const;
-
-  // This API may be called from any thread.
-  napi_status BlockingCall(DataType* data = nullptr) const;
-
-  // This API may be called from any thread.
-  napi_status NonBlockingCall(DataType* data = nullptr) const;
-
-  // This API may only be called from the main thread.
-  void Ref(napi_env env) const;
-
-  // This API may only be called from the main thread.
-  void Unref(napi_env env) const;
-
-  // This API may be called from any thread.
-  napi_status Acquire() const;
-
-  // This API may be called from any thread.
-  napi_status Release() const;
-
-  // This API may be called from any thread.
-  napi_status Abort() const;
-
-  // This API may be called from any thread.
-  ContextType* GetContext() const;
-
- private:
-  template <typename ResourceString,
-            typename Finalizer,
-            typename FinalizerDataType>
-  static TypedThreadSafeFunction<ContextType, DataType, CallJs> New(
-      napi_env env,
-      const Function& callback,
-      const Object& resource,
-      ResourceString resourceName,
-      size_t maxQueueSize,
-      size_t initialThreadCount,
-      ContextType* context,
-      Finalizer finalizeCallback,
-      FinalizerDataType* data,
-      napi_finalize wrapper);
-
-  static void CallJsInternal(napi_env env,
-                             napi_value jsCallback,
-                             void* context,
-                             void* data);
-
- protected:
-  napi_threadsafe_function _tsfn;
-};
-template <typename DataType>
-class AsyncProgressWorkerBase : public AsyncWorker {
- public:
-  virtual void OnWorkProgress(DataType* data) = 0;
-  class ThreadSafeData {
-   public:
-    ThreadSafeData(AsyncProgressWorkerBase* asyncprogressworker, DataType* data)
-        : _asyncprogressworker(asyncprogressworker), _data(data) {}
-
-    AsyncProgressWorkerBase* asyncprogressworker() {
-      return _asyncprogressworker;
-    };
-    DataType* data() { return _data; };
-
-   private:
-    AsyncProgressWorkerBase* _asyncprogressworker;
-    DataType* _data;
-  };
-  void OnWorkComplete(Napi::Env env, napi_status status) override;
-
- protected:
-  explicit AsyncProgressWorkerBase(const Object& receiver,
-                                   const Function& callback,
-                                   const char* resource_name,
-                                   const Object& resource,
-                                   size_t queue_size = 1);
-  virtual ~AsyncProgressWorkerBase();
-
-// Optional callback of Napi::ThreadSafeFunction only available after
-// NAPI_VERSION 4. Refs: https://github.com/nodejs/node/pull/27791
-#if NAPI_VERSION > 4
-  explicit AsyncProgressWorkerBase(Napi::Env env,
-                                   const char* resource_name,
-                                   const Object& resource,
-                                   size_t queue_size = 1);
-#endif
-
-  static inline void OnAsyncWorkProgress(Napi::Env env,
-                                         Napi::Function jsCallback,
-                                         void* data);
-
-  napi_status NonBlockingCall(DataType* data);
-
- private:
-  ThreadSafeFunction _tsfn;
-  bool _work_completed = false;
-  napi_status _complete_status;
-  static inline void OnThreadSafeFunctionFinalize(
-      Napi::Env env, void* data, AsyncProgressWorkerBase* context);
-};
-
-template <class T>
-class AsyncProgressWorker : public AsyncProgressWorkerBase<void> {
- public:
-  virtual ~AsyncProgressWorker();
-
-  class ExecutionProgress {
-    friend class AsyncProgressWorker;
-
-   public:
-    void Signal() const;
-    void Send(const T* data, size_t count) const;
-
-   private:
-    explicit ExecutionProgress(AsyncProgressWorker* worker) : _worker(worker) {}
-    AsyncProgressWorker* const _worker;
-  };
-
-  void OnWorkProgress(void*) override;
-
- protected:
-  explicit AsyncProgressWorker(const Function& callback);
-  explicit AsyncProgressWorker(const Function& callback,
-                               const char* resource_name);
-  explicit AsyncProgressWorker(const Function& callback,
-                               const char* resource_name,
-                               const Object& resource);
-  explicit AsyncProgressWorker(const Object& receiver,
-                               const Function& callback);
-  explicit AsyncProgressWorker(const Object& receiver,
-                               const Function& callback,
-                               const char* resource_name);
-  explicit AsyncProgressWorker(const Object& receiver,
-                               const Function& callback,
-                               const char* resource_name,
-                               const Object& resource);
-
-// Optional callback of Napi::ThreadSafeFunction only available after
-// NAPI_VERSION 4. Refs: https://github.com/nodejs/node/pull/27791
-#if NAPI_VERSION > 4
-  explicit AsyncProgressWorker(Napi::Env env);
-  explicit AsyncProgressWorker(Napi::Env env, const char* resource_name);
-  explicit AsyncProgressWorker(Napi::Env env,
-                               const char* resource_name,
-                               const Object& resource);
-#endif
-  virtual void Execute(const ExecutionProgress& progress) = 0;
-  virtual void OnProgress(const T* data, size_t count) = 0;
-
- private:
-  void Execute() override;
-  void Signal();
-  void SendProgress_(const T* data, size_t count);
-
-  std::mutex _mutex;
-  T* _asyncdata;
-  size_t _asyncsize;
-  bool _signaled;
+  size_t _chunkSize;
+  size_t _iterations;
+  bool _escaped;
+  napi_escapable_handle_scope _scope;
 };
 
-template <class T>
-class AsyncProgressQueueWorker
-    : public AsyncProgressWorkerBase<std::pair<T*, size_t>> {
- public:
-  virtual ~AsyncProgressQueueWorker(){};
-
-  class ExecutionProgress {
-    friend class AsyncProgressQueueWorker;
-
-   public:
-    void Signal() const;
-    void Send(const T* data, size_t count) const;
-
-   private:
-    explicit ExecutionProgress(AsyncProgressQueueWorker* worker)
-        : _worker(worker) {}
-    AsyncProgressQueueWorker* const _worker;
-  };
-
-  void OnWorkComplete(Napi::Env env, napi_status status) override;
-  void OnWorkProgress(std::pair<T*, size_t>*) override;
-
- protected:
-  explicit AsyncProgressQueueWorker(const Function& callback);
-  explicit AsyncProgressQueueWorker(const Function& callback,
-                                    const char* resource_name);
-  explicit AsyncProgressQueueWorker(const Function& callback,
-                                    const char* resource_name,
-                                    const Object& resource);
-  explicit AsyncProgressQueueWorker(const Object& receiver,
-                                    const Function& callback);
-  explicit AsyncProgressQueueWorker(const Object& receiver,
-                                    const Function& callback,
-                                    const char* resource_name);
-  explicit AsyncProgressQueueWorker(const Object& receiver,
-                                    const Function& callback,
-                                    const char* resource_name,
-                                    const Object& resource);
-
-// Optional callback of Napi::ThreadSafeFunction only available after
-// NAPI_VERSION 4. Refs: https://github.com/nodejs/node/pull/27791
-#if NAPI_VERSION > 4
-  explicit AsyncProgressQueueWorker(Napi::Env env);
-  explicit AsyncProgressQueueWorker(Napi::Env env, const char* resource_name);
-  explicit AsyncProgressQueueWorker(Napi::Env env,
-                                    const char* resource_name,
-                                    const Object& resource);
-#endif
-  virtual void Execute(const ExecutionProgress& progress) = 0;
-  virtual void OnProgress(const T* data, size_t count) = 0;
-
- private:
-  void Execute() override;
-  void Signal() const;
-  void SendProgress_(const T* data, size_t count);
-};
-#endif  // NAPI_VERSION > 3 && NAPI_HAS_THREADS
+/// Calls `callback(element)` or `callback(element, loop)` for every element of
+/// `range`, sharing one handle scope between `chunkSize` consecutive elements.
+/// A callback that returns `false` stops the iteration.
+template <typename Range, typename Callback>
+void ForEachScoped(Napi::Env env,
+                   Range&& range,
+                   Callback callback,
+                   size_t chunkSize = 1024);
 
 // Memory management.
 class MemoryManagement {
@@ -3160,25 +3201,6 @@ class VersionManagement {
   static const napi_node_version* GetNodeVersion(Env env);
 };
 
-#if NAPI_VERSION > 5
-template <typename T>
-class Addon : public InstanceWrap<T> {
- public:
-  static inline Object Init(Env env, Object exports);
-  static T* Unwrap(Object wrapper);
-
- protected:
-  using AddonProp = ClassPropertyDescriptor<T>;
-  void DefineAddon(Object exports,
-                   const std::initializer_list<AddonProp>& props);
-  Napi::Object DefineProperties(Object object,
-                                const std::initializer_list<AddonProp>& props);
-
- private:
-  Object entry_point_;
-};
-#endif  // NAPI_VERSION > 5
-
 #ifdef NAPI_CPP_CUSTOM_NAMESPACE
 }  // namespace NAPI_CPP_CUSTOM_NAMESPACE
 #endif
@@ -3188,4 +3210,13 @@ class Addon : public InstanceWrap<T> {
 // Inline implementations of all the above class methods are included here.
 #include "napi-inl.h"
 
+// Everything above is the core of the library. The remaining subsystems live
+// in headers of their own, so that translation units built with
+// NODE_ADDON_API_MODULAR_HEADERS only parse the parts they include.
+#ifndef NODE_ADDON_API_MODULAR_HEADERS
+#include "napi-async.h"
+#include "napi-objectwrap.h"
+#include "napi-serializer.h"
+#endif  // !NODE_ADDON_API_MODULAR_HEADERS
+
 #endif  // SRC_NAPI_H_
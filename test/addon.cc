@@ -10,6 +10,9 @@ class TestAddon : public Napi::Addon<TestAddon> {
     DefineAddon(
         exports,
         {InstanceMethod("increment", &TestAddon::Increment),
+         InstanceMethod("reset", &TestAddon::Reset),
+         InstanceAccessor("value", &TestAddon::GetValue, &TestAddon::SetValue),
+         LazyValue<&TestAddon::CreateLazy>("lazy"),
          InstanceValue(
              "subObject",
              DefineProperties(
@@ -26,6 +29,21 @@ class TestAddon : public Napi::Addon<TestAddon> {
     return Napi::Number::New(info.Env(), --value);
   }
 
+  void Reset(const Napi::CallbackInfo& /*info*/) { value = 42; }
+
+  Napi::Value GetValue(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), value);
+  }
+
+  void SetValue(const Napi::CallbackInfo& /*info*/,
+                const Napi::Value& newValue) {
+    value = newValue.As<Napi::Number>().Uint32Value();
+  }
+
+  Napi::Value CreateLazy(Napi::Env env) {
+    return Napi::Number::New(env, value * 2);
+  }
+
   uint32_t value = 42;
 };
 
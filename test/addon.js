@@ -8,4 +8,28 @@ function test (binding) {
   assert.strictEqual(binding.addon.increment(), 43);
   assert.strictEqual(binding.addon.increment(), 44);
   assert.strictEqual(binding.addon.subObject.decrement(), 43);
+
+  // The lazy value is computed from the addon instance on first access.
+  assert.strictEqual(
+    typeof Object.getOwnPropertyDescriptor(binding.addon, 'lazy').get,
+    'function');
+  assert.strictEqual(binding.addon.lazy, 86);
+  assert.strictEqual(binding.addon.increment(), 44);
+  assert.strictEqual(binding.addon.lazy, 86);
+  assert.strictEqual(
+    Object.getOwnPropertyDescriptor(binding.addon, 'lazy').value, 86);
+
+  // The methods and accessors reach the add-on instance whatever `this` is.
+  const { increment, reset } = binding.addon;
+  assert.strictEqual(increment(), 45);
+  assert.strictEqual(increment.call({}), 46);
+  assert.strictEqual(binding.addon.subObject.decrement.call(null), 45);
+  assert.strictEqual(binding.addon.value, 45);
+  binding.addon.value = 100;
+  assert.strictEqual(binding.addon.increment(), 101);
+  reset();
+  assert.strictEqual(binding.addon.value, 42);
+  const { get, set } = Object.getOwnPropertyDescriptor(binding.addon, 'value');
+  set.call(undefined, 7);
+  assert.strictEqual(get.call(undefined), 7);
 }
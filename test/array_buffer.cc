@@ -116,6 +116,66 @@ Value CreateExternalBufferWithFinalizeHint(const CallbackInfo& info) {
   return buffer;
 }
 
+void DeleteTestData(Env /*env*/, void* finalizeData) {
+  delete[] static_cast<uint8_t*>(finalizeData);
+  finalizeCount++;
+}
+
+void DeleteTestDataWithHint(Env /*env*/, void* finalizeData, int* increment) {
+  delete[] static_cast<uint8_t*>(finalizeData);
+  finalizeCount += *increment;
+}
+
+int finalizeIncrement = 2;
+
+Value CreateExternalBufferWithTemplatedFinalize(const CallbackInfo& info) {
+  finalizeCount = 0;
+
+  uint8_t* data = new uint8_t[testLength];
+
+  ArrayBuffer buffer =
+      ArrayBuffer::New<&DeleteTestData>(info.Env(), data, testLength);
+
+  if (buffer.ByteLength() != testLength) {
+    Error::New(info.Env(), "Incorrect buffer length.")
+        .ThrowAsJavaScriptException();
+    return Value();
+  }
+
+  if (buffer.Data() != data) {
+    Error::New(info.Env(), "Incorrect buffer data.")
+        .ThrowAsJavaScriptException();
+    return Value();
+  }
+
+  InitData(data, testLength);
+  return buffer;
+}
+
+Value CreateExternalBufferWithTemplatedFinalizeHint(const CallbackInfo& info) {
+  finalizeCount = 0;
+
+  uint8_t* data = new uint8_t[testLength];
+
+  ArrayBuffer buffer = ArrayBuffer::New<int, &DeleteTestDataWithHint>(
+      info.Env(), data, testLength, &finalizeIncrement);
+
+  if (buffer.ByteLength() != testLength) {
+    Error::New(info.Env(), "Incorrect buffer length.")
+        .ThrowAsJavaScriptException();
+    return Value();
+  }
+
+  if (buffer.Data() != data) {
+    Error::New(info.Env(), "Incorrect buffer data.")
+        .ThrowAsJavaScriptException();
+    return Value();
+  }
+
+  InitData(data, testLength);
+  return buffer;
+}
+
 void CheckBuffer(const CallbackInfo& info) {
   if (!info[0].IsArrayBuffer()) {
     Error::New(info.Env(), "A buffer was expected.")
@@ -231,6 +291,10 @@ Object InitArrayBuffer(Env env) {
       Function::New(env, CreateExternalBufferWithFinalize);
   exports["createExternalBufferWithFinalizeHint"] =
       Function::New(env, CreateExternalBufferWithFinalizeHint);
+  exports["createExternalBufferWithTemplatedFinalize"] =
+      Function::New(env, CreateExternalBufferWithTemplatedFinalize);
+  exports["createExternalBufferWithTemplatedFinalizeHint"] =
+      Function::New(env, CreateExternalBufferWithTemplatedFinalizeHint);
   exports["checkBuffer"] = Function::New(env, CheckBuffer);
   exports["getFinalizeCount"] = Function::New(env, GetFinalizeCount);
   exports["createBufferWithConstructor"] =
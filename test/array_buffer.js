@@ -47,6 +47,26 @@ function test (binding) {
 
     () => assert.strictEqual(1, binding.arraybuffer.getFinalizeCount()),
 
+    'External ArrayBuffer with templated finalizer',
+    () => {
+      const test = binding.arraybuffer.createExternalBufferWithTemplatedFinalize();
+      binding.arraybuffer.checkBuffer(test);
+      assert.ok(test instanceof ArrayBuffer);
+      assert.strictEqual(0, binding.arraybuffer.getFinalizeCount());
+    },
+
+    () => assert.strictEqual(1, binding.arraybuffer.getFinalizeCount()),
+
+    'External ArrayBuffer with templated finalizer and hint',
+    () => {
+      const test = binding.arraybuffer.createExternalBufferWithTemplatedFinalizeHint();
+      binding.arraybuffer.checkBuffer(test);
+      assert.ok(test instanceof ArrayBuffer);
+      assert.strictEqual(0, binding.arraybuffer.getFinalizeCount());
+    },
+
+    () => assert.strictEqual(2, binding.arraybuffer.getFinalizeCount()),
+
     'ArrayBuffer with constructor',
     () => {
       assert.strictEqual(true, binding.arraybuffer.checkEmptyBuffer());
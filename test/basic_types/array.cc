@@ -1,4 +1,6 @@
+#include <vector>
 #include "napi.h"
+#include "test_helper.h"
 
 using namespace Napi;
 
@@ -28,6 +30,70 @@ void SetElement(const CallbackInfo& info) {
   array[index] = info[2].As<Value>();
 }
 
+Value GetRange(const CallbackInfo& info) {
+  Array array = info[0].As<Array>();
+  uint32_t start = info[1].As<Number>().Uint32Value();
+  uint32_t count = info[2].As<Number>().Uint32Value();
+
+  std::vector<napi_value> values(count);
+  if (!MaybeUnwrapOr(array.GetRange(start, count, values.data()), false)) {
+    return Value();
+  }
+
+  Array result = Array::New(info.Env(), count);
+  if (!MaybeUnwrapOr(result.SetRange(0, count, values.data()), false)) {
+    return Value();
+  }
+  return result;
+}
+
+void SetRange(const CallbackInfo& info) {
+  Array array = info[0].As<Array>();
+  uint32_t start = info[1].As<Number>().Uint32Value();
+
+  std::vector<napi_value> values;
+  for (size_t index = 2; index < info.Length(); index++) {
+    values.push_back(info[index]);
+  }
+  array.SetRange(start, static_cast<uint32_t>(values.size()), values.data());
+}
+
+#if NAPI_VERSION > 2
+Value PushValues(const CallbackInfo& info) {
+  Array array = info[0].As<Array>();
+  uint32_t length;
+  if (!MaybeUnwrapTo(array.Push(1, "two", true, info[1]), &length)) {
+    return Value();
+  }
+  return Number::New(info.Env(), length);
+}
+
+Value PushNothing(const CallbackInfo& info) {
+  Array array = info[0].As<Array>();
+  uint32_t length;
+  if (!MaybeUnwrapTo(array.Push(), &length)) {
+    return Value();
+  }
+  return Number::New(info.Env(), length);
+}
+
+Value AppendNumbers(const CallbackInfo& info) {
+  Array array = info[0].As<Array>();
+  uint32_t count = info[1].As<Number>().Uint32Value();
+
+  std::vector<double> numbers;
+  for (uint32_t index = 0; index < count; index++) {
+    numbers.push_back(index);
+  }
+
+  uint32_t length;
+  if (!MaybeUnwrapTo(array.Append(numbers), &length)) {
+    return Value();
+  }
+  return Number::New(info.Env(), length);
+}
+#endif  // NAPI_VERSION > 2
+
 Object InitBasicTypesArray(Env env) {
   Object exports = Object::New(env);
 
@@ -35,6 +101,13 @@ Object InitBasicTypesArray(Env env) {
   exports["getLength"] = Function::New(env, GetLength);
   exports["get"] = Function::New(env, GetElement);
   exports["set"] = Function::New(env, SetElement);
+  exports["getRange"] = Function::New(env, GetRange);
+  exports["setRange"] = Function::New(env, SetRange);
+#if NAPI_VERSION > 2
+  exports["push"] = Function::New(env, PushValues);
+  exports["pushNothing"] = Function::New(env, PushNothing);
+  exports["appendNumbers"] = Function::New(env, AppendNumbers);
+#endif  // NAPI_VERSION > 2
 
   return exports;
 }
@@ -31,4 +31,50 @@ function test (binding) {
 
   // out of index test
   assert.strictEqual(binding.basic_types_array.get(array, 5), undefined);
+
+  // range tests
+  const source = ['a', 'b', 'c', 'd'];
+  assert.deepStrictEqual(binding.basic_types_array.getRange(source, 1, 2),
+    ['b', 'c']);
+  assert.deepStrictEqual(binding.basic_types_array.getRange(source, 3, 2),
+    ['d', undefined]);
+  assert.deepStrictEqual(binding.basic_types_array.getRange(source, 0, 0), []);
+
+  const target = [0, 1, 2];
+  binding.basic_types_array.setRange(target, 1, 'x', 'y', 'z');
+  assert.deepStrictEqual(target, [0, 'x', 'y', 'z']);
+
+  const throwing = [0, 1, 2];
+  Object.defineProperty(throwing, 1, {
+    get () { throw new Error('getter'); },
+    set () { throw new Error('setter'); }
+  });
+  assert.throws(() => binding.basic_types_array.getRange(throwing, 0, 3),
+    /getter/);
+  assert.throws(() => binding.basic_types_array.setRange(throwing, 0, 5, 6),
+    /setter/);
+  assert.strictEqual(throwing[0], 5);
+
+  if (binding.basic_types_array.push) {
+    const pushed = ['first'];
+    const object = {};
+    assert.strictEqual(binding.basic_types_array.push(pushed, object), 5);
+    assert.deepStrictEqual(pushed, ['first', 1, 'two', true, object]);
+    assert.strictEqual(pushed[4], object);
+    assert.strictEqual(binding.basic_types_array.pushNothing(pushed), 5);
+
+    assert.throws(() => binding.basic_types_array.push(Object.freeze([]), 0),
+      TypeError);
+
+    // Crosses several chunks of calls to Array.prototype.push.
+    const appended = ['first'];
+    assert.strictEqual(binding.basic_types_array.appendNumbers(appended, 2500),
+      2501);
+    assert.strictEqual(appended[0], 'first');
+    for (let index = 0; index < 2500; index++) {
+      assert.strictEqual(appended[index + 1], index);
+    }
+    assert.strictEqual(binding.basic_types_array.appendNumbers(appended, 0),
+      2501);
+  }
 }
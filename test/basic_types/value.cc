@@ -1,3 +1,4 @@
+#include <string>
 #include "napi.h"
 #include "test_helper.h"
 
@@ -128,6 +129,69 @@ static Value ToObject(const CallbackInfo& info) {
   return MaybeUnwrap(info[0].ToObject());
 }
 
+// Names the type a value is passed to the visitor as.
+struct TypeNamer {
+  std::string operator()(Value value) const {
+    return value.IsNull() ? "null" : "undefined";
+  }
+  std::string operator()(Boolean) const { return "boolean"; }
+  std::string operator()(Number) const { return "number"; }
+  std::string operator()(String) const { return "string"; }
+  std::string operator()(Symbol) const { return "symbol"; }
+  std::string operator()(Function) const { return "function"; }
+  std::string operator()(External<void>) const { return "external"; }
+  std::string operator()(Array) const { return "array"; }
+  std::string operator()(ArrayBuffer) const { return "arraybuffer"; }
+  std::string operator()(TypedArray) const { return "typedarray"; }
+  std::string operator()(DataView) const { return "dataview"; }
+#if (NAPI_VERSION > 4)
+  std::string operator()(Date) const { return "date"; }
+#endif
+  std::string operator()(Promise) const { return "promise"; }
+  std::string operator()(Object) const { return "object"; }
+};
+
+static Value VisitType(const CallbackInfo& info) {
+  return String::New(info.Env(), info[0].Visit(TypeNamer()));
+}
+
+// Checks that the cached classification agrees with every `Value::Is*()`.
+static Value ClassifyMatchesChecks(const CallbackInfo& info) {
+  Value value = info[0];
+  ClassifiedValue classified = value.Classify();
+  bool matches = classified.Value() == value &&
+                 classified.Type() == value.Type() &&
+                 classified.IsUndefined() == value.IsUndefined() &&
+                 classified.IsNull() == value.IsNull() &&
+                 classified.IsBoolean() == value.IsBoolean() &&
+                 classified.IsNumber() == value.IsNumber() &&
+#if NAPI_VERSION > 5
+                 classified.IsBigInt() == value.IsBigInt() &&
+#endif
+#if (NAPI_VERSION > 4)
+                 classified.IsDate() == value.IsDate() &&
+#endif
+                 classified.IsString() == value.IsString() &&
+                 classified.IsSymbol() == value.IsSymbol() &&
+                 classified.IsArray() == value.IsArray() &&
+                 classified.IsArrayBuffer() == value.IsArrayBuffer() &&
+                 classified.IsTypedArray() == value.IsTypedArray() &&
+                 classified.IsObject() == value.IsObject() &&
+                 classified.IsFunction() == value.IsFunction() &&
+                 classified.IsPromise() == value.IsPromise() &&
+                 classified.IsDataView() == value.IsDataView() &&
+                 classified.IsBuffer() == value.IsBuffer() &&
+                 classified.IsExternal() == value.IsExternal();
+  return Boolean::New(info.Env(), matches);
+}
+
+static Value ClassifyEmpty(const CallbackInfo& info) {
+  ClassifiedValue classified = Value().Classify();
+  return Boolean::New(info.Env(),
+                      classified.IsEmpty() && classified.IsUndefined() &&
+                          classified.Visit(TypeNamer()) == "undefined");
+}
+
 Object InitBasicTypesValue(Env env) {
   Object exports = Object::New(env);
 
@@ -150,6 +214,9 @@ Object InitBasicTypesValue(Env env) {
   exports["toNumber"] = Function::New(env, ToNumber);
   exports["toString"] = Function::New(env, ToString);
   exports["toObject"] = Function::New(env, ToObject);
+  exports["visitType"] = Function::New(env, VisitType);
+  exports["classifyMatchesChecks"] = Function::New(env, ClassifyMatchesChecks);
+  exports["classifyEmpty"] = Function::New(env, ClassifyEmpty);
 
   exports["strictlyEquals"] = Function::New(env, StrictlyEquals);
   exports["strictlyEqualsOverload"] = Function::New(env, StrictEqualsOverload);
@@ -140,6 +140,33 @@ function test (binding) {
   typeCheckerTest(value.isDataView, 'dataview');
   typeCheckerTest(value.isExternal, 'external');
 
+  const classifyValueList = [
+    undefined,
+    null,
+    true,
+    10,
+    'string',
+    Symbol('symbol'),
+    [],
+    new ArrayBuffer(10),
+    new Int32Array(new ArrayBuffer(12)),
+    Buffer.from('buffer'),
+    {},
+    function () {},
+    new Promise((resolve, reject) => {}),
+    new DataView(new ArrayBuffer(12)),
+    externalValue
+  ];
+
+  classifyValueList.forEach((testValue) => {
+    assert.strictEqual(value.visitType(testValue), detailedTypeOf(testValue));
+    assert(value.classifyMatchesChecks(testValue));
+  });
+  assert.strictEqual(value.visitType(new Date()),
+    binding.date ? 'date' : 'object');
+  assert(value.classifyMatchesChecks(new Date()));
+  assert(value.classifyEmpty());
+
   typeConverterTest(value.toBoolean, Boolean);
   assert.strictEqual(value.toBoolean(undefined), false);
   assert.strictEqual(value.toBoolean(null), false);
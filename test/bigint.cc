@@ -75,6 +75,74 @@ Value TestTooBigBigInt(const CallbackInfo& info) {
   return BigInt::New(info.Env(), sign_bit, word_count, words);
 }
 
+Value TestWordsVector(const CallbackInfo& info) {
+  BigInt big = info[0].As<BigInt>();
+  std::vector<uint64_t> words;
+  words.reserve(info[1].As<Number>().Uint32Value());
+
+  int sign_bit;
+  big.ToWords(&sign_bit, &words);
+  if (words.size() != big.WordCount()) {
+    Error::New(info.Env(), "word count did not match")
+        .ThrowAsJavaScriptException();
+    return BigInt();
+  }
+
+  return BigInt::New(info.Env(), sign_bit, words.size(), words.data());
+}
+
+#ifdef NAPI_HAS_INT128
+Value TestInt128(const CallbackInfo& info) {
+  bool lossless = false;
+  int128_t input = info[0].As<BigInt>().Int128Value(&lossless);
+
+  Array result = Array::New(info.Env(), 2);
+  result.Set(0u, BigInt::New(info.Env(), input));
+  result.Set(1u, lossless);
+  return result;
+}
+
+Value TestUint128(const CallbackInfo& info) {
+  bool lossless = false;
+  uint128_t input = info[0].As<BigInt>().Uint128Value(&lossless);
+
+  Array result = Array::New(info.Env(), 2);
+  result.Set(0u, BigInt::New(info.Env(), input));
+  result.Set(1u, lossless);
+  return result;
+}
+
+Value TestInt128Vector(const CallbackInfo& info) {
+  std::vector<int128_t> values;
+  if (!MaybeUnwrapTo(info[0].To<std::vector<int128_t>>(), &values)) {
+    return Value();
+  }
+  for (int128_t& value : values) {
+    value *= 2;
+  }
+  return Value::From(info.Env(), values);
+}
+
+Value TestUint128Vector(const CallbackInfo& info) {
+  std::vector<uint128_t> values;
+  if (!MaybeUnwrapTo(info[0].To<std::vector<uint128_t>>(), &values)) {
+    return Value();
+  }
+  return Value::From(info.Env(), values);
+}
+#endif  // NAPI_HAS_INT128
+
+Value TestInt64Vector(const CallbackInfo& info) {
+  std::vector<int64_t> values;
+  if (!MaybeUnwrapTo(info[0].To<std::vector<int64_t>>(), &values)) {
+    return Value();
+  }
+  for (int64_t& value : values) {
+    value += 1;
+  }
+  return Value::From(info.Env(), values);
+}
+
 }  // anonymous namespace
 
 Object InitBigInt(Env env) {
@@ -85,6 +153,14 @@ Object InitBigInt(Env env) {
   exports["TestUint64"] = Function::New(env, TestUint64);
   exports["TestWords"] = Function::New(env, TestWords);
   exports["TestTooBigBigInt"] = Function::New(env, TestTooBigBigInt);
+  exports["TestWordsVector"] = Function::New(env, TestWordsVector);
+  exports["TestInt64Vector"] = Function::New(env, TestInt64Vector);
+#ifdef NAPI_HAS_INT128
+  exports["TestInt128"] = Function::New(env, TestInt128);
+  exports["TestUint128"] = Function::New(env, TestUint128);
+  exports["TestInt128Vector"] = Function::New(env, TestInt128Vector);
+  exports["TestUint128Vector"] = Function::New(env, TestUint128Vector);
+#endif  // NAPI_HAS_INT128
 
   return exports;
 }
@@ -11,7 +11,13 @@ function test (binding) {
     TestWords,
     IsLossless,
     IsBigInt,
-    TestTooBigBigInt
+    TestTooBigBigInt,
+    TestWordsVector,
+    TestInt64Vector,
+    TestInt128,
+    TestUint128,
+    TestInt128Vector,
+    TestUint128Vector
   } = binding.bigint;
 
   [
@@ -44,8 +50,56 @@ function test (binding) {
     assert.strictEqual(IsBigInt(num), true);
 
     assert.strictEqual(num, TestWords(num));
+    assert.strictEqual(num, TestWordsVector(num, 0));
+    assert.strictEqual(num, TestWordsVector(num, 1));
+    assert.strictEqual(num, TestWordsVector(num, 16));
+
+    if (TestInt128) {
+      const int128 = BigInt.asIntN(128, num);
+      const uint128 = BigInt.asUintN(128, num);
+      assert.deepStrictEqual(TestInt128(num), [int128, int128 === num]);
+      assert.deepStrictEqual(TestUint128(num), [uint128, uint128 === num]);
+    }
   });
 
+  if (TestInt128) {
+    [
+      2n ** 127n - 1n,
+      -(2n ** 127n),
+      2n ** 64n,
+      -(2n ** 64n) - 1n
+    ].forEach((num) => {
+      assert.deepStrictEqual(TestInt128(num), [num, true]);
+    });
+    assert.deepStrictEqual(TestInt128(2n ** 127n), [-(2n ** 127n), false]);
+    assert.deepStrictEqual(TestUint128(2n ** 128n - 1n), [2n ** 128n - 1n, true]);
+    assert.deepStrictEqual(TestUint128(2n ** 128n), [0n, false]);
+    assert.deepStrictEqual(TestUint128(-1n), [2n ** 128n - 1n, false]);
+
+    assert.deepStrictEqual(TestInt128Vector([1n, -(2n ** 100n)]), [2n, -(2n ** 101n)]);
+    assert.throws(() => TestInt128Vector([1]), {
+      name: 'TypeError',
+      message: 'A BigInt was expected.'
+    });
+    assert.deepStrictEqual(TestUint128Vector([2n ** 128n - 1n]), [2n ** 128n - 1n]);
+    assert.throws(() => TestInt128Vector([2n ** 130n]), {
+      name: 'RangeError',
+      message: 'The BigInt is out of range.'
+    });
+    assert.throws(() => TestUint128Vector([-1n]), {
+      name: 'RangeError',
+      message: 'The BigInt is out of range.'
+    });
+  }
+
+  // BigInt64Array is copied in bulk, and plain arrays may hold BigInts.
+  assert.deepStrictEqual(
+    TestInt64Vector(new BigInt64Array([1n, -2n, 2n ** 62n])),
+    new BigInt64Array([2n, -1n, 2n ** 62n + 1n]));
+  assert.deepStrictEqual(
+    TestInt64Vector([1n, 2]),
+    new BigInt64Array([2n, 3n]));
+
   assert.throws(TestTooBigBigInt, {
     name: /^(RangeError|Error)$/,
     message: /^(Maximum BigInt size exceeded|Invalid argument)$/
@@ -24,12 +24,14 @@ Object InitBigInt(Env env);
 Object InitBuffer(Env env);
 Object InitBufferNoExternal(Env env);
 #if (NAPI_VERSION > 2)
+Object InitBuiltins(Env env);
 Object InitCallbackScope(Env env);
 #endif
 #if (NAPI_VERSION > 4)
 Object InitDate(Env env);
 #endif
 Object InitCallbackInfo(Env env);
+Object InitConvert(Env env);
 Object InitDataView(Env env);
 Object InitDataViewReadWrite(Env env);
 Object InitEnvCleanup(Env env);
@@ -39,6 +41,10 @@ Object InitExternal(Env env);
 Object InitFunction(Env env);
 Object InitFunctionReference(Env env);
 Object InitHandleScope(Env env);
+Object InitLazyExports(Env env);
+#if (NAPI_VERSION > 2)
+Object InitMapSet(Env env);
+#endif
 Object InitMovableCallbacks(Env env);
 Object InitMemoryManagement(Env env);
 Object InitName(Env env);
@@ -48,6 +54,9 @@ Object InitObjectDeprecated(Env env);
 #endif  // !NODE_ADDON_API_DISABLE_DEPRECATED
 Object InitPromise(Env env);
 Object InitRunScript(Env env);
+#if (NAPI_VERSION > 5)
+Object InitSerializer(Env env);
+#endif
 #if (NAPI_VERSION > 3)
 Object InitThreadSafeFunctionCtx(Env env);
 Object InitThreadSafeFunctionExistingTsfn(Env env);
@@ -68,10 +77,15 @@ Object InitGlobalObject(Env env);
 Object InitObjectWrap(Env env);
 Object InitObjectWrapConstructorException(Env env);
 Object InitObjectWrapFunction(Env env);
+Object InitObjectWrapNoReference(Env env);
 Object InitObjectWrapRemoveWrap(Env env);
+#if (NAPI_VERSION > 2)
+Object InitObjectWrapTransfer(Env env);
+#endif
 Object InitObjectWrapMultipleInheritance(Env env);
 Object InitObjectReference(Env env);
 Object InitReference(Env env);
+Object InitSharedReference(Env env);
 Object InitVersionManagement(Env env);
 Object InitThunkingManual(Env env);
 #if (NAPI_VERSION > 7)
@@ -110,9 +124,11 @@ Object Init(Env env, Object exports) {
   exports.Set("buffer", InitBuffer(env));
   exports.Set("bufferNoExternal", InitBufferNoExternal(env));
 #if (NAPI_VERSION > 2)
+  exports.Set("builtins", InitBuiltins(env));
   exports.Set("callbackscope", InitCallbackScope(env));
 #endif
   exports.Set("callbackInfo", InitCallbackInfo(env));
+  exports.Set("convert", InitConvert(env));
   exports.Set("dataview", InitDataView(env));
   exports.Set("dataview_read_write", InitDataView(env));
   exports.Set("dataview_read_write", InitDataViewReadWrite(env));
@@ -126,6 +142,10 @@ Object Init(Env env, Object exports) {
   exports.Set("functionreference", InitFunctionReference(env));
   exports.Set("name", InitName(env));
   exports.Set("handlescope", InitHandleScope(env));
+  exports.Set("lazy_exports", InitLazyExports(env));
+#if (NAPI_VERSION > 2)
+  exports.Set("map_set", InitMapSet(env));
+#endif
   exports.Set("movable_callbacks", InitMovableCallbacks(env));
   exports.Set("memory_management", InitMemoryManagement(env));
   exports.Set("object", InitObject(env));
@@ -134,6 +154,9 @@ Object Init(Env env, Object exports) {
 #endif  // !NODE_ADDON_API_DISABLE_DEPRECATED
   exports.Set("promise", InitPromise(env));
   exports.Set("run_script", InitRunScript(env));
+#if (NAPI_VERSION > 5)
+  exports.Set("serializer", InitSerializer(env));
+#endif
   exports.Set("symbol", InitSymbol(env));
 #if (NAPI_VERSION > 3)
   exports.Set("threadsafe_function_ctx", InitThreadSafeFunctionCtx(env));
@@ -160,11 +183,16 @@ Object Init(Env env, Object exports) {
   exports.Set("objectwrapConstructorException",
               InitObjectWrapConstructorException(env));
   exports.Set("objectwrap_function", InitObjectWrapFunction(env));
+  exports.Set("objectwrap_no_reference", InitObjectWrapNoReference(env));
   exports.Set("objectwrap_removewrap", InitObjectWrapRemoveWrap(env));
+#if (NAPI_VERSION > 2)
+  exports.Set("objectwrap_transfer", InitObjectWrapTransfer(env));
+#endif
   exports.Set("objectwrap_multiple_inheritance",
               InitObjectWrapMultipleInheritance(env));
   exports.Set("objectreference", InitObjectReference(env));
   exports.Set("reference", InitReference(env));
+  exports.Set("shared_reference", InitSharedReference(env));
   exports.Set("version_management", InitVersionManagement(env));
   exports.Set("thunking_manual", InitThunkingManual(env));
 #if (NAPI_VERSION > 7)
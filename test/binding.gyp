@@ -18,10 +18,12 @@
         'basic_types/value.cc',
         'bigint.cc',
         'callbackInfo.cc',
+        'convert.cc',
         'date.cc',
         'binding.cc',
         'buffer_no_external.cc',
         'buffer.cc',
+        'builtins.cc',
         'callbackscope.cc',
         'dataview/dataview.cc',
         'dataview/dataview_read_write.cc',
@@ -32,6 +34,8 @@
         'function.cc',
         'function_reference.cc',
         'handlescope.cc',
+        'lazy_exports.cc',
+        'map_set.cc',
         'maybe/check.cc',
         'movable_callbacks.cc',
         'memory_management.cc',
@@ -52,6 +56,7 @@
         'object/subscript_operator.cc',
         'promise.cc',
         'run_script.cc',
+        'serializer.cc',
         'symbol.cc',
         'threadsafe_function/threadsafe_function_ctx.cc',
         'threadsafe_function/threadsafe_function_existing_tsfn.cc',
@@ -70,10 +75,13 @@
         'objectwrap.cc',
         'objectwrap_constructor_exception.cc',
         'objectwrap_function.cc',
+        'objectwrap_no_reference.cc',
         'objectwrap_removewrap.cc',
+        'objectwrap_transfer.cc',
         'objectwrap_multiple_inheritance.cc',
         'object_reference.cc',
         'reference.cc',
+        'shared_reference.cc',
         'version_management.cc',
         'thunking_manual.cc',
       ],
@@ -81,6 +89,10 @@
         'binding-swallowexcept.cc',
         'error.cc',
       ],
+      'build_sources_shared_error': [
+        'binding-swallowexcept.cc',
+        'error.cc',
+      ],
       'build_sources_type_check': [
         'value_type_cast.cc'
       ],
@@ -120,6 +132,48 @@
       'sources': ['>@(build_sources_swallowexcept)'],
       'defines': ['NODE_API_SWALLOW_UNTHROWABLE_EXCEPTIONS']
     },
+    {
+      'target_name': 'binding_shared_error',
+      'includes': ['../except.gypi'],
+      'sources': ['>@(build_sources_shared_error)'],
+      'defines': ['NODE_ADDON_API_SHARE_ERROR_REFERENCES']
+    },
+    {
+      'target_name': 'binding_shared_error_noexcept',
+      'includes': ['../noexcept.gypi'],
+      'sources': ['>@(build_sources_shared_error)'],
+      'defines': ['NODE_ADDON_API_SHARE_ERROR_REFERENCES']
+    },
+    {
+      'target_name': 'binding_external_type_tags',
+      'includes': ['../except.gypi'],
+      'sources': ['external_type_tags.cc'],
+      'defines': ['NODE_ADDON_API_EXTERNAL_TYPE_TAGS']
+    },
+    {
+      'target_name': 'binding_external_type_tags_noexcept',
+      'includes': ['../noexcept.gypi'],
+      'sources': ['external_type_tags.cc'],
+      'defines': ['NODE_ADDON_API_EXTERNAL_TYPE_TAGS']
+    },
+    {
+      'target_name': 'binding_modular',
+      'includes': ['../except.gypi'],
+      'sources': ['modular_headers.cc', 'modular_instantiations.cc'],
+      'defines': [
+        'NODE_ADDON_API_MODULAR_HEADERS',
+        'NODE_ADDON_API_EXTERN_TEMPLATES'
+      ]
+    },
+    {
+      'target_name': 'binding_modular_noexcept',
+      'includes': ['../noexcept.gypi'],
+      'sources': ['modular_headers.cc', 'modular_instantiations.cc'],
+      'defines': [
+        'NODE_ADDON_API_MODULAR_HEADERS',
+        'NODE_ADDON_API_EXTERN_TEMPLATES'
+      ]
+    },
     {
       'target_name': 'binding_type_check',
       'includes': ['../noexcept.gypi'],
@@ -134,6 +134,55 @@ Value CreateBufferCopy(const CallbackInfo& info) {
 
 #include "buffer_new_or_copy-inl.h"
 
+Value CreateExternalBufferWithTemplatedFinalize(const CallbackInfo& info) {
+  finalizeCount = 0;
+
+  uint16_t* data = new uint16_t[testLength];
+
+  Buffer<uint16_t> buffer =
+      Buffer<uint16_t>::New<&DeleteTestData>(info.Env(), data, testLength);
+
+  if (buffer.Length() != testLength) {
+    Error::New(info.Env(), "Incorrect buffer length.")
+        .ThrowAsJavaScriptException();
+    return Value();
+  }
+
+  if (buffer.Data() != data) {
+    Error::New(info.Env(), "Incorrect buffer data.")
+        .ThrowAsJavaScriptException();
+    return Value();
+  }
+
+  InitData(data, testLength);
+  return buffer;
+}
+
+Value CreateExternalBufferWithTemplatedFinalizeHint(const CallbackInfo& info) {
+  finalizeCount = 0;
+
+  uint16_t* data = new uint16_t[testLength];
+
+  Buffer<uint16_t> buffer =
+      Buffer<uint16_t>::New<int, &DeleteTestDataWithHint>(
+          info.Env(), data, testLength, &finalizeIncrement);
+
+  if (buffer.Length() != testLength) {
+    Error::New(info.Env(), "Incorrect buffer length.")
+        .ThrowAsJavaScriptException();
+    return Value();
+  }
+
+  if (buffer.Data() != data) {
+    Error::New(info.Env(), "Incorrect buffer data.")
+        .ThrowAsJavaScriptException();
+    return Value();
+  }
+
+  InitData(data, testLength);
+  return buffer;
+}
+
 void CheckBuffer(const CallbackInfo& info) {
   if (!info[0].IsBuffer()) {
     Error::New(info.Env(), "A buffer was expected.")
@@ -177,6 +226,14 @@ Object InitBuffer(Env env) {
       Function::New(env, CreateOrCopyExternalBufferWithFinalize);
   exports["createOrCopyExternalBufferWithFinalizeHint"] =
       Function::New(env, CreateOrCopyExternalBufferWithFinalizeHint);
+  exports["createExternalBufferWithTemplatedFinalize"] =
+      Function::New(env, CreateExternalBufferWithTemplatedFinalize);
+  exports["createExternalBufferWithTemplatedFinalizeHint"] =
+      Function::New(env, CreateExternalBufferWithTemplatedFinalizeHint);
+  exports["createOrCopyExternalBufferWithTemplatedFinalize"] =
+      Function::New(env, CreateOrCopyExternalBufferWithTemplatedFinalize);
+  exports["createOrCopyExternalBufferWithTemplatedFinalizeHint"] =
+      Function::New(env, CreateOrCopyExternalBufferWithTemplatedFinalizeHint);
   exports["createBufferCopy"] = Function::New(env, CreateBufferCopy);
   exports["checkBuffer"] = Function::New(env, CheckBuffer);
   exports["getFinalizeCount"] = Function::New(env, GetFinalizeCount);
@@ -146,6 +146,92 @@ function test (binding) {
     },
     () => {
       assert.strictEqual(1, binding.buffer.getFinalizeCount());
+    },
+
+    'External Buffer with templated finalizer',
+    () => {
+      const test = binding.buffer.createExternalBufferWithTemplatedFinalize();
+      binding.buffer.checkBuffer(test);
+      assert.ok(test instanceof Buffer);
+      assert.strictEqual(0, binding.buffer.getFinalizeCount());
+    },
+    () => {
+      global.gc();
+    },
+    () => {
+      assert.strictEqual(1, binding.buffer.getFinalizeCount());
+    },
+
+    'External Buffer with templated finalizer and hint',
+    () => {
+      const test = binding.buffer.createExternalBufferWithTemplatedFinalizeHint();
+      binding.buffer.checkBuffer(test);
+      assert.ok(test instanceof Buffer);
+      assert.strictEqual(0, binding.buffer.getFinalizeCount());
+    },
+    () => {
+      global.gc();
+    },
+    () => {
+      assert.strictEqual(2, binding.buffer.getFinalizeCount());
+    },
+
+    'Create or Copy External Buffer with templated finalizer',
+    () => {
+      const test = binding.buffer.createOrCopyExternalBufferWithTemplatedFinalize();
+      binding.buffer.checkBuffer(test);
+      assert.ok(test instanceof Buffer);
+      assert.strictEqual(0, binding.buffer.getFinalizeCount());
+    },
+    () => {
+      global.gc();
+    },
+    () => {
+      assert.strictEqual(1, binding.buffer.getFinalizeCount());
+    },
+
+    'Create or Copy External Buffer with templated finalizer and hint',
+    () => {
+      const test = binding.buffer.createOrCopyExternalBufferWithTemplatedFinalizeHint();
+      binding.buffer.checkBuffer(test);
+      assert.ok(test instanceof Buffer);
+      assert.strictEqual(0, binding.buffer.getFinalizeCount());
+    },
+    () => {
+      global.gc();
+    },
+    () => {
+      assert.strictEqual(2, binding.buffer.getFinalizeCount());
+    },
+
+    'Create or Copy External Buffer with templated finalizer when NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED defined',
+    () => {
+      const test = binding.bufferNoExternal.createOrCopyExternalBufferWithTemplatedFinalize();
+      binding.buffer.checkBuffer(test);
+      assert.ok(test instanceof Buffer);
+      // finalizer should have been called when the buffer was created.
+      assert.strictEqual(1, binding.buffer.getFinalizeCount());
+    },
+    () => {
+      global.gc();
+    },
+    () => {
+      assert.strictEqual(1, binding.buffer.getFinalizeCount());
+    },
+
+    'Create or Copy External Buffer with templated finalizer and hint when NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED defined',
+    () => {
+      const test = binding.bufferNoExternal.createOrCopyExternalBufferWithTemplatedFinalizeHint();
+      binding.buffer.checkBuffer(test);
+      assert.ok(test instanceof Buffer);
+      // finalizer should have been called when the buffer was created.
+      assert.strictEqual(2, binding.buffer.getFinalizeCount());
+    },
+    () => {
+      global.gc();
+    },
+    () => {
+      assert.strictEqual(2, binding.buffer.getFinalizeCount());
     }
   ]);
 }
@@ -1,6 +1,21 @@
 // Same tests on when NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED is defined or not
 // defined.
 
+void DeleteTestData(Env /*env*/, uint16_t* finalizeData) {
+  delete[] finalizeData;
+  finalizeCount++;
+}
+
+// Adds the value of its hint to the finalize count.
+void DeleteTestDataWithHint(Env /*env*/,
+                            uint16_t* finalizeData,
+                            int* increment) {
+  delete[] finalizeData;
+  finalizeCount += *increment;
+}
+
+int finalizeIncrement = 2;
+
 Value CreateOrCopyExternalBuffer(const CallbackInfo& info) {
   finalizeCount = 0;
 
@@ -66,3 +81,44 @@ Value CreateOrCopyExternalBufferWithFinalizeHint(const CallbackInfo& info) {
   VerifyData(buffer.Data(), testLength);
   return buffer;
 }
+
+Value CreateOrCopyExternalBufferWithTemplatedFinalize(
+    const CallbackInfo& info) {
+  finalizeCount = 0;
+
+  uint16_t* data = new uint16_t[testLength];
+  InitData(data, testLength);
+
+  Buffer<uint16_t> buffer = Buffer<uint16_t>::NewOrCopy<&DeleteTestData>(
+      info.Env(), data, testLength);
+
+  if (buffer.Length() != testLength) {
+    Error::New(info.Env(), "Incorrect buffer length.")
+        .ThrowAsJavaScriptException();
+    return Value();
+  }
+
+  VerifyData(buffer.Data(), testLength);
+  return buffer;
+}
+
+Value CreateOrCopyExternalBufferWithTemplatedFinalizeHint(
+    const CallbackInfo& info) {
+  finalizeCount = 0;
+
+  uint16_t* data = new uint16_t[testLength];
+  InitData(data, testLength);
+
+  Buffer<uint16_t> buffer =
+      Buffer<uint16_t>::NewOrCopy<int, &DeleteTestDataWithHint>(
+          info.Env(), data, testLength, &finalizeIncrement);
+
+  if (buffer.Length() != testLength) {
+    Error::New(info.Env(), "Incorrect buffer length.")
+        .ThrowAsJavaScriptException();
+    return Value();
+  }
+
+  VerifyData(buffer.Data(), testLength);
+  return buffer;
+}
@@ -19,6 +19,10 @@ Object InitBufferNoExternal(Env env) {
       Function::New(env, CreateOrCopyExternalBufferWithFinalize);
   exports["createOrCopyExternalBufferWithFinalizeHint"] =
       Function::New(env, CreateOrCopyExternalBufferWithFinalizeHint);
+  exports["createOrCopyExternalBufferWithTemplatedFinalize"] =
+      Function::New(env, CreateOrCopyExternalBufferWithTemplatedFinalize);
+  exports["createOrCopyExternalBufferWithTemplatedFinalizeHint"] =
+      Function::New(env, CreateOrCopyExternalBufferWithTemplatedFinalizeHint);
 
   return exports;
 }
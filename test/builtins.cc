@@ -0,0 +1,67 @@
+#include "napi.h"
+#include "test_helper.h"
+
+using namespace Napi;
+
+#if (NAPI_VERSION > 2)
+namespace {
+
+Value GetBuiltins(const CallbackInfo& info) {
+  Env env = info.Env();
+  Object builtins = Object::New(env);
+  builtins["jsonParse"] = Builtins::JsonParse(env);
+  builtins["jsonStringify"] = Builtins::JsonStringify(env);
+  builtins["arrayFrom"] = Builtins::ArrayFrom(env);
+  builtins["arrayFlat"] = Builtins::ArrayFlat(env);
+  builtins["arrayPush"] = Builtins::ArrayPush(env);
+  builtins["mapConstructor"] = Builtins::MapConstructor(env);
+  builtins["mapGet"] = Builtins::MapGet(env);
+  builtins["mapSet"] = Builtins::MapSet(env);
+  builtins["mapHas"] = Builtins::MapHas(env);
+  builtins["mapDelete"] = Builtins::MapDelete(env);
+  builtins["setConstructor"] = Builtins::SetConstructor(env);
+  builtins["setAdd"] = Builtins::SetAdd(env);
+  builtins["setHas"] = Builtins::SetHas(env);
+  builtins["setDelete"] = Builtins::SetDelete(env);
+  builtins["symbolFor"] = Builtins::SymbolFor(env);
+  return builtins;
+}
+
+Value ParseValue(const CallbackInfo& info) {
+  return MaybeUnwrapOr(Json::Parse(info.Env(), info[0]), Value());
+}
+
+Value ParseString(const CallbackInfo& info) {
+  std::string json = info[0].As<String>().Utf8Value();
+  return MaybeUnwrapOr(Json::Parse(info.Env(), json), Value());
+}
+
+Value ParseCString(const CallbackInfo& info) {
+  std::string json = info[0].As<String>().Utf8Value();
+  return MaybeUnwrapOr(Json::Parse(info.Env(), json.c_str(), json.size()),
+                       Value());
+}
+
+Value Stringify(const CallbackInfo& info) {
+  return MaybeUnwrapOr(Json::Stringify(info.Env(), info[0]), Value());
+}
+
+Value StringifyWithSpace(const CallbackInfo& info) {
+  return MaybeUnwrapOr(
+      Json::Stringify(info.Env(), info[0], info.Env().Null(), info[1]),
+      Value());
+}
+
+}  // end anonymous namespace
+
+Object InitBuiltins(Env env) {
+  Object exports = Object::New(env);
+  exports["getBuiltins"] = Function::New(env, GetBuiltins);
+  exports["parseValue"] = Function::New(env, ParseValue);
+  exports["parseString"] = Function::New(env, ParseString);
+  exports["parseCString"] = Function::New(env, ParseCString);
+  exports["stringify"] = Function::New(env, Stringify);
+  exports["stringifyWithSpace"] = Function::New(env, StringifyWithSpace);
+  return exports;
+}
+#endif
@@ -0,0 +1,51 @@
+'use strict';
+
+const assert = require('assert');
+
+module.exports = require('./common').runTest(test);
+
+function test (binding) {
+  const builtins = binding.builtins.getBuiltins();
+  assert.strictEqual(builtins.jsonParse, JSON.parse);
+  assert.strictEqual(builtins.jsonStringify, JSON.stringify);
+  assert.strictEqual(builtins.arrayFrom, Array.from);
+  assert.strictEqual(builtins.arrayFlat, Array.prototype.flat);
+  assert.strictEqual(builtins.arrayPush, Array.prototype.push);
+  assert.strictEqual(builtins.mapConstructor, Map);
+  assert.strictEqual(builtins.mapGet, Map.prototype.get);
+  assert.strictEqual(builtins.mapSet, Map.prototype.set);
+  assert.strictEqual(builtins.mapHas, Map.prototype.has);
+  assert.strictEqual(builtins.mapDelete, Map.prototype.delete);
+  assert.strictEqual(builtins.setConstructor, Set);
+  assert.strictEqual(builtins.setAdd, Set.prototype.add);
+  assert.strictEqual(builtins.setHas, Set.prototype.has);
+  assert.strictEqual(builtins.setDelete, Set.prototype.delete);
+  assert.strictEqual(builtins.symbolFor, Symbol.for);
+
+  // Once cached, the intrinsics are not looked up again.
+  const parse = JSON.parse;
+  JSON.parse = () => 'patched';
+  try {
+    assert.strictEqual(binding.builtins.getBuiltins().jsonParse, parse);
+    assert.deepStrictEqual(binding.builtins.parseValue('[1]'), [1]);
+  } finally {
+    JSON.parse = parse;
+  }
+
+  const json = '{"a":1,"b":[true,null,"c"]}';
+  const expected = { a: 1, b: [true, null, 'c'] };
+  assert.deepStrictEqual(binding.builtins.parseValue(json), expected);
+  assert.deepStrictEqual(binding.builtins.parseString(json), expected);
+  assert.deepStrictEqual(binding.builtins.parseCString(json), expected);
+  assert.deepStrictEqual(binding.builtins.parseString('"é"'), 'é');
+  assert.throws(() => binding.builtins.parseString('{'), SyntaxError);
+
+  assert.strictEqual(binding.builtins.stringify(expected), json);
+  assert.strictEqual(binding.builtins.stringify(undefined), undefined);
+  assert.strictEqual(binding.builtins.stringifyWithSpace([1], 2), '[\n  1\n]');
+  assert.throws(() => {
+    const cyclic = {};
+    cyclic.self = cyclic;
+    binding.builtins.stringify(cyclic);
+  }, TypeError);
+}
@@ -1,5 +1,7 @@
 #include "assert.h"
 #include "napi.h"
+#include "test_helper.h"
+#include "uv.h"
 using namespace Napi;
 
 #if (NAPI_VERSION > 2)
@@ -27,6 +29,78 @@ static void RunInCallbackScopeFromExisting(const CallbackInfo& info) {
   callback.Call({});
 }
 
+static Value RunInCallbackBatch(const CallbackInfo& info) {
+  Function callback = info[0].As<Function>();
+  uint32_t count = info[1].As<Number>().Uint32Value();
+  Env env = info.Env();
+
+  AsyncContext context(env, "callback_batch_test");
+  CallbackBatch batch(env, context);
+  assert(batch.Env() == env);
+
+  double sum = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    Value result =
+        MaybeUnwrapOr(batch.Call(callback, env.Undefined(), i), Value());
+    if (env.IsExceptionPending()) {
+      return Value();
+    }
+    sum += result.As<Number>().DoubleValue();
+  }
+  return Number::New(env, sum);
+}
+
+// Drives a batch from a libuv timer, where no callback scope of Node.js
+// encloses the calls, so ticks are processed whenever the outermost callback
+// scope closes. With `perCall` set, every call gets a callback scope of its own
+// through MakeCallback instead, which processes the ticks after each call.
+struct TimerBatch {
+  uv_timer_t timer;
+  napi_env env;
+  FunctionReference callback;
+  uint32_t count;
+  bool perCall;
+};
+
+static void RunTimerBatch(uv_timer_t* handle) {
+  TimerBatch* data = static_cast<TimerBatch*>(handle->data);
+  Env env(data->env);
+  {
+    HandleScope scope(env);
+    Function callback = data->callback.Value();
+    AsyncContext context(env, "callback_batch_timer_test");
+    if (data->perCall) {
+      for (uint32_t i = 0; i < data->count; i++) {
+        callback.MakeCallback(
+            Object::New(env), {Number::New(env, i)}, context);
+      }
+    } else {
+      CallbackBatch batch(env, context);
+      for (uint32_t i = 0; i < data->count; i++) {
+        batch.Call(callback, env.Undefined(), i);
+      }
+    }
+  }
+  uv_close(reinterpret_cast<uv_handle_t*>(handle), [](uv_handle_t* handle) {
+    delete static_cast<TimerBatch*>(handle->data);
+  });
+}
+
+static void RunCallbackBatchFromTimer(const CallbackInfo& info) {
+  uv_loop_t* loop;
+  NAPI_THROW_IF_FAILED_VOID(
+      info.Env(), napi_get_uv_event_loop(info.Env(), &loop));
+
+  TimerBatch* data = new TimerBatch();
+  data->env = info.Env();
+  data->callback = Persistent(info[0].As<Function>());
+  data->count = info[1].As<Number>().Uint32Value();
+  data->perCall = info[2].As<Boolean>().Value();
+  data->timer.data = data;
+  uv_timer_init(loop, &data->timer);
+  uv_timer_start(&data->timer, RunTimerBatch, 0, 0);
+}
+
 }  // namespace
 
 Object InitCallbackScope(Env env) {
@@ -34,6 +108,9 @@ Object InitCallbackScope(Env env) {
   exports["runInCallbackScope"] = Function::New(env, RunInCallbackScope);
   exports["runInPreExistingCbScope"] =
       Function::New(env, RunInCallbackScopeFromExisting);
+  exports["runInCallbackBatch"] = Function::New(env, RunInCallbackBatch);
+  exports["runCallbackBatchFromTimer"] =
+      Function::New(env, RunCallbackBatchFromTimer);
   return exports;
 }
 #endif
@@ -22,17 +22,25 @@ function test (binding) {
 
   let id;
   let insideHook = false;
+  let batchId;
+  let batchEntered = 0;
+  let insideBatch = false;
   const hook = asyncHooks.createHook({
     init (asyncId, type, triggerAsyncId, resource) {
       if (id === undefined && (type === 'callback_scope_test' || type === 'existing_callback_scope_test')) {
         id = asyncId;
       }
+      if (type === 'callback_batch_test') {
+        batchId = asyncId;
+      }
     },
     before (asyncId) {
       if (asyncId === id) { insideHook = true; }
+      if (asyncId === batchId) { batchEntered++; insideBatch = true; }
     },
     after (asyncId) {
       if (asyncId === id) { insideHook = false; }
+      if (asyncId === batchId) { insideBatch = false; }
     }
   }).enable();
 
@@ -41,9 +49,61 @@ function test (binding) {
       assert(insideHook);
       binding.callbackscope.runInPreExistingCbScope(function () {
         assert(insideHook);
+
+        // All calls in a batch share a single callback scope.
+        const seen = [];
+        const sum = binding.callbackscope.runInCallbackBatch((i) => {
+          assert(insideBatch);
+          seen.push(i);
+          return i * 2;
+        }, 5);
+        assert.strictEqual(sum, 20);
+        assert.deepStrictEqual(seen, [0, 1, 2, 3, 4]);
+        assert.strictEqual(batchEntered, 1);
+        assert(!insideBatch);
+
+        // A throwing callback stops the batch and the exception propagates.
+        let calls = 0;
+        assert.throws(() => {
+          binding.callbackscope.runInCallbackBatch(() => {
+            if (++calls === 2) throw new Error('stop');
+            return 0;
+          }, 5);
+        }, /stop/);
+        assert.strictEqual(calls, 2);
+
         hook.disable();
         resolve();
       });
     });
+  }).then(async () => {
+    // Called from a libuv timer, outside of any callback scope, the batch holds
+    // back the ticks and promise reactions queued by its calls until it is
+    // destroyed, while separate MakeCallback() calls each process them.
+    const runFromTimer = (perCall) => new Promise((resolve) => {
+      let ticks = 0;
+      let resolutions = 0;
+      const observed = [];
+      binding.callbackscope.runCallbackBatchFromTimer((i) => {
+        observed.push([ticks, resolutions]);
+        process.nextTick(() => { ticks++; });
+        Promise.resolve().then(() => { resolutions++; });
+        if (i === 2) {
+          setImmediate(() => resolve({ observed, ticks, resolutions }));
+        }
+        return 0;
+      }, 3, perCall);
+    });
+
+    assert.deepStrictEqual(await runFromTimer(false), {
+      observed: [[0, 0], [0, 0], [0, 0]],
+      ticks: 3,
+      resolutions: 3
+    });
+    assert.deepStrictEqual(await runFromTimer(true), {
+      observed: [[0, 0], [1, 1], [2, 2]],
+      ticks: 3,
+      resolutions: 3
+    });
   });
 }
@@ -0,0 +1,144 @@
+#include "napi.h"
+#include "test_helper.h"
+
+using namespace Napi;
+
+namespace {
+
+enum class Color { Red = 1, Green = 2, Blue = 4 };
+
+template <typename T>
+Value RoundTrip(const CallbackInfo& info) {
+  T value;
+  if (!MaybeUnwrapTo(info[0].To<T>(), &value) ||
+      info.Env().IsExceptionPending()) {
+    return Value();
+  }
+  return Value::From(info.Env(), value);
+}
+
+Value SumDoubles(const CallbackInfo& info) {
+  std::vector<double> values;
+  if (!MaybeUnwrapTo(info[0].To<std::vector<double>>(), &values) ||
+      info.Env().IsExceptionPending()) {
+    return Value();
+  }
+  double sum = 0;
+  for (double value : values) {
+    sum += value;
+  }
+  return Number::New(info.Env(), sum);
+}
+
+Value MakeIntMap(const CallbackInfo& info) {
+  std::unordered_map<int32_t, std::string> map{{1, "one"}, {2, "two"}};
+  return Value::From(info.Env(), map);
+}
+
+Value MakeDuration(const CallbackInfo& info) {
+  return Value::From(info.Env(), std::chrono::seconds(3));
+}
+
+Value ToMicroseconds(const CallbackInfo& info) {
+  std::chrono::microseconds duration;
+  if (!MaybeUnwrapTo(info[0].To<std::chrono::microseconds>(), &duration) ||
+      info.Env().IsExceptionPending()) {
+    return Value();
+  }
+  return Number::New(info.Env(), static_cast<double>(duration.count()));
+}
+
+#ifdef NAPI_HAS_CPP17
+Value VariantIndex(const CallbackInfo& info) {
+  std::variant<String, Number, Array> value;
+  if (!MaybeUnwrapTo(info[0].To<decltype(value)>(), &value) ||
+      info.Env().IsExceptionPending()) {
+    return Value();
+  }
+  return Number::New(info.Env(), static_cast<double>(value.index()));
+}
+#endif
+
+Value AcceptsVector(const CallbackInfo& info) {
+  return Boolean::New(info.Env(),
+                      Convert<std::vector<int32_t>>::Accepts(info[0]));
+}
+
+Value AcceptsUint8Vector(const CallbackInfo& info) {
+  return Boolean::New(info.Env(),
+                      Convert<std::vector<uint8_t>>::Accepts(info[0]));
+}
+
+}  // end anonymous namespace
+
+Object InitConvert(Env env) {
+  Object exports = Object::New(env);
+
+  exports["roundTripBool"] = Function::New(env, RoundTrip<bool>);
+  exports["roundTripInt32"] = Function::New(env, RoundTrip<int32_t>);
+  exports["roundTripUint32"] = Function::New(env, RoundTrip<uint32_t>);
+#if (NAPI_VERSION > 5)
+  exports["roundTripUint64"] = Function::New(env, RoundTrip<uint64_t>);
+#endif
+  exports["roundTripDouble"] = Function::New(env, RoundTrip<double>);
+  exports["roundTripEnum"] = Function::New(env, RoundTrip<Color>);
+  exports["roundTripString"] = Function::New(env, RoundTrip<std::string>);
+  exports["roundTripU16String"] =
+      Function::New(env, RoundTrip<std::u16string>);
+  exports["roundTripDoubleVector"] =
+      Function::New(env, RoundTrip<std::vector<double>>);
+  exports["roundTripUint8Vector"] =
+      Function::New(env, RoundTrip<std::vector<uint8_t>>);
+#if (NAPI_VERSION > 5)
+  exports["roundTripInt64Vector"] =
+      Function::New(env, RoundTrip<std::vector<int64_t>>);
+#endif
+  exports["roundTripBoolVector"] =
+      Function::New(env, RoundTrip<std::vector<bool>>);
+  exports["roundTripStringVector"] =
+      Function::New(env, RoundTrip<std::vector<std::string>>);
+  exports["roundTripNestedVector"] =
+      Function::New(env, RoundTrip<std::vector<std::vector<std::string>>>);
+  exports["roundTripArray"] =
+      Function::New(env, RoundTrip<std::array<int32_t, 3>>);
+  exports["roundTripMap"] =
+      Function::New(env, RoundTrip<std::map<std::string, double>>);
+  exports["roundTripIntKeyMap"] =
+      Function::New(env, RoundTrip<std::map<int32_t, std::string>>);
+  exports["roundTripPair"] =
+      Function::New(env, RoundTrip<std::pair<std::string, int32_t>>);
+  exports["roundTripTuple"] = Function::New(
+      env, RoundTrip<std::tuple<bool, std::string, std::vector<double>>>);
+  exports["roundTripValueVector"] =
+      Function::New(env, RoundTrip<std::vector<Value>>);
+  exports["roundTripArrayValue"] = Function::New(env, RoundTrip<Array>);
+  exports["roundTripUint8Array"] = Function::New(env, RoundTrip<Uint8Array>);
+  exports["roundTripDuration"] =
+      Function::New(env, RoundTrip<std::chrono::milliseconds>);
+#if (NAPI_VERSION > 4)
+  exports["roundTripTimePoint"] = Function::New(
+      env,
+      RoundTrip<std::chrono::time_point<std::chrono::system_clock,
+                                        std::chrono::milliseconds>>);
+  exports["roundTripNanosecondTimePoint"] = Function::New(
+      env,
+      RoundTrip<std::chrono::time_point<std::chrono::system_clock,
+                                        std::chrono::nanoseconds>>);
+#endif
+#ifdef NAPI_HAS_CPP17
+  exports["roundTripOptional"] =
+      Function::New(env, RoundTrip<std::optional<std::string>>);
+  exports["roundTripVariant"] = Function::New(
+      env,
+      RoundTrip<std::variant<double, std::string, std::vector<std::string>>>);
+  exports["variantIndex"] = Function::New(env, VariantIndex);
+#endif
+  exports["sumDoubles"] = Function::New(env, SumDoubles);
+  exports["makeIntMap"] = Function::New(env, MakeIntMap);
+  exports["makeDuration"] = Function::New(env, MakeDuration);
+  exports["toMicroseconds"] = Function::New(env, ToMicroseconds);
+  exports["acceptsVector"] = Function::New(env, AcceptsVector);
+  exports["acceptsUint8Vector"] = Function::New(env, AcceptsUint8Vector);
+
+  return exports;
+}
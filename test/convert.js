@@ -0,0 +1,154 @@
+'use strict';
+
+const assert = require('assert');
+
+module.exports = require('./common').runTest(test);
+
+function test (binding) {
+  const convert = binding.convert;
+
+  assert.strictEqual(convert.roundTripBool(true), true);
+  assert.strictEqual(convert.roundTripInt32(-42), -42);
+  assert.strictEqual(convert.roundTripInt32(-(2 ** 31)), -(2 ** 31));
+  assert.strictEqual(convert.roundTripUint32(2 ** 32 - 1), 2 ** 32 - 1);
+  assert.strictEqual(convert.roundTripDouble(1.5), 1.5);
+  assert.strictEqual(convert.roundTripEnum(4), 4);
+  assert.strictEqual(convert.roundTripString('hello'), 'hello');
+  assert.strictEqual(convert.roundTripU16String('héllo'), 'héllo');
+
+  // Numeric vectors come back as typed-arrays, and accept both forms.
+  assert.deepStrictEqual(convert.roundTripDoubleVector([1, 2.5, 3]),
+    new Float64Array([1, 2.5, 3]));
+  assert.deepStrictEqual(convert.roundTripDoubleVector(new Float64Array([4, 5])),
+    new Float64Array([4, 5]));
+  assert.deepStrictEqual(convert.roundTripDoubleVector([]), new Float64Array(0));
+  assert.deepStrictEqual(convert.roundTripUint8Vector(new Uint8Array([1, 2, 255])),
+    new Uint8Array([1, 2, 255]));
+  assert.deepStrictEqual(convert.roundTripUint8Vector(new Uint8ClampedArray([1, 2])),
+    new Uint8Array([1, 2]));
+  assert.strictEqual(convert.acceptsUint8Vector(new Uint8ClampedArray(1)), true);
+  assert.strictEqual(convert.acceptsUint8Vector(new Int8Array(1)), false);
+  if (convert.roundTripInt64Vector) {
+    assert.deepStrictEqual(convert.roundTripInt64Vector(new BigInt64Array([-1n, 2n ** 40n])),
+      new BigInt64Array([-1n, 2n ** 40n]));
+  }
+  assert.strictEqual(convert.sumDoubles(new Float64Array([1, 2, 3])), 6);
+  assert.strictEqual(convert.sumDoubles([1, 2, 3, 4]), 10);
+  assert.strictEqual(convert.acceptsVector([1]), true);
+  assert.strictEqual(convert.acceptsVector(new Int32Array(1)), true);
+  assert.strictEqual(convert.acceptsVector(new Float32Array(1)), false);
+  assert.strictEqual(convert.acceptsVector({}), false);
+
+  assert.deepStrictEqual(convert.roundTripBoolVector([true, false]), [true, false]);
+  assert.deepStrictEqual(convert.roundTripStringVector(['a', 'b']), ['a', 'b']);
+  assert.deepStrictEqual(convert.roundTripNestedVector([['a'], [], ['b', 'c']]),
+    [['a'], [], ['b', 'c']]);
+  assert.deepStrictEqual(convert.roundTripArray([1, 2, 3]), new Int32Array([1, 2, 3]));
+  assert.throws(() => convert.roundTripArray([1, 2]), TypeError);
+
+  assert.deepStrictEqual(convert.roundTripMap({ a: 1, b: 2.5 }), { a: 1, b: 2.5 });
+  assert.deepStrictEqual(convert.roundTripIntKeyMap({ 1: 'x', 10: 'y' }), { 1: 'x', 10: 'y' });
+  assert.deepStrictEqual(convert.makeIntMap(), { 1: 'one', 2: 'two' });
+  const inherited = Object.create({ inherited: 1 });
+  inherited.own = 2;
+  assert.deepStrictEqual(convert.roundTripMap(inherited), { own: 2 });
+
+  assert.deepStrictEqual(convert.roundTripPair(['x', 7]), ['x', 7]);
+  assert.deepStrictEqual(convert.roundTripTuple([true, 'y', [1, 2]]),
+    [true, 'y', new Float64Array([1, 2])]);
+  assert.throws(() => convert.roundTripTuple([true, 'y']), TypeError);
+
+  const obj = {};
+  const values = convert.roundTripValueVector([obj, 'z', null]);
+  assert.strictEqual(values[0], obj);
+  assert.deepStrictEqual(values, [obj, 'z', null]);
+  const array = [1];
+  assert.strictEqual(convert.roundTripArrayValue(array), array);
+  assert.throws(() => convert.roundTripArrayValue({}), TypeError);
+  const bytes = new Uint8Array(2);
+  assert.strictEqual(convert.roundTripUint8Array(bytes), bytes);
+  assert.throws(() => convert.roundTripUint8Array(new Int8Array(2)), TypeError);
+
+  assert.strictEqual(convert.roundTripDuration(1500), 1500);
+  assert.strictEqual(convert.makeDuration(), 3000);
+  assert.strictEqual(convert.toMicroseconds(2.5), 2500);
+  if (convert.roundTripTimePoint) {
+    const date = new Date(1700000000123);
+    assert.deepStrictEqual(convert.roundTripTimePoint(date), date);
+    assert.deepStrictEqual(convert.roundTripTimePoint(42), new Date(42));
+    for (const bad of [new Date(NaN), NaN, Infinity, 8.64e15 + 1]) {
+      assert.throws(() => convert.roundTripTimePoint(bad), {
+        name: 'RangeError',
+        message: 'Invalid Date'
+      });
+    }
+
+    // A valid Date may still not fit into 64 bits of nanoseconds.
+    assert.deepStrictEqual(convert.roundTripNanosecondTimePoint(date), date);
+    for (const bad of [new Date(8.64e15), -8.64e15]) {
+      assert.throws(() => convert.roundTripNanosecondTimePoint(bad), {
+        name: 'RangeError',
+        message: 'The Date is out of range of the time point.'
+      });
+    }
+  }
+
+  if (convert.roundTripOptional) {
+    assert.strictEqual(convert.roundTripOptional('v'), 'v');
+    assert.strictEqual(convert.roundTripOptional(undefined), undefined);
+    assert.strictEqual(convert.roundTripOptional(null), undefined);
+    assert.throws(() => convert.roundTripOptional(1), TypeError);
+  }
+  if (convert.roundTripVariant) {
+    assert.strictEqual(convert.roundTripVariant(2), 2);
+    assert.strictEqual(convert.roundTripVariant('s'), 's');
+    assert.deepStrictEqual(convert.roundTripVariant(['a']), ['a']);
+    assert.throws(() => convert.roundTripVariant(true), {
+      name: 'TypeError',
+      message: 'Value does not match any variant alternative.'
+    });
+
+    // Napi::Value alternatives only accept values of their own type.
+    assert.strictEqual(convert.variantIndex('s'), 0);
+    assert.strictEqual(convert.variantIndex(1), 1);
+    assert.strictEqual(convert.variantIndex([]), 2);
+    assert.throws(() => convert.variantIndex({}), TypeError);
+  }
+
+  assert.throws(() => convert.roundTripBool(1), {
+    name: 'TypeError',
+    message: 'A boolean was expected.'
+  });
+  assert.throws(() => convert.roundTripInt32('1'), TypeError);
+  for (const bad of [1.5, NaN, Infinity, -Infinity]) {
+    assert.throws(() => convert.roundTripInt32(bad), {
+      name: 'RangeError',
+      message: 'An integer was expected.'
+    });
+  }
+  for (const bad of [2 ** 31, -(2 ** 31) - 1]) {
+    assert.throws(() => convert.roundTripInt32(bad), {
+      name: 'RangeError',
+      message: 'The number is out of range.'
+    });
+  }
+  assert.throws(() => convert.roundTripUint32(-1), RangeError);
+  assert.throws(() => convert.roundTripUint32(2 ** 32), RangeError);
+  assert.throws(() => convert.roundTripEnum(2 ** 40), RangeError);
+  if (convert.roundTripUint64) {
+    assert.strictEqual(convert.roundTripUint64(2n ** 63n), 2 ** 63);
+    for (const bad of [-1n, 2n ** 64n]) {
+      assert.throws(() => convert.roundTripUint64(bad), {
+        name: 'RangeError',
+        message: 'The BigInt is out of range.'
+      });
+    }
+  }
+  assert.throws(() => convert.roundTripString(1), TypeError);
+  assert.throws(() => convert.roundTripDoubleVector('abc'), {
+    name: 'TypeError',
+    message: 'An array was expected.'
+  });
+  assert.throws(() => convert.roundTripStringVector(['a', 1]), TypeError);
+  assert.throws(() => convert.roundTripMap(1), TypeError);
+}
@@ -1,4 +1,5 @@
 #include "napi.h"
+#include "test_helper.h"
 
 using namespace Napi;
 
@@ -30,6 +31,62 @@ Value OperatorValue(const CallbackInfo& info) {
                       input.ValueOf() == static_cast<double>(input));
 }
 
+using Microseconds = Date::TimePoint<std::chrono::microseconds>;
+
+std::vector<Microseconds> ToTimePoints(const Array& array) {
+  std::vector<Microseconds> result;
+  for (uint32_t i = 0; i < array.Length(); i++) {
+    Value element = MaybeUnwrapOr(array.Get(i), Value());
+    result.emplace_back(
+        std::chrono::microseconds(element.As<Number>().Int64Value()));
+  }
+  return result;
+}
+
+Value CreateDateFromMicroseconds(const CallbackInfo& info) {
+  int64_t input = info[0].As<Number>().Int64Value();
+
+  return Date::New(info.Env(), Microseconds(std::chrono::microseconds(input)));
+}
+
+Value MicrosecondsValue(const CallbackInfo& info) {
+  Date input = info[0].As<Date>();
+
+  return Number::New(
+      info.Env(),
+      static_cast<double>(input.TimePointValue<std::chrono::microseconds>()
+                              .time_since_epoch()
+                              .count()));
+}
+
+Value NanosecondsValue(const CallbackInfo& info) {
+  Date input = info[0].As<Date>();
+
+  return Number::New(
+      info.Env(),
+      static_cast<double>(input.TimePointValue<std::chrono::nanoseconds>()
+                              .time_since_epoch()
+                              .count()));
+}
+
+Value SecondsValue(const CallbackInfo& info) {
+  Date input = info[0].As<Date>();
+
+  return Number::New(
+      info.Env(),
+      static_cast<double>(input.TimePointValue<std::chrono::seconds>()
+                              .time_since_epoch()
+                              .count()));
+}
+
+Value CreateDateArray(const CallbackInfo& info) {
+  return Date::NewArray(info.Env(), ToTimePoints(info[0].As<Array>()));
+}
+
+Value CreateEpochArray(const CallbackInfo& info) {
+  return Date::NewEpochArray(info.Env(), ToTimePoints(info[0].As<Array>()));
+}
+
 }  // anonymous namespace
 
 Object InitDate(Env env) {
@@ -38,6 +95,13 @@ Object InitDate(Env env) {
   exports["IsDate"] = Function::New(env, IsDate);
   exports["ValueOf"] = Function::New(env, ValueOf);
   exports["OperatorValue"] = Function::New(env, OperatorValue);
+  exports["CreateDateFromMicroseconds"] =
+      Function::New(env, CreateDateFromMicroseconds);
+  exports["MicrosecondsValue"] = Function::New(env, MicrosecondsValue);
+  exports["NanosecondsValue"] = Function::New(env, NanosecondsValue);
+  exports["SecondsValue"] = Function::New(env, SecondsValue);
+  exports["CreateDateArray"] = Function::New(env, CreateDateArray);
+  exports["CreateEpochArray"] = Function::New(env, CreateEpochArray);
 
   return exports;
 }
@@ -9,10 +9,47 @@ function test (binding) {
     CreateDate,
     IsDate,
     ValueOf,
-    OperatorValue
+    OperatorValue,
+    CreateDateFromMicroseconds,
+    MicrosecondsValue,
+    NanosecondsValue,
+    SecondsValue,
+    CreateDateArray,
+    CreateEpochArray
   } = binding.date;
   assert.deepStrictEqual(CreateDate(0), new Date(0));
   assert.strictEqual(IsDate(new Date(0)), true);
   assert.strictEqual(ValueOf(new Date(42)), 42);
   assert.strictEqual(OperatorValue(new Date(42)), true);
+
+  // Time points are rounded down to whole milliseconds.
+  assert.deepStrictEqual(CreateDateFromMicroseconds(1500), new Date(1));
+  assert.deepStrictEqual(CreateDateFromMicroseconds(-1500), new Date(-2));
+  assert.deepStrictEqual(CreateDateFromMicroseconds(-1000), new Date(-1));
+  assert.strictEqual(MicrosecondsValue(new Date(-42)), -42000);
+  assert.strictEqual(SecondsValue(new Date(1500)), 1);
+  assert.strictEqual(SecondsValue(new Date(-1500)), -2);
+  assert.throws(() => MicrosecondsValue(new Date(NaN)), {
+    name: 'RangeError',
+    message: 'Invalid Date'
+  });
+
+  // 64 bits of nanoseconds cover the years 1677 to 2262 only.
+  assert.strictEqual(NanosecondsValue(new Date(-42)), -42000000);
+  assert.strictEqual(MicrosecondsValue(new Date(8.64e15)), 8.64e18);
+  assert.strictEqual(NanosecondsValue(new Date(9223372036854)),
+    9223372036854e6);
+  for (const ms of [8.64e15, -8.64e15, 9223372036855]) {
+    assert.throws(() => NanosecondsValue(new Date(ms)), {
+      name: 'RangeError',
+      message: 'The Date is out of range of the time point.'
+    });
+  }
+
+  const micros = Array.from({ length: 600 }, (_, i) => (i - 300) * 1500);
+  const millis = micros.map((us) => Math.floor(us / 1000));
+  assert.deepStrictEqual(CreateDateArray(micros), millis.map((ms) => new Date(ms)));
+  assert.deepStrictEqual(CreateEpochArray(micros), new Float64Array(millis));
+  assert.deepStrictEqual(CreateDateArray([]), []);
+  assert.deepStrictEqual(CreateEpochArray([]), new Float64Array(0));
 }
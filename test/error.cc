@@ -87,6 +87,36 @@ void TestErrorCopySemantics(const Napi::CallbackInfo& info) {
   assert(existingErr.Message() == "errorCopyCtor");
 }
 
+// Reports whether copies of an error share the original's `napi_ref`.
+Value ErrorCopiesShareReference(const Napi::CallbackInfo& info) {
+  Napi::Error error = Napi::Error::New(info.Env(), "errorShare");
+  Napi::Error copy = error;
+  Napi::Error assigned;
+  assigned = copy;
+  bool shared = static_cast<napi_ref>(copy) == static_cast<napi_ref>(error) &&
+                static_cast<napi_ref>(assigned) == static_cast<napi_ref>(error);
+
+  // Copies stay usable after the original is gone.
+  error = Napi::Error();
+  copy.Reset();
+  bool usable = copy.IsEmpty() && assigned.Message() == "errorShare";
+
+  // Resetting or moving a copy through its base classes only releases that
+  // copy's share.
+  Napi::Error viaObjectReference = assigned;
+  Napi::Error viaReference = assigned;
+  Napi::Error viaMove = assigned;
+  static_cast<Napi::ObjectReference&>(viaObjectReference).Reset();
+  static_cast<Napi::Reference<Napi::Object>&>(viaReference).Reset();
+  {
+    Napi::ObjectReference moved(
+        std::move(static_cast<Napi::ObjectReference&>(viaMove)));
+  }
+  usable = usable && viaObjectReference.IsEmpty() && viaReference.IsEmpty() &&
+           viaMove.IsEmpty() && assigned.Value().IsObject();
+  return Napi::Boolean::New(info.Env(), shared && usable);
+}
+
 void TestErrorMoveSemantics(const Napi::CallbackInfo& info) {
   std::string errorMsg = "errorMoveCtor";
   Napi::Error newError = Napi::Error::New(info.Env(), errorMsg.c_str());
@@ -362,6 +392,8 @@ Object InitError(Env env) {
       Function::New(env, TestErrorCopySemantics);
   exports["testErrorMoveSemantics"] =
       Function::New(env, TestErrorMoveSemantics);
+  exports["errorCopiesShareReference"] =
+      Function::New(env, ErrorCopiesShareReference);
   exports["lastExceptionErrorCode"] =
       Function::New(env, LastExceptionErrorCode);
   exports["throwJSError"] = Function::New(env, ThrowJSError);
@@ -7,12 +7,18 @@ if (process.argv[2] === 'fatal') {
   binding.error.throwFatalError();
 }
 
-module.exports = require('./common').runTestWithBindingPath(test);
+module.exports = require('./common').runTestWithBindingPath(test)
+  .then(() => require('./common').runTestWithBuildType((buildType) => {
+    test(`./build/${buildType}/binding_shared_error.node`);
+    test(`./build/${buildType}/binding_shared_error_noexcept.node`);
+  }));
 
 function test (bindingPath) {
   const binding = require(bindingPath);
   binding.error.testErrorCopySemantics();
   binding.error.testErrorMoveSemantics();
+  assert.strictEqual(binding.error.errorCopiesShareReference(),
+    bindingPath.includes('binding_shared_error'));
 
   assert.throws(() => binding.error.throwApiError('test'), function (err) {
     return err instanceof Error && err.message.includes('Invalid');
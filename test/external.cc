@@ -66,6 +66,83 @@ Value CreateExternalWithFinalizeException(const CallbackInfo& info) {
   });
 }
 
+void DeleteInt(Env /*env*/, int* data) {
+  delete data;
+  finalizeCount++;
+}
+
+void DeleteIntWithHint(Env /*env*/, int* data, int* hint) {
+  delete data;
+  finalizeCount += *hint;
+}
+
+Value CreateExternalWithTemplatedFinalize(const CallbackInfo& info) {
+  finalizeCount = 0;
+  return External<int>::New<&DeleteInt>(info.Env(), new int(1));
+}
+
+Value CreateExternalWithTemplatedFinalizeHint(const CallbackInfo& info) {
+  static int hint = 2;
+  finalizeCount = 0;
+  return External<int>::New<int, &DeleteIntWithHint>(
+      info.Env(), new int(1), &hint);
+}
+
+// Counts the live instances to check that pooled data is destroyed.
+struct Pooled {
+  explicit Pooled(int value) : value(value) { live++; }
+  ~Pooled() { live--; }
+  int value;
+  static int live;
+};
+
+int Pooled::live = 0;
+
+Value CreatePooledExternals(const CallbackInfo& info) {
+  Env env = info.Env();
+  uint32_t count = info[0].As<Number>();
+  // The pool is destroyed before its externals are collected.
+  External<Pooled>::Pool pool(4);
+  Array result = Array::New(env, count);
+  for (uint32_t index = 0; index < count; index++) {
+    result[index] = pool.New(env, static_cast<int>(index));
+  }
+  if (pool.Size() != count) {
+    Error::New(env, "Unexpected pool size").ThrowAsJavaScriptException();
+    return Value();
+  }
+  return result;
+}
+
+Value GetPooledValue(const CallbackInfo& info) {
+  return Number::New(info.Env(),
+                     External<Pooled>(info.Env(), info[0]).Data()->value);
+}
+
+Value GetLivePooledCount(const CallbackInfo& info) {
+  return Number::New(info.Env(), Pooled::live);
+}
+
+#if NAPI_VERSION >= 8
+Value CreateTaggedExternal(const CallbackInfo& info) {
+  External<int> external = External<int>::New(info.Env(), &testData);
+  external.TypeTag(External<int>::DataTypeTag());
+  return external;
+}
+
+Value TryDataAsInt(const CallbackInfo& info) {
+  int* data = External<int>(info.Env(), info[0]).TryData();
+  return data == nullptr ? info.Env().Undefined()
+                         : Number::New(info.Env(), *data);
+}
+
+Value TryDataAsDouble(const CallbackInfo& info) {
+  double* data = External<double>(info.Env(), info[0]).TryData();
+  return data == nullptr ? info.Env().Undefined()
+                         : Number::New(info.Env(), *data);
+}
+#endif  // NAPI_VERSION >= 8
+
 }  // end anonymous namespace
 
 Object InitExternal(Env env) {
@@ -79,6 +156,18 @@ Object InitExternal(Env env) {
   exports["createExternalWithFinalizeHint"] =
       Function::New(env, CreateExternalWithFinalizeHint);
   exports["checkExternal"] = Function::New(env, CheckExternal);
+  exports["createExternalWithTemplatedFinalize"] =
+      Function::New(env, CreateExternalWithTemplatedFinalize);
+  exports["createExternalWithTemplatedFinalizeHint"] =
+      Function::New(env, CreateExternalWithTemplatedFinalizeHint);
+  exports["createPooledExternals"] = Function::New(env, CreatePooledExternals);
+  exports["getPooledValue"] = Function::New(env, GetPooledValue);
+  exports["getLivePooledCount"] = Function::New(env, GetLivePooledCount);
+#if NAPI_VERSION >= 8
+  exports["createTaggedExternal"] = Function::New(env, CreateTaggedExternal);
+  exports["tryDataAsInt"] = Function::New(env, TryDataAsInt);
+  exports["tryDataAsDouble"] = Function::New(env, TryDataAsDouble);
+#endif  // NAPI_VERSION >= 8
   exports["getFinalizeCount"] = Function::New(env, GetFinalizeCount);
 
   return exports;
@@ -79,7 +79,51 @@ if (process.argv.length === 3) {
       },
       () => {
         assert.strictEqual(1, binding.external.getFinalizeCount());
+      },
+
+      'External with templated finalizer',
+      () => {
+        const test = binding.external.createExternalWithTemplatedFinalize();
+        binding.external.checkExternal(test);
+        assert.strictEqual(0, binding.external.getFinalizeCount());
+      },
+      () => {
+        assert.strictEqual(1, binding.external.getFinalizeCount());
+      },
+
+      'External with templated finalizer and hint',
+      () => {
+        const test = binding.external.createExternalWithTemplatedFinalizeHint();
+        binding.external.checkExternal(test);
+        assert.strictEqual(0, binding.external.getFinalizeCount());
+      },
+      () => {
+        // The finalizer adds the value of its hint, 2.
+        assert.strictEqual(2, binding.external.getFinalizeCount());
+      },
+
+      'Externals from a pool',
+      () => {
+        const externals = binding.external.createPooledExternals(10);
+        assert.deepStrictEqual(externals.map(binding.external.getPooledValue),
+          [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]);
+        assert.strictEqual(10, binding.external.getLivePooledCount());
+      },
+      () => {
+        assert.strictEqual(0, binding.external.getLivePooledCount());
+      }
+    ]).then(() => {
+      if (!('tryDataAsInt' in binding.external)) {
+        return;
       }
-    ]);
+      const tagged = binding.external.createTaggedExternal();
+      assert.strictEqual(binding.external.tryDataAsInt(tagged), 1);
+      assert.strictEqual(binding.external.tryDataAsDouble(tagged), undefined);
+      assert.strictEqual(
+        binding.external.tryDataAsInt(binding.external.createExternal()),
+        undefined);
+      assert.strictEqual(binding.external.tryDataAsInt({}), undefined);
+      assert.strictEqual(binding.external.tryDataAsInt(1), undefined);
+    });
   }
 }
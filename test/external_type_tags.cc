@@ -0,0 +1,65 @@
+#include "napi.h"
+
+// This file is built with NODE_ADDON_API_EXTERNAL_TYPE_TAGS, so every
+// External<T> is tagged with External<T>::DataTypeTag() when it is created.
+#if (NAPI_VERSION > 7)
+
+namespace {
+
+int intData = 1;
+double doubleData = 0.5;
+
+void FinalizeInt(Napi::Env /*env*/, int* /*data*/) {}
+
+Napi::Value CreateInt(const Napi::CallbackInfo& info) {
+  return Napi::External<int>::New(info.Env(), &intData);
+}
+
+Napi::Value CreateIntWithFinalizer(const Napi::CallbackInfo& info) {
+  return Napi::External<int>::New(
+      info.Env(), &intData, [](Napi::Env /*env*/, int* /*data*/) {});
+}
+
+Napi::Value CreateIntWithTemplatedFinalizer(const Napi::CallbackInfo& info) {
+  return Napi::External<int>::New<&FinalizeInt>(info.Env(), &intData);
+}
+
+Napi::Value CreatePooledInt(const Napi::CallbackInfo& info) {
+  Napi::External<int>::Pool pool;
+  return pool.New(info.Env(), 1);
+}
+
+Napi::Value CreateDouble(const Napi::CallbackInfo& info) {
+  return Napi::External<double>::New(info.Env(), &doubleData);
+}
+
+Napi::Value TryDataAsInt(const Napi::CallbackInfo& info) {
+  int* data = Napi::External<int>(info.Env(), info[0]).TryData();
+  return data == nullptr ? info.Env().Undefined()
+                         : Napi::Number::New(info.Env(), *data);
+}
+
+Napi::Value TryDataAsDouble(const Napi::CallbackInfo& info) {
+  double* data = Napi::External<double>(info.Env(), info[0]).TryData();
+  return data == nullptr ? info.Env().Undefined()
+                         : Napi::Number::New(info.Env(), *data);
+}
+
+}  // namespace
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  exports["createInt"] = Napi::Function::New(env, CreateInt);
+  exports["createIntWithFinalizer"] =
+      Napi::Function::New(env, CreateIntWithFinalizer);
+  exports["createIntWithTemplatedFinalizer"] =
+      Napi::Function::New(env, CreateIntWithTemplatedFinalizer);
+  exports["createPooledInt"] = Napi::Function::New(env, CreatePooledInt);
+  exports["createDouble"] = Napi::Function::New(env, CreateDouble);
+  exports["tryDataAsInt"] = Napi::Function::New(env, TryDataAsInt);
+  exports["tryDataAsDouble"] = Napi::Function::New(env, TryDataAsDouble);
+  return exports;
+}
+
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, Init)
+
+#endif  // NAPI_VERSION > 7
@@ -0,0 +1,24 @@
+'use strict';
+
+const assert = require('assert');
+
+module.exports = require('./common').runTestWithBuildType((buildType) => {
+  test(`./build/${buildType}/binding_external_type_tags.node`);
+  test(`./build/${buildType}/binding_external_type_tags_noexcept.node`);
+});
+
+function test (bindingPath) {
+  const binding = require(bindingPath);
+
+  for (const create of ['createInt', 'createIntWithFinalizer',
+    'createIntWithTemplatedFinalizer', 'createPooledInt']) {
+    const external = binding[create]();
+    assert.strictEqual(binding.tryDataAsInt(external), 1, create);
+    assert.strictEqual(binding.tryDataAsDouble(external), undefined, create);
+  }
+
+  const external = binding.createDouble();
+  assert.strictEqual(binding.tryDataAsDouble(external), 0.5);
+  assert.strictEqual(binding.tryDataAsInt(external), undefined);
+  assert.strictEqual(binding.tryDataAsInt({}), undefined);
+}
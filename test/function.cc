@@ -8,6 +8,20 @@ namespace {
 
 int testData = 1;
 
+// Empty and trivial, so `Function::New()` has nothing to store for them.
+struct StatelessFunctor {
+  Value operator()(const CallbackInfo& info) const {
+    return Boolean::New(info.Env(), info.Data() == &testData);
+  }
+};
+
+struct StatelessVoidFunctor {
+  void operator()(const CallbackInfo& info) const {
+    info[0].As<Object>()["data"] =
+        Boolean::New(info.Env(), info.Data() == &testData);
+  }
+};
+
 Boolean EmptyConstructor(const CallbackInfo& info) {
   auto env = info.Env();
   bool isEmpty = info[0].As<Boolean>();
@@ -129,6 +143,24 @@ Value CallWithReceiverAndVectorUsingCppWrapper(const CallbackInfo& info) {
   return MaybeUnwrap(func.Call(receiver, args));
 }
 
+Value CallWithReceiverAndVariadicArgs(const CallbackInfo& info) {
+  Function func = info[0].As<Function>();
+  Value receiver = info[1];
+  return MaybeUnwrap(func.Call(receiver, info[2], info[3], info[4]));
+}
+
+Value CallWithConvertedArgs(const CallbackInfo& info) {
+  Function func = info[0].As<Function>();
+  Value receiver = info[1];
+  return MaybeUnwrap(func.Call(
+      receiver, 1, "two", true, std::vector<std::string>{"four"}, info[2]));
+}
+
+Value CallWithReceiverOnly(const CallbackInfo& info) {
+  Function func = info[0].As<Function>();
+  return MaybeUnwrap(func.Call(info[1]));
+}
+
 Value CallWithInvalidReceiver(const CallbackInfo& info) {
   Function func = info[0].As<Function>();
   return MaybeUnwrapOr(func.Call(Value(), std::initializer_list<napi_value>{}),
@@ -214,6 +246,16 @@ void MakeCallbackWithCStyleArray(const CallbackInfo& info) {
   callback.MakeCallback(resource, args.size(), args.data(), context);
 }
 
+void MakeCallbackWithVariadicArgs(const CallbackInfo& info) {
+  Env env = info.Env();
+  Function callback = info[0].As<Function>();
+  Object resource = info[1].As<Object>();
+
+  AsyncContext context(env, "function_test_context", resource);
+
+  callback.MakeCallback(resource, context, info[2], info[3], info[4]);
+}
+
 void MakeCallbackWithInvalidReceiver(const CallbackInfo& info) {
   Function callback = info[0].As<Function>();
   callback.MakeCallback(Value(), std::initializer_list<napi_value>{});
@@ -252,6 +294,10 @@ Object InitFunction(Env env) {
       Function::New(env, CallWithReceiverAndVector);
   exports["callWithReceiverAndVectorUsingCppWrapper"] =
       Function::New(env, CallWithReceiverAndVectorUsingCppWrapper);
+  exports["callWithReceiverAndVariadicArgs"] =
+      Function::New(env, CallWithReceiverAndVariadicArgs);
+  exports["callWithConvertedArgs"] = Function::New(env, CallWithConvertedArgs);
+  exports["callWithReceiverOnly"] = Function::New(env, CallWithReceiverOnly);
   exports["callWithInvalidReceiver"] =
       Function::New(env, CallWithInvalidReceiver);
   exports["callConstructorWithArgs"] =
@@ -266,6 +312,8 @@ Object InitFunction(Env env) {
       Function::New(env, MakeCallbackWithVector);
   exports["makeCallbackWithCStyleArray"] =
       Function::New(env, MakeCallbackWithCStyleArray);
+  exports["makeCallbackWithVariadicArgs"] =
+      Function::New(env, MakeCallbackWithVariadicArgs);
   exports["makeCallbackWithInvalidReceiver"] =
       Function::New(env, MakeCallbackWithInvalidReceiver);
   exports["callWithFunctionOperator"] =
@@ -296,6 +344,10 @@ Object InitFunction(Env env) {
       Function::New<CallWithReceiverAndVector>(env);
   exports["callWithReceiverAndVectorUsingCppWrapper"] =
       Function::New<CallWithReceiverAndVectorUsingCppWrapper>(env);
+  exports["callWithReceiverAndVariadicArgs"] =
+      Function::New<CallWithReceiverAndVariadicArgs>(env);
+  exports["callWithConvertedArgs"] = Function::New<CallWithConvertedArgs>(env);
+  exports["callWithReceiverOnly"] = Function::New<CallWithReceiverOnly>(env);
   exports["callWithInvalidReceiver"] =
       Function::New<CallWithInvalidReceiver>(env);
   exports["callConstructorWithArgs"] =
@@ -310,6 +362,8 @@ Object InitFunction(Env env) {
       Function::New<MakeCallbackWithVector>(env);
   exports["makeCallbackWithCStyleArray"] =
       Function::New<MakeCallbackWithCStyleArray>(env);
+  exports["makeCallbackWithVariadicArgs"] =
+      Function::New<MakeCallbackWithVariadicArgs>(env);
   exports["makeCallbackWithInvalidReceiver"] =
       Function::New<MakeCallbackWithInvalidReceiver>(env);
   exports["callWithFunctionOperator"] =
@@ -332,6 +386,25 @@ Object InitFunction(Env env) {
         auto env = info.Env();
         return Boolean::New(env, *data == 42);
       });
+  exports["lambdaWithNoCaptureAndData"] = Function::New(
+      env,
+      [](const CallbackInfo& info) {
+        return Boolean::New(info.Env(), info.Data() == &testData);
+      },
+      "lambdaWithNoCaptureAndData",
+      &testData);
+  exports["lambdaWithNoCaptureHasNoData"] =
+      Function::New(env, [](const CallbackInfo& info) {
+        return Boolean::New(info.Env(), info.Data() == nullptr);
+      });
+  exports["voidLambdaWithNoCapture"] =
+      Function::New(env, [](const CallbackInfo& info) {
+        info[0].As<Object>()["foo"] = String::New(info.Env(), "bar");
+      });
+  exports["statelessFunctor"] =
+      Function::New(env, StatelessFunctor(), "statelessFunctor", &testData);
+  exports["statelessVoidFunctor"] = Function::New(
+      env, StatelessVoidFunctor(), "statelessVoidFunctor", &testData);
   result["lambda"] = exports;
 
   return result;
@@ -68,6 +68,21 @@ function test (binding) {
   assert.deepStrictEqual(receiver, obj);
   assert.deepStrictEqual(args, [4, 5, 6]);
 
+  ret = 8;
+  assert.strictEqual(binding.callWithReceiverAndVariadicArgs(testFunction, obj, 5, 6, 7), 8);
+  assert.deepStrictEqual(receiver, obj);
+  assert.deepStrictEqual(args, [5, 6, 7]);
+
+  ret = 9;
+  assert.strictEqual(binding.callWithConvertedArgs(testFunction, obj, 5), 9);
+  assert.deepStrictEqual(receiver, obj);
+  assert.deepStrictEqual(args, [1, 'two', true, ['four'], 5]);
+
+  ret = 10;
+  assert.strictEqual(binding.callWithReceiverOnly(testFunction, obj), 10);
+  assert.deepStrictEqual(receiver, obj);
+  assert.deepStrictEqual(args, []);
+
   ret = 7;
   assert.strictEqual(binding.callWithReceiverAndVectorUsingCppWrapper(testFunction, obj, 4, 5, 6), 7);
   assert.deepStrictEqual(receiver, obj);
@@ -125,6 +140,7 @@ function test (binding) {
   binding.makeCallbackWithArgs(makeCallbackTestFunction(obj, '1', '2', '3'), obj, '1', '2', '3');
   binding.makeCallbackWithVector(makeCallbackTestFunction(obj, 4, 5, 6), obj, 4, 5, 6);
   binding.makeCallbackWithCStyleArray(makeCallbackTestFunction(obj, 7, 8, 9), obj, 7, 8, 9);
+  binding.makeCallbackWithVariadicArgs(makeCallbackTestFunction(obj, 10, 11, 12), obj, 10, 11, 12);
   assert.throws(() => {
     binding.makeCallbackWithInvalidReceiver(() => {});
   });
@@ -134,4 +150,15 @@ function testLambda (binding) {
   assert.ok(binding.lambdaWithNoCapture());
   assert.ok(binding.lambdaWithCapture());
   assert.ok(binding.lambdaWithMoveOnlyCapture());
+  assert.ok(binding.lambdaWithNoCaptureAndData());
+  assert.ok(binding.lambdaWithNoCaptureHasNoData());
+
+  const obj = {};
+  binding.voidLambdaWithNoCapture(obj);
+  assert.strictEqual(obj.foo, 'bar');
+
+  assert.strictEqual(binding.statelessFunctor.name, 'statelessFunctor');
+  assert.ok(binding.statelessFunctor());
+  binding.statelessVoidFunctor(obj);
+  assert.strictEqual(obj.data, true);
 }
@@ -94,6 +94,14 @@ Value CallWithRecvArgc(const CallbackInfo& info) {
   return MaybeUnwrap(ref.Call(info[1], argLength, args.get()));
 }
 
+Value CallWithRecvVariadic(const CallbackInfo& info) {
+  HandleScope scope(info.Env());
+  FunctionReference ref;
+  ref.Reset(info[0].As<Function>());
+
+  return MaybeUnwrap(ref.Call(info[1], info[2], info[3], info[4]));
+}
+
 Value MakeAsyncCallbackWithInitList(const Napi::CallbackInfo& info) {
   Napi::FunctionReference ref;
   ref.Reset(info[0].As<Function>());
@@ -136,6 +144,15 @@ Value MakeAsyncCallbackWithArgv(const Napi::CallbackInfo& info) {
                                       context));
 }
 
+Value MakeAsyncCallbackWithVariadicArgs(const Napi::CallbackInfo& info) {
+  Napi::FunctionReference ref;
+  ref.Reset(info[0].As<Function>());
+
+  Napi::AsyncContext context(info.Env(), "func_ref_resources", {});
+  return MaybeUnwrap(ref.MakeCallback(
+      Napi::Object::New(info.Env()), context, info[1], info[2], 5, 6.0));
+}
+
 Value CreateFunctionReferenceUsingNew(const Napi::CallbackInfo& info) {
   Napi::Function func = ObjectWrap<FuncRefObject>::DefineClass(
       info.Env(),
@@ -177,6 +194,79 @@ Value Construct(const CallbackInfo& info) {
 
   return MaybeUnwrapOr(ref.New({}), Object());
 }
+Value CallNoScopeWithRecvArgc(const CallbackInfo& info) {
+  HandleScope scope(info.Env());
+  FunctionReference ref;
+  ref.Reset(info[0].As<Function>());
+
+  napi_value args[] = {info[2], info[3]};
+  return MaybeUnwrap(ref.CallNoScope(info[1], 2, args));
+}
+
+Value CallNoScopeWithRecvVariadic(const CallbackInfo& info) {
+  HandleScope scope(info.Env());
+  FunctionReference ref;
+  ref.Reset(info[0].As<Function>());
+
+  return MaybeUnwrap(ref.CallNoScope(info[1], info[2], 5, "x"));
+}
+
+// Calls the function many times from a single caller-owned scope.
+Value CallNoScopeRepeatedly(const CallbackInfo& info) {
+  HandleScope scope(info.Env());
+  FunctionReference ref = Persistent(info[0].As<Function>());
+  uint32_t count = info[1].As<Number>().Uint32Value();
+
+  double sum = 0;
+  for (uint32_t index = 0; index < count; index++) {
+    HandleScope iterationScope(info.Env());
+    Value result;
+    if (!MaybeUnwrapTo(ref.CallNoScope(info.Env().Undefined(),
+                                       {Number::New(info.Env(), index)}),
+                       &result) ||
+        result.IsEmpty()) {
+      return Value();
+    }
+    sum += result.As<Number>().DoubleValue();
+  }
+  return Number::New(info.Env(), sum);
+}
+
+Value MakeCallbackNoScope(const CallbackInfo& info) {
+  FunctionReference ref;
+  ref.Reset(info[0].As<Function>());
+
+  napi_value args[] = {info[1]};
+  AsyncContext context(info.Env(), "func_ref_resources", {});
+  return MaybeUnwrap(
+      ref.MakeCallbackNoScope(Object::New(info.Env()), 1, args, context));
+}
+
+// Reports whether a call that throws yields an empty result.
+Value CallThrowingReturnsEmpty(const CallbackInfo& info) {
+  Env env = info.Env();
+  FunctionReference ref;
+  ref.Reset(info[0].As<Function>());
+
+  bool empty;
+#ifdef NAPI_CPP_EXCEPTIONS
+  try {
+    ref.Call({});
+    empty = false;
+  } catch (const Error&) {
+    empty = true;
+  }
+#else
+  MaybeOrValue<Value> result = ref.Call({});
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  empty = result.IsNothing();
+#else
+  empty = result.IsEmpty();
+#endif
+  env.GetAndClearPendingException();
+#endif
+  return Boolean::New(env, empty);
+}
 }  // namespace
 
 Object InitFunctionReference(Env env) {
@@ -188,6 +278,7 @@ Object InitFunctionReference(Env env) {
   exports["CallWithRecvArgc"] = Function::New(env, CallWithRecvArgc);
   exports["CallWithRecvVector"] = Function::New(env, CallWithRecvVector);
   exports["CallWithRecvInitList"] = Function::New(env, CallWithRecvInitList);
+  exports["CallWithRecvVariadic"] = Function::New(env, CallWithRecvVariadic);
   exports["CallWithInitList"] = Function::New(env, CallWithInitList);
   exports["CallWithVec"] = Function::New(env, CallWithVectorArgs);
   exports["ConstructWithMove"] =
@@ -197,6 +288,16 @@ Object InitFunctionReference(Env env) {
   exports["AsyncCallWithVector"] =
       Function::New(env, MakeAsyncCallbackWithVector);
   exports["AsyncCallWithArgv"] = Function::New(env, MakeAsyncCallbackWithArgv);
+  exports["AsyncCallWithVariadicArgs"] =
+      Function::New(env, MakeAsyncCallbackWithVariadicArgs);
+  exports["CallNoScopeWithRecvArgc"] =
+      Function::New(env, CallNoScopeWithRecvArgc);
+  exports["CallNoScopeWithRecvVariadic"] =
+      Function::New(env, CallNoScopeWithRecvVariadic);
+  exports["CallNoScopeRepeatedly"] = Function::New(env, CallNoScopeRepeatedly);
+  exports["MakeCallbackNoScope"] = Function::New(env, MakeCallbackNoScope);
+  exports["CallThrowingReturnsEmpty"] =
+      Function::New(env, CallThrowingReturnsEmpty);
   exports["call"] = Function::New(env, Call);
   exports["construct"] = Function::New(env, Construct);
 
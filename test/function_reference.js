@@ -82,6 +82,10 @@ function canCallFunctionWithDifferentOverloads (binding) {
   outsideRef = {};
   binding.CallWithRecvArgc(testFuncD, outsideRef, 2, 4, 5, 6);
   assert(outsideRef.result === testFuncD(2, 4, 5, 6));
+
+  outsideRef = {};
+  binding.CallWithRecvVariadic(testFuncC, outsideRef, 3, 5, 7);
+  assert(outsideRef.a === 3 && outsideRef.b === 5 && outsideRef.c === 7);
 }
 
 async function canCallAsyncFunctionWithDifferentOverloads (binding) {
@@ -126,7 +130,32 @@ async function canCallAsyncFunctionWithDifferentOverloads (binding) {
   assert(
     binding.AsyncCallWithArgv(testFuncB, 2, 4, 5, 6) === testFuncB(2, 4, 5, 6)
   );
+
+  assert(
+    binding.AsyncCallWithVariadicArgs(testFuncB, 2, 4) === testFuncB(2, 4, 5, 6)
+  );
 }
+function canCallFunctionWithoutScope (binding) {
+  const receiver = {};
+  function testFunc (a, b, c) {
+    assert.strictEqual(this, receiver);
+    return [a, b, c];
+  }
+
+  assert.deepStrictEqual(
+    binding.CallNoScopeWithRecvArgc(testFunc, receiver, 1, 'two'),
+    [1, 'two', undefined]);
+  assert.deepStrictEqual(
+    binding.CallNoScopeWithRecvVariadic(testFunc, receiver, true),
+    [true, 5, 'x']);
+  assert.strictEqual(binding.CallNoScopeRepeatedly((i) => i * 2, 1000),
+    999 * 1000);
+  assert.strictEqual(binding.MakeCallbackNoScope((a) => a + 1, 41), 42);
+  assert.throws(() => {
+    binding.CallNoScopeRepeatedly(() => { throw new Error('foobar'); }, 10);
+  }, /foobar/);
+}
+
 async function test (binding) {
   const e = new Error('foobar');
   const functionMayThrow = () => {
@@ -151,7 +180,10 @@ async function test (binding) {
     binding.construct(classMayThrow);
   }, /foobar/);
 
+  assert.strictEqual(binding.CallThrowingReturnsEmpty(functionMayThrow), true);
+
   canConstructRefFromExistingRef(binding);
+  canCallFunctionWithoutScope(binding);
   canCallFunctionWithDifferentOverloads(binding);
   await canCallAsyncFunctionWithDifferentOverloads(binding);
 }
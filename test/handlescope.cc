@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <vector>
 #include "napi.h"
 #include "string.h"
 
@@ -70,6 +71,71 @@ Value doubleEscapeFromScope(const CallbackInfo& info) {
   return result;
 }
 
+Value stressScopedLoop(const CallbackInfo& info) {
+  Value result;
+  ScopedLoop loop(info.Env(), 64);
+  for (int i = 0; i < LOOP_MAX; i++, loop.Next()) {
+    char buffer[128];
+    snprintf(buffer, 128, "%d", i);
+    std::string name = std::string("inner-scope") + std::string(buffer);
+    Value newValue = String::New(info.Env(), name.c_str());
+    if (i == (LOOP_MAX - 1)) {
+      result = loop.Escape(newValue);
+    }
+  }
+  return result;
+}
+
+Value escapeFromScopedLoop(const CallbackInfo& info) {
+  std::vector<int> numbers;
+  for (int i = 0; i < 1000; i++) {
+    numbers.push_back(i);
+  }
+
+  // Escaped values must outlive the scopes that were open when they were
+  // created.
+  std::vector<Value> escaped;
+  ForEachScoped(
+      info.Env(),
+      numbers,
+      [&](int number, ScopedLoop& loop) {
+        Value value = Number::New(loop.Env(), number);
+        if (number % 100 == 0) {
+          escaped.push_back(loop.Escape(value));
+        }
+      },
+      16);
+
+  Array result = Array::New(info.Env(), escaped.size());
+  for (size_t i = 0; i < escaped.size(); i++) {
+    result[i] = escaped[i];
+  }
+  return result;
+}
+
+Value stopForEachScoped(const CallbackInfo& info) {
+  uint32_t stopAt = info[0].As<Number>().Uint32Value();
+  std::vector<uint32_t> numbers(100);
+  uint32_t visited = 0;
+  ForEachScoped(
+      info.Env(),
+      numbers,
+      [&](uint32_t) {
+        String::New(info.Env(), "inner-scope");
+        return ++visited < stopAt;
+      },
+      8);
+  return Number::New(info.Env(), visited);
+}
+
+Value doubleEscapeFromScopedLoop(const CallbackInfo& info) {
+  Value result;
+  ScopedLoop loop(info.Env());
+  result = loop.Escape(String::New(info.Env(), "inner-scope"));
+  result = loop.Escape(String::New(info.Env(), "inner-scope"));
+  return result;
+}
+
 Object InitHandleScope(Env env) {
   Object exports = Object::New(env);
 
@@ -81,6 +147,11 @@ Object InitHandleScope(Env env) {
       Function::New(env, escapeFromExistingScope);
   exports["stressEscapeFromScope"] = Function::New(env, stressEscapeFromScope);
   exports["doubleEscapeFromScope"] = Function::New(env, doubleEscapeFromScope);
+  exports["stressScopedLoop"] = Function::New(env, stressScopedLoop);
+  exports["escapeFromScopedLoop"] = Function::New(env, escapeFromScopedLoop);
+  exports["stopForEachScoped"] = Function::New(env, stopForEachScoped);
+  exports["doubleEscapeFromScopedLoop"] =
+      Function::New(env, doubleEscapeFromScopedLoop);
 
   return exports;
 }
@@ -13,4 +13,12 @@ function test (binding) {
   assert.throws(() => binding.handlescope.doubleEscapeFromScope(),
     Error,
     ' napi_escape_handle already called on scope');
+  assert.strictEqual(binding.handlescope.stressScopedLoop(), 'inner-scope999999');
+  assert.deepStrictEqual(binding.handlescope.escapeFromScopedLoop(),
+    [0, 100, 200, 300, 400, 500, 600, 700, 800, 900]);
+  assert.strictEqual(binding.handlescope.stopForEachScoped(10), 10);
+  assert.strictEqual(binding.handlescope.stopForEachScoped(1000), 100);
+  assert.throws(() => binding.handlescope.doubleEscapeFromScopedLoop(),
+    Error,
+    ' napi_escape_handle already called on scope');
 }
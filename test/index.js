@@ -101,7 +101,10 @@ console.log('napiVersion:' + napiVersion);
 
 if (napiVersion < 3) {
   testModules.splice(testModules.indexOf('env_cleanup'), 1);
+  testModules.splice(testModules.indexOf('builtins'), 1);
   testModules.splice(testModules.indexOf('callbackscope'), 1);
+  testModules.splice(testModules.indexOf('map_set'), 1);
+  testModules.splice(testModules.indexOf('objectwrap_transfer'), 1);
   testModules.splice(testModules.indexOf('version_management'), 1);
 }
 
@@ -124,6 +127,7 @@ if (napiVersion < 6 && !filterConditionsProvided) {
   testModules.splice(testModules.indexOf('addon'), 1);
   testModules.splice(testModules.indexOf('addon_data'), 1);
   testModules.splice(testModules.indexOf('bigint'), 1);
+  testModules.splice(testModules.indexOf('serializer'), 1);
   testModules.splice(testModules.indexOf('typedarray-bigint'), 1);
 }
 
@@ -134,6 +138,7 @@ if (majorNodeVersion < 12 && !filterConditionsProvided) {
 
 if (napiVersion < 8 && !filterConditionsProvided) {
   testModules.splice(testModules.indexOf('object/object_freeze_seal'), 1);
+  testModules.splice(testModules.indexOf('external_type_tags'), 1);
   testModules.splice(testModules.indexOf('type_taggable'), 1);
 }
 
@@ -0,0 +1,72 @@
+#include "napi.h"
+
+using namespace Napi;
+
+namespace {
+
+uint32_t valueCalls = 0;
+uint32_t throwingCalls = 0;
+uint32_t staticCalls = 0;
+
+Value CreateValue(Env env) {
+  ++valueCalls;
+  Object value = Object::New(env);
+  value["answer"] = Number::New(env, 42);
+  return value;
+}
+
+// Fails on the first access and succeeds afterwards.
+Value CreateAfterFailure(Env env) {
+  if (++throwingCalls == 1) {
+    NAPI_THROW(Error::New(env, "not yet"), Value());
+  }
+  return String::New(env, "ok");
+}
+
+Value CreateStaticValue(Env env) {
+  ++staticCalls;
+  return String::New(env, "static");
+}
+
+const LazyExports::Entry kStaticEntries[] = {
+    {"first", CreateStaticValue},
+    {"second", CreateStaticValue},
+};
+
+// Defines a lazy export whose name is not a string literal.
+Value MakeTemporary(const CallbackInfo& info) {
+  std::string name = "temporary";
+  return LazyExports::Define(
+      info.Env(),
+      Object::New(info.Env()),
+      {{name.c_str(), [](Env env) -> Value { return Number::New(env, 7); }}});
+}
+
+Value GetCallCounts(const CallbackInfo& info) {
+  Object counts = Object::New(info.Env());
+  counts["value"] = Number::New(info.Env(), valueCalls);
+  counts["throwing"] = Number::New(info.Env(), throwingCalls);
+  counts["static"] = Number::New(info.Env(), staticCalls);
+  return counts;
+}
+
+}  // end anonymous namespace
+
+Object InitLazyExports(Env env) {
+  std::string dynamicName = "dynamic";
+  Object exports = LazyExports::Define(
+      env,
+      Object::New(env),
+      {
+          {"value", CreateValue},
+          {"throwing", CreateAfterFailure},
+          {"assigned", CreateValue},
+          {dynamicName.c_str(),
+           [](Env env) -> Value { return Function::New(env, GetCallCounts); }},
+      });
+  exports["static"] =
+      LazyExports::Define(env, Object::New(env), kStaticEntries, 2);
+  exports["getCallCounts"] = Function::New(env, GetCallCounts);
+  exports["makeTemporary"] = Function::New(env, MakeTemporary);
+  return exports;
+}
@@ -0,0 +1,62 @@
+'use strict';
+
+const assert = require('assert');
+
+module.exports = require('./common').runTest(test);
+
+function isAccessor (object, name) {
+  const descriptor = Object.getOwnPropertyDescriptor(object, name);
+  return typeof descriptor.get === 'function';
+}
+
+async function test (binding) {
+  const lazy = binding.lazy_exports;
+  assert.deepStrictEqual(Object.keys(lazy),
+    ['value', 'throwing', 'assigned', 'dynamic', 'static', 'getCallCounts',
+      'makeTemporary']);
+  assert.deepStrictEqual(lazy.getCallCounts(),
+    { value: 0, throwing: 0, static: 0 });
+
+  // The first access creates the value and replaces the accessor.
+  assert.ok(isAccessor(lazy, 'value'));
+  const value = lazy.value;
+  assert.deepStrictEqual(value, { answer: 42 });
+  assert.deepStrictEqual(Object.getOwnPropertyDescriptor(lazy, 'value'), {
+    value, writable: true, enumerable: true, configurable: true
+  });
+  assert.strictEqual(lazy.value, value);
+  assert.strictEqual(lazy.getCallCounts().value, 1);
+
+  // A failed definition keeps the accessor so that it is retried.
+  assert.throws(() => lazy.throwing, { message: 'not yet' });
+  assert.ok(isAccessor(lazy, 'throwing'));
+  assert.strictEqual(lazy.throwing, 'ok');
+  assert.strictEqual(lazy.throwing, 'ok');
+  assert.strictEqual(lazy.getCallCounts().throwing, 2);
+
+  // Assigning first replaces the accessor without creating the value.
+  lazy.assigned = 'replaced';
+  assert.strictEqual(lazy.assigned, 'replaced');
+  assert.strictEqual(lazy.getCallCounts().value, 1);
+
+  // Names passed in the initializer list are copied.
+  assert.strictEqual(typeof lazy.dynamic, 'function');
+
+  // Entries kept in a static array are used in place.
+  const { first, second } = lazy.static;
+  assert.strictEqual(first, 'static');
+  assert.strictEqual(second, 'static');
+  assert.strictEqual(lazy.getCallCounts().static, 2);
+
+  // Accessors taken out of the exports keep working after the exports are
+  // collected.
+  const { get } =
+    Object.getOwnPropertyDescriptor(lazy.makeTemporary(), 'temporary');
+  for (let i = 0; i < 10; i++) {
+    global.gc();
+    await new Promise((resolve) => setImmediate(resolve));
+  }
+  const receiver = {};
+  assert.strictEqual(get.call(receiver), 7);
+  assert.deepStrictEqual(receiver, { temporary: 7 });
+}
@@ -0,0 +1,194 @@
+#include "napi.h"
+#include "test_helper.h"
+
+using namespace Napi;
+
+#if (NAPI_VERSION > 2)
+namespace {
+
+Value NewMap(const CallbackInfo& info) {
+  return Map::New(info.Env());
+}
+
+Value MapSetAndGet(const CallbackInfo& info) {
+  Map map = info[0].As<Map>();
+  bool set = MaybeUnwrapOr(map.Set(info[1], info[2]), false);
+  if (!set) {
+    return Value();
+  }
+  return MaybeUnwrapOr(map.Get(info[1]), Value());
+}
+
+Value MapHas(const CallbackInfo& info) {
+  Map map = info[0].As<Map>();
+  return Boolean::New(info.Env(), MaybeUnwrapOr(map.Has(info[1]), false));
+}
+
+Value MapSetConverted(const CallbackInfo& info) {
+  Map map = info[0].As<Map>();
+  map.Set("one", 1);
+  map.Set(2, "two");
+  map.Set(std::string("three"), std::vector<std::string>{"3"});
+  return Boolean::New(info.Env(),
+                      MaybeUnwrapOr(map.Has("one"), false) &&
+                          MaybeUnwrapOr(map.Has(2), false) &&
+                          !MaybeUnwrapOr(map.Has("2"), true));
+}
+
+Value NewSet(const CallbackInfo& info) {
+  return Set::New(info.Env());
+}
+
+Value SetAdd(const CallbackInfo& info) {
+  Set set = info[0].As<Set>();
+  return Boolean::New(info.Env(), MaybeUnwrapOr(set.Add(info[1]), false));
+}
+
+Value SetHas(const CallbackInfo& info) {
+  Set set = info[0].As<Set>();
+  return Boolean::New(info.Env(), MaybeUnwrapOr(set.Has(info[1]), false));
+}
+
+Value SetAddConverted(const CallbackInfo& info) {
+  Set set = info[0].As<Set>();
+  set.Add("one");
+  set.Add(2);
+  return Boolean::New(info.Env(),
+                      MaybeUnwrapOr(set.Has("one"), false) &&
+                          MaybeUnwrapOr(set.Has(2), false));
+}
+
+Value MapDelete(const CallbackInfo& info) {
+  Map map = info[0].As<Map>();
+  return Boolean::New(info.Env(), MaybeUnwrapOr(map.Delete(info[1]), false));
+}
+
+Value MapSize(const CallbackInfo& info) {
+  return Number::New(info.Env(), info[0].As<Map>().Size());
+}
+
+Value MapFromRange(const CallbackInfo& info) {
+  std::vector<std::pair<std::string, double>> entries = {
+      {"b", 2}, {"a", 1}, {"c", 3}};
+  return Map::FromRange(info.Env(), entries);
+}
+
+// A null C string cannot be converted to a `String`, so both ranges below stop
+// with the error thrown by the conversion.
+Value MapFromUnconvertibleRange(const CallbackInfo& info) {
+  std::vector<std::pair<const char*, double>> entries = {{"a", 1},
+                                                         {nullptr, 2}};
+  return Map::FromRange(info.Env(), entries);
+}
+
+Value SetFromUnconvertibleRange(const CallbackInfo& info) {
+  std::vector<const char*> values = {"a", nullptr};
+  return Set::FromRange(info.Env(), values);
+}
+
+Value MapForEach(const CallbackInfo& info) {
+  Env env = info.Env();
+  Map map = info[0].As<Map>();
+  uint32_t limit = info[1].As<Number>().Uint32Value();
+  Array visited = Array::New(env);
+  uint32_t index = 0;
+  auto callback = [&](Value key, Value value) {
+    if (index == limit) {
+      return false;
+    }
+    Array entry = Array::New(env, 2);
+    entry.Set(0u, key);
+    entry.Set(1u, value);
+    visited.Set(index++, entry);
+    return true;
+  };
+  Object result = Object::New(env);
+  result["completed"] = MaybeUnwrapOr(map.ForEach(callback), false);
+  result["visited"] = visited;
+  return result;
+}
+
+Value MapToUnorderedMap(const CallbackInfo& info) {
+  Map map = info[0].As<Map>();
+  std::unordered_map<std::string, double> entries;
+  if (!MaybeUnwrapTo(map.ToUnorderedMap<std::string, double>(), &entries)) {
+    return Value();
+  }
+  double sum = 0;
+  for (const auto& entry : entries) {
+    sum += entry.second * entry.first.size();
+  }
+  return Number::New(info.Env(), sum);
+}
+
+Value SetDelete(const CallbackInfo& info) {
+  Set set = info[0].As<Set>();
+  return Boolean::New(info.Env(), MaybeUnwrapOr(set.Delete(info[1]), false));
+}
+
+Value SetSize(const CallbackInfo& info) {
+  return Number::New(info.Env(), info[0].As<Set>().Size());
+}
+
+Value SetFromRange(const CallbackInfo& info) {
+  std::vector<std::string> values = {"b", "a", "b", "c"};
+  return Set::FromRange(info.Env(), values.begin(), values.end());
+}
+
+Value SetForEach(const CallbackInfo& info) {
+  Env env = info.Env();
+  Set set = info[0].As<Set>();
+  Array visited = Array::New(env);
+  uint32_t index = 0;
+  auto callback = [&](Value value) {
+    visited.Set(index++, value);
+    return true;
+  };
+  if (!MaybeUnwrapOr(set.ForEach(callback), false)) {
+    return Value();
+  }
+  return visited;
+}
+
+Value SetToVector(const CallbackInfo& info) {
+  Set set = info[0].As<Set>();
+  std::vector<double> values;
+  if (!MaybeUnwrapTo(set.ToVector<double>(), &values)) {
+    return Value();
+  }
+  double sum = 0;
+  for (double value : values) {
+    sum += value;
+  }
+  return Number::New(info.Env(), sum);
+}
+
+}  // end anonymous namespace
+
+Object InitMapSet(Env env) {
+  Object exports = Object::New(env);
+  exports["newMap"] = Function::New(env, NewMap);
+  exports["mapSetAndGet"] = Function::New(env, MapSetAndGet);
+  exports["mapHas"] = Function::New(env, MapHas);
+  exports["mapSetConverted"] = Function::New(env, MapSetConverted);
+  exports["newSet"] = Function::New(env, NewSet);
+  exports["setAdd"] = Function::New(env, SetAdd);
+  exports["setHas"] = Function::New(env, SetHas);
+  exports["setAddConverted"] = Function::New(env, SetAddConverted);
+  exports["mapDelete"] = Function::New(env, MapDelete);
+  exports["mapSize"] = Function::New(env, MapSize);
+  exports["mapFromRange"] = Function::New(env, MapFromRange);
+  exports["mapFromUnconvertibleRange"] =
+      Function::New(env, MapFromUnconvertibleRange);
+  exports["mapForEach"] = Function::New(env, MapForEach);
+  exports["mapToUnorderedMap"] = Function::New(env, MapToUnorderedMap);
+  exports["setDelete"] = Function::New(env, SetDelete);
+  exports["setSize"] = Function::New(env, SetSize);
+  exports["setFromRange"] = Function::New(env, SetFromRange);
+  exports["setFromUnconvertibleRange"] =
+      Function::New(env, SetFromUnconvertibleRange);
+  exports["setForEach"] = Function::New(env, SetForEach);
+  exports["setToVector"] = Function::New(env, SetToVector);
+  return exports;
+}
+#endif
@@ -0,0 +1,106 @@
+'use strict';
+
+const assert = require('assert');
+
+module.exports = require('./common').runTest(test);
+
+function test (binding) {
+  const {
+    newMap,
+    mapSetAndGet,
+    mapHas,
+    mapSetConverted,
+    newSet,
+    setAdd,
+    setHas,
+    setAddConverted,
+    mapDelete,
+    mapSize,
+    mapFromRange,
+    mapFromUnconvertibleRange,
+    mapForEach,
+    mapToUnorderedMap,
+    setDelete,
+    setSize,
+    setFromRange,
+    setFromUnconvertibleRange,
+    setForEach,
+    setToVector
+  } = binding.map_set;
+
+  const map = newMap();
+  assert(map instanceof Map);
+  assert.strictEqual(map.size, 0);
+
+  const key = {};
+  assert.strictEqual(mapSetAndGet(map, key, 'value'), 'value');
+  assert.strictEqual(map.get(key), 'value');
+  assert.strictEqual(mapSetAndGet(map, 1, 'one'), 'one');
+  assert.strictEqual(mapHas(map, key), true);
+  assert.strictEqual(mapHas(map, 1), true);
+  assert.strictEqual(mapHas(map, '1'), false);
+  assert.strictEqual(mapHas(map, {}), false);
+  assert.strictEqual(mapSetAndGet(map, '__proto__', 'safe'), 'safe');
+  assert.strictEqual(Object.getPrototypeOf(map), Map.prototype);
+
+  const converted = new Map();
+  assert.strictEqual(mapSetConverted(converted), true);
+  assert.deepStrictEqual(converted, new Map([['one', 1], [2, 'two'], ['three', ['3']]]));
+
+  const set = newSet();
+  assert(set instanceof Set);
+  assert.strictEqual(setAdd(set, key), true);
+  assert.strictEqual(setAdd(set, key), true);
+  assert.strictEqual(set.size, 1);
+  assert.strictEqual(setHas(set, key), true);
+  assert.strictEqual(setHas(set, {}), false);
+
+  const convertedSet = new Set();
+  assert.strictEqual(setAddConverted(convertedSet), true);
+  assert.deepStrictEqual(convertedSet, new Set(['one', 2]));
+
+  const sized = new Map([[1, 'a'], [2, 'b']]);
+  assert.strictEqual(mapSize(sized), 2);
+  assert.strictEqual(mapDelete(sized, 1), true);
+  assert.strictEqual(mapDelete(sized, 1), false);
+  assert.strictEqual(mapSize(sized), 1);
+
+  const fromRange = mapFromRange();
+  assert(fromRange instanceof Map);
+  assert.deepStrictEqual([...fromRange], [['b', 2], ['a', 1], ['c', 3]]);
+
+  const iterated = new Map([[key, [1]], ['x', 2], [3, 'y']]);
+  assert.deepStrictEqual(mapForEach(iterated, 10), {
+    completed: true,
+    visited: [[key, [1]], ['x', 2], [3, 'y']]
+  });
+  assert.deepStrictEqual(mapForEach(iterated, 1), {
+    completed: false,
+    visited: [[key, [1]]]
+  });
+  assert.deepStrictEqual(mapForEach(new Map(), 1), { completed: true, visited: [] });
+
+  // 'a' * 1 + 'bb' * 2 + 'ccc' * 3
+  assert.strictEqual(mapToUnorderedMap(new Map([['a', 1], ['bb', 2], ['ccc', 3]])), 14);
+  assert.throws(() => mapToUnorderedMap(new Map([[1, 1]])), {
+    name: 'TypeError',
+    message: 'A string was expected.'
+  });
+
+  const values = new Set([1, 2, 3]);
+  assert.strictEqual(setSize(values), 3);
+  assert.strictEqual(setDelete(values, 2), true);
+  assert.strictEqual(setDelete(values, 2), false);
+  assert.strictEqual(setSize(values), 2);
+  assert.deepStrictEqual(setForEach(values), [1, 3]);
+  assert.strictEqual(setToVector(values), 4);
+  assert.throws(() => setToVector(new Set(['1'])), {
+    name: 'TypeError',
+    message: 'A number was expected.'
+  });
+
+  assert.deepStrictEqual([...setFromRange()], ['b', 'a', 'c']);
+
+  assert.throws(() => mapFromUnconvertibleRange(), { name: 'Error' });
+  assert.throws(() => setFromUnconvertibleRange(), { name: 'Error' });
+}
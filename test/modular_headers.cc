@@ -0,0 +1,57 @@
+#include "napi.h"
+#include "napi-objectwrap.h"
+
+// This file is built with NODE_ADDON_API_MODULAR_HEADERS, so only the core and
+// the subsystems included above are visible, and with
+// NODE_ADDON_API_EXTERN_TEMPLATES, so the typed array and reference
+// specializations it uses are compiled in napi.cc, through
+// modular_instantiations.cc.
+#ifdef SRC_NAPI_ASYNC_H_
+#error "napi.h must not include the other subsystems in modular mode"
+#endif
+
+namespace {
+
+class Counter : public Napi::ObjectWrap<Counter> {
+ public:
+  static Napi::Function Define(Napi::Env env) {
+    return DefineClass(env,
+                       "Counter",
+                       {InstanceMethod<&Counter::Increment>("increment")});
+  }
+
+  Counter(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Counter>(info) {}
+
+ private:
+  Napi::Value Increment(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), ++_count);
+  }
+
+  uint32_t _count = 0;
+};
+
+Napi::Value SumBytes(const Napi::CallbackInfo& info) {
+  Napi::Uint8Array bytes = info[0].As<Napi::Uint8Array>();
+  uint32_t sum = 0;
+  for (size_t index = 0; index < bytes.ElementLength(); index++) {
+    sum += bytes[index];
+  }
+  return Napi::Number::New(info.Env(), sum);
+}
+
+Napi::Value RoundTripReference(const Napi::CallbackInfo& info) {
+  Napi::ObjectReference reference =
+      Napi::Persistent(info[0].As<Napi::Object>());
+  return reference.Value();
+}
+
+}  // namespace
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  exports["Counter"] = Counter::Define(env);
+  exports["sumBytes"] = Napi::Function::New(env, SumBytes);
+  exports["roundTripReference"] = Napi::Function::New(env, RoundTripReference);
+  return exports;
+}
+
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -0,0 +1,21 @@
+'use strict';
+
+const assert = require('assert');
+
+module.exports = require('./common').runTestWithBuildType((buildType) => {
+  test(`./build/${buildType}/binding_modular.node`);
+  test(`./build/${buildType}/binding_modular_noexcept.node`);
+});
+
+function test (bindingPath) {
+  const binding = require(bindingPath);
+
+  const counter = new binding.Counter();
+  assert.strictEqual(counter.increment(), 1);
+  assert.strictEqual(counter.increment(), 2);
+
+  assert.strictEqual(binding.sumBytes(new Uint8Array([1, 2, 3, 250])), 256);
+
+  const obj = {};
+  assert.strictEqual(binding.roundTripReference(obj), obj);
+}
@@ -0,0 +1,4 @@
+// Compiles napi.cc as part of each modular test target. Listing '../napi.cc'
+// directly would make the targets share one object file outside their own
+// build directories, built with whichever target's flags came first.
+#include "../napi.cc"
@@ -48,6 +48,10 @@ Value SubscriptGetAtIndex(const CallbackInfo& info);
 void SubscriptSetWithCStyleString(const CallbackInfo& info);
 void SubscriptSetWithCppStyleString(const CallbackInfo& info);
 void SubscriptSetAtIndex(const CallbackInfo& info);
+Value SubscriptIncrementWithCStyleString(const CallbackInfo& info);
+Value SubscriptIncrementAtIndex(const CallbackInfo& info);
+Value SubscriptIncrementWithNapiValue(const CallbackInfo& info);
+void SubscriptAccumulateWithCppStyleString(const CallbackInfo& info);
 
 static bool testValue = true;
 // Used to test void* Data() integrity
@@ -291,6 +295,76 @@ void DefineValueProperty(const CallbackInfo& info) {
   obj.DefineProperty(PropertyDescriptor::Value(name, value));
 }
 
+// Stateless getter and setter, defined without any callback data.
+struct StatelessGetter {
+  Value operator()(const CallbackInfo& info) const {
+    return Boolean::New(info.Env(), testValue);
+  }
+};
+
+struct StatelessSetter {
+  void operator()(const CallbackInfo& info) const {
+    testValue = info[0].As<Boolean>();
+  }
+};
+
+// Defines properties from every kind of callable: stateless function objects,
+// lambdas without captures, which are stored as function pointers, and lambdas
+// with captures, whose data is freed along with `obj`.
+void DefineCallableProperties(const CallbackInfo& info) {
+  Object obj = info[0].As<Object>();
+  Env env = info.Env();
+
+  static UserDataHolder holder = {42};
+  int32_t captured = 7;
+
+  obj.DefineProperties({
+      PropertyDescriptor::Accessor(
+          env, obj, "statelessAccessor", StatelessGetter(), StatelessSetter()),
+      PropertyDescriptor::Accessor(
+          env,
+          obj,
+          "lambdaAccessor",
+          [](const CallbackInfo& info) -> Value {
+            return Boolean::New(info.Env(), testValue);
+          }),
+      PropertyDescriptor::Accessor(
+          env,
+          obj,
+          "lambdaAccessorWithUserData",
+          [](const CallbackInfo& info) -> Value {
+            return Number::New(
+                info.Env(), static_cast<UserDataHolder*>(info.Data())->value);
+          },
+          napi_default,
+          &holder),
+      PropertyDescriptor::Accessor(
+          env,
+          obj,
+          "capturingAccessor",
+          [captured](const CallbackInfo& info) -> Value {
+            return Number::New(info.Env(), captured);
+          },
+          [captured](const CallbackInfo& info) {
+            testValue = info[0].As<Number>().Int32Value() == captured;
+          }),
+      PropertyDescriptor::Function(
+          env,
+          obj,
+          "lambdaFunction",
+          [](const CallbackInfo& info) -> Value {
+            return Boolean::New(info.Env(), info.Data() == nullptr);
+          }),
+      PropertyDescriptor::Function(
+          env,
+          obj,
+          "capturingFunction",
+          [captured](const CallbackInfo& info) -> Value {
+            return Number::New(info.Env(), captured);
+          }),
+  });
+}
+
 Value CreateObjectUsingMagic(const CallbackInfo& info) {
   Env env = info.Env();
   Object obj = Object::New(env);
@@ -337,6 +411,87 @@ void Increment(const CallbackInfo& info) {
 }
 #endif  // NAPI_CPP_EXCEPTIONS
 
+static Value EntriesToArray(Env env,
+                            const std::vector<Object::Entry>& entries) {
+  Array result = Array::New(env, entries.size());
+  for (uint32_t index = 0; index < entries.size(); index++) {
+    Array pair = Array::New(env, 2);
+    pair[0u] = entries[index].key;
+    pair[1u] = entries[index].value;
+    result[index] = pair;
+  }
+  return result;
+}
+
+static Value SumEntriesWith(const CallbackInfo& info, Object::EntryKeys keys) {
+  int64_t sum = 0;
+  bool completed = false;
+  if (!MaybeUnwrapTo(info[0].As<Object>().ForEachEntry(
+                         [&](const Object::Entry& entry) {
+                           sum += entry.value.As<Number>().Int64Value();
+                         },
+                         keys,
+                         2),
+                     &completed)) {
+    return Value();
+  }
+  return Number::New(info.Env(), static_cast<double>(sum));
+}
+
+Value GetEntries(const CallbackInfo& info) {
+  std::vector<Object::Entry> entries;
+  if (!MaybeUnwrapTo(info[0].As<Object>().GetEntries(), &entries)) {
+    return Value();
+  }
+  return EntriesToArray(info.Env(), entries);
+}
+
+Value SumEntries(const CallbackInfo& info) {
+  return SumEntriesWith(info, Object::EntryKeys::Enumerable);
+}
+
+#if NAPI_VERSION > 5
+Value GetOwnEntries(const CallbackInfo& info) {
+  std::vector<Object::Entry> entries;
+  if (!MaybeUnwrapTo(
+          info[0].As<Object>().GetEntries(Object::EntryKeys::OwnEnumerable),
+          &entries)) {
+    return Value();
+  }
+  return EntriesToArray(info.Env(), entries);
+}
+
+Value SumOwnEntries(const CallbackInfo& info) {
+  return SumEntriesWith(info, Object::EntryKeys::OwnEnumerable);
+}
+#endif  // NAPI_VERSION > 5
+
+// Returns the key of the first entry whose value is strictly equal to info[1],
+// escaping it out of the chunked scopes.
+Value FindEntryKey(const CallbackInfo& info) {
+  Env env = info.Env();
+  Value needle = info[1];
+  Value found = env.Undefined();
+  bool completed = false;
+  if (!MaybeUnwrapTo(info[0].As<Object>().ForEachEntry(
+                         [&](const Object::Entry& entry, ScopedLoop& loop) {
+                           if (!entry.value.StrictEquals(needle)) {
+                             return true;
+                           }
+                           found = loop.Escape(entry.key);
+                           return false;
+                         },
+                         Object::EntryKeys::Enumerable,
+                         2),
+                     &completed)) {
+    return Value();
+  }
+  Object result = Object::New(env);
+  result["key"] = found;
+  result["completed"] = completed;
+  return result;
+}
+
 Value InstanceOf(const CallbackInfo& info) {
   Object obj = info[0].As<Object>();
   Function constructor = info[1].As<Function>();
@@ -352,6 +507,8 @@ Object InitObject(Env env) {
   exports["GetPropertyNames"] = Function::New(env, GetPropertyNames);
   exports["defineProperties"] = Function::New(env, DefineProperties);
   exports["defineValueProperty"] = Function::New(env, DefineValueProperty);
+  exports["defineCallableProperties"] =
+      Function::New(env, DefineCallableProperties);
 
   exports["getPropertyWithUint32"] = Function::New(env, GetPropertyWithUint32);
   exports["getPropertyWithNapiValue"] =
@@ -409,6 +566,13 @@ Object InitObject(Env env) {
   exports["sum"] = Function::New(env, Sum);
   exports["increment"] = Function::New(env, Increment);
 #endif  // NAPI_CPP_EXCEPTIONS
+  exports["getEntries"] = Function::New(env, GetEntries);
+  exports["sumEntries"] = Function::New(env, SumEntries);
+  exports["findEntryKey"] = Function::New(env, FindEntryKey);
+#if NAPI_VERSION > 5
+  exports["getOwnEntries"] = Function::New(env, GetOwnEntries);
+  exports["sumOwnEntries"] = Function::New(env, SumOwnEntries);
+#endif  // NAPI_VERSION > 5
 
   exports["addFinalizer"] = Function::New(env, AddFinalizer);
   exports["addFinalizerWithHint"] = Function::New(env, AddFinalizerWithHint);
@@ -425,6 +589,14 @@ Object InitObject(Env env) {
   exports["subscriptSetWithCppStyleString"] =
       Function::New(env, SubscriptSetWithCppStyleString);
   exports["subscriptSetAtIndex"] = Function::New(env, SubscriptSetAtIndex);
+  exports["subscriptIncrementWithCStyleString"] =
+      Function::New(env, SubscriptIncrementWithCStyleString);
+  exports["subscriptIncrementAtIndex"] =
+      Function::New(env, SubscriptIncrementAtIndex);
+  exports["subscriptIncrementWithNapiValue"] =
+      Function::New(env, SubscriptIncrementWithNapiValue);
+  exports["subscriptAccumulateWithCppStyleString"] =
+      Function::New(env, SubscriptAccumulateWithCppStyleString);
 
   return exports;
 }
@@ -101,6 +101,28 @@ function test (binding) {
   testDefineProperties('string');
   testDefineProperties('value');
 
+  {
+    const obj = {};
+    binding.object.defineCallableProperties(obj);
+
+    obj.statelessAccessor = false;
+    assert.strictEqual(obj.statelessAccessor, false);
+    assert.strictEqual(obj.lambdaAccessor, false);
+    obj.statelessAccessor = true;
+    assert.strictEqual(obj.statelessAccessor, true);
+    assert.strictEqual(obj.lambdaAccessor, true);
+    assert.strictEqual(obj.lambdaAccessorWithUserData, 42);
+
+    assert.strictEqual(obj.capturingAccessor, 7);
+    obj.capturingAccessor = 6;
+    assert.strictEqual(obj.statelessAccessor, false);
+    obj.capturingAccessor = 7;
+    assert.strictEqual(obj.statelessAccessor, true);
+
+    assert.strictEqual(obj.lambdaFunction(), true);
+    assert.strictEqual(obj.capturingFunction(), 7);
+  }
+
   // eslint-disable-next-line no-lone-blocks
   {
     assert.strictEqual(binding.object.emptyConstructor(true), true);
@@ -215,4 +237,51 @@ function test (binding) {
       c: 3
     });
   }
+
+  {
+    const proto = { inherited: 100 };
+    const obj = Object.create(proto);
+    obj.a = 1;
+    obj.b = 2;
+    obj[3] = 3;
+    obj[Symbol('symbol')] = 4;
+    Object.defineProperty(obj, 'hidden', { value: 5, enumerable: false });
+
+    assert.deepStrictEqual(binding.object.getEntries(obj),
+      [['3', 3], ['a', 1], ['b', 2], ['inherited', 100]]);
+    assert.strictEqual(binding.object.sumEntries(obj), 106);
+    assert.deepStrictEqual(binding.object.getEntries({}), []);
+
+    if ('getOwnEntries' in binding.object) {
+      assert.deepStrictEqual(binding.object.getOwnEntries(obj),
+        Object.entries(obj));
+      assert.strictEqual(binding.object.sumOwnEntries(obj), 6);
+    }
+
+    // Enough entries to span several chunks of the scoped walk.
+    const large = {};
+    let sum = 0;
+    for (let i = 0; i < 1000; i++) {
+      large[`key${i}`] = i;
+      sum += i;
+    }
+    assert.strictEqual(binding.object.sumEntries(large), sum);
+    assert.deepStrictEqual(binding.object.findEntryKey(large, 777),
+      { key: 'key777', completed: false });
+    assert.deepStrictEqual(binding.object.findEntryKey(large, -1),
+      { key: undefined, completed: true });
+
+    const throwing = {
+      a: 1,
+      get b () { throw new Error('getter error'); }
+    };
+    assert.throws(() => binding.object.getEntries(throwing), /getter error/);
+    assert.throws(() => binding.object.sumEntries(throwing), /getter error/);
+
+    const proxy = new Proxy({ a: 1 }, {
+      ownKeys () { throw new Error('ownKeys error'); }
+    });
+    assert.throws(() => binding.object.getEntries(proxy), /ownKeys error/);
+    assert.throws(() => binding.object.sumEntries(proxy), /ownKeys error/);
+  }
 }
@@ -59,12 +59,44 @@ void DefineProperties(const CallbackInfo& info) {
   }
 }
 
+struct StatelessGetter {
+  Value operator()(const CallbackInfo& info) const {
+    return Boolean::New(info.Env(), testValue);
+  }
+};
+
+struct StatelessSetter {
+  void operator()(const CallbackInfo& info) const {
+    testValue = info[0].As<Boolean>();
+  }
+};
+
+// Callables that hold no state are defined without allocating anything.
+void DefineCallableProperties(const CallbackInfo& info) {
+  Object obj = info[0].As<Object>();
+
+  obj.DefineProperties({
+      PropertyDescriptor::Accessor(
+          "statelessAccessor", StatelessGetter(), StatelessSetter()),
+      PropertyDescriptor::Accessor("lambdaAccessor",
+                                   [](const CallbackInfo& info) -> Value {
+                                     return Boolean::New(info.Env(), testValue);
+                                   }),
+      PropertyDescriptor::Function(
+          "lambdaFunction", [](const CallbackInfo& info) -> Value {
+            return Boolean::New(info.Env(), info.Data() == nullptr);
+          }),
+  });
+}
+
 }  // end of anonymous namespace
 
 Object InitObjectDeprecated(Env env) {
   Object exports = Object::New(env);
 
   exports["defineProperties"] = Function::New(env, DefineProperties);
+  exports["defineCallableProperties"] =
+      Function::New(env, DefineCallableProperties);
 
   return exports;
 }
@@ -39,4 +39,16 @@ function test (binding) {
   testDefineProperties('literal');
   testDefineProperties('string');
   testDefineProperties('value');
+
+  {
+    const obj = {};
+    binding.object_deprecated.defineCallableProperties(obj);
+
+    obj.statelessAccessor = false;
+    assert.strictEqual(obj.statelessAccessor, false);
+    assert.strictEqual(obj.lambdaAccessor, false);
+    obj.statelessAccessor = true;
+    assert.strictEqual(obj.lambdaAccessor, true);
+    assert.strictEqual(obj.lambdaFunction(), true);
+  }
 }
@@ -56,3 +56,48 @@ void SubscriptSetAtIndex(const CallbackInfo& info) {
   Value value = info[2];
   obj[index] = value;
 }
+
+Value SubscriptIncrementWithCStyleString(const CallbackInfo& info) {
+  Object obj = info[0].As<Object>();
+  String jsKey = info[1].As<String>();
+  double delta = info[2].As<Number>().DoubleValue();
+  double result = 0;
+  if (!MaybeUnwrapTo(obj[jsKey.Utf8Value().c_str()].Increment(delta),
+                     &result)) {
+    return Value();
+  }
+  return Number::New(info.Env(), result);
+}
+
+Value SubscriptIncrementAtIndex(const CallbackInfo& info) {
+  Object obj = info[0].As<Object>();
+  uint32_t index = info[1].As<Number>();
+  double result = 0;
+  if (!MaybeUnwrapTo(obj[index].Increment(), &result)) {
+    return Value();
+  }
+  return Number::New(info.Env(), result);
+}
+
+Value SubscriptIncrementWithNapiValue(const CallbackInfo& info) {
+  const Object obj = info[0].As<Object>();
+  double result = 0;
+  if (!MaybeUnwrapTo(obj[info[1]].Increment(), &result)) {
+    return Value();
+  }
+  return Number::New(info.Env(), result);
+}
+
+// Adds 1 to the property `count` times through a single PropertyLValue whose
+// key was created outside the handle scopes of the individual additions.
+void SubscriptAccumulateWithCppStyleString(const CallbackInfo& info) {
+  Env env = info.Env();
+  Object obj = info[0].As<Object>();
+  Object::PropertyLValue<std::string> counter =
+      obj[info[1].As<String>().Utf8Value()];
+  uint32_t count = info[2].As<Number>();
+  for (uint32_t i = 0; i < count; i++) {
+    HandleScope scope(env);
+    counter += 1;
+  }
+}
@@ -14,4 +14,46 @@ function test (binding) {
   testProperty({ key: 'override me' }, 'key', 'value', binding.object.subscriptGetWithCppStyleString, binding.object.subscriptSetWithCppStyleString);
   testProperty({}, 0, 'value', binding.object.subscriptGetAtIndex, binding.object.subscriptSetAtIndex);
   testProperty({ key: 'override me' }, 0, 'value', binding.object.subscriptGetAtIndex, binding.object.subscriptSetAtIndex);
+
+  testIncrement(binding);
+}
+
+function testIncrement (binding) {
+  const obj = { count: 1, text: '5', 0: 10 };
+  assert.strictEqual(binding.object.subscriptIncrementWithCStyleString(obj, 'count', 2), 3);
+  assert.strictEqual(obj.count, 3);
+  // Like `++`, non-numbers are converted rather than concatenated.
+  assert.strictEqual(binding.object.subscriptIncrementWithCStyleString(obj, 'text', 1), 6);
+  assert.strictEqual(obj.text, 6);
+  assert.ok(Number.isNaN(binding.object.subscriptIncrementWithCStyleString(obj, 'missing', 1)));
+  assert.strictEqual(binding.object.subscriptIncrementAtIndex(obj, 0), 11);
+  assert.strictEqual(obj[0], 11);
+
+  const symbol = Symbol('counter');
+  obj[symbol] = -1;
+  assert.strictEqual(binding.object.subscriptIncrementWithNapiValue(obj, symbol), 0);
+  assert.strictEqual(obj[symbol], 0);
+
+  const accumulator = { total: 0 };
+  binding.object.subscriptAccumulateWithCppStyleString(accumulator, 'total', 1000);
+  assert.strictEqual(accumulator.total, 1000);
+
+  // One read and one write per increment.
+  let reads = 0;
+  let writes = 0;
+  let stored = 7;
+  const accessors = {
+    get value () { reads++; return stored; },
+    set value (value) { writes++; stored = value; }
+  };
+  assert.strictEqual(binding.object.subscriptIncrementWithCStyleString(accessors, 'value', 1), 8);
+  assert.deepStrictEqual([reads, writes, stored], [1, 1, 8]);
+
+  const throwing = { get value () { throw new Error('getter error'); } };
+  assert.throws(() => {
+    binding.object.subscriptIncrementWithCStyleString(throwing, 'value', 1);
+  }, /getter error/);
+  assert.throws(() => {
+    binding.object.subscriptIncrementWithCStyleString({ value: 1n }, 'value', 1);
+  }, TypeError);
 }
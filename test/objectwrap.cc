@@ -1,7 +1,10 @@
 #include <napi.h>
 #include "test_helper.h"
 
-Napi::ObjectReference testStaticContextRef;
+// Each environment runs on its own thread. Keeping the reference per thread
+// stops a worker's Init from deleting a reference owned by another, possibly
+// already torn down, environment.
+thread_local Napi::ObjectReference testStaticContextRef;
 
 Napi::Value StaticGetter(const Napi::CallbackInfo& /*info*/) {
   return MaybeUnwrap(testStaticContextRef.Value().Get("value"));
@@ -0,0 +1,96 @@
+#include <napi.h>
+
+namespace {
+
+static int liveCounters = 0;
+static int failedDestroyed = 0;
+
+class DestroyedCounter {
+ public:
+  ~DestroyedCounter() { failedDestroyed++; }
+};
+
+// Wrapped without a reference, so the only way from an instance to its object
+// is through the `this` of a call.
+class Counter : public Napi::ObjectWrap<Counter> {
+ public:
+  static constexpr bool kWrapReference = false;
+
+  Counter(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Counter>(info) {
+    liveCounters++;
+    if (info[0].IsNumber()) {
+      count_ = info[0].As<Napi::Number>().Int32Value();
+    }
+  }
+
+  ~Counter() { liveCounters--; }
+
+  static void Initialize(Napi::Env env, Napi::Object exports) {
+    exports.Set(
+        "Counter",
+        DefineClass(env,
+                    "Counter",
+                    {
+                        InstanceMethod<&Counter::Increment>("increment"),
+                        InstanceAccessor<&Counter::GetCount>("count"),
+                        InstanceMethod<&Counter::HasReference>("hasReference"),
+                    }));
+  }
+
+ private:
+  Napi::Value Increment(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), ++count_);
+  }
+
+  Napi::Value GetCount(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), count_);
+  }
+
+  Napi::Value HasReference(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), !IsEmpty());
+  }
+
+  int32_t count_ = 0;
+};
+
+// Without a reference, the wrap is removed by the constructor callback rather
+// than by the destructor when construction fails.
+class Failing : public Napi::ObjectWrap<Failing> {
+ public:
+  static constexpr bool kWrapReference = false;
+
+  Failing(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Failing>(info) {
+#ifdef NAPI_CPP_EXCEPTIONS
+    throw Napi::Error::New(Env(), "Some error");
+#else
+    Napi::Error::New(Env(), "Some error").ThrowAsJavaScriptException();
+#endif
+  }
+
+  static void Initialize(Napi::Env env, Napi::Object exports) {
+    exports.Set("Failing", DefineClass(env, "Failing", {}));
+  }
+
+ private:
+  DestroyedCounter destroyedCounter_;
+};
+
+Napi::Value GetLiveCounters(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), liveCounters);
+}
+
+Napi::Value GetFailedDestroyed(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), failedDestroyed);
+}
+
+}  // anonymous namespace
+
+Napi::Object InitObjectWrapNoReference(Napi::Env env) {
+  Napi::Object exports = Napi::Object::New(env);
+  Counter::Initialize(env, exports);
+  Failing::Initialize(env, exports);
+  exports.Set("getLiveCounters", Napi::Function::New(env, GetLiveCounters));
+  exports.Set("getFailedDestroyed",
+              Napi::Function::New(env, GetFailedDestroyed));
+  return exports;
+}
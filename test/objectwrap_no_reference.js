@@ -0,0 +1,44 @@
+'use strict';
+
+const assert = require('assert');
+const testUtil = require('./testUtil');
+
+function test (binding) {
+  const {
+    Counter,
+    Failing,
+    getLiveCounters,
+    getFailedDestroyed
+  } = binding.objectwrap_no_reference;
+  const liveCounters = getLiveCounters();
+
+  return testUtil.runGCTests([
+    'objectwrap without reference',
+    () => {
+      const counter = new Counter(41);
+      assert.strictEqual(counter.hasReference(), false);
+      assert.strictEqual(counter.increment(), 42);
+      assert.strictEqual(counter.count, 42);
+      assert.strictEqual(getLiveCounters(), liveCounters + 1);
+
+      for (let i = 0; i < 100; i++) {
+        // eslint-disable-next-line no-new
+        new Counter();
+      }
+    },
+    () => {
+      assert.strictEqual(getLiveCounters(), liveCounters);
+    },
+
+    'objectwrap without reference, constructor exception',
+    () => {
+      const failedDestroyed = getFailedDestroyed();
+      assert.throws(() => new Failing(), /Some error/);
+      assert.strictEqual(getFailedDestroyed(), failedDestroyed + 1);
+    },
+    // Test that gc does not crash.
+    () => {}
+  ]);
+}
+
+module.exports = require('./common').runTest(test);
@@ -0,0 +1,118 @@
+#include <string>
+#include "napi.h"
+#include "test_helper.h"
+
+#if (NAPI_VERSION > 2)
+namespace {
+
+struct Blob {
+  explicit Blob(std::string contents) : contents(std::move(contents)) {}
+  std::string contents;
+};
+
+class TransferBlob : public Napi::ObjectWrap<TransferBlob> {
+ public:
+  static Napi::Function Initialize(Napi::Env env) {
+    return DefineClass(
+        env,
+        "TransferBlob",
+        {
+            InstanceMethod("contents", &TransferBlob::Contents),
+            InstanceMethod("address", &TransferBlob::Address),
+            InstanceMethod("useCount", &TransferBlob::UseCount),
+            InstanceMethod("isEmpty", &TransferBlob::IsEmpty),
+            InstanceMethod("detach", &TransferBlob::Detach),
+            InstanceMethod("share", &TransferBlob::Share),
+        });
+  }
+
+  TransferBlob(const Napi::CallbackInfo& info)
+      : Napi::ObjectWrap<TransferBlob>(info) {
+    if (info[0].IsString()) {
+      _blob = Napi::Transferable<Blob>::New(
+          info[0].As<Napi::String>().Utf8Value());
+    } else {
+      MaybeUnwrapTo(Napi::Transferable<Blob>::Adopt(info.Env(), info[0]),
+                    &_blob);
+    }
+  }
+
+ private:
+  Napi::Value Contents(const Napi::CallbackInfo& info) {
+    if (_blob.IsEmpty()) {
+      NAPI_THROW(Napi::Error::New(info.Env(), "detached"), Napi::Value());
+    }
+    return Napi::String::New(info.Env(), _blob->contents);
+  }
+
+  // The address of the payload shows that transfers do not copy it.
+  Napi::Value Address(const Napi::CallbackInfo& info) {
+    return Napi::String::New(
+        info.Env(),
+        std::to_string(reinterpret_cast<uintptr_t>(_blob.Get())));
+  }
+
+  Napi::Value UseCount(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(),
+                             static_cast<double>(_blob.Payload().use_count()));
+  }
+
+  Napi::Value IsEmpty(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), _blob.IsEmpty());
+  }
+
+  Napi::Value Detach(const Napi::CallbackInfo& info) {
+    return MaybeUnwrapOr(_blob.Detach(info.Env()), Napi::Number());
+  }
+
+  Napi::Value Share(const Napi::CallbackInfo& info) {
+    return MaybeUnwrapOr(_blob.Share(info.Env()), Napi::Number());
+  }
+
+  Napi::Transferable<Blob> _blob;
+};
+
+class NeverDefined : public Napi::ObjectWrap<NeverDefined> {
+ public:
+  NeverDefined(const Napi::CallbackInfo& info)
+      : Napi::ObjectWrap<NeverDefined>(info) {}
+};
+
+// Creates the wrapper through the constructor defined in the calling
+// environment.
+Napi::Value Adopt(const Napi::CallbackInfo& info) {
+  Napi::Function constructor = TransferBlob::Constructor(info.Env());
+  if (constructor.IsEmpty()) {
+    return Napi::Value();
+  }
+  return MaybeUnwrapOr(constructor.New({info[0]}), Napi::Object());
+}
+
+Napi::Value AdoptAsInt(const Napi::CallbackInfo& info) {
+  Napi::Transferable<int> payload;
+  MaybeUnwrapTo(Napi::Transferable<int>::Adopt(info.Env(), info[0]), &payload);
+  return info.Env().Undefined();
+}
+
+Napi::Value Discard(const Napi::CallbackInfo& info) {
+  return Napi::Boolean::New(
+      info.Env(), Napi::Transferable<Blob>::Discard(info.Env(), info[0]));
+}
+
+Napi::Value UndefinedConstructor(const Napi::CallbackInfo& info) {
+  return NeverDefined::Constructor(info.Env());
+}
+
+}  // anonymous namespace
+
+Napi::Object InitObjectWrapTransfer(Napi::Env env) {
+  Napi::Object exports = Napi::Object::New(env);
+  exports["TransferBlob"] = TransferBlob::Initialize(env);
+  exports["adopt"] = Napi::Function::New(env, Adopt);
+  exports["adoptAsInt"] = Napi::Function::New(env, AdoptAsInt);
+  exports["discard"] = Napi::Function::New(env, Discard);
+  exports["undefinedConstructor"] =
+      Napi::Function::New(env, UndefinedConstructor);
+  return exports;
+}
+#endif
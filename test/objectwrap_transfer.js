@@ -0,0 +1,103 @@
+'use strict';
+
+const assert = require('assert');
+const {
+  Worker, isMainThread, parentPort, workerData
+} = require('worker_threads');
+
+if (isMainThread) {
+  module.exports = require('./common').runTestWithBindingPath(test);
+} else {
+  const { TransferBlob, adopt } =
+    require(workerData.bindingPath).objectwrap_transfer;
+  const blob = adopt(workerData.token);
+  if (workerData.reshare) {
+    // Published by this environment, which exits before the token is adopted.
+    parentPort.postMessage(blob.share());
+  } else {
+    parentPort.postMessage({
+      contents: blob.contents(),
+      address: blob.address(),
+      isInstance: blob instanceof TransferBlob
+    });
+  }
+}
+
+async function test (bindingPath) {
+  const binding = require(bindingPath).objectwrap_transfer;
+  const { TransferBlob } = binding;
+  const invalidToken = { message: 'Invalid or already adopted transfer token' };
+
+  const blob = new TransferBlob('payload');
+  const address = blob.address();
+  assert.strictEqual(blob.useCount(), 1);
+
+  // Detaching leaves the original wrapper empty.
+  const token = blob.detach();
+  assert.strictEqual(typeof token, 'number');
+  assert.ok(blob.isEmpty());
+  assert.throws(() => blob.contents(), { message: 'detached' });
+  assert.throws(() => blob.detach(), { message: 'The transferable is empty' });
+
+  // Adopting creates a new wrapper around the same payload.
+  const adopted = binding.adopt(token);
+  assert.ok(adopted instanceof TransferBlob);
+  assert.strictEqual(adopted.contents(), 'payload');
+  assert.strictEqual(adopted.address(), address);
+  assert.throws(() => binding.adopt(token), invalidToken);
+  for (const bad of [0, -1, 1.5, NaN, null]) {
+    assert.throws(() => new TransferBlob(bad), invalidToken);
+  }
+
+  // Sharing publishes an additional reference.
+  const shared = adopted.share();
+  assert.strictEqual(adopted.useCount(), 2);
+  const second = new TransferBlob(shared);
+  assert.strictEqual(second.address(), address);
+  assert.strictEqual(second.useCount(), 2);
+  assert.strictEqual(adopted.contents(), 'payload');
+
+  // Tokens are bound to their payload type and can be discarded.
+  const unclaimed = second.detach();
+  assert.throws(() => binding.adoptAsInt(unclaimed), invalidToken);
+  assert.strictEqual(adopted.useCount(), 2);
+  assert.strictEqual(binding.discard(unclaimed), true);
+  assert.strictEqual(binding.discard(unclaimed), false);
+  assert.strictEqual(adopted.useCount(), 1);
+
+  assert.throws(() => binding.undefinedConstructor(), {
+    message: 'The class has not been defined in this environment'
+  });
+
+  // The payload moves to a worker thread, where the class is looked up in the
+  // worker's own environment.
+  const workerToken = adopted.detach();
+  const result = await new Promise((resolve, reject) => {
+    const worker = new Worker(__filename, {
+      workerData: { bindingPath, token: workerToken }
+    });
+    worker.once('message', resolve);
+    worker.once('error', reject);
+  });
+  assert.deepStrictEqual(result, {
+    contents: 'payload',
+    address,
+    isInstance: true
+  });
+
+  // Payloads that nobody adopted are released when the environment that
+  // published them is torn down.
+  const owner = new TransferBlob('owned');
+  const orphan = await new Promise((resolve, reject) => {
+    const worker = new Worker(__filename, {
+      workerData: { bindingPath, token: owner.share(), reshare: true }
+    });
+    let token;
+    worker.once('message', (message) => { token = message; });
+    worker.once('error', reject);
+    worker.once('exit', () => resolve(token));
+  });
+  assert.strictEqual(typeof orphan, 'number');
+  assert.throws(() => binding.adopt(orphan), invalidToken);
+  assert.strictEqual(owner.useCount(), 1);
+}
@@ -0,0 +1,74 @@
+#include "napi.h"
+#include "test_helper.h"
+
+using namespace Napi;
+
+#if (NAPI_VERSION > 5)
+namespace {
+
+Value Serialize(const CallbackInfo& info) {
+  return MaybeUnwrapOr(Serializer::Serialize(info.Env(), info[0]),
+                       Buffer<uint8_t>());
+}
+
+Value Deserialize(const CallbackInfo& info) {
+  Buffer<uint8_t> buffer = info[0].As<Buffer<uint8_t>>();
+  return MaybeUnwrapOr(
+      Deserializer::Deserialize(info.Env(), buffer.Data(), buffer.Length()),
+      Value());
+}
+
+Value RoundTrip(const CallbackInfo& info) {
+  Env env = info.Env();
+  Serializer serializer(env);
+  if (!MaybeUnwrapOr(serializer.WriteValue(info[0]), false)) {
+    return Value();
+  }
+  std::vector<uint8_t> data = serializer.Release();
+  return MaybeUnwrapOr(
+      Deserializer::Deserialize(env, data.data(), data.size()), Value());
+}
+
+// Writes each element of the array as a separate value.
+Value SerializeEach(const CallbackInfo& info) {
+  Env env = info.Env();
+  Array values = info[0].As<Array>();
+  Serializer serializer(env);
+  for (uint32_t i = 0; i < values.Length(); ++i) {
+    if (!MaybeUnwrapOr(serializer.WriteValue(MaybeUnwrap(values.Get(i))),
+                       false)) {
+      return Value();
+    }
+  }
+  return Buffer<uint8_t>::Copy(
+      env, serializer.Data().data(), serializer.Data().size());
+}
+
+// Reads values until the end of the buffer and returns them in an array.
+Value DeserializeEach(const CallbackInfo& info) {
+  Env env = info.Env();
+  Buffer<uint8_t> buffer = info[0].As<Buffer<uint8_t>>();
+  Deserializer deserializer(env, buffer.Data(), buffer.Length());
+  Array result = Array::New(env);
+  while (!deserializer.AtEnd()) {
+    Value value;
+    if (!MaybeUnwrapTo(deserializer.ReadValue(), &value) || value.IsEmpty()) {
+      return Value();
+    }
+    result.Set(result.Length(), value);
+  }
+  return result;
+}
+
+}  // end anonymous namespace
+
+Object InitSerializer(Env env) {
+  Object exports = Object::New(env);
+  exports["serialize"] = Function::New(env, Serialize);
+  exports["deserialize"] = Function::New(env, Deserialize);
+  exports["roundTrip"] = Function::New(env, RoundTrip);
+  exports["serializeEach"] = Function::New(env, SerializeEach);
+  exports["deserializeEach"] = Function::New(env, DeserializeEach);
+  return exports;
+}
+#endif
@@ -0,0 +1,136 @@
+'use strict';
+
+const assert = require('assert');
+
+module.exports = require('./common').runTest(test);
+
+function test (binding) {
+  const { serialize, deserialize, roundTrip } = binding.serializer;
+
+  const primitives = [
+    undefined, null, true, false, 0, -0, 1, -1, 2147483647, -2147483648,
+    2147483648, 0.5, NaN, Infinity, -Infinity, '', 'ascii', 'é', '😀',
+    '\ud800', 0n, 1n, -1n, 2n ** 64n, -(2n ** 130n)
+  ];
+  for (const value of primitives) {
+    assert.ok(Object.is(roundTrip(value), value), String(value));
+    assert.ok(Object.is(deserialize(serialize(value)), value), String(value));
+  }
+
+  const date = new Date(1234567890123);
+  assert.deepStrictEqual(roundTrip(date), date);
+  assert.ok(Number.isNaN(roundTrip(new Date(NaN)).getTime()));
+
+  const graph = {
+    name: 'root',
+    list: [1, 'two', { three: 3 }, [4]],
+    nested: { a: { b: { c: null } } },
+    [Symbol('ignored')]: 1
+  };
+  Object.defineProperty(graph, 'hidden', { value: 1, enumerable: false });
+  assert.deepStrictEqual(roundTrip(graph), {
+    name: 'root',
+    list: [1, 'two', { three: 3 }, [4]],
+    nested: { a: { b: { c: null } } }
+  });
+  assert.deepStrictEqual(roundTrip({ 1: 'a', b: 'b' }), { 1: 'a', b: 'b' });
+  assert.deepStrictEqual(roundTrip(Object.create(null)), {});
+  assert.deepStrictEqual(roundTrip([1, , 3]), [1, undefined, 3]); // eslint-disable-line no-sparse-arrays
+
+  // "__proto__" is restored as an own property, not as the prototype.
+  const proto = roundTrip(JSON.parse('{"__proto__":{"x":1}}'));
+  assert.strictEqual(Object.getPrototypeOf(proto), Object.prototype);
+  assert.deepStrictEqual(Object.keys(proto), ['__proto__']);
+
+  // Cycles and shared objects keep their identity.
+  const cyclic = { items: [] };
+  cyclic.self = cyclic;
+  cyclic.items.push(cyclic, cyclic.items);
+  const copy = roundTrip(cyclic);
+  assert.notStrictEqual(copy, cyclic);
+  assert.strictEqual(copy.self, copy);
+  assert.strictEqual(copy.items[0], copy);
+  assert.strictEqual(copy.items[1], copy.items);
+
+  const shared = { value: 1 };
+  const pair = roundTrip([shared, shared, { shared }]);
+  assert.strictEqual(pair[0], pair[1]);
+  assert.strictEqual(pair[2].shared, pair[0]);
+
+  // Binary data is copied byte for byte.
+  const buffer = Buffer.from('buffer');
+  const bufferCopy = roundTrip(buffer);
+  assert.ok(Buffer.isBuffer(bufferCopy));
+  assert.deepStrictEqual(bufferCopy, buffer);
+
+  const backing = new ArrayBuffer(32);
+  new Uint8Array(backing).forEach((_, i, a) => { a[i] = i; });
+  assert.deepStrictEqual(roundTrip(backing), backing);
+  const view = new DataView(backing, 4, 8);
+  const viewCopy = roundTrip(view);
+  assert.ok(viewCopy instanceof DataView);
+  assert.strictEqual(viewCopy.byteLength, 8);
+  assert.strictEqual(viewCopy.getUint8(0), 4);
+
+  const typedArrays = [
+    new Int8Array([-1, 2]), new Uint8Array([1, 2]),
+    new Uint8ClampedArray([255]), new Int16Array([-300]),
+    new Uint16Array([60000]), new Int32Array([-70000]),
+    new Uint32Array([4000000000]), new Float32Array([0.5]),
+    new Float64Array([Math.PI, -0]), new BigInt64Array([-1n]),
+    new BigUint64Array([2n ** 63n]), new Float64Array(backing, 8, 2),
+    new Uint8Array(0)
+  ];
+  for (const array of typedArrays) {
+    const arrayCopy = roundTrip(array);
+    assert.strictEqual(arrayCopy.constructor, array.constructor);
+    assert.deepStrictEqual(arrayCopy, array);
+  }
+
+  // Repeated keys are written once per value.
+  const rows = Array.from({ length: 100 }, (_, i) => ({ identifier: i }));
+  const keyBytes = Buffer.from('identifier');
+  const serialized = serialize(rows);
+  assert.strictEqual(serialized.indexOf(keyBytes),
+    serialized.lastIndexOf(keyBytes));
+  assert.deepStrictEqual(deserialize(serialized), rows);
+
+  // Several values can share one buffer; each one is self-contained.
+  const values = [{ a: 1 }, 'two', [3n], { a: 4 }];
+  assert.deepStrictEqual(
+    binding.serializer.deserializeEach(
+      binding.serializer.serializeEach(values)),
+    values);
+  assert.deepStrictEqual(
+    binding.serializer.deserializeEach(binding.serializer.serializeEach([])),
+    []);
+
+  assert.throws(() => roundTrip(() => {}), {
+    name: 'TypeError',
+    message: 'Functions cannot be serialized'
+  });
+  assert.throws(() => roundTrip({ nested: [Symbol('s')] }), {
+    name: 'TypeError',
+    message: 'Symbols cannot be serialized'
+  });
+  assert.throws(() => roundTrip({
+    get failing () { throw new Error('getter'); }
+  }), { message: 'getter' });
+
+  let deep = [];
+  for (let i = 0; i < 5000; ++i) deep = [deep];
+  assert.throws(() => roundTrip(deep), RangeError);
+
+  const invalid = { message: 'Invalid serialized data' };
+  assert.throws(() => deserialize(Buffer.alloc(0)), invalid);
+  assert.throws(() => deserialize(Buffer.from('xx')), invalid);
+  const truncated = serialize({ key: 'value' });
+  assert.throws(
+    () => deserialize(truncated.subarray(0, truncated.length - 1)), invalid);
+  const badReference = Buffer.concat([serialize(null).subarray(0, 2),
+    Buffer.from('^\u0005')]);
+  assert.throws(() => deserialize(badReference), invalid);
+  assert.throws(
+    () => binding.serializer.deserializeEach(Buffer.from('N\u0001?')),
+    invalid);
+}
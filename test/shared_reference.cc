@@ -0,0 +1,98 @@
+#include <vector>
+#include "napi.h"
+#include "test_helper.h"
+
+using namespace Napi;
+
+namespace {
+
+using Holder = std::vector<SharedReference<Object>>;
+
+Value CopiesShareRef(const CallbackInfo& info) {
+  Object obj = info[0].As<Object>();
+  SharedReference<Object> original = SharedReference<Object>::New(obj);
+  SharedReference<Object> copy = original;
+  SharedReference<Object> assigned;
+  assigned = copy;
+
+  Object result = Object::New(info.Env());
+  result["sameRef"] = static_cast<napi_ref>(original) ==
+                          static_cast<napi_ref>(copy) &&
+                      static_cast<napi_ref>(copy) ==
+                          static_cast<napi_ref>(assigned);
+  result["useCount"] = original.UseCount();
+  result["equal"] = original == assigned;
+  result["value"] = assigned.Value();
+  return result;
+}
+
+Value ResetReleasesShare(const CallbackInfo& info) {
+  Object obj = info[0].As<Object>();
+  SharedReference<Object> original = SharedReference<Object>::New(obj);
+  SharedReference<Object> copy = original;
+  copy.Reset();
+
+  SharedReference<Object> moved = std::move(original);
+  Object result = Object::New(info.Env());
+  result["copyEmpty"] = copy.IsEmpty() && copy.UseCount() == 0;
+  result["movedFromEmpty"] = original.IsEmpty();
+  result["useCount"] = moved.UseCount();
+  result["value"] = moved.Value();
+  return result;
+}
+
+Value AdoptReference(const CallbackInfo& info) {
+  Reference<Object> reference = Persistent(info[0].As<Object>());
+  napi_ref ref = reference;
+  SharedReference<Object> shared(std::move(reference));
+
+  Object result = Object::New(info.Env());
+  result["adopted"] =
+      reference.IsEmpty() && static_cast<napi_ref>(shared) == ref;
+  result["value"] = shared.Value();
+  return result;
+}
+
+Value EmptyReference(const CallbackInfo& info) {
+  SharedReference<Object> empty;
+  SharedReference<Object> copy = empty;
+  return Boolean::New(info.Env(),
+                      empty.IsEmpty() && copy.IsEmpty() &&
+                          copy.Value().IsEmpty() && empty == copy);
+}
+
+// Keeps `count` copies of one shared reference to `info[0]` alive for as long
+// as the returned external.
+Value CreateHolder(const CallbackInfo& info) {
+  Holder* holder = new Holder();
+  SharedReference<Object> ref =
+      SharedReference<Object>::New(info[0].As<Object>());
+  uint32_t count = info[1].As<Number>().Uint32Value();
+  for (uint32_t index = 0; index < count; index++) {
+    holder->push_back(ref);
+  }
+  return External<Holder>::New(
+      info.Env(), holder, [](Env, Holder* data) { delete data; });
+}
+
+Value Release(const CallbackInfo& info) {
+  Holder* holder = info[0].As<External<Holder>>().Data();
+  holder->pop_back();
+  return Number::New(info.Env(),
+                     holder->empty() ? 0 : holder->back().UseCount());
+}
+
+}  // namespace
+
+Object InitSharedReference(Env env) {
+  Object exports = Object::New(env);
+
+  exports["copiesShareRef"] = Function::New(env, CopiesShareRef);
+  exports["resetReleasesShare"] = Function::New(env, ResetReleasesShare);
+  exports["adoptReference"] = Function::New(env, AdoptReference);
+  exports["emptyReference"] = Function::New(env, EmptyReference);
+  exports["createHolder"] = Function::New(env, CreateHolder);
+  exports["release"] = Function::New(env, Release);
+
+  return exports;
+}
@@ -0,0 +1,53 @@
+'use strict';
+
+const assert = require('assert');
+const testUtil = require('./testUtil');
+
+module.exports = require('./common').runTest(test);
+
+function test (binding) {
+  const sharedReference = binding.shared_reference;
+  const obj = {};
+
+  let result = sharedReference.copiesShareRef(obj);
+  assert.strictEqual(result.sameRef, true);
+  assert.strictEqual(result.useCount, 3);
+  assert.strictEqual(result.equal, true);
+  assert.strictEqual(result.value, obj);
+
+  result = sharedReference.resetReleasesShare(obj);
+  assert.strictEqual(result.copyEmpty, true);
+  assert.strictEqual(result.movedFromEmpty, true);
+  assert.strictEqual(result.useCount, 1);
+  assert.strictEqual(result.value, obj);
+
+  result = sharedReference.adoptReference(obj);
+  assert.strictEqual(result.adopted, true);
+  assert.strictEqual(result.value, obj);
+
+  assert.strictEqual(sharedReference.emptyReference(), true);
+
+  let holder;
+  let weak;
+  return testUtil.runGCTests([
+    'the last copy keeps the value alive',
+    () => {
+      const held = {};
+      weak = new WeakRef(held);
+      holder = sharedReference.createHolder(held, 3);
+      assert.strictEqual(sharedReference.release(holder), 2);
+      assert.strictEqual(sharedReference.release(holder), 1);
+    },
+    () => {
+      assert.notStrictEqual(weak.deref(), undefined);
+    },
+
+    'releasing the last copy deletes the reference',
+    () => {
+      assert.strictEqual(sharedReference.release(holder), 0);
+    },
+    () => {
+      assert.strictEqual(weak.deref(), undefined);
+    }
+  ]);
+}
@@ -56,6 +56,21 @@ function test (binding) {
   assertCanCreateOrFetchGlobalSymbols('CppKey', binding.symbol.getSymbolFromGlobalRegistryWithCppKey);
   assertCanCreateOrFetchGlobalSymbols('CKey', binding.symbol.getSymbolFromGlobalRegistryWithCKey);
 
+  assert.strictEqual(binding.symbol.getWellKnownSymbol('iterator'), Symbol.iterator);
+  assert.strictEqual(binding.symbol.getSymbolFromGlobalRegistryWithCKey('CKey'), Symbol.for('CKey'));
+  assert.strictEqual(binding.symbol.getSymbolFromGlobalRegistryWithCppKey('CppKey'), Symbol.for('CppKey'));
+
+  // Once cached, `Symbol.for` and the symbols are not looked up again.
+  const symbolFor = Symbol.for;
+  Symbol.for = () => Symbol('patched');
+  try {
+    assert.strictEqual(binding.symbol.getSymbolFromGlobalRegistryWithCKey('CKey'), symbolFor('CKey'));
+    assert.strictEqual(binding.symbol.getSymbolFromGlobalRegistryWithCKey('new'), symbolFor('new'));
+    assert.strictEqual(binding.symbol.getSymbolFromGlobalRegistry('data'), symbolFor('data'));
+  } finally {
+    Symbol.for = symbolFor;
+  }
+
   assert(binding.symbol.createNewSymbolWithNoArgs() === undefined);
 
   // eslint-disable-next-line no-self-compare